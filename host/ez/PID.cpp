@@ -0,0 +1,201 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Host build of EZ-Template's PID, only the headers ship with the V5 library
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+PID::PID() { reset_i_sgn = true; }
+
+PID::PID(double p, double i, double d, double start_i, std::string name) {
+  reset_i_sgn = true;
+  constants_set(p, i, d, start_i);
+  if (name != "") name_set(name);
+}
+
+void PID::constants_set(double p, double i, double d, double p_start_i) { constants = {p, i, d, p_start_i}; }
+
+PID::Constants PID::constants_get() { return constants; }
+
+bool PID::constants_set_check() { return !(constants.kp == 0 && constants.ki == 0 && constants.kd == 0 && constants.start_i == 0); }
+
+void PID::exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout) {
+  exit = {p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout};
+}
+
+void PID::target_set(double input) { target = input; }
+
+double PID::target_get() { return target; }
+
+void PID::name_set(std::string p_name) {
+  name = p_name;
+  name_active = name != "";
+}
+
+std::string PID::name_get() { return name; }
+
+void PID::i_reset_toggle(bool toggle) { reset_i_sgn = toggle; }
+
+bool PID::i_reset_get() { return reset_i_sgn; }
+
+void PID::variables_reset() {
+  output = 0;
+  target = 0;
+  error = 0;
+  prev_error = 0;
+  integral = 0;
+  derivative = 0;
+  time = 0;
+  prev_time = 0;
+}
+
+void PID::timers_reset() {
+  i = 0;
+  j = 0;
+  k = 0;
+  l = 0;
+  m = 0;
+  is_mA = false;
+}
+
+double PID::compute(double current) {
+  error = target - current;
+  cur = current;
+  return raw_compute();
+}
+
+double PID::compute_error(double err, double current) {
+  error = err;
+  cur = current;
+  return raw_compute();
+}
+
+double PID::raw_compute() {
+  // The first loop after a reset has no previous reading to compare against
+  if (time == 0) prev_current = cur;
+
+  // Derivative on measurement, so changing the target doesn't kick the output
+  derivative = prev_current - cur;
+
+  if (constants.ki != 0) {
+    // Only build i when within start_i of the target
+    if (fabs(error) < constants.start_i) integral += error;
+
+    // Reset i when the error crosses zero
+    if (util::sgn(error) != util::sgn(prev_error) && reset_i_sgn) integral = 0;
+  }
+
+  output = (error * constants.kp) + (integral * constants.ki) + (derivative * constants.kd);
+
+  prev_current = cur;
+  prev_error = error;
+  prev_time = time;
+  time += util::DELAY_TIME;
+  return output;
+}
+
+void PID::velocity_sensor_secondary_set(double secondary_sensor) { second_sensor = secondary_sensor; }
+double PID::velocity_sensor_secondary_get() { return second_sensor; }
+void PID::velocity_sensor_secondary_toggle_set(bool toggle) { use_second_sensor = toggle; }
+bool PID::velocity_sensor_secondary_toggle_get() { return use_second_sensor; }
+void PID::velocity_sensor_main_exit_set(double zero) { velocity_zero_main = zero; }
+double PID::velocity_sensor_main_exit_get() { return velocity_zero_main; }
+void PID::velocity_sensor_secondary_exit_set(double zero) { velocity_zero_secondary = zero; }
+double PID::velocity_sensor_secondary_exit_get() { return velocity_zero_secondary; }
+
+void PID::exit_condition_print(ez::exit_output exit_type) {
+  if (!name_active) return;
+  std::cout << " " << name << " PID " << exit_to_string(exit_type) << " Exit.\n";
+}
+
+exit_output PID::exit_condition(bool print) {
+  // Nothing to exit on
+  if (exit.small_error == 0 && exit.small_exit_time == 0 && exit.big_error == 0 && exit.big_exit_time == 0 &&
+      exit.velocity_exit_time == 0 && exit.mA_timeout == 0) {
+    if (print) exit_condition_print(ERROR_NO_CONSTANTS);
+    return ERROR_NO_CONSTANTS;
+  }
+
+  // Within small_error for small_exit_time
+  if (exit.small_error != 0) {
+    if (fabs(error) < exit.small_error) {
+      j += util::DELAY_TIME;
+      i = 0;  // Big exit waits while small exit is counting
+      if (j > exit.small_exit_time) {
+        timers_reset();
+        if (print) exit_condition_print(SMALL_EXIT);
+        return SMALL_EXIT;
+      }
+    } else {
+      j = 0;
+    }
+  }
+
+  // Within big_error but not getting closer for big_exit_time
+  if (exit.big_error != 0 && exit.big_exit_time != 0) {
+    if (fabs(error) < exit.big_error) {
+      i += util::DELAY_TIME;
+      if (i > exit.big_exit_time) {
+        timers_reset();
+        if (print) exit_condition_print(BIG_EXIT);
+        return BIG_EXIT;
+      }
+    } else {
+      i = 0;
+    }
+  }
+
+  // Not moving for velocity_exit_time
+  if (exit.velocity_exit_time != 0) {
+    bool stopped = fabs(derivative) <= velocity_zero_main;
+    if (use_second_sensor) stopped = stopped && fabs(second_sensor) <= velocity_zero_secondary;
+    if (stopped) {
+      k += util::DELAY_TIME;
+      if (k > exit.velocity_exit_time) {
+        timers_reset();
+        if (print) exit_condition_print(VELOCITY_EXIT);
+        return VELOCITY_EXIT;
+      }
+    } else {
+      k = 0;
+    }
+  }
+
+  return RUNNING;
+}
+
+exit_output PID::exit_condition(pros::Motor sensor, bool print) {
+  return exit_condition(std::vector<pros::Motor>{sensor}, print);
+}
+
+exit_output PID::exit_condition(pros::MotorGroup sensor, bool print) {
+  std::vector<pros::Motor> motors;
+  for (int8_t port : sensor.get_port_all()) motors.push_back(pros::Motor(port));
+  return exit_condition(motors, print);
+}
+
+exit_output PID::exit_condition(std::vector<pros::Motor> sensor, bool print) {
+  // Any motor over its current limit for mA_timeout
+  if (exit.mA_timeout != 0) {
+    bool over = false;
+    for (pros::Motor& motor : sensor)
+      if (motor.is_over_current()) over = true;
+    if (over) {
+      l += util::DELAY_TIME;
+      if (l > exit.mA_timeout) {
+        timers_reset();
+        if (print) exit_condition_print(mA_EXIT);
+        return mA_EXIT;
+      }
+    } else {
+      l = 0;
+    }
+  }
+
+  return exit_condition(print);
+}
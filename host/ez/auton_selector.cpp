@@ -0,0 +1,103 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Host build of EZ-Template's auton selector, only the headers ship with the V5 library.
+// There's no brain screen or SD card to page through, pick autons by setting
+// ez::as::auton_selector.auton_page_current.
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+Auton::Auton() {
+  Name = "";
+  auton_call = nullptr;
+}
+
+Auton::Auton(std::string name, std::function<void()> callback) {
+  Name = name;
+  auton_call = callback;
+}
+
+AutonSelector::AutonSelector() {
+  auton_count = 0;
+  auton_page_current = 0;
+  last_auton_page_current = 0;
+  Autons = {};
+}
+
+AutonSelector::AutonSelector(std::vector<Auton> autons) {
+  auton_count = autons.size();
+  auton_page_current = 0;
+  last_auton_page_current = 0;
+  Autons = autons;
+}
+
+void AutonSelector::selected_auton_print() {
+  if (auton_page_current < 0 || auton_page_current >= auton_count) return;
+  screen_print("Page " + std::to_string(auton_page_current + 1) + "\n" + Autons[auton_page_current].Name);
+}
+
+void AutonSelector::selected_auton_call() {
+  if (auton_page_current < 0 || auton_page_current >= auton_count) return;
+  if (Autons[auton_page_current].auton_call) Autons[auton_page_current].auton_call();
+}
+
+void AutonSelector::autons_add(std::vector<Auton> autons) {
+  auton_count += autons.size();
+  auton_page_current = 0;
+  for (Auton& auton : autons) Autons.push_back(auton);
+}
+
+namespace ez::as {
+AutonSelector auton_selector{};
+bool turn_off = false;
+int amount_of_blank_pages = 0;
+pros::adi::DigitalIn* limit_switch_left = nullptr;
+pros::adi::DigitalIn* limit_switch_right = nullptr;
+
+void auto_sd_update() {}
+
+void auton_selector_initialize() {}
+
+void page_up() {
+  if (auton_selector.auton_count == 0) return;
+  auton_selector.auton_page_current = (auton_selector.auton_page_current + 1) % auton_selector.auton_count;
+  auton_selector.selected_auton_print();
+}
+
+void page_down() {
+  if (auton_selector.auton_count == 0) return;
+  auton_selector.auton_page_current = (auton_selector.auton_page_current + auton_selector.auton_count - 1) % auton_selector.auton_count;
+  auton_selector.selected_auton_print();
+}
+
+void initialize() {
+  auton_selector_running = true;
+  auton_selector.selected_auton_print();
+}
+
+void shutdown() { auton_selector_running = false; }
+
+bool enabled() { return auton_selector_running; }
+
+void limit_switch_lcd_initialize(pros::adi::DigitalIn* right_limit, pros::adi::DigitalIn* left_limit) {
+  limit_switch_right = right_limit;
+  limit_switch_left = left_limit;
+}
+
+void limitSwitchTask() {}
+
+int page_blank_current() { return 0; }
+
+bool page_blank_is_on(int /*page*/) { return false; }
+
+void page_blank_remove(int /*page*/) {}
+
+void page_blank_remove_all() { amount_of_blank_pages = 0; }
+
+int page_blank_amount() { return amount_of_blank_pages; }
+}  // namespace ez::as
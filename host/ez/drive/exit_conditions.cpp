@@ -0,0 +1,245 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Host build of EZ-Template's pid_wait family
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+static bool is_odom_mode(e_mode mode) { return mode == POINT_TO_POINT || mode == PURE_PURSUIT; }
+
+static bool interfering(exit_output output) { return output == mA_EXIT || output == VELOCITY_EXIT; }
+
+void Drive::pid_wait() {
+  e_mode wait_mode = drive_mode_get();
+
+  if (wait_mode == DRIVE) {
+    exit_output left_exit = RUNNING;
+    exit_output right_exit = RUNNING;
+    while (left_exit == RUNNING || right_exit == RUNNING) {
+      left_exit = left_exit != RUNNING ? left_exit : leftPID.exit_condition(left_motors[0]);
+      right_exit = right_exit != RUNNING ? right_exit : rightPID.exit_condition(right_motors[0]);
+      pros::delay(util::DELAY_TIME);
+    }
+    if (print_toggle) printf("  Left: %s Exit, error: %.2f.   Right: %s Exit, error: %.2f.\n", exit_to_string(left_exit).c_str(), leftPID.error, exit_to_string(right_exit).c_str(), rightPID.error);
+    interfered = interfering(left_exit) || interfering(right_exit);
+  }
+
+  else if (wait_mode == TURN || wait_mode == TURN_TO_POINT) {
+    exit_output turn_exit = RUNNING;
+    while (turn_exit == RUNNING) {
+      turn_exit = turnPID.exit_condition({left_motors[0], right_motors[0]});
+      pros::delay(util::DELAY_TIME);
+    }
+    if (print_toggle) printf("  Turn: %s Exit, error: %.2f.\n", exit_to_string(turn_exit).c_str(), turnPID.error);
+    interfered = interfering(turn_exit);
+  }
+
+  else if (wait_mode == SWING) {
+    exit_output swing_exit = RUNNING;
+    pros::Motor& sensor = current_swing == LEFT_SWING ? left_motors[0] : right_motors[0];
+    while (swing_exit == RUNNING) {
+      swing_exit = swingPID.exit_condition(sensor);
+      pros::delay(util::DELAY_TIME);
+    }
+    if (print_toggle) printf("  Swing: %s Exit, error: %.2f.\n", exit_to_string(swing_exit).c_str(), swingPID.error);
+    interfered = interfering(swing_exit);
+  }
+
+  else if (is_odom_mode(wait_mode)) {
+    exit_output xy_exit = RUNNING;
+    while (xy_exit == RUNNING && drive_mode_get() == wait_mode) {
+      // Pure pursuit can't finish until it's following the last point
+      if (wait_mode != PURE_PURSUIT || pp_index == (int)pp_movements.size() - 1)
+        xy_exit = xyPID.exit_condition({left_motors[0], right_motors[0]});
+      pros::delay(util::DELAY_TIME);
+    }
+    if (print_toggle) printf("  XY: %s Exit, error: %.2f.\n", exit_to_string(xy_exit).c_str(), xyPID.error);
+    interfered = interfering(xy_exit);
+
+    // Odom motions hand over to holding the heading they ended on
+    drive_mode_set(DISABLE);
+    headingPID.target_set(drive_imu_get());
+  }
+}
+
+void Drive::wait_until_drive(double target) {
+  // Targets are relative to where the motion started
+  double l_tar = l_start + target;
+  double r_tar = r_start + target;
+  int l_sgn = util::sgn(l_tar - drive_sensor_left());
+  int r_sgn = util::sgn(r_tar - drive_sensor_right());
+  exit_output left_exit = RUNNING;
+  exit_output right_exit = RUNNING;
+
+  while (true) {
+    double l_error = l_tar - drive_sensor_left();
+    double r_error = r_tar - drive_sensor_right();
+
+    // Both sides have gone past the target
+    if (util::sgn(l_error) != l_sgn && util::sgn(r_error) != r_sgn) {
+      if (print_toggle) printf("  Drive Wait Until Exit Success, triggered at %.2f.   Target: %.2f\n", (drive_sensor_left() - l_start + drive_sensor_right() - r_start) / 2.0, target);
+      return;
+    }
+
+    left_exit = left_exit != RUNNING ? left_exit : leftPID.exit_condition(left_motors[0]);
+    right_exit = right_exit != RUNNING ? right_exit : rightPID.exit_condition(right_motors[0]);
+    if (left_exit != RUNNING && right_exit != RUNNING) {
+      if (print_toggle) printf("  Drive Wait Until Exit Failed.  Left: %s   Right: %s\n", exit_to_string(left_exit).c_str(), exit_to_string(right_exit).c_str());
+      interfered = interfering(left_exit) || interfering(right_exit);
+      return;
+    }
+
+    pros::delay(util::DELAY_TIME);
+  }
+}
+
+void Drive::wait_until_turn_swing(double target) {
+  int g_sgn = util::sgn(target - drive_imu_get());
+  exit_output turn_exit = RUNNING;
+  PID& pid = drive_mode_get() == SWING ? swingPID : turnPID;
+
+  while (true) {
+    double g_error = target - drive_imu_get();
+    if (util::sgn(g_error) != g_sgn) {
+      if (print_toggle) printf("  Turn/Swing Wait Until Exit Success, triggered at %.2f.   Target: %.2f\n", drive_imu_get(), target);
+      return;
+    }
+
+    turn_exit = pid.exit_condition({left_motors[0], right_motors[0]});
+    if (turn_exit != RUNNING) {
+      if (print_toggle) printf("  Turn/Swing Wait Until Exit Failed.  %s\n", exit_to_string(turn_exit).c_str());
+      interfered = interfering(turn_exit);
+      return;
+    }
+
+    pros::delay(util::DELAY_TIME);
+  }
+}
+
+// Waits until an odom motion has travelled target inches
+static void wait_until_odom(double target, double& travelled, PID& xy, std::vector<pros::Motor>& sensors, bool print, bool& interfered) {
+  exit_output xy_exit = RUNNING;
+  while (travelled < fabs(target)) {
+    xy_exit = xy.exit_condition(sensors);
+    if (xy_exit != RUNNING) {
+      if (print) printf("  Odom Wait Until Exit Failed.  %s\n", exit_to_string(xy_exit).c_str());
+      interfered = interfering(xy_exit);
+      return;
+    }
+    pros::delay(util::DELAY_TIME);
+  }
+  if (print) printf("  Odom Wait Until Exit Success, triggered at %.2f.   Target: %.2f\n", travelled, fabs(target));
+}
+
+void Drive::pid_wait_until(double target) {
+  e_mode wait_mode = drive_mode_get();
+  if (wait_mode == DRIVE) {
+    wait_until_drive(target);
+  } else if (wait_mode == TURN || wait_mode == TURN_TO_POINT || wait_mode == SWING) {
+    // Go the same way around as the motion does
+    double error = util::wrap_angle(flip_angle_target(target) - chain_sensor_start);
+    if (chain_target_start > chain_sensor_start && error < 0) error += 360.0;
+    if (chain_target_start < chain_sensor_start && error > 0) error -= 360.0;
+    wait_until_turn_swing(chain_sensor_start + error);
+  } else if (is_odom_mode(wait_mode)) {
+    std::vector<pros::Motor> sensors = {left_motors[0], right_motors[0]};
+    wait_until_odom(target, xy_current_fake, xyPID, sensors, print_toggle, interfered);
+  }
+}
+
+void Drive::pid_wait_until(okapi::QLength target) { pid_wait_until(target.convert(okapi::inch)); }
+
+void Drive::pid_wait_until(okapi::QAngle target) { pid_wait_until(target.convert(okapi::degree)); }
+
+void Drive::pid_wait_quick() {
+  e_mode wait_mode = drive_mode_get();
+  if (wait_mode == DRIVE) {
+    wait_until_drive(chain_target_start);
+  } else if (wait_mode == TURN || wait_mode == TURN_TO_POINT || wait_mode == SWING) {
+    wait_until_turn_swing(chain_target_start);
+  } else if (is_odom_mode(wait_mode)) {
+    std::vector<pros::Motor> sensors = {left_motors[0], right_motors[0]};
+    wait_until_odom(chain_target_start, xy_current_fake, xyPID, sensors, print_toggle, interfered);
+  }
+}
+
+void Drive::pid_wait_quick_chain() {
+  e_mode wait_mode = drive_mode_get();
+  double scale = motion_chain_backward ? -used_motion_chain_scale : used_motion_chain_scale;
+
+  // Aim past the target so the robot is still moving when the next motion takes over
+  if (wait_mode == DRIVE) {
+    leftPID.target_set(leftPID.target_get() + scale);
+    rightPID.target_set(rightPID.target_get() + scale);
+    wait_until_drive(chain_target_start);
+  } else if (wait_mode == TURN || wait_mode == TURN_TO_POINT) {
+    turnPID.target_set(turnPID.target_get() + scale);
+    wait_until_turn_swing(chain_target_start);
+  } else if (wait_mode == SWING) {
+    swingPID.target_set(swingPID.target_get() + scale);
+    wait_until_turn_swing(chain_target_start);
+  } else if (is_odom_mode(wait_mode)) {
+    pose from = wait_mode == PURE_PURSUIT ? odom_second_to_last : odom_start;
+    double angle = util::absolute_angle_to_point(odom_target, from);
+    pose extended = util::vector_off_point(used_motion_chain_scale, {odom_target.x, odom_target.y, angle});
+    odom_target.x = extended.x;
+    odom_target.y = extended.y;
+    if (wait_mode == PURE_PURSUIT) pp_movements.back().target = odom_target;
+    xyPID.target_set(xyPID.target_get() + used_motion_chain_scale);
+    std::vector<pros::Motor> sensors = {left_motors[0], right_motors[0]};
+    wait_until_odom(chain_target_start, xy_current_fake, xyPID, sensors, print_toggle, interfered);
+  } else {
+    pid_wait();
+  }
+}
+
+void Drive::pid_wait_until_index_started(int index) {
+  if (index < 0 || index >= (int)injected_pp_index.size()) return;
+  while (drive_mode_get() == PURE_PURSUIT && pp_index < injected_pp_index[index]) pros::delay(util::DELAY_TIME);
+}
+
+void Drive::pid_wait_until_index(int index) {
+  if (index < 0 || index >= (int)injected_pp_index.size()) return;
+  int path_index = injected_pp_index[index];
+  pose point = pp_movements[path_index].target;
+  pose before = pp_movements[std::max(path_index - 1, 0)].target;
+  double angle = util::to_rad(util::absolute_angle_to_point(point, before));
+
+  // Passed once the robot is beyond the point along the path going into it
+  exit_output xy_exit = RUNNING;
+  while (drive_mode_get() == PURE_PURSUIT) {
+    double ahead = (point.x - odom_current.x) * sin(angle) + (point.y - odom_current.y) * cos(angle);
+    if (pp_index >= path_index && ahead <= 0) break;
+    if (pp_index == (int)pp_movements.size() - 1) {
+      xy_exit = xyPID.exit_condition({left_motors[0], right_motors[0]});
+      if (xy_exit != RUNNING) break;
+    }
+    pros::delay(util::DELAY_TIME);
+  }
+  if (print_toggle) printf("  Pure Pursuit Wait Until Index %d Done.\n", index);
+}
+
+void Drive::pid_wait_until_point(pose target) {
+  pose point = flip_pose(target);
+  exit_output xy_exit = RUNNING;
+  while (is_odom_mode(drive_mode_get()) && is_past_target(point, odom_current) > 0) {
+    xy_exit = xyPID.exit_condition({left_motors[0], right_motors[0]});
+    if (xy_exit != RUNNING) {
+      interfered = interfering(xy_exit);
+      break;
+    }
+    pros::delay(util::DELAY_TIME);
+  }
+  if (print_toggle) printf("  Wait Until Point (%.2f, %.2f) Done.\n", target.x, target.y);
+}
+
+void Drive::pid_wait_until_point(united_pose target) { pid_wait_until_point(util::united_pose_to_pose(target)); }
+
+void Drive::pid_wait_until(pose target) { pid_wait_until_point(target); }
+
+void Drive::pid_wait_until(united_pose target) { pid_wait_until_point(target); }
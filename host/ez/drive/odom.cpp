@@ -0,0 +1,306 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Host build of EZ-Template's odom motion setters and path building
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+////
+// Flipping between the user's field and the internal one
+
+pose Drive::flip_pose(pose input) {
+  pose output = input;
+  if (x_flipped) output.x = -output.x;
+  if (y_flipped) output.y = -output.y;
+  if (theta_flipped && output.theta != ANGLE_NOT_SET) output.theta = -output.theta;
+  return output;
+}
+
+odom Drive::set_odom_direction(odom input) {
+  odom output = input;
+  output.target = flip_pose(input.target);
+  return output;
+}
+
+std::vector<odom> Drive::set_odoms_direction(std::vector<odom> inputs) {
+  std::vector<odom> output;
+  for (auto& input : inputs) output.push_back(set_odom_direction(input));
+  return output;
+}
+
+bool Drive::odom_turn_bias_enabled() { return is_odom_turn_bias_enabled; }
+
+void Drive::odom_turn_bias_enable(bool set) { is_odom_turn_bias_enabled = set; }
+
+////
+// Path helpers
+
+double Drive::is_past_target(pose target, pose current) {
+  // Distance left to the target along the line the motion started on, negative once past it
+  double angle = util::to_rad(util::absolute_angle_to_point(target, odom_start));
+  return (target.x - current.x) * sin(angle) + (target.y - current.y) * cos(angle);
+}
+
+std::vector<pose> Drive::find_point_to_face(pose current, pose target, drive_directions /*dir*/, bool set_global) {
+  // A point past the target on the line from the start, so the heading settles instead of
+  // chasing the target as the robot gets close to it
+  double angle = util::absolute_angle_to_point(target, current);
+  pose extended = util::vector_off_point(LOOK_AHEAD, {target.x, target.y, angle});
+  std::vector<pose> output = {target, extended};
+  if (set_global) point_to_face = output;
+  return output;
+}
+
+std::vector<odom> Drive::inject_points(std::vector<odom> imovements) {
+  injected_pp_index.clear();
+  std::vector<odom> output;
+  if (imovements.empty()) return output;
+
+  output.push_back(imovements[0]);
+  for (size_t i = 1; i < imovements.size(); i++) {
+    pose start = imovements[i - 1].target;
+    pose end = imovements[i].target;
+    double length = util::distance_to_point(end, start);
+    int count = (int)floor(length / SPACING);
+    for (int j = 1; j < count; j++) {
+      double t = (j * SPACING) / length;
+      odom point = imovements[i];
+      point.target = {start.x + (end.x - start.x) * t, start.y + (end.y - start.y) * t, ANGLE_NOT_SET};
+      output.push_back(point);
+    }
+    output.push_back(imovements[i]);
+
+    // The first movement is where the robot already is, so user index 0 is movement 1
+    injected_pp_index.push_back(output.size() - 1);
+  }
+  return output;
+}
+
+std::vector<odom> Drive::smooth_path(std::vector<odom> ipath, double weight_smooth, double weight_data, double tolerance) {
+  std::vector<odom> path = ipath;
+  if (path.size() < 3) return path;
+
+  double change = tolerance;
+  int iterations = 0;
+  while (change >= tolerance && iterations++ < 1000) {
+    change = 0.0;
+    for (size_t i = 1; i < path.size() - 1; i++) {
+      double old_x = path[i].target.x, old_y = path[i].target.y;
+      path[i].target.x += weight_data * (ipath[i].target.x - path[i].target.x) + weight_smooth * (path[i - 1].target.x + path[i + 1].target.x - 2.0 * path[i].target.x);
+      path[i].target.y += weight_data * (ipath[i].target.y - path[i].target.y) + weight_smooth * (path[i - 1].target.y + path[i + 1].target.y - 2.0 * path[i].target.y);
+      change += fabs(old_x - path[i].target.x) + fabs(old_y - path[i].target.y);
+    }
+  }
+  return path;
+}
+
+void Drive::odom_path_print() {
+  for (size_t i = 0; i < pp_movements.size(); i++)
+    printf("Point %zu: (%.2f, %.2f, %.2f)\n", i, pp_movements[i].target.x, pp_movements[i].target.y, pp_movements[i].target.theta);
+}
+
+////
+// Point to point and boomerang
+
+void Drive::raw_pid_odom_ptp_set(odom imovement, bool slew_on) {
+  odom_target = imovement.target;
+  odom_start = odom_current;
+  odom_target_start = odom_target;
+  current_drive_direction = imovement.drive_direction;
+  current_angle_behavior = imovement.turn_behavior;
+  pid_speed_max_set(imovement.max_xy_speed);
+
+  // Boomerang settles on a heading, so it gets its own angular constants
+  PID::Constants constants = odom_target.theta != ANGLE_NOT_SET ? boomerangPID.constants_get() : odom_angularPID.constants_get();
+  current_a_odomPID.constants_set(constants.kp, constants.ki, constants.kd, constants.start_i);
+  current_a_odomPID.variables_reset();
+  current_a_odomPID.timers_reset();
+  xyPID.variables_reset();
+  xyPID.timers_reset();
+  find_point_to_face(odom_current, odom_target, current_drive_direction, true);
+
+  // The first heading target takes the turn behavior, later ones follow it from there
+  double a_target = util::absolute_angle_to_point(odom_target, odom_current) + (current_drive_direction == REV ? 180.0 : 0.0);
+  current_a_odomPID.target_set(new_turn_target_compute(a_target, drive_imu_get(), current_angle_behavior));
+
+  // xy runs on distance travelled, which starts at 0 and ends at the distance to the target
+  double distance = util::distance_to_point(odom_target, odom_current);
+  xyPID.target_set(distance);
+  xy_current_fake = 0.0;
+  xy_last_fake = 0.0;
+  xy_delta_fake = 0.0;
+
+  bool backward = current_drive_direction == REV;
+  PID::Constants xy_constants = backward ? backward_drivePID.constants_get() : forward_drivePID.constants_get();
+  xyPID.constants_set(xy_constants.kp, xy_constants.ki, xy_constants.kd, xy_constants.start_i);
+  ez::slew::Constants slew_constants = backward ? slew_backward.constants_get() : slew_forward.constants_get();
+  slew_left.constants_set(slew_constants.distance_to_travel, slew_constants.min_speed);
+  slew_right.constants_set(slew_constants.distance_to_travel, slew_constants.min_speed);
+  slew_left.initialize(slew_on, max_speed, distance, 0.0);
+  slew_right.initialize(slew_on, max_speed, distance, 0.0);
+  current_slew_on = slew_on;
+
+  used_motion_chain_scale = backward ? drive_backward_motion_chain_scale : drive_forward_motion_chain_scale;
+  motion_chain_backward = backward;
+  chain_target_start = distance;
+  chain_sensor_start = 0.0;
+
+  if (print_toggle) printf("Odom Motion Started... Target Coordinates: (%.2f, %.2f, %.2f)\n", imovement.target.x, imovement.target.y, imovement.target.theta);
+  drive_mode_set(POINT_TO_POINT);
+}
+
+void Drive::pid_odom_ptp_set(odom imovement, bool slew_on) {
+  imovement.target.theta = ANGLE_NOT_SET;
+  raw_pid_odom_ptp_set(set_odom_direction(imovement), slew_on);
+}
+
+void Drive::pid_odom_ptp_set(odom imovement) {
+  pid_odom_ptp_set(imovement, imovement.drive_direction == REV ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled);
+}
+
+void Drive::pid_odom_ptp_set(united_odom p_imovement) { pid_odom_ptp_set(util::united_odom_to_odom(p_imovement)); }
+
+void Drive::pid_odom_ptp_set(united_odom p_imovement, bool slew_on) { pid_odom_ptp_set(util::united_odom_to_odom(p_imovement), slew_on); }
+
+void Drive::pid_odom_boomerang_set(odom imovement, bool slew_on) {
+  if (imovement.target.theta == ANGLE_NOT_SET) printf("Boomerang needs a target angle, running point to point instead\n");
+  raw_pid_odom_ptp_set(set_odom_direction(imovement), slew_on);
+}
+
+void Drive::pid_odom_boomerang_set(odom imovement) {
+  pid_odom_boomerang_set(imovement, imovement.drive_direction == REV ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled);
+}
+
+void Drive::pid_odom_boomerang_set(united_odom p_imovement) { pid_odom_boomerang_set(util::united_odom_to_odom(p_imovement)); }
+
+void Drive::pid_odom_boomerang_set(united_odom p_imovement, bool slew_on) { pid_odom_boomerang_set(util::united_odom_to_odom(p_imovement), slew_on); }
+
+void Drive::pid_odom_set(odom imovement, bool slew_on) { raw_pid_odom_ptp_set(set_odom_direction(imovement), slew_on); }
+
+void Drive::pid_odom_set(odom imovement) {
+  pid_odom_set(imovement, imovement.drive_direction == REV ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled);
+}
+
+void Drive::pid_odom_set(united_odom p_imovement) { pid_odom_set(util::united_odom_to_odom(p_imovement)); }
+
+void Drive::pid_odom_set(united_odom p_imovement, bool slew_on) { pid_odom_set(util::united_odom_to_odom(p_imovement), slew_on); }
+
+void Drive::pid_odom_set(double target, int speed, bool slew_on) {
+  // Straight along the current heading, worked out in the internal frame
+  drive_directions dir = target < 0 ? REV : FWD;
+  pose end = util::vector_off_point(target, {odom_current.x, odom_current.y, drive_imu_get()});
+  end.theta = ANGLE_NOT_SET;
+  raw_pid_odom_ptp_set({end, dir, speed, default_odom_type}, slew_on);
+}
+
+void Drive::pid_odom_set(double target, int speed) {
+  pid_odom_set(target, speed, target < 0 ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled);
+}
+
+void Drive::pid_odom_set(okapi::QLength p_target, int speed) { pid_odom_set(p_target.convert(okapi::inch), speed); }
+
+void Drive::pid_odom_set(okapi::QLength p_target, int speed, bool slew_on) { pid_odom_set(p_target.convert(okapi::inch), speed, slew_on); }
+
+////
+// Pure pursuit
+
+void Drive::raw_pid_odom_pp_set(std::vector<odom> imovements, bool slew_on) {
+  // imovements already starts with where the robot is
+  pp_movements = imovements;
+  pp_index = 0;
+  was_last_pp_mode_boomerang = false;
+  odom_second_to_last = pp_movements.size() > 1 ? pp_movements[pp_movements.size() - 2].target : odom_current;
+
+  // The last point drives the exit conditions, the lookahead point steers
+  odom final = pp_movements.back();
+  raw_pid_odom_ptp_set(final, slew_on);
+
+  // Boomerang constants only take over at the end of the path, and the end settles along the last segment
+  PID::Constants constants = odom_angularPID.constants_get();
+  current_a_odomPID.constants_set(constants.kp, constants.ki, constants.kd, constants.start_i);
+  find_point_to_face(odom_second_to_last, final.target, final.drive_direction, true);
+
+  // Travel is measured along the path, not straight to the end
+  double length = 0.0;
+  for (size_t i = 1; i < pp_movements.size(); i++) length += util::distance_to_point(pp_movements[i].target, pp_movements[i - 1].target);
+  xyPID.target_set(length);
+  slew_left.initialize(slew_on, max_speed, length, 0.0);
+  slew_right.initialize(slew_on, max_speed, length, 0.0);
+  chain_target_start = length;
+
+  drive_mode_set(PURE_PURSUIT);
+}
+
+static std::vector<odom> path_from_current(pose current, std::vector<odom> imovements) {
+  std::vector<odom> output;
+  odom start = imovements.front();
+  start.target = {current.x, current.y, ANGLE_NOT_SET};
+  output.push_back(start);
+  output.insert(output.end(), imovements.begin(), imovements.end());
+  return output;
+}
+
+void Drive::pid_odom_pp_set(std::vector<odom> imovements, bool slew_on) {
+  if (imovements.empty()) return;
+  std::vector<odom> path = path_from_current(odom_current, set_odoms_direction(imovements));
+  injected_pp_index.clear();
+  for (size_t i = 1; i < path.size(); i++) injected_pp_index.push_back(i);
+  raw_pid_odom_pp_set(path, slew_on);
+}
+
+void Drive::pid_odom_pp_set(std::vector<odom> imovements) {
+  pid_odom_pp_set(imovements, imovements.front().drive_direction == REV ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled);
+}
+
+void Drive::pid_odom_pp_set(std::vector<united_odom> p_imovements) { pid_odom_pp_set(util::united_odoms_to_odoms(p_imovements)); }
+
+void Drive::pid_odom_pp_set(std::vector<united_odom> p_imovements, bool slew_on) { pid_odom_pp_set(util::united_odoms_to_odoms(p_imovements), slew_on); }
+
+void Drive::pid_odom_injected_pp_set(std::vector<odom> imovements, bool slew_on) {
+  if (imovements.empty()) return;
+  raw_pid_odom_pp_set(inject_points(path_from_current(odom_current, set_odoms_direction(imovements))), slew_on);
+}
+
+void Drive::pid_odom_injected_pp_set(std::vector<odom> imovements) {
+  pid_odom_injected_pp_set(imovements, imovements.front().drive_direction == REV ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled);
+}
+
+void Drive::pid_odom_injected_pp_set(std::vector<united_odom> p_imovements) { pid_odom_injected_pp_set(util::united_odoms_to_odoms(p_imovements)); }
+
+void Drive::pid_odom_injected_pp_set(std::vector<united_odom> p_imovements, bool slew_on) { pid_odom_injected_pp_set(util::united_odoms_to_odoms(p_imovements), slew_on); }
+
+void Drive::pid_odom_smooth_pp_set(std::vector<odom> imovements, bool slew_on) {
+  if (imovements.empty()) return;
+  std::vector<odom> injected = inject_points(path_from_current(odom_current, set_odoms_direction(imovements)));
+  raw_pid_odom_pp_set(smooth_path(injected, odom_smooth_weight_smooth, odom_smooth_weight_data, odom_smooth_tolerance), slew_on);
+}
+
+void Drive::pid_odom_smooth_pp_set(std::vector<odom> imovements) {
+  pid_odom_smooth_pp_set(imovements, imovements.front().drive_direction == REV ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled);
+}
+
+void Drive::pid_odom_smooth_pp_set(std::vector<united_odom> p_imovements) { pid_odom_smooth_pp_set(util::united_odoms_to_odoms(p_imovements)); }
+
+void Drive::pid_odom_smooth_pp_set(std::vector<united_odom> p_imovements, bool slew_on) { pid_odom_smooth_pp_set(util::united_odoms_to_odoms(p_imovements), slew_on); }
+
+void Drive::pid_odom_set(std::vector<odom> imovements, bool slew_on) {
+  // A single point doesn't need a path
+  if (imovements.size() == 1)
+    pid_odom_set(imovements.front(), slew_on);
+  else
+    pid_odom_smooth_pp_set(imovements, slew_on);
+}
+
+void Drive::pid_odom_set(std::vector<odom> imovements) {
+  if (imovements.empty()) return;
+  pid_odom_set(imovements, imovements.front().drive_direction == REV ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled);
+}
+
+void Drive::pid_odom_set(std::vector<united_odom> p_imovements) { pid_odom_set(util::united_odoms_to_odoms(p_imovements)); }
+
+void Drive::pid_odom_set(std::vector<united_odom> p_imovements, bool slew_on) { pid_odom_set(util::united_odoms_to_odoms(p_imovements), slew_on); }
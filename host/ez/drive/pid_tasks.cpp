@@ -0,0 +1,229 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Host build of EZ-Template's autonomous task, one loop of every motion runs in here
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+// Scales both sides down together so neither is over max, keeping the ratio between them
+static void vector_scale(double& left, double& right, double max) {
+  double faster = std::max(fabs(left), fabs(right));
+  if (faster <= max || faster == 0) return;
+  left = left * max / faster;
+  right = right * max / faster;
+}
+
+void Drive::ez_auto_task() {
+  while (true) {
+    if (odometry_enabled) ez_tracking_task();
+
+    switch (drive_mode_get()) {
+      case DRIVE:
+        drive_pid_task();
+        break;
+      case TURN:
+      case TURN_TO_POINT:
+        turn_pid_task();
+        break;
+      case SWING:
+        swing_pid_task();
+        break;
+      case POINT_TO_POINT:
+        if (odom_target.theta != ANGLE_NOT_SET)
+          boomerang_task();
+        else
+          ptp_task();
+        break;
+      case PURE_PURSUIT:
+        pp_task();
+        break;
+      default:
+        break;
+    }
+
+    // Motions stop when the robot gets disabled
+    if (pros::competition::is_disabled() && drive_mode_get() != DISABLE) drive_mode_set(DISABLE);
+    if (pros::competition::is_autonomous()) util::AUTON_RAN = true;
+
+    pros::delay(util::DELAY_TIME);
+  }
+}
+
+void Drive::drive_pid_task() {
+  double left = drive_sensor_left();
+  double right = drive_sensor_right();
+  double imu = drive_imu_get();
+
+  leftPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+  rightPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+  leftPID.compute(left);
+  rightPID.compute(right);
+  headingPID.compute(imu);
+
+  slew_left.iterate(left);
+  slew_right.iterate(right);
+  double l_drive_out = util::clamp(leftPID.output, slew_left.output());
+  double r_drive_out = util::clamp(rightPID.output, slew_right.output());
+
+  // Heading correction stays even when the drive output is at max
+  double gyro_out = heading_on ? headingPID.output : 0.0;
+  double l_out = l_drive_out + gyro_out;
+  double r_out = r_drive_out - gyro_out;
+  vector_scale(l_out, r_out, max_speed);
+
+  if (drive_toggle) private_drive_set(l_out, r_out);
+}
+
+void Drive::turn_pid_task() {
+  double imu = drive_imu_get();
+
+  // Turning to a point follows the point as the robot moves
+  if (drive_mode_get() == TURN_TO_POINT) {
+    double a_target = util::absolute_angle_to_point(turn_to_point_target, odom_current) + (current_drive_direction == REV ? 180.0 : 0.0);
+    double target = turnPID.target_get() + util::wrap_angle(a_target - turnPID.target_get());
+    turnPID.target_set(target);
+    headingPID.target_set(target);
+  }
+
+  turnPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+  turnPID.compute(imu);
+  slew_turn.iterate(imu);
+  double out = util::clamp(turnPID.output, slew_turn.output());
+
+  // Clip the output while i builds so the turn doesn't overshoot
+  if (turnPID.constants.ki != 0 && fabs(turnPID.error) < turnPID.constants.start_i && turn_min != 0)
+    out = util::clamp(out, turn_min);
+
+  if (drive_toggle) private_drive_set(out, -out);
+}
+
+void Drive::swing_pid_task() {
+  double imu = drive_imu_get();
+
+  swingPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+  swingPID.compute(imu);
+  double side = current_swing == LEFT_SWING ? drive_sensor_left() : drive_sensor_right();
+  slew_swing.iterate(slew_swing_using_angle ? imu : side);
+  double out = util::clamp(swingPID.output, slew_swing.output());
+
+  if (swingPID.constants.ki != 0 && fabs(swingPID.error) < swingPID.constants.start_i && swing_min != 0)
+    out = util::clamp(out, swing_min);
+
+  // The other side follows as a fraction of the swinging side
+  double opposite = out * swing_opposite_speed / std::max(max_speed, 1);
+  if (drive_toggle) {
+    if (current_swing == LEFT_SWING)
+      private_drive_set(out, opposite);
+    else
+      private_drive_set(-opposite, -out);
+  }
+}
+
+void Drive::ptp_task() {
+  bool backward = current_drive_direction == REV;
+  double imu = drive_imu_get();
+  double distance = util::distance_to_point(odom_target, odom_current);
+  int last = (int)pp_movements.size() - 1;
+
+  // Aim at the target from far away, and past it once close so the heading settles
+  pose face = distance > LOOK_AHEAD ? odom_target : point_to_face[1];
+  double travel = imu + (backward ? 180.0 : 0.0);
+  double error = distance * cos(util::to_rad(util::absolute_angle_to_point(odom_target, odom_current) - travel));
+
+  // Pure pursuit steers at the lookahead point, and has the rest of the path left to drive
+  if (drive_mode_get() == PURE_PURSUIT && pp_index < last) {
+    face = pp_movements[pp_index].target;
+    error = util::distance_to_point(face, odom_current);
+    for (int i = pp_index + 1; i <= last; i++) error += util::distance_to_point(pp_movements[i].target, pp_movements[i - 1].target);
+  }
+
+  double a_target = util::absolute_angle_to_point(face, odom_current) + (backward ? 180.0 : 0.0);
+  current_a_odomPID.target_set(current_a_odomPID.target_get() + util::wrap_angle(a_target - current_a_odomPID.target_get()));
+  current_a_odomPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+  current_a_odomPID.compute(imu);
+
+  xy_current_fake = xyPID.target_get() - error;
+  xy_delta_fake = xy_current_fake - xy_last_fake;
+  xy_last_fake = xy_current_fake;
+  xyPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+  xyPID.compute_error(error, xy_current_fake);
+
+  slew_left.iterate(xy_current_fake);
+  double a_out = util::clamp(current_a_odomPID.output, max_speed);
+  double xy_out = util::clamp(xyPID.output, slew_left.output());
+
+  // Slow down while turning so the robot doesn't swing wide
+  if (odom_turn_bias_enabled()) xy_out = util::clamp(xy_out, std::max(0.0, max_speed - fabs(a_out) / odom_turn_bias_amount));
+  if (backward) xy_out = -xy_out;
+
+  double l_out = xy_out + a_out;
+  double r_out = xy_out - a_out;
+  vector_scale(l_out, r_out, max_speed);
+
+  if (drive_toggle) private_drive_set(l_out, r_out);
+}
+
+void Drive::boomerang_task() {
+  bool backward = current_drive_direction == REV;
+  double imu = drive_imu_get();
+  double distance = util::distance_to_point(odom_target, odom_current);
+
+  // Chase a carrot behind the target along its heading, so the robot arrives facing it
+  double lead = std::min(distance * dlead, max_boomerang_distance) * (backward ? -1.0 : 1.0);
+  double t = util::to_rad(odom_target.theta);
+  pose carrot = {odom_target.x - lead * sin(t), odom_target.y - lead * cos(t), odom_target.theta};
+
+  double a_target = distance > LOOK_AHEAD ? util::absolute_angle_to_point(carrot, odom_current) + (backward ? 180.0 : 0.0) : odom_target.theta;
+  current_a_odomPID.target_set(current_a_odomPID.target_get() + util::wrap_angle(a_target - current_a_odomPID.target_get()));
+  current_a_odomPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+  current_a_odomPID.compute(imu);
+
+  double travel = imu + (backward ? 180.0 : 0.0);
+  double error = distance * cos(util::to_rad(util::absolute_angle_to_point(odom_target, odom_current) - travel));
+  xy_current_fake = xyPID.target_get() - error;
+  xy_delta_fake = xy_current_fake - xy_last_fake;
+  xy_last_fake = xy_current_fake;
+  xyPID.velocity_sensor_secondary_set(drive_imu_accel_get());
+  xyPID.compute_error(error, xy_current_fake);
+
+  slew_left.iterate(xy_current_fake);
+  double a_out = util::clamp(current_a_odomPID.output, max_speed);
+  double xy_out = util::clamp(xyPID.output, slew_left.output());
+  if (odom_turn_bias_enabled()) xy_out = util::clamp(xy_out, std::max(0.0, max_speed - fabs(a_out) / odom_turn_bias_amount));
+  if (backward) xy_out = -xy_out;
+
+  double l_out = xy_out + a_out;
+  double r_out = xy_out - a_out;
+  vector_scale(l_out, r_out, max_speed);
+
+  if (drive_toggle) private_drive_set(l_out, r_out);
+}
+
+void Drive::pp_task() {
+  int last = (int)pp_movements.size() - 1;
+  if (last < 0) return;
+
+  // The lookahead point only moves forward along the path
+  while (pp_index < last && util::distance_to_point(pp_movements[pp_index].target, odom_current) < LOOK_AHEAD) pp_index++;
+
+  odom look = pp_movements[pp_index];
+  current_drive_direction = look.drive_direction;
+  if (look.max_xy_speed != max_speed) pid_speed_max_set(look.max_xy_speed);
+
+  // The end of the path settles like a normal odom motion, with boomerang if it has an angle
+  if (pp_index == last && odom_target.theta != ANGLE_NOT_SET) {
+    if (!was_last_pp_mode_boomerang) {
+      PID::Constants constants = boomerangPID.constants_get();
+      current_a_odomPID.constants_set(constants.kp, constants.ki, constants.kd, constants.start_i);
+      was_last_pp_mode_boomerang = true;
+    }
+    boomerang_task();
+  } else {
+    ptp_task();
+  }
+}
@@ -0,0 +1,596 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Host build of EZ-Template's Drive constants and the drive, turn and swing motion setters
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+////
+// PID constants
+
+void Drive::pid_drive_constants_set(double p, double i, double d, double p_start_i) {
+  pid_drive_constants_forward_set(p, i, d, p_start_i);
+  pid_drive_constants_backward_set(p, i, d, p_start_i);
+  fwd_rev_drivePID.constants_set(p, i, d, p_start_i);
+}
+
+PID::Constants Drive::pid_drive_constants_get() { return fwd_rev_drivePID.constants_get(); }
+
+void Drive::pid_drive_constants_forward_set(double p, double i, double d, double p_start_i) { forward_drivePID.constants_set(p, i, d, p_start_i); }
+
+PID::Constants Drive::pid_drive_constants_forward_get() { return forward_drivePID.constants_get(); }
+
+void Drive::pid_drive_constants_backward_set(double p, double i, double d, double p_start_i) { backward_drivePID.constants_set(p, i, d, p_start_i); }
+
+PID::Constants Drive::pid_drive_constants_backward_get() { return backward_drivePID.constants_get(); }
+
+void Drive::pid_heading_constants_set(double p, double i, double d, double p_start_i) { headingPID.constants_set(p, i, d, p_start_i); }
+
+PID::Constants Drive::pid_heading_constants_get() { return headingPID.constants_get(); }
+
+void Drive::pid_turn_constants_set(double p, double i, double d, double p_start_i) { turnPID.constants_set(p, i, d, p_start_i); }
+
+PID::Constants Drive::pid_turn_constants_get() { return turnPID.constants_get(); }
+
+void Drive::pid_swing_constants_set(double p, double i, double d, double p_start_i) {
+  pid_swing_constants_forward_set(p, i, d, p_start_i);
+  pid_swing_constants_backward_set(p, i, d, p_start_i);
+  fwd_rev_swingPID.constants_set(p, i, d, p_start_i);
+}
+
+PID::Constants Drive::pid_swing_constants_get() { return fwd_rev_swingPID.constants_get(); }
+
+void Drive::pid_swing_constants_forward_set(double p, double i, double d, double p_start_i) { forward_swingPID.constants_set(p, i, d, p_start_i); }
+
+PID::Constants Drive::pid_swing_constants_forward_get() { return forward_swingPID.constants_get(); }
+
+void Drive::pid_swing_constants_backward_set(double p, double i, double d, double p_start_i) { backward_swingPID.constants_set(p, i, d, p_start_i); }
+
+PID::Constants Drive::pid_swing_constants_backward_get() { return backward_swingPID.constants_get(); }
+
+void Drive::pid_odom_angular_constants_set(double p, double i, double d, double p_start_i) { odom_angularPID.constants_set(p, i, d, p_start_i); }
+
+void Drive::pid_odom_boomerang_constants_set(double p, double i, double d, double p_start_i) { boomerangPID.constants_set(p, i, d, p_start_i); }
+
+void Drive::pid_turn_min_set(int min) { turn_min = abs(min); }
+
+int Drive::pid_turn_min_get() { return turn_min; }
+
+void Drive::pid_swing_min_set(int min) { swing_min = abs(min); }
+
+int Drive::pid_swing_min_get() { return swing_min; }
+
+void Drive::pid_speed_max_set(int speed) {
+  max_speed = abs(util::clamp(speed, 127, -127));
+  slew_left.speed_max_set(max_speed);
+  slew_right.speed_max_set(max_speed);
+  slew_turn.speed_max_set(max_speed);
+  slew_swing.speed_max_set(max_speed);
+  slew_forward.speed_max_set(max_speed);
+  slew_backward.speed_max_set(max_speed);
+}
+
+int Drive::pid_speed_max_get() { return max_speed; }
+
+////
+// Exit conditions
+
+void Drive::pid_drive_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu) {
+  leftPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+  rightPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+  leftPID.velocity_sensor_secondary_toggle_set(use_imu);
+  rightPID.velocity_sensor_secondary_toggle_set(use_imu);
+}
+
+void Drive::pid_turn_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu) {
+  turnPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+  turnPID.velocity_sensor_secondary_toggle_set(use_imu);
+}
+
+void Drive::pid_swing_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu) {
+  swingPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+  swingPID.velocity_sensor_secondary_toggle_set(use_imu);
+}
+
+void Drive::pid_odom_drive_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu) {
+  xyPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+  xyPID.velocity_sensor_secondary_toggle_set(use_imu);
+}
+
+void Drive::pid_odom_turn_exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout, bool use_imu) {
+  current_a_odomPID.exit_condition_set(p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout);
+  current_a_odomPID.velocity_sensor_secondary_toggle_set(use_imu);
+}
+
+void Drive::pid_drive_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QLength p_small_error, okapi::QTime p_big_exit_time, okapi::QLength p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+  pid_drive_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::inch), p_big_exit_time.convert(okapi::millisecond), p_big_error.convert(okapi::inch), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond), use_imu);
+}
+
+void Drive::pid_turn_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error, okapi::QTime p_big_exit_time, okapi::QAngle p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+  pid_turn_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::degree), p_big_exit_time.convert(okapi::millisecond), p_big_error.convert(okapi::degree), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond), use_imu);
+}
+
+void Drive::pid_swing_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error, okapi::QTime p_big_exit_time, okapi::QAngle p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+  pid_swing_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::degree), p_big_exit_time.convert(okapi::millisecond), p_big_error.convert(okapi::degree), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond), use_imu);
+}
+
+void Drive::pid_odom_drive_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QLength p_small_error, okapi::QTime p_big_exit_time, okapi::QLength p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+  pid_odom_drive_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::inch), p_big_exit_time.convert(okapi::millisecond), p_big_error.convert(okapi::inch), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond), use_imu);
+}
+
+void Drive::pid_odom_turn_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error, okapi::QTime p_big_exit_time, okapi::QAngle p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool use_imu) {
+  pid_odom_turn_exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::degree), p_big_exit_time.convert(okapi::millisecond), p_big_error.convert(okapi::degree), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond), use_imu);
+}
+
+////
+// Motion chaining
+
+void Drive::pid_drive_chain_constant_set(double input) {
+  pid_drive_chain_forward_constant_set(input);
+  pid_drive_chain_backward_constant_set(input);
+}
+
+void Drive::pid_drive_chain_forward_constant_set(double input) { drive_forward_motion_chain_scale = fabs(input); }
+
+void Drive::pid_drive_chain_backward_constant_set(double input) { drive_backward_motion_chain_scale = fabs(input); }
+
+double Drive::pid_drive_chain_forward_constant_get() { return drive_forward_motion_chain_scale; }
+
+double Drive::pid_drive_chain_backward_constant_get() { return drive_backward_motion_chain_scale; }
+
+void Drive::pid_drive_chain_constant_set(okapi::QLength input) { pid_drive_chain_constant_set(input.convert(okapi::inch)); }
+
+void Drive::pid_drive_chain_forward_constant_set(okapi::QLength input) { pid_drive_chain_forward_constant_set(input.convert(okapi::inch)); }
+
+void Drive::pid_drive_chain_backward_constant_set(okapi::QLength input) { pid_drive_chain_backward_constant_set(input.convert(okapi::inch)); }
+
+void Drive::pid_turn_chain_constant_set(double input) { turn_motion_chain_scale = fabs(input); }
+
+void Drive::pid_turn_chain_constant_set(okapi::QAngle input) { pid_turn_chain_constant_set(input.convert(okapi::degree)); }
+
+double Drive::pid_turn_chain_constant_get() { return turn_motion_chain_scale; }
+
+void Drive::pid_swing_chain_constant_set(double input) {
+  pid_swing_chain_forward_constant_set(input);
+  pid_swing_chain_backward_constant_set(input);
+}
+
+void Drive::pid_swing_chain_forward_constant_set(double input) { swing_forward_motion_chain_scale = fabs(input); }
+
+void Drive::pid_swing_chain_backward_constant_set(double input) { swing_backward_motion_chain_scale = fabs(input); }
+
+double Drive::pid_swing_chain_forward_constant_get() { return swing_forward_motion_chain_scale; }
+
+double Drive::pid_swing_chain_backward_constant_get() { return swing_backward_motion_chain_scale; }
+
+void Drive::pid_swing_chain_constant_set(okapi::QAngle input) { pid_swing_chain_constant_set(input.convert(okapi::degree)); }
+
+void Drive::pid_swing_chain_forward_constant_set(okapi::QAngle input) { pid_swing_chain_forward_constant_set(input.convert(okapi::degree)); }
+
+void Drive::pid_swing_chain_backward_constant_set(okapi::QAngle input) { pid_swing_chain_backward_constant_set(input.convert(okapi::degree)); }
+
+////
+// Slew
+
+void Drive::slew_drive_constants_forward_set(okapi::QLength distance, int min_speed) { slew_forward.constants_set(distance.convert(okapi::inch), min_speed); }
+
+void Drive::slew_drive_constants_backward_set(okapi::QLength distance, int min_speed) { slew_backward.constants_set(distance.convert(okapi::inch), min_speed); }
+
+void Drive::slew_drive_constants_set(okapi::QLength distance, int min_speed) {
+  slew_drive_constants_forward_set(distance, min_speed);
+  slew_drive_constants_backward_set(distance, min_speed);
+}
+
+void Drive::slew_turn_constants_set(okapi::QAngle distance, int min_speed) { slew_turn.constants_set(distance.convert(okapi::degree), min_speed); }
+
+void Drive::slew_swing_constants_forward_set(okapi::QLength distance, int min_speed) {
+  slew_swing_forward.constants_set(distance.convert(okapi::inch), min_speed);
+  slew_swing_fwd_using_angle = false;
+}
+
+void Drive::slew_swing_constants_backward_set(okapi::QLength distance, int min_speed) {
+  slew_swing_backward.constants_set(distance.convert(okapi::inch), min_speed);
+  slew_swing_rev_using_angle = false;
+}
+
+void Drive::slew_swing_constants_set(okapi::QLength distance, int min_speed) {
+  slew_swing_constants_forward_set(distance, min_speed);
+  slew_swing_constants_backward_set(distance, min_speed);
+}
+
+void Drive::slew_swing_constants_forward_set(okapi::QAngle distance, int min_speed) {
+  slew_swing_forward.constants_set(distance.convert(okapi::degree), min_speed);
+  slew_swing_fwd_using_angle = true;
+}
+
+void Drive::slew_swing_constants_backward_set(okapi::QAngle distance, int min_speed) {
+  slew_swing_backward.constants_set(distance.convert(okapi::degree), min_speed);
+  slew_swing_rev_using_angle = true;
+}
+
+void Drive::slew_swing_constants_set(okapi::QAngle distance, int min_speed) {
+  slew_swing_constants_forward_set(distance, min_speed);
+  slew_swing_constants_backward_set(distance, min_speed);
+}
+
+void Drive::slew_drive_set(bool slew_on) {
+  slew_drive_forward_set(slew_on);
+  slew_drive_backward_set(slew_on);
+}
+
+void Drive::slew_drive_forward_set(bool slew_on) { global_forward_drive_slew_enabled = slew_on; }
+
+bool Drive::slew_drive_forward_get() { return global_forward_drive_slew_enabled; }
+
+void Drive::slew_drive_backward_set(bool slew_on) { global_backward_drive_slew_enabled = slew_on; }
+
+bool Drive::slew_drive_backward_get() { return global_backward_drive_slew_enabled; }
+
+void Drive::slew_swing_set(bool slew_on) {
+  slew_swing_forward_set(slew_on);
+  slew_swing_backward_set(slew_on);
+}
+
+void Drive::slew_swing_forward_set(bool slew_on) { global_forward_swing_slew_enabled = slew_on; }
+
+bool Drive::slew_swing_forward_get() { return global_forward_swing_slew_enabled; }
+
+void Drive::slew_swing_backward_set(bool slew_on) { global_backward_swing_slew_enabled = slew_on; }
+
+bool Drive::slew_swing_backward_get() { return global_backward_swing_slew_enabled; }
+
+void Drive::slew_turn_set(bool slew_on) { global_turn_slew_enabled = slew_on; }
+
+bool Drive::slew_turn_get() { return global_turn_slew_enabled; }
+
+void Drive::slew_odom_reenable(bool reenable) { slew_reenables_when_max_speed_changes = reenable; }
+
+bool Drive::slew_odom_reenabled() { return slew_reenables_when_max_speed_changes; }
+
+////
+// Angle behavior
+
+void Drive::pid_angle_behavior_set(e_angle_behavior behavior) {
+  pid_turn_behavior_set(behavior);
+  pid_swing_behavior_set(behavior);
+  pid_odom_behavior_set(behavior);
+}
+
+void Drive::pid_turn_behavior_set(e_angle_behavior behavior) { default_turn_type = behavior; }
+
+void Drive::pid_swing_behavior_set(e_angle_behavior behavior) { default_swing_type = behavior; }
+
+void Drive::pid_odom_behavior_set(e_angle_behavior behavior) { default_odom_type = behavior; }
+
+e_angle_behavior Drive::pid_turn_behavior_get() { return default_turn_type; }
+
+e_angle_behavior Drive::pid_swing_behavior_get() { return default_swing_type; }
+
+e_angle_behavior Drive::pid_odom_behavior_get() { return default_odom_type; }
+
+void Drive::pid_angle_behavior_tolerance_set(double tolerance) { turn_tolerance = fabs(tolerance); }
+
+void Drive::pid_angle_behavior_tolerance_set(okapi::QAngle p_tolerance) { pid_angle_behavior_tolerance_set(p_tolerance.convert(okapi::degree)); }
+
+double Drive::pid_angle_behavior_tolerance_get() { return turn_tolerance; }
+
+void Drive::pid_angle_behavior_bias_set(e_angle_behavior behavior) { turn_biased_left = behavior == left_turn; }
+
+e_angle_behavior Drive::pid_angle_behavior_bias_get() { return turn_biased_left ? left_turn : right_turn; }
+
+////
+// Turn target behavior
+
+double Drive::flip_angle_target(double target) { return theta_flipped ? -target : target; }
+
+double Drive::turn_short(double target, double current, bool print) { return util::turn_shortest(target, current, print); }
+
+double Drive::turn_long(double target, double current, bool print) { return util::turn_longest(target, current, print); }
+
+double Drive::turn_left(double target, double current, bool print) {
+  double error = util::wrap_angle(target - current);
+  // Don't spin a full circle to fix a tiny overshoot
+  if (error > 0 && error > turn_tolerance) error -= 360.0;
+  if (print) printf("Left turn: target %.2f from %.2f becomes %.2f\n", target, current, current + error);
+  return current + error;
+}
+
+double Drive::turn_right(double target, double current, bool print) {
+  double error = util::wrap_angle(target - current);
+  if (error < 0 && error < -turn_tolerance) error += 360.0;
+  if (print) printf("Right turn: target %.2f from %.2f becomes %.2f\n", target, current, current + error);
+  return current + error;
+}
+
+double Drive::turn_is_toleranced(double /*target*/, double current, double input, double longest, double shortest) {
+  // Close to a half turn both ways are about as long, so go the biased way
+  if (fabs(fabs(shortest - current) - 180.0) < turn_tolerance) {
+    bool shortest_goes_left = shortest < current;
+    return shortest_goes_left == turn_biased_left ? shortest : longest;
+  }
+  return input;
+}
+
+double Drive::new_turn_target_compute(double target, double current, ez::e_angle_behavior behavior) {
+  current_angle_behavior = behavior;
+  double short_target = turn_short(target, current);
+  double long_target = turn_long(target, current);
+  switch (behavior) {
+    case shortest:
+      return turn_is_toleranced(target, current, short_target, long_target, short_target);
+    case longest:
+      return turn_is_toleranced(target, current, long_target, long_target, short_target);
+    case left_turn:
+      return turn_left(target, current);
+    case right_turn:
+      return turn_right(target, current);
+    default:
+      return target;
+  }
+}
+
+bool Drive::is_swing_slew_enabled(e_swing type, double target, double current) {
+  // A left swing going clockwise, or a right swing going counterclockwise, drives forward
+  bool backward = type == LEFT_SWING ? target < current : target > current;
+  return backward ? global_backward_swing_slew_enabled : global_forward_swing_slew_enabled;
+}
+
+////
+// Drive motions
+
+void Drive::pid_targets_reset() {
+  headingPID.target_set(0);
+  leftPID.target_set(0);
+  rightPID.target_set(0);
+  forward_drivePID.target_set(0);
+  backward_drivePID.target_set(0);
+  turnPID.target_set(0);
+  swingPID.target_set(0);
+  xyPID.target_set(0);
+  current_a_odomPID.target_set(0);
+  odom_target = {0.0, 0.0, 0.0};
+  pp_movements.clear();
+  injected_pp_index.clear();
+  pp_index = 0;
+}
+
+void Drive::pid_drive_set(double target, int speed, bool slew_on, bool toggle_heading) {
+  heading_on = toggle_heading;
+  bool backward = target < 0;
+
+  // Forward and backward can be tuned apart
+  PID::Constants constants = backward ? backward_drivePID.constants_get() : forward_drivePID.constants_get();
+  leftPID.constants_set(constants.kp, constants.ki, constants.kd, constants.start_i);
+  rightPID.constants_set(constants.kp, constants.ki, constants.kd, constants.start_i);
+  used_motion_chain_scale = backward ? drive_backward_motion_chain_scale : drive_forward_motion_chain_scale;
+  motion_chain_backward = backward;
+
+  l_start = drive_sensor_left();
+  r_start = drive_sensor_right();
+  leftPID.variables_reset();
+  rightPID.variables_reset();
+  leftPID.timers_reset();
+  rightPID.timers_reset();
+  double l_target = l_start + target;
+  double r_target = r_start + target;
+  leftPID.target_set(l_target);
+  rightPID.target_set(r_target);
+
+  pid_speed_max_set(speed);
+  ez::slew::Constants slew_constants = backward ? slew_backward.constants_get() : slew_forward.constants_get();
+  slew_left.constants_set(slew_constants.distance_to_travel, slew_constants.min_speed);
+  slew_right.constants_set(slew_constants.distance_to_travel, slew_constants.min_speed);
+  slew_left.initialize(slew_on, max_speed, l_target, l_start);
+  slew_right.initialize(slew_on, max_speed, r_target, r_start);
+
+  chain_target_start = target;
+  chain_sensor_start = 0.0;
+
+  if (print_toggle) printf("Drive Started... Target Value: %.2f\n", target);
+  drive_mode_set(DRIVE);
+}
+
+void Drive::pid_drive_set(double target, int speed) {
+  pid_drive_set(target, speed, target < 0 ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled);
+}
+
+void Drive::pid_drive_set(okapi::QLength p_target, int speed, bool slew_on, bool toggle_heading) {
+  pid_drive_set(p_target.convert(okapi::inch), speed, slew_on, toggle_heading);
+}
+
+void Drive::pid_drive_set(okapi::QLength p_target, int speed) { pid_drive_set(p_target.convert(okapi::inch), speed); }
+
+////
+// Turn motions
+
+void Drive::pid_turn_set(double target, int speed, e_angle_behavior behavior, bool slew_on) {
+  double current = drive_imu_get();
+  double new_target = new_turn_target_compute(flip_angle_target(target), current, behavior);
+
+  turnPID.variables_reset();
+  turnPID.timers_reset();
+  turnPID.target_set(new_target);
+  headingPID.target_set(new_target);
+  pid_speed_max_set(speed);
+  slew_turn.initialize(slew_on, max_speed, new_target, current);
+
+  used_motion_chain_scale = turn_motion_chain_scale;
+  motion_chain_backward = new_target < current;
+  chain_target_start = new_target;
+  chain_sensor_start = current;
+
+  if (print_toggle) printf("Turn Started... Target Value: %.2f\n", new_target);
+  drive_mode_set(TURN);
+}
+
+void Drive::pid_turn_set(double target, int speed) { pid_turn_set(target, speed, default_turn_type, global_turn_slew_enabled); }
+
+void Drive::pid_turn_set(double target, int speed, e_angle_behavior behavior) { pid_turn_set(target, speed, behavior, global_turn_slew_enabled); }
+
+void Drive::pid_turn_set(double target, int speed, bool slew_on) { pid_turn_set(target, speed, default_turn_type, slew_on); }
+
+void Drive::pid_turn_set(okapi::QAngle p_target, int speed) { pid_turn_set(p_target.convert(okapi::degree), speed); }
+
+void Drive::pid_turn_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior) { pid_turn_set(p_target.convert(okapi::degree), speed, behavior); }
+
+void Drive::pid_turn_set(okapi::QAngle p_target, int speed, bool slew_on) { pid_turn_set(p_target.convert(okapi::degree), speed, slew_on); }
+
+void Drive::pid_turn_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) { pid_turn_set(p_target.convert(okapi::degree), speed, behavior, slew_on); }
+
+void Drive::pid_turn_relative_set(double target, int speed, e_angle_behavior behavior, bool slew_on) {
+  // Relative to where the last motion wanted to be, not where the robot drifted to
+  pid_turn_set(flip_angle_target(headingPID.target_get()) + target, speed, behavior, slew_on);
+}
+
+void Drive::pid_turn_relative_set(double target, int speed) { pid_turn_relative_set(target, speed, raw, global_turn_slew_enabled); }
+
+void Drive::pid_turn_relative_set(double target, int speed, e_angle_behavior behavior) { pid_turn_relative_set(target, speed, behavior, global_turn_slew_enabled); }
+
+void Drive::pid_turn_relative_set(double target, int speed, bool slew_on) { pid_turn_relative_set(target, speed, raw, slew_on); }
+
+void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed) { pid_turn_relative_set(p_target.convert(okapi::degree), speed); }
+
+void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior) { pid_turn_relative_set(p_target.convert(okapi::degree), speed, behavior); }
+
+void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, bool slew_on) { pid_turn_relative_set(p_target.convert(okapi::degree), speed, slew_on); }
+
+void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) { pid_turn_relative_set(p_target.convert(okapi::degree), speed, behavior, slew_on); }
+
+void Drive::pid_turn_set(pose itarget, drive_directions dir, int speed, e_angle_behavior behavior, bool slew_on) {
+  turn_to_point_target = flip_pose(itarget);
+  current_drive_direction = dir;
+
+  // Targets are worked out in the unflipped frame, so undo the flip pid_turn_set applies
+  double target = util::absolute_angle_to_point(turn_to_point_target, odom_current) + (dir == REV ? 180.0 : 0.0);
+  pid_turn_set(flip_angle_target(target), speed, behavior, slew_on);
+  drive_mode_set(TURN_TO_POINT);
+}
+
+void Drive::pid_turn_set(pose itarget, drive_directions dir, int speed) { pid_turn_set(itarget, dir, speed, default_turn_type, global_turn_slew_enabled); }
+
+void Drive::pid_turn_set(pose itarget, drive_directions dir, int speed, bool slew_on) { pid_turn_set(itarget, dir, speed, default_turn_type, slew_on); }
+
+void Drive::pid_turn_set(pose itarget, drive_directions dir, int speed, e_angle_behavior behavior) { pid_turn_set(itarget, dir, speed, behavior, global_turn_slew_enabled); }
+
+void Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed) { pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed); }
+
+void Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, bool slew_on) { pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed, slew_on); }
+
+void Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, e_angle_behavior behavior) { pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed, behavior); }
+
+void Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, e_angle_behavior behavior, bool slew_on) { pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed, behavior, slew_on); }
+
+////
+// Swing motions
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
+  // Mirroring the field swaps which side swings
+  if (theta_flipped) type = type == LEFT_SWING ? RIGHT_SWING : LEFT_SWING;
+  current_swing = type;
+  swing_opposite_speed = opposite_speed;
+
+  double current = drive_imu_get();
+  double new_target = new_turn_target_compute(flip_angle_target(target), current, behavior);
+  bool backward = type == LEFT_SWING ? new_target < current : new_target > current;
+
+  PID::Constants constants = backward ? backward_swingPID.constants_get() : forward_swingPID.constants_get();
+  swingPID.constants_set(constants.kp, constants.ki, constants.kd, constants.start_i);
+  swingPID.variables_reset();
+  swingPID.timers_reset();
+  swingPID.target_set(new_target);
+  headingPID.target_set(new_target);
+  pid_speed_max_set(speed);
+
+  // Swing slew runs on the imu or on the swinging side, whichever its constants were given in
+  ez::slew::Constants slew_constants = backward ? slew_swing_backward.constants_get() : slew_swing_forward.constants_get();
+  slew_swing_using_angle = backward ? slew_swing_rev_using_angle : slew_swing_fwd_using_angle;
+  slew_swing.constants_set(slew_constants.distance_to_travel, slew_constants.min_speed);
+  if (slew_swing_using_angle) {
+    slew_swing.initialize(slew_on, max_speed, new_target, current);
+  } else {
+    double side = type == LEFT_SWING ? drive_sensor_left() : drive_sensor_right();
+    slew_swing.initialize(slew_on, max_speed, side + (backward ? -1.0 : 1.0), side);
+  }
+
+  used_motion_chain_scale = backward ? swing_backward_motion_chain_scale : swing_forward_motion_chain_scale;
+  motion_chain_backward = new_target < current;
+  chain_target_start = new_target;
+  chain_sensor_start = current;
+
+  if (print_toggle) printf("Swing Started... Target Value: %.2f\n", new_target);
+  drive_mode_set(SWING);
+}
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior) {
+  pid_swing_set(type, target, speed, opposite_speed, behavior, is_swing_slew_enabled(type, target, drive_imu_get()));
+}
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on) { pid_swing_set(type, target, speed, opposite_speed, default_swing_type, slew_on); }
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed) { pid_swing_set(type, target, speed, opposite_speed, default_swing_type); }
+
+void Drive::pid_swing_set(e_swing type, double target, int speed) { pid_swing_set(type, target, speed, 0); }
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, e_angle_behavior behavior) { pid_swing_set(type, target, speed, 0, behavior); }
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, bool slew_on) { pid_swing_set(type, target, speed, 0, slew_on); }
+
+void Drive::pid_swing_set(e_swing type, double target, int speed, e_angle_behavior behavior, bool slew_on) { pid_swing_set(type, target, speed, 0, behavior, slew_on); }
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed) { pid_swing_set(type, p_target.convert(okapi::degree), speed); }
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior) { pid_swing_set(type, p_target.convert(okapi::degree), speed, behavior); }
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, bool slew_on) { pid_swing_set(type, p_target.convert(okapi::degree), speed, slew_on); }
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) { pid_swing_set(type, p_target.convert(okapi::degree), speed, behavior, slew_on); }
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed) { pid_swing_set(type, p_target.convert(okapi::degree), speed, opposite_speed); }
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior) { pid_swing_set(type, p_target.convert(okapi::degree), speed, opposite_speed, behavior); }
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on) { pid_swing_set(type, p_target.convert(okapi::degree), speed, opposite_speed, slew_on); }
+
+void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) { pid_swing_set(type, p_target.convert(okapi::degree), speed, opposite_speed, behavior, slew_on); }
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
+  pid_swing_set(type, flip_angle_target(headingPID.target_get()) + target, speed, opposite_speed, behavior, slew_on);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior) {
+  double absolute = flip_angle_target(headingPID.target_get()) + target;
+  pid_swing_set(type, absolute, speed, opposite_speed, behavior);
+}
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on) { pid_swing_relative_set(type, target, speed, opposite_speed, raw, slew_on); }
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed) { pid_swing_relative_set(type, target, speed, opposite_speed, raw); }
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed) { pid_swing_relative_set(type, target, speed, 0); }
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, e_angle_behavior behavior) { pid_swing_relative_set(type, target, speed, 0, behavior); }
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, bool slew_on) { pid_swing_relative_set(type, target, speed, 0, slew_on); }
+
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed, e_angle_behavior behavior, bool slew_on) { pid_swing_relative_set(type, target, speed, 0, behavior, slew_on); }
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed) { pid_swing_relative_set(type, p_target.convert(okapi::degree), speed); }
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior) { pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, behavior); }
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, bool slew_on) { pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, slew_on); }
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) { pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, behavior, slew_on); }
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed) { pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, opposite_speed); }
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior) { pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, opposite_speed, behavior); }
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on) { pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, opposite_speed, slew_on); }
+
+void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) { pid_swing_relative_set(type, p_target.convert(okapi::degree), speed, opposite_speed, behavior, slew_on); }
@@ -0,0 +1,225 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Host build of EZ-Template's odometry, position tracking and its settings
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+////
+// Settings
+
+void Drive::odom_enable(bool input) { odometry_enabled = input; }
+
+bool Drive::odom_enabled() { return odometry_enabled; }
+
+void Drive::odom_x_flip(bool flip) { x_flipped = flip; }
+
+bool Drive::odom_x_direction_get() { return x_flipped; }
+
+void Drive::odom_y_flip(bool flip) { y_flipped = flip; }
+
+bool Drive::odom_y_direction_get() { return y_flipped; }
+
+void Drive::odom_theta_flip(bool flip) { theta_flipped = flip; }
+
+bool Drive::odom_theta_direction_get() { return theta_flipped; }
+
+void Drive::odom_boomerang_dlead_set(double input) { dlead = fabs(input); }
+
+double Drive::odom_boomerang_dlead_get() { return dlead; }
+
+void Drive::odom_boomerang_distance_set(double distance) { max_boomerang_distance = fabs(distance); }
+
+void Drive::odom_boomerang_distance_set(okapi::QLength p_distance) { odom_boomerang_distance_set(p_distance.convert(okapi::inch)); }
+
+double Drive::odom_boomerang_distance_get() { return max_boomerang_distance; }
+
+void Drive::odom_turn_bias_set(double bias) {
+  odom_turn_bias_amount = fabs(bias);
+  odom_turn_bias_enable(odom_turn_bias_amount != 0);
+}
+
+double Drive::odom_turn_bias_get() { return odom_turn_bias_amount; }
+
+void Drive::odom_path_spacing_set(double spacing) { SPACING = fabs(spacing); }
+
+void Drive::odom_path_spacing_set(okapi::QLength p_spacing) { odom_path_spacing_set(p_spacing.convert(okapi::inch)); }
+
+double Drive::odom_path_spacing_get() { return SPACING; }
+
+void Drive::odom_path_smooth_constants_set(double weight_smooth, double weight_data, double tolerance) {
+  odom_smooth_weight_smooth = weight_smooth;
+  odom_smooth_weight_data = weight_data;
+  odom_smooth_tolerance = tolerance;
+}
+
+std::vector<double> Drive::odom_path_smooth_constants_get() { return {odom_smooth_weight_smooth, odom_smooth_weight_data, odom_smooth_tolerance}; }
+
+void Drive::odom_look_ahead_set(double distance) { LOOK_AHEAD = fabs(distance); }
+
+void Drive::odom_look_ahead_set(okapi::QLength p_distance) { odom_look_ahead_set(p_distance.convert(okapi::inch)); }
+
+double Drive::odom_look_ahead_get() { return LOOK_AHEAD; }
+
+////
+// Tracking wheels
+
+// Left and back trackers sit on the negative side of the center
+void Drive::odom_tracker_left_set(tracking_wheel* input) {
+  if (input == nullptr) return;
+  odom_tracker_left = input;
+  odom_tracker_left->distance_to_center_flip_set(true);
+  odom_tracker_left_enabled = true;
+  odom_use_left = true;
+  l_last = odom_tracker_left->get();
+}
+
+void Drive::odom_tracker_right_set(tracking_wheel* input) {
+  if (input == nullptr) return;
+  odom_tracker_right = input;
+  odom_tracker_right->distance_to_center_flip_set(false);
+  odom_tracker_right_enabled = true;
+  if (!odom_tracker_left_enabled) {
+    odom_use_left = false;
+    l_last = odom_tracker_right->get();
+  }
+}
+
+void Drive::odom_tracker_front_set(tracking_wheel* input) {
+  if (input == nullptr) return;
+  odom_tracker_front = input;
+  odom_tracker_front->distance_to_center_flip_set(false);
+  odom_tracker_front_enabled = true;
+  h_last = odom_tracker_front->get();
+}
+
+void Drive::odom_tracker_back_set(tracking_wheel* input) {
+  if (input == nullptr) return;
+  odom_tracker_back = input;
+  odom_tracker_back->distance_to_center_flip_set(true);
+  odom_tracker_back_enabled = true;
+  if (!odom_tracker_front_enabled) h_last = odom_tracker_back->get();
+}
+
+////
+// Pose
+
+void Drive::odom_x_set(double x) {
+  odom_current.x = x_flipped ? -x : x;
+  was_odom_just_set = true;
+}
+
+void Drive::odom_x_set(okapi::QLength p_x) { odom_x_set(p_x.convert(okapi::inch)); }
+
+double Drive::odom_x_get() { return x_flipped ? -odom_current.x : odom_current.x; }
+
+void Drive::odom_y_set(double y) {
+  odom_current.y = y_flipped ? -y : y;
+  was_odom_just_set = true;
+}
+
+void Drive::odom_y_set(okapi::QLength p_y) { odom_y_set(p_y.convert(okapi::inch)); }
+
+double Drive::odom_y_get() { return y_flipped ? -odom_current.y : odom_current.y; }
+
+void Drive::odom_theta_set(double a) {
+  // The imu is the heading, so setting theta sets the imu
+  double angle = flip_angle_target(a);
+  drive_angle_set(angle);
+  odom_current.theta = angle;
+  odom_imu_start = angle;
+  was_odom_just_set = true;
+}
+
+void Drive::odom_theta_set(okapi::QAngle p_a) { odom_theta_set(p_a.convert(okapi::degree)); }
+
+double Drive::odom_theta_get() { return flip_angle_target(odom_current.theta); }
+
+void Drive::odom_xy_set(double x, double y) {
+  odom_x_set(x);
+  odom_y_set(y);
+}
+
+void Drive::odom_xy_set(okapi::QLength p_x, okapi::QLength p_y) { odom_xy_set(p_x.convert(okapi::inch), p_y.convert(okapi::inch)); }
+
+void Drive::odom_xyt_set(double x, double y, double t) {
+  odom_xy_set(x, y);
+  odom_theta_set(t);
+}
+
+void Drive::odom_xyt_set(okapi::QLength p_x, okapi::QLength p_y, okapi::QAngle p_t) {
+  odom_xyt_set(p_x.convert(okapi::inch), p_y.convert(okapi::inch), p_t.convert(okapi::degree));
+}
+
+void Drive::odom_pose_set(pose itarget) {
+  odom_xy_set(itarget.x, itarget.y);
+  if (itarget.theta != ANGLE_NOT_SET) odom_theta_set(itarget.theta);
+}
+
+void Drive::odom_pose_set(united_pose itarget) { odom_pose_set(util::united_pose_to_pose(itarget)); }
+
+pose Drive::odom_pose_get() { return flip_pose(odom_current); }
+
+void Drive::odom_reset() { odom_xyt_set(0.0, 0.0, 0.0); }
+
+////
+// Tracking
+
+std::pair<float, float> Drive::decide_vert_sensor(ez::tracking_wheel* tracker, bool is_tracker_enabled, float ime, float ime_track) {
+  if (is_tracker_enabled) return {tracker->get(), tracker->distance_to_center_get()};
+  return {ime, ime_track};
+}
+
+pose Drive::solve_xy_vert(float p_track_width, float current_t, float delta_vert, float delta_t) {
+  // A wheel off center also rolls when the robot turns in place, take that out
+  float forward = delta_vert + delta_t * p_track_width;
+  float chord = delta_t != 0 ? 2.0 * sin(delta_t / 2.0) / delta_t : 1.0;
+  return {0.0, forward * chord, current_t};
+}
+
+pose Drive::solve_xy_horiz(float p_track_width, float current_t, float delta_horiz, float delta_t) {
+  float lateral = delta_horiz - delta_t * p_track_width;
+  float chord = delta_t != 0 ? 2.0 * sin(delta_t / 2.0) / delta_t : 1.0;
+  return {lateral * chord, 0.0, current_t};
+}
+
+void Drive::ez_tracking_task() {
+  double t = util::to_rad(drive_imu_get());
+  if (!std::isfinite(t)) return;  // The imu reads an error while it calibrates
+
+  // Without a vertical tracker, the average of both sides has no offset from the center
+  double ime = (drive_sensor_left_raw() + drive_sensor_right_raw()) / 2.0 / drive_tick_per_inch();
+  tracking_wheel* vert = odom_use_left ? odom_tracker_left : odom_tracker_right;
+  bool vert_enabled = odom_use_left ? odom_tracker_left_enabled : odom_tracker_right_enabled;
+  std::pair<float, float> v = decide_vert_sensor(vert, vert_enabled, ime, 0.0);
+
+  tracking_wheel* horiz = odom_tracker_front_enabled ? odom_tracker_front : odom_tracker_back;
+  bool horiz_enabled = odom_tracker_front_enabled || odom_tracker_back_enabled;
+  double h = horiz_enabled ? horiz->get() : 0.0;
+  double h_offset = horiz_enabled ? horiz->distance_to_center_get() : 0.0;
+
+  double delta_t = t - t_last;
+  double delta_vert = v.first - l_last;
+  double delta_horiz = h - h_last;
+  l_last = v.first;
+  h_last = h;
+  t_last = t;
+
+  pose vert_pose = solve_xy_vert(v.second, t, delta_vert, delta_t);
+  pose horiz_pose = solve_xy_horiz(h_offset, t, delta_horiz, delta_t);
+
+  // Rotate the robot relative motion onto the field at the middle of the arc
+  double mid = t - delta_t / 2.0;
+  double forward = vert_pose.y;
+  double lateral = horiz_pose.x;
+  odom_current.x += lateral * cos(mid) + forward * sin(mid);
+  odom_current.y += forward * cos(mid) - lateral * sin(mid);
+  odom_current.theta = util::to_deg(t);
+  angle_rad = t;
+  was_odom_just_set = false;
+}
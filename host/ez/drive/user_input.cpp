@@ -0,0 +1,400 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Host build of EZ-Template's driver control and PID tuner
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+////
+// Curves
+
+void Drive::opcontrol_curve_buttons_toggle(bool toggle) { disable_controller = toggle; }
+
+bool Drive::opcontrol_curve_buttons_toggle_get() { return disable_controller; }
+
+void Drive::opcontrol_curve_default_set(double left, double right) {
+  left_curve_scale = left;
+  right_curve_scale = right;
+}
+
+std::vector<double> Drive::opcontrol_curve_default_get() { return {left_curve_scale, right_curve_scale}; }
+
+void Drive::save_l_curve_sd() {
+  if (!util::SD_CARD_ACTIVE) return;
+  FILE* usd_file_write = fopen("/usd/left_curve.txt", "w");
+  if (usd_file_write == nullptr) return;
+  fprintf(usd_file_write, "%.2f", left_curve_scale);
+  fclose(usd_file_write);
+}
+
+void Drive::save_r_curve_sd() {
+  if (!util::SD_CARD_ACTIVE) return;
+  FILE* usd_file_write = fopen("/usd/right_curve.txt", "w");
+  if (usd_file_write == nullptr) return;
+  fprintf(usd_file_write, "%.2f", right_curve_scale);
+  fclose(usd_file_write);
+}
+
+void Drive::opcontrol_curve_sd_initialize() {
+  if (!util::SD_CARD_ACTIVE) return;
+  FILE* l_usd_file_read = fopen("/usd/left_curve.txt", "r");
+  if (l_usd_file_read != nullptr) {
+    if (fscanf(l_usd_file_read, "%lf", &left_curve_scale) != 1) save_l_curve_sd();
+    fclose(l_usd_file_read);
+  } else {
+    save_l_curve_sd();
+  }
+  FILE* r_usd_file_read = fopen("/usd/right_curve.txt", "r");
+  if (r_usd_file_read != nullptr) {
+    if (fscanf(r_usd_file_read, "%lf", &right_curve_scale) != 1) save_r_curve_sd();
+    fclose(r_usd_file_read);
+  } else {
+    save_r_curve_sd();
+  }
+}
+
+void Drive::opcontrol_curve_buttons_left_set(pros::controller_digital_e_t decrease, pros::controller_digital_e_t increase) {
+  l_increase_.button = increase;
+  l_decrease_.button = decrease;
+}
+
+std::vector<pros::controller_digital_e_t> Drive::opcontrol_curve_buttons_left_get() { return {l_decrease_.button, l_increase_.button}; }
+
+void Drive::opcontrol_curve_buttons_right_set(pros::controller_digital_e_t decrease, pros::controller_digital_e_t increase) {
+  r_increase_.button = increase;
+  r_decrease_.button = decrease;
+}
+
+std::vector<pros::controller_digital_e_t> Drive::opcontrol_curve_buttons_right_get() { return {r_decrease_.button, r_increase_.button}; }
+
+void Drive::l_increase() { left_curve_scale += 0.1; }
+
+void Drive::l_decrease() { left_curve_scale = std::max(left_curve_scale - 0.1, 0.0); }
+
+void Drive::r_increase() { right_curve_scale += 0.1; }
+
+void Drive::r_decrease() { right_curve_scale = std::max(right_curve_scale - 0.1, 0.0); }
+
+void Drive::button_press(button_* input_name, int button, std::function<void()> change_curve, std::function<void()> save) {
+  // Tap to change once, hold to keep changing
+  if (button && !input_name->lock) {
+    change_curve();
+    input_name->lock = true;
+    input_name->release_reset = true;
+  } else if (button && input_name->lock) {
+    input_name->hold_timer += util::DELAY_TIME;
+    if (input_name->hold_timer > 500) {
+      input_name->increase_timer += util::DELAY_TIME;
+      if (input_name->increase_timer > 100) {
+        change_curve();
+        input_name->increase_timer = 0;
+      }
+    }
+  } else if (!button) {
+    input_name->lock = false;
+    input_name->hold_timer = 0;
+    input_name->increase_timer = 0;
+    if (input_name->release_reset) {
+      input_name->release_timer += util::DELAY_TIME;
+      if (input_name->release_timer > 250) {
+        save();
+        input_name->release_timer = 0;
+        input_name->release_reset = false;
+      }
+    }
+  }
+}
+
+void Drive::opcontrol_curve_buttons_iterate() {
+  if (!disable_controller) return;
+
+  button_press(&l_increase_, master.get_digital(l_increase_.button), ([this] { this->l_increase(); }), ([this] { this->save_l_curve_sd(); }));
+  button_press(&l_decrease_, master.get_digital(l_decrease_.button), ([this] { this->l_decrease(); }), ([this] { this->save_l_curve_sd(); }));
+  if (!is_tank) {
+    button_press(&r_increase_, master.get_digital(r_increase_.button), ([this] { this->r_increase(); }), ([this] { this->save_r_curve_sd(); }));
+    button_press(&r_decrease_, master.get_digital(r_decrease_.button), ([this] { this->r_decrease(); }), ([this] { this->save_r_curve_sd(); }));
+  }
+
+  auto sr = std::to_string(right_curve_scale);
+  auto sl = std::to_string(left_curve_scale);
+  if (!is_tank)
+    master.set_text(2, 0, sl + "   " + sr);
+  else
+    master.set_text(2, 0, sl);
+}
+
+double Drive::opcontrol_curve_left(double x) {
+  if (left_curve_scale != 0) return (powf(2.718, -(left_curve_scale / 10)) + powf(2.718, (fabs(x) - 127) / 10) * (1 - powf(2.718, -(left_curve_scale / 10)))) * x;
+  return x;
+}
+
+double Drive::opcontrol_curve_right(double x) {
+  if (right_curve_scale != 0) return (powf(2.718, -(right_curve_scale / 10)) + powf(2.718, (fabs(x) - 127) / 10) * (1 - powf(2.718, -(right_curve_scale / 10)))) * x;
+  return x;
+}
+
+////
+// Joysticks
+
+void Drive::opcontrol_joystick_threshold_set(int threshold) { JOYSTICK_THRESHOLD = abs(threshold); }
+
+int Drive::opcontrol_joystick_threshold_get() { return JOYSTICK_THRESHOLD; }
+
+void Drive::opcontrol_joystick_practicemode_toggle(bool toggle) { practice_mode_is_on = toggle; }
+
+bool Drive::opcontrol_joystick_practicemode_toggle_get() { return practice_mode_is_on; }
+
+void Drive::opcontrol_drive_reverse_set(bool toggle) { is_reversed = toggle; }
+
+bool Drive::opcontrol_drive_reverse_get() { return is_reversed; }
+
+void Drive::opcontrol_speed_max_set(int speed) { opcontrol_speed_max = abs(util::clamp(speed, 127, -127)); }
+
+int Drive::opcontrol_speed_max_get() { return opcontrol_speed_max; }
+
+void Drive::opcontrol_arcade_scaling(bool enable) { arcade_vector_scaling = enable; }
+
+bool Drive::opcontrol_arcade_scaling_enabled() { return arcade_vector_scaling; }
+
+void Drive::opcontrol_drive_activebrake_set(double kp, double ki, double kd, double start_i) {
+  left_activebrakePID.constants_set(kp, ki, kd, start_i);
+  right_activebrakePID.constants_set(kp, ki, kd, start_i);
+}
+
+double Drive::opcontrol_drive_activebrake_get() { return left_activebrakePID.constants_get().kp; }
+
+PID::Constants Drive::opcontrol_drive_activebrake_constants_get() { return left_activebrakePID.constants_get(); }
+
+void Drive::opcontrol_drive_sensors_reset() {
+  drive_sensor_reset();
+  opcontrol_drive_activebrake_targets_set();
+}
+
+void Drive::opcontrol_drive_activebrake_targets_set() {
+  left_activebrakePID.target_set(drive_sensor_left());
+  right_activebrakePID.target_set(drive_sensor_right());
+}
+
+int Drive::clipped_joystick(int joystick) {
+  // Practice mode cuts the power when the stick is pushed all the way
+  if (practice_mode_is_on && (abs(joystick) == 127)) joystick = 0;
+  return abs(joystick) > JOYSTICK_THRESHOLD ? joystick : 0;
+}
+
+void Drive::opcontrol_joystick_threshold_iterate(int l_stick, int r_stick) {
+  double l_out = 0.0, r_out = 0.0;
+
+  if (abs(l_stick) > JOYSTICK_THRESHOLD || abs(r_stick) > JOYSTICK_THRESHOLD) {
+    // Driver control takes over from any running motion
+    if (drive_mode_get() != DISABLE) drive_mode_set(DISABLE);
+    l_out = l_stick;
+    r_out = r_stick;
+    opcontrol_drive_activebrake_targets_set();
+  } else if (left_activebrakePID.constants_get().kp != 0 && drive_mode_get() == DISABLE) {
+    // Hold position when the sticks are let go
+    left_activebrakePID.compute(drive_sensor_left());
+    right_activebrakePID.compute(drive_sensor_right());
+    l_out = left_activebrakePID.output;
+    r_out = right_activebrakePID.output;
+  } else if (drive_mode_get() != DISABLE) {
+    return;
+  }
+
+  l_out = util::clamp(l_out, opcontrol_speed_max);
+  r_out = util::clamp(r_out, opcontrol_speed_max);
+  private_drive_set(l_out, r_out);
+}
+
+void Drive::opcontrol_tank() {
+  is_tank = true;
+  opcontrol_curve_buttons_iterate();
+
+  int l_stick = opcontrol_curve_left(clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y)));
+  int r_stick = opcontrol_curve_left(clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_Y)));
+
+  if (is_reversed)
+    opcontrol_joystick_threshold_iterate(-r_stick, -l_stick);
+  else
+    opcontrol_joystick_threshold_iterate(l_stick, r_stick);
+}
+
+// Arcade with fwd on one stick and turn on the other
+static void arcade_mix(double fwd, double turn, bool scaling, double& left, double& right) {
+  left = fwd + turn;
+  right = fwd - turn;
+  if (!scaling) return;
+  double faster = std::max(fabs(left), fabs(right));
+  if (faster > 127) {
+    left = left * 127 / faster;
+    right = right * 127 / faster;
+  }
+}
+
+void Drive::opcontrol_arcade_standard(e_type stick_type) {
+  is_tank = false;
+  opcontrol_curve_buttons_iterate();
+
+  double fwd_stick = clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y));
+  double turn_stick = clipped_joystick(master.get_analog(stick_type == SPLIT ? pros::E_CONTROLLER_ANALOG_RIGHT_X : pros::E_CONTROLLER_ANALOG_LEFT_X));
+  fwd_stick = opcontrol_curve_left(fwd_stick);
+  turn_stick = opcontrol_curve_right(turn_stick);
+  if (is_reversed) fwd_stick = -fwd_stick;
+
+  double left, right;
+  arcade_mix(fwd_stick, turn_stick, arcade_vector_scaling, left, right);
+  opcontrol_joystick_threshold_iterate(left, right);
+}
+
+void Drive::opcontrol_arcade_flipped(e_type stick_type) {
+  is_tank = false;
+  opcontrol_curve_buttons_iterate();
+
+  double fwd_stick = clipped_joystick(master.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_Y));
+  double turn_stick = clipped_joystick(master.get_analog(stick_type == SPLIT ? pros::E_CONTROLLER_ANALOG_LEFT_X : pros::E_CONTROLLER_ANALOG_RIGHT_X));
+  fwd_stick = opcontrol_curve_right(fwd_stick);
+  turn_stick = opcontrol_curve_left(turn_stick);
+  if (is_reversed) fwd_stick = -fwd_stick;
+
+  double left, right;
+  arcade_mix(fwd_stick, turn_stick, arcade_vector_scaling, left, right);
+  opcontrol_joystick_threshold_iterate(left, right);
+}
+
+////
+// PID tuner
+
+void Drive::pid_tuner_enable() {
+  pid_tuner_on = true;
+  column = 0;
+  pid_tuner_brain_init();
+  pid_tuner_print();
+}
+
+void Drive::pid_tuner_disable() {
+  pid_tuner_on = false;
+  screen_print("", 0);
+}
+
+void Drive::pid_tuner_toggle() {
+  if (pid_tuner_on)
+    pid_tuner_disable();
+  else
+    pid_tuner_enable();
+}
+
+bool Drive::pid_tuner_enabled() { return pid_tuner_on; }
+
+void Drive::pid_tuner_print_brain_set(bool input) { pid_tuner_lcd_b = input; }
+
+void Drive::pid_tuner_print_terminal_set(bool input) { pid_tuner_terminal_b = input; }
+
+bool Drive::pid_tuner_print_terminal_enabled() { return pid_tuner_terminal_b; }
+
+bool Drive::pid_tuner_print_brain_enabled() { return pid_tuner_lcd_b; }
+
+void Drive::pid_tuner_increment_p_set(double p) { p_increment = fabs(p); }
+
+void Drive::pid_tuner_increment_i_set(double i) { i_increment = fabs(i); }
+
+void Drive::pid_tuner_increment_d_set(double d) { d_increment = fabs(d); }
+
+void Drive::pid_tuner_increment_start_i_set(double start_i) { start_i_increment = fabs(start_i); }
+
+double Drive::pid_tuner_increment_p_get() { return p_increment; }
+
+double Drive::pid_tuner_increment_i_get() { return i_increment; }
+
+double Drive::pid_tuner_increment_d_get() { return d_increment; }
+
+double Drive::pid_tuner_increment_start_i_get() { return start_i_increment; }
+
+void Drive::pid_tuner_full_enable(bool enable) {
+  is_full_pid_tuner_enabled = enable;
+  used_pid_tuner_pids = enable ? &pid_tuner_full_pids : &pid_tuner_pids;
+  column = 0;
+  row = 0;
+  if (pid_tuner_on) pid_tuner_print();
+}
+
+bool Drive::pid_tuner_full_enabled() { return is_full_pid_tuner_enabled; }
+
+void Drive::pid_tuner_brain_init() {
+  if (!pid_tuner_lcd_b) return;
+  for (int i = 0; i < 8; i++) screen_print("", i);
+}
+
+void Drive::pid_tuner_print() {
+  const_and_name& current = used_pid_tuner_pids->at(column);
+  std::string name = current.name;
+  std::string p = std::to_string(current.consts->kp);
+  std::string i = std::to_string(current.consts->ki);
+  std::string d = std::to_string(current.consts->kd);
+  std::string start_i = std::to_string(current.consts->start_i);
+
+  std::string rows[4] = {"kp: " + p, "ki: " + i, "kd: " + d, "start i: " + start_i};
+  complete_pid_tuner_output = name + "\n";
+  for (int r = 0; r < 4; r++) complete_pid_tuner_output += rows[r] + (r == row ? arrow : "\n");
+
+  pid_tuner_print_brain();
+  pid_tuner_print_terminal();
+}
+
+void Drive::pid_tuner_print_brain() {
+  if (pid_tuner_lcd_b) screen_print(complete_pid_tuner_output, 0);
+}
+
+void Drive::pid_tuner_print_terminal() {
+  if (pid_tuner_terminal_b) std::cout << complete_pid_tuner_output << "\n";
+}
+
+void Drive::pid_tuner_value_modify(float p, float i, float d, float start) {
+  PID::Constants* consts = used_pid_tuner_pids->at(column).consts;
+  consts->kp = std::max(consts->kp + p, 0.0);
+  consts->ki = std::max(consts->ki + i, 0.0);
+  consts->kd = std::max(consts->kd + d, 0.0);
+  consts->start_i = std::max(consts->start_i + start, 0.0);
+
+  // The simple tuner edits one constant set for both directions, so copy it out
+  if (!is_full_pid_tuner_enabled) {
+    forward_drivePID.constants = backward_drivePID.constants = fwd_rev_drivePID.constants;
+    forward_swingPID.constants = backward_swingPID.constants = fwd_rev_swingPID.constants;
+  }
+}
+
+void Drive::pid_tuner_value_increase() {
+  pid_tuner_value_modify(row == 0 ? p_increment : 0, row == 1 ? i_increment : 0, row == 2 ? d_increment : 0, row == 3 ? start_i_increment : 0);
+}
+
+void Drive::pid_tuner_value_decrease() {
+  pid_tuner_value_modify(row == 0 ? -p_increment : 0, row == 1 ? -i_increment : 0, row == 2 ? -d_increment : 0, row == 3 ? -start_i_increment : 0);
+}
+
+void Drive::pid_tuner_iterate() {
+  if (!pid_tuner_on) return;
+  int size = used_pid_tuner_pids->size();
+
+  if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_RIGHT)) {
+    column = column + 1 >= size ? 0 : column + 1;
+    pid_tuner_print();
+  } else if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_LEFT)) {
+    column = column - 1 < 0 ? size - 1 : column - 1;
+    pid_tuner_print();
+  } else if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_UP)) {
+    row = row - 1 < 0 ? 3 : row - 1;
+    pid_tuner_print();
+  } else if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_DOWN)) {
+    row = row + 1 > 3 ? 0 : row + 1;
+    pid_tuner_print();
+  } else if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_A)) {
+    pid_tuner_value_increase();
+    pid_tuner_print();
+  } else if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_Y)) {
+    pid_tuner_value_decrease();
+    pid_tuner_print();
+  }
+}
@@ -0,0 +1,39 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Host build of EZ-Template's Piston, only the headers ship with the V5 library
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+Piston::Piston(int input_port, bool default_state) : piston(input_port, default_state) {
+  reversed = default_state;
+}
+
+Piston::Piston(int input_port, int expander_smart_port, bool default_state)
+    : piston({expander_smart_port, input_port}, default_state) {
+  reversed = default_state;
+}
+
+void Piston::set(bool input) {
+  piston.set_value(reversed ? !input : input);
+  current = input;
+}
+
+bool Piston::get() { return current; }
+
+void Piston::button_toggle(int toggle) {
+  if (toggle && !last_press) set(!current);
+  last_press = toggle;
+}
+
+void Piston::buttons(int active, int deactive) {
+  if (active && !current)
+    set(true);
+  else if (deactive && current)
+    set(false);
+}
@@ -0,0 +1,54 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Host build of EZ-Template's slew, only the headers ship with the V5 library
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+slew::slew() {}
+
+slew::slew(double distance, int minimum_speed) { constants_set(distance, minimum_speed); }
+
+void slew::constants_set(double distance, int minimum_speed) {
+  constants.distance_to_travel = distance;
+  constants.min_speed = minimum_speed;
+}
+
+slew::Constants slew::constants_get() { return constants; }
+
+void slew::speed_max_set(double speed) { max_speed = fabs(speed); }
+
+double slew::speed_max_get() { return max_speed; }
+
+bool slew::enabled() { return is_enabled; }
+
+double slew::output() { return last_output; }
+
+void slew::initialize(bool enabled, double maximum_speed, double target, double current) {
+  is_enabled = enabled && constants.distance_to_travel != 0;
+  max_speed = fabs(maximum_speed);
+  sign = util::sgn(target - current);
+
+  // Line from min_speed at the start to max_speed at distance_to_travel
+  x_intercept = current + (constants.distance_to_travel * sign);
+  y_intercept = max_speed * sign;
+  slope = is_enabled ? ((sign * constants.min_speed) - y_intercept) / (x_intercept - current) : 0;
+}
+
+double slew::iterate(double current) {
+  if (is_enabled) {
+    error = x_intercept - current;
+    if (util::sgn(error) == sign) {
+      last_output = ((slope * error) + y_intercept) * sign;
+      return last_output;
+    }
+    is_enabled = false;  // Past the slew distance, full speed from here
+  }
+  last_output = max_speed;
+  return last_output;
+}
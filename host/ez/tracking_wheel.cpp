@@ -0,0 +1,79 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Host build of EZ-Template's tracking_wheel, only the headers ship with the V5 library
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+tracking_wheel::tracking_wheel(std::vector<int> ports, double wheel_diameter, double distance_to_center, double ratio)
+    : adi_encoder(abs(ports[0]), abs(ports[1]), util::reversed_active(ports[0])), smart_encoder(-1) {
+  IS_TRACKER = DRIVE_ADI_ENCODER;
+  ENCODER_TICKS_PER_REV = 360.0;
+  WHEEL_DIAMETER = wheel_diameter;
+  DISTANCE_TO_CENTER = distance_to_center;
+  ratio_set(ratio);
+}
+
+tracking_wheel::tracking_wheel(int smart_port, std::vector<int> ports, double wheel_diameter, double distance_to_center, double ratio)
+    : adi_encoder({smart_port, abs(ports[0]), abs(ports[1])}, util::reversed_active(ports[0])), smart_encoder(-1) {
+  IS_TRACKER = DRIVE_ADI_ENCODER;
+  ENCODER_TICKS_PER_REV = 360.0;
+  WHEEL_DIAMETER = wheel_diameter;
+  DISTANCE_TO_CENTER = distance_to_center;
+  ratio_set(ratio);
+}
+
+tracking_wheel::tracking_wheel(int port, double wheel_diameter, double distance_to_center, double ratio)
+    : adi_encoder(-1, -1, false), smart_encoder(port) {
+  IS_TRACKER = DRIVE_ROTATION;
+  ENCODER_TICKS_PER_REV = 36000.0;
+  WHEEL_DIAMETER = wheel_diameter;
+  DISTANCE_TO_CENTER = distance_to_center;
+  ratio_set(ratio);
+}
+
+double tracking_wheel::get_raw() {
+  return IS_TRACKER == DRIVE_ADI_ENCODER ? adi_encoder.get_value() : smart_encoder.get_position();
+}
+
+double tracking_wheel::get() { return get_raw() / ticks_per_inch(); }
+
+void tracking_wheel::reset() {
+  if (IS_TRACKER == DRIVE_ADI_ENCODER)
+    adi_encoder.reset();
+  else
+    smart_encoder.reset_position();
+}
+
+double tracking_wheel::ticks_per_inch() { return WHEEL_TICK_PER_REV / (WHEEL_DIAMETER * M_PI); }
+
+void tracking_wheel::ticks_per_rev_set(double input) {
+  ENCODER_TICKS_PER_REV = input;
+  ratio_set(RATIO);
+}
+
+double tracking_wheel::ticks_per_rev_get() { return ENCODER_TICKS_PER_REV; }
+
+void tracking_wheel::ratio_set(double input) {
+  RATIO = input;
+  WHEEL_TICK_PER_REV = ENCODER_TICKS_PER_REV * RATIO;
+}
+
+double tracking_wheel::ratio_get() { return RATIO; }
+
+void tracking_wheel::wheel_diameter_set(double input) { WHEEL_DIAMETER = input; }
+
+double tracking_wheel::wheel_diameter_get() { return WHEEL_DIAMETER; }
+
+void tracking_wheel::distance_to_center_set(double input) { DISTANCE_TO_CENTER = input; }
+
+double tracking_wheel::distance_to_center_get() { return IS_FLIPPED ? -DISTANCE_TO_CENTER : DISTANCE_TO_CENTER; }
+
+void tracking_wheel::distance_to_center_flip_set(bool input) { IS_FLIPPED = input; }
+
+bool tracking_wheel::distance_to_center_flip_get() { return IS_FLIPPED; }
@@ -0,0 +1,133 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Host build of EZ-Template's util, only the headers ship with the V5 library
+
+#include "EZ-Template/util.hpp"
+
+#include "EZ-Template/api.hpp"
+#include "pls/format.hpp"
+#include "sim/devices.hpp"
+
+pros::Controller master(pros::E_CONTROLLER_MASTER);
+
+namespace ez {
+
+void ez_template_print() {
+  std::cout << "EZ-Template (host build)\n";
+}
+
+void screen_print(std::string text, int line) {
+  // Split on newlines so each line lands on its own row, like the brain
+  std::stringstream lines(text);
+  std::string row;
+  while (std::getline(lines, row) && line >= 0 && line < 8) pls::sim::devices().screen[line++] = row;
+}
+
+std::string exit_to_string(exit_output input) {
+  switch ((int)input) {
+    case RUNNING:
+      return "Running";
+    case SMALL_EXIT:
+      return "Small";
+    case BIG_EXIT:
+      return "Big";
+    case VELOCITY_EXIT:
+      return "Velocity";
+    case mA_EXIT:
+      return "mA";
+    case ERROR_NO_CONSTANTS:
+      return "Error: Exit condition constants not set!";
+    default:
+      return "Error: Out of bounds!";
+  }
+}
+
+namespace util {
+bool AUTON_RAN = true;
+
+int places_after_decimal(double input, int min) {
+  return pls::places_after_decimal(input, min);
+}
+
+std::string to_string_with_precision(double input, int n) {
+  std::ostringstream out;
+  out.precision(n);
+  out << std::fixed << input;
+  return out.str();
+}
+
+int sgn(double input) {
+  if (input > 0) return 1;
+  if (input < 0) return -1;
+  return 0;
+}
+
+bool reversed_active(double input) { return input < 0; }
+
+double clamp(double input, double max, double min) {
+  if (input > max) return max;
+  if (input < min) return min;
+  return input;
+}
+
+double clamp(double input, double max) { return clamp(input, fabs(max), -fabs(max)); }
+
+double to_deg(double input) { return input * (180.0 / M_PI); }
+
+double to_rad(double input) { return input * (M_PI / 180.0); }
+
+double absolute_angle_to_point(pose itarget, pose icurrent) {
+  // Angles are clockwise from +y, so x and y swap places in atan2
+  double angle = to_deg(atan2(itarget.x - icurrent.x, itarget.y - icurrent.y));
+  return std::isnan(angle) ? 0.0 : angle;
+}
+
+double distance_to_point(pose itarget, pose icurrent) {
+  return hypot(itarget.x - icurrent.x, itarget.y - icurrent.y);
+}
+
+double wrap_angle(double theta) {
+  theta = fmod(theta, 360.0);
+  if (theta > 180.0) theta -= 360.0;
+  if (theta < -180.0) theta += 360.0;
+  return theta;
+}
+
+pose vector_off_point(double added, pose icurrent) {
+  double angle = to_rad(icurrent.theta);
+  return {icurrent.x + sin(angle) * added, icurrent.y + cos(angle) * added, icurrent.theta};
+}
+
+double turn_shortest(double target, double current, bool print) {
+  double out = current + wrap_angle(target - current);
+  if (print) printf("Shortest turn: target %.2f from %.2f becomes %.2f\n", target, current, out);
+  return out;
+}
+
+double turn_longest(double target, double current, bool print) {
+  double error = wrap_angle(target - current);
+  double out = current + (error > 0 ? error - 360.0 : error + 360.0);
+  if (print) printf("Longest turn: target %.2f from %.2f becomes %.2f\n", target, current, out);
+  return out;
+}
+
+pose united_pose_to_pose(united_pose input) {
+  double theta = input.theta == p_ANGLE_NOT_SET ? ANGLE_NOT_SET : input.theta.convert(okapi::degree);
+  return {input.x.convert(okapi::inch), input.y.convert(okapi::inch), theta};
+}
+
+odom united_odom_to_odom(united_odom input) {
+  return {united_pose_to_pose(input.target), input.drive_direction, input.max_xy_speed, input.turn_behavior};
+}
+
+std::vector<odom> united_odoms_to_odoms(std::vector<united_odom> inputs) {
+  std::vector<odom> out;
+  for (united_odom input : inputs) out.push_back(united_odom_to_odom(input));
+  return out;
+}
+}  // namespace util
+}  // namespace ez
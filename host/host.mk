@@ -0,0 +1,80 @@
+# Linux build of the robot code against the simulated PROS in host/, for
+# running autons on a computer.  Included from the Makefile.
+#
+#   make host                 Build the tools below and bin/host/trace2json
+#   ./bin/host/auton RA7      Run an auton, see host/tools/auton.cpp
+#   ./bin/host/montecarlo     Run every auton a thousand times, see host/tools/montecarlo.cpp
+#   ./bin/host/tune           Tune default_constants() on the autons, see host/tools/tune.cpp
+#   ./bin/host/schedules      Run the autons under many task interleavings, see host/tools/schedules.cpp
+#   ./bin/host/replay in.txt  Replay a driver's controller into opcontrol, see host/tools/replay.cpp
+#   make bench                Time the per-tick code, see host/tools/bench.cpp
+
+HOST_CXX?=g++
+HOST_BINDIR=$(BINDIR)/host
+HOST_OBJDIR=$(HOST_BINDIR)/obj
+HOST_CXXFLAGS=-std=gnu++20 -O2 -g -Wall -Wextra -Wno-deprecated-enum-enum-conversion \
+	-I$(INCDIR) -iquote$(INCDIR) -iquote$(INCDIR)/okapi/squiggles -I$(ROOT)/host -DPLS_PROFILE=$(PROFILE) -DPLS_FAST_MATH=$(FAST_MATH)
+
+# Only EZ-Template's headers ship in include/, the V5 library is prebuilt.  host/ez
+# is written from the 3.2 headers so the sim builds without it.  With a checkout
+# of EZ-Template 3.2 at hand, build its own sources against the sim instead:
+#   make host EZ_SRC=../EZ-Template/src/EZ-Template
+EZ_SRC?=$(ROOT)/host/ez
+
+# The same for squiggles, which ships inside okapilib as headers only.  host/squiggles
+# is written from those, or build squiggles' MIT sources from a checkout:
+#   make host SQUIGGLES_SRC=../squiggles/src
+SQUIGGLES_SRC?=$(ROOT)/host/squiggles
+
+HOST_ROBOT_SRC=$(wildcard $(SRCDIR)/*.cpp $(SRCDIR)/*/*.cpp)
+HOST_SIM_SRC=$(wildcard $(ROOT)/host/pros/*.cpp $(ROOT)/host/sim/*.cpp $(ROOT)/host/okapi/*.cpp)
+HOST_EZ_SRC=$(wildcard $(EZ_SRC)/*.cpp $(EZ_SRC)/*/*.cpp)
+HOST_SQUIGGLES_SRC=$(wildcard $(SQUIGGLES_SRC)/*.cpp $(SQUIGGLES_SRC)/*/*.cpp)
+HOST_OBJ=$(patsubst $(ROOT)/%.cpp,$(HOST_OBJDIR)/%.o,$(HOST_ROBOT_SRC) $(HOST_SIM_SRC)) \
+	$(patsubst $(EZ_SRC)/%.cpp,$(HOST_OBJDIR)/ez-src/%.o,$(HOST_EZ_SRC)) \
+	$(patsubst $(SQUIGGLES_SRC)/%.cpp,$(HOST_OBJDIR)/squiggles-src/%.o,$(HOST_SQUIGGLES_SRC))
+
+.PHONY: host
+host: $(HOST_BINDIR)/auton $(HOST_BINDIR)/montecarlo $(HOST_BINDIR)/tune $(HOST_BINDIR)/schedules $(HOST_BINDIR)/replay $(HOST_BINDIR)/bench $(HOST_BINDIR)/trace2json
+
+$(HOST_BINDIR)/auton: $(HOST_OBJ) $(HOST_OBJDIR)/host/tools/auton.o
+	$(HOST_CXX) $^ -o $@
+
+$(HOST_BINDIR)/montecarlo: $(HOST_OBJ) $(HOST_OBJDIR)/host/tools/montecarlo.o
+	$(HOST_CXX) $^ -o $@
+
+$(HOST_BINDIR)/tune: $(HOST_OBJ) $(HOST_OBJDIR)/host/tools/tune.o
+	$(HOST_CXX) $^ -o $@
+
+$(HOST_BINDIR)/schedules: $(HOST_OBJ) $(HOST_OBJDIR)/host/tools/schedules.o
+	$(HOST_CXX) $^ -o $@
+
+$(HOST_BINDIR)/replay: $(HOST_OBJ) $(HOST_OBJDIR)/host/tools/replay.o
+	$(HOST_CXX) $^ -o $@
+
+$(HOST_BINDIR)/bench: $(HOST_OBJ) $(HOST_OBJDIR)/host/tools/bench.o
+	$(HOST_CXX) $^ -o $@
+
+# Writes bin/host/bench.json, pass options to bench with BENCH_ARGS="..."
+.PHONY: bench
+bench: $(HOST_BINDIR)/bench
+	$(HOST_BINDIR)/bench -j $(HOST_BINDIR)/bench.json $(BENCH_ARGS)
+
+$(HOST_BINDIR)/trace2json: $(ROOT)/host/tools/trace2json.cpp
+	@mkdir -p $(dir $@)
+	$(HOST_CXX) -std=c++17 -O2 $< -o $@
+
+$(HOST_OBJDIR)/ez-src/%.o: $(EZ_SRC)/%.cpp
+	@mkdir -p $(dir $@)
+	$(HOST_CXX) $(HOST_CXXFLAGS) -MMD -MP -c $< -o $@
+
+$(HOST_OBJDIR)/squiggles-src/%.o: $(SQUIGGLES_SRC)/%.cpp
+	@mkdir -p $(dir $@)
+	$(HOST_CXX) $(HOST_CXXFLAGS) -MMD -MP -c $< -o $@
+
+$(HOST_OBJDIR)/%.o: $(ROOT)/%.cpp
+	@mkdir -p $(dir $@)
+	$(HOST_CXX) $(HOST_CXXFLAGS) -MMD -MP -c $< -o $@
+
+-include $(HOST_OBJ:.o=.d) $(HOST_OBJDIR)/host/tools/auton.d $(HOST_OBJDIR)/host/tools/montecarlo.d $(HOST_OBJDIR)/host/tools/tune.d $(HOST_OBJDIR)/host/tools/schedules.d $(HOST_OBJDIR)/host/tools/replay.d \
+	$(HOST_OBJDIR)/host/tools/bench.d
@@ -0,0 +1,87 @@
+// Host build of okapi's timers and logger, only the headers ship with the V5 library
+
+#include "okapi/api/util/abstractTimer.hpp"
+#include "okapi/api/util/logging.hpp"
+#include "okapi/impl/util/timer.hpp"
+#include "pros/rtos.h"
+
+namespace okapi {
+AbstractTimer::AbstractTimer(const QTime ifirstCalled)
+    : firstCalled(ifirstCalled), lastCalled(ifirstCalled), mark(ifirstCalled), hardMark(0_ms), repeatMark(-1_ms) {}
+
+AbstractTimer::~AbstractTimer() = default;
+
+QTime AbstractTimer::getDt() {
+  const QTime now = millis();
+  const QTime dt = now - lastCalled;
+  lastCalled = now;
+  return dt;
+}
+
+QTime AbstractTimer::readDt() const { return millis() - lastCalled; }
+
+QTime AbstractTimer::getStartingTime() const { return firstCalled; }
+
+QTime AbstractTimer::getDtFromStart() const { return millis() - firstCalled; }
+
+void AbstractTimer::placeMark() { mark = millis(); }
+
+QTime AbstractTimer::clearMark() {
+  const QTime old = mark;
+  mark = 0_ms;
+  return old;
+}
+
+void AbstractTimer::placeHardMark() {
+  if (hardMark == 0_ms) hardMark = millis();
+}
+
+QTime AbstractTimer::clearHardMark() {
+  const QTime old = hardMark;
+  hardMark = 0_ms;
+  return old;
+}
+
+QTime AbstractTimer::getDtFromMark() const { return mark == 0_ms ? 0_ms : millis() - mark; }
+
+QTime AbstractTimer::getDtFromHardMark() const { return hardMark == 0_ms ? 0_ms : millis() - hardMark; }
+
+bool AbstractTimer::repeat(const QTime time) {
+  if (repeatMark == -1_ms) repeatMark = millis();
+  if (millis() - repeatMark >= time) {
+    repeatMark = -1_ms;
+    return true;
+  }
+  return false;
+}
+
+bool AbstractTimer::repeat(const QFrequency frequency) { return repeat(QTime(1 / frequency.convert(Hz))); }
+
+Timer::Timer() : AbstractTimer(pros::c::millis() * millisecond) {}
+
+QTime Timer::millis() const { return pros::c::millis() * millisecond; }
+
+// Logs nowhere unless given a file, the host tools print for themselves
+Logger::Logger() noexcept : timer(nullptr), logLevel(LogLevel::off), logfile(nullptr) {}
+
+Logger::Logger(std::unique_ptr<AbstractTimer> itimer, std::string_view ifileName, const LogLevel& ilevel) noexcept
+    : timer(std::move(itimer)), logLevel(ilevel), logfile(fopen(std::string(ifileName).c_str(), "a")) {}
+
+Logger::Logger(std::unique_ptr<AbstractTimer> itimer, FILE* const ifile, const LogLevel& ilevel) noexcept
+    : timer(std::move(itimer)), logLevel(ilevel), logfile(ifile) {}
+
+Logger::~Logger() {
+  if (logfile != nullptr && logfile != stdout && logfile != stderr) close();
+}
+
+// Set by the DefaultLoggerInitializer every okapi header includes.  "/ser/sout" doesn't open on a
+// computer, so it logs nowhere.
+std::shared_ptr<Logger> defaultLogger;
+int DefaultLoggerInitializer::count = 0;
+
+std::shared_ptr<Logger> Logger::getDefaultLogger() { return defaultLogger; }
+
+void Logger::setDefaultLogger(std::shared_ptr<Logger> ilogger) { defaultLogger = std::move(ilogger); }
+
+bool Logger::isSerialStream(std::string_view filename) { return filename.find("/ser/") == 0; }
+}  // namespace okapi
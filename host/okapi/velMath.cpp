@@ -0,0 +1,35 @@
+// Host build of okapi's VelMath, only the headers ship with the V5 library
+
+#include "okapi/api/filter/velMath.hpp"
+
+#include <stdexcept>
+
+namespace okapi {
+VelMath::VelMath(const double iticksPerRev, std::unique_ptr<Filter> ifilter, const QTime isampleTime, std::unique_ptr<AbstractTimer> iloopDtTimer,
+                 std::shared_ptr<Logger> ilogger)
+    : logger(std::move(ilogger)), ticksPerRev(iticksPerRev), sampleTime(isampleTime), loopDtTimer(std::move(iloopDtTimer)), filter(std::move(ifilter)) {
+  if (iticksPerRev == 0) throw std::invalid_argument("VelMath: The ticks per revolution cannot be zero.");
+}
+
+VelMath::~VelMath() = default;
+
+QAngularSpeed VelMath::step(const double inewPos) {
+  const QTime dt = loopDtTimer->readDt();
+  if (dt >= sampleTime) {
+    // Ticks per ms to rpm
+    vel = (1000.0 / dt.convert(millisecond)) * (inewPos - lastPos) * 60.0 / ticksPerRev * rpm;
+    vel = filter->filter(vel.convert(rpm)) * rpm;
+    accel = (vel - lastVel) / dt;
+    lastVel = vel;
+    lastPos = inewPos;
+    loopDtTimer->getDt();
+  }
+  return vel;
+}
+
+void VelMath::setTicksPerRev(const double iTPR) { ticksPerRev = iTPR; }
+
+QAngularSpeed VelMath::getVelocity() const { return vel; }
+
+QAngularAcceleration VelMath::getAccel() const { return accel; }
+}  // namespace okapi
@@ -0,0 +1,547 @@
+// pros::Imu, Rotation, adi, Controller, battery, competition and usd on the simulated devices
+
+#include <cerrno>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+#include "pros/adi.hpp"
+#include "pros/error.h"
+#include "pros/imu.hpp"
+#include "pros/misc.hpp"
+#include "pros/rotation.hpp"
+#include "sim/devices.hpp"
+#include "sim/scheduler.hpp"
+
+namespace sim = pls::sim;
+
+namespace pros {
+inline namespace v5 {
+
+////
+// IMU
+
+#define IMU_GET(error)                                  \
+  sim::Imu* imu = sim::devices().imu(get_port());       \
+  if (imu == nullptr) {                                 \
+    errno = ENODEV;                                     \
+    return error;                                       \
+  }                                                     \
+  if (imu->calibrating()) {                             \
+    errno = EAGAIN;                                     \
+    return error;                                       \
+  }
+
+static double wrap_360(double input) {
+  double out = std::fmod(input, 360.0);
+  return out < 0.0 ? out + 360.0 : out;
+}
+
+static double wrap_180(double input) { return wrap_360(input + 180.0) - 180.0; }
+
+std::int32_t Imu::reset(bool blocking) const {
+  sim::Imu* imu = sim::devices().imu(get_port());
+  if (imu == nullptr) {
+    errno = ENODEV;
+    return PROS_ERR;
+  }
+  imu->calibrated_us = sim::now_us() + imu->calibration_ms * 1000ull;
+  imu->rotation_offset = imu->yaw * imu->scale + imu->drift_total;
+  imu->heading_offset = imu->rotation_offset;
+  imu->yaw_offset = imu->rotation_offset;
+  imu->pitch_offset = imu->pitch;
+  imu->roll_offset = imu->roll;
+  if (blocking) sim::task_sleep_until(imu->calibrated_us);
+  return 1;
+}
+
+std::int32_t Imu::set_data_rate(std::uint32_t /*rate*/) const {
+  IMU_GET(PROS_ERR);
+  return 1;
+}
+
+Imu Imu::get_imu() {
+  for (std::uint8_t port = 1; port <= sim::SMART_PORTS; port++)
+    if (sim::devices().type[port] == sim::IMU) return Imu(port);
+  errno = ENODEV;
+  return Imu(PROS_ERR_BYTE);
+}
+
+std::vector<Imu> Imu::get_all_devices() {
+  std::vector<Imu> out;
+  for (std::uint8_t port = 1; port <= sim::SMART_PORTS; port++)
+    if (sim::devices().type[port] == sim::IMU) out.push_back(Imu(port));
+  return out;
+}
+
+double Imu::get_rotation() const {
+  IMU_GET(PROS_ERR_F);
+  return imu->rotation();
+}
+
+double Imu::get_heading() const {
+  IMU_GET(PROS_ERR_F);
+  return wrap_360(imu->yaw * imu->scale + imu->drift_total - imu->heading_offset);
+}
+
+double Imu::get_yaw() const {
+  IMU_GET(PROS_ERR_F);
+  return wrap_180(imu->yaw * imu->scale + imu->drift_total - imu->yaw_offset);
+}
+
+double Imu::get_pitch() const {
+  IMU_GET(PROS_ERR_F);
+  return wrap_180(imu->pitch - imu->pitch_offset);
+}
+
+double Imu::get_roll() const {
+  IMU_GET(PROS_ERR_F);
+  return wrap_180(imu->roll - imu->roll_offset);
+}
+
+pros::euler_s_t Imu::get_euler() const {
+  pros::euler_s_t out = {get_pitch(), get_roll(), get_yaw()};
+  return out;
+}
+
+pros::quaternion_s_t Imu::get_quaternion() const {
+  pros::euler_s_t e = get_euler();
+  double to_rad = M_PI / 180.0;
+  double cy = std::cos(e.yaw * to_rad / 2), sy = std::sin(e.yaw * to_rad / 2);
+  double cp = std::cos(e.pitch * to_rad / 2), sp = std::sin(e.pitch * to_rad / 2);
+  double cr = std::cos(e.roll * to_rad / 2), sr = std::sin(e.roll * to_rad / 2);
+  pros::quaternion_s_t out = {sr * cp * cy - cr * sp * sy, cr * sp * cy + sr * cp * sy,
+                              cr * cp * sy - sr * sp * cy, cr * cp * cy + sr * sp * sy};
+  return out;
+}
+
+pros::imu_gyro_s_t Imu::get_gyro_rate() const {
+  IMU_GET((pros::imu_gyro_s_t{PROS_ERR_F, PROS_ERR_F, PROS_ERR_F}));
+  return {0.0, 0.0, imu->yaw_rate * imu->scale + imu->drift};
+}
+
+pros::imu_accel_s_t Imu::get_accel() const {
+  IMU_GET((pros::imu_accel_s_t{PROS_ERR_F, PROS_ERR_F, PROS_ERR_F}));
+  return {imu->accel_x, imu->accel_y, imu->accel_z};
+}
+
+std::int32_t Imu::tare_rotation() const { return set_rotation(0.0); }
+std::int32_t Imu::tare_heading() const { return set_heading(0.0); }
+std::int32_t Imu::tare_pitch() const { return set_pitch(0.0); }
+std::int32_t Imu::tare_yaw() const { return set_yaw(0.0); }
+std::int32_t Imu::tare_roll() const { return set_roll(0.0); }
+std::int32_t Imu::tare_euler() const { return set_euler({0.0, 0.0, 0.0}); }
+
+std::int32_t Imu::tare() const {
+  if (tare_euler() == PROS_ERR) return PROS_ERR;
+  if (tare_heading() == PROS_ERR) return PROS_ERR;
+  return tare_rotation();
+}
+
+std::int32_t Imu::set_heading(const double target) const {
+  IMU_GET(PROS_ERR);
+  imu->heading_offset = imu->yaw * imu->scale + imu->drift_total - target;
+  return 1;
+}
+
+std::int32_t Imu::set_rotation(const double target) const {
+  IMU_GET(PROS_ERR);
+  imu->rotation_offset = imu->yaw * imu->scale + imu->drift_total - target;
+  return 1;
+}
+
+std::int32_t Imu::set_yaw(const double target) const {
+  IMU_GET(PROS_ERR);
+  imu->yaw_offset = imu->yaw * imu->scale + imu->drift_total - target;
+  return 1;
+}
+
+std::int32_t Imu::set_pitch(const double target) const {
+  IMU_GET(PROS_ERR);
+  imu->pitch_offset = imu->pitch - target;
+  return 1;
+}
+
+std::int32_t Imu::set_roll(const double target) const {
+  IMU_GET(PROS_ERR);
+  imu->roll_offset = imu->roll - target;
+  return 1;
+}
+
+std::int32_t Imu::set_euler(const pros::euler_s_t target) const {
+  if (set_pitch(target.pitch) == PROS_ERR) return PROS_ERR;
+  if (set_roll(target.roll) == PROS_ERR) return PROS_ERR;
+  return set_yaw(target.yaw);
+}
+
+pros::ImuStatus Imu::get_status() const {
+  sim::Imu* imu = sim::devices().imu(get_port());
+  if (imu == nullptr) return ImuStatus::error;
+  return imu->calibrating() ? ImuStatus::calibrating : ImuStatus::ready;
+}
+
+bool Imu::is_calibrating() const { return get_status() == ImuStatus::calibrating; }
+
+imu_orientation_e_t Imu::get_physical_orientation() const { return E_IMU_Z_UP; }
+
+////
+// Rotation sensor
+
+#define ROTATION_GET(error)                                       \
+  sim::Rotation* rotation = sim::devices().rotation(get_port());  \
+  if (rotation == nullptr) {                                      \
+    errno = ENODEV;                                               \
+    return error;                                                 \
+  }
+
+Rotation::Rotation(const std::int8_t port) : Device(std::abs(port), DeviceType::rotation) {
+  sim::Rotation* rotation = sim::devices().rotation(port);
+  if (rotation != nullptr && port < 0) rotation->reversed = true;
+}
+
+std::int32_t Rotation::reset() {
+  ROTATION_GET(PROS_ERR);
+  rotation->offset = rotation->reading() + rotation->offset - wrap_360(rotation->reading() + rotation->offset);
+  return 1;
+}
+
+std::int32_t Rotation::set_data_rate(std::uint32_t /*rate*/) const {
+  ROTATION_GET(PROS_ERR);
+  return 1;
+}
+
+std::int32_t Rotation::set_position(std::uint32_t position) const {
+  ROTATION_GET(PROS_ERR);
+  rotation->offset += rotation->reading() - (std::int32_t)position / 100.0;
+  return 1;
+}
+
+std::int32_t Rotation::reset_position(void) const { return set_position(0); }
+
+std::vector<Rotation> Rotation::get_all_devices() {
+  std::vector<Rotation> out;
+  for (std::int8_t port = 1; port <= sim::SMART_PORTS; port++)
+    if (sim::devices().type[port] == sim::ROTATION) out.push_back(Rotation(port));
+  return out;
+}
+
+std::int32_t Rotation::get_position() const {
+  ROTATION_GET(PROS_ERR);
+  return (std::int32_t)std::lround(rotation->reading() * 100.0);
+}
+
+std::int32_t Rotation::get_velocity() const {
+  ROTATION_GET(PROS_ERR);
+  return (std::int32_t)std::lround((rotation->reversed ? -rotation->velocity : rotation->velocity) * 100.0);
+}
+
+std::int32_t Rotation::get_angle() const {
+  ROTATION_GET(PROS_ERR);
+  double raw = rotation->reversed ? -rotation->angle : rotation->angle;
+  return (std::int32_t)std::lround(wrap_360(raw) * 100.0) % 36000;
+}
+
+std::int32_t Rotation::set_reversed(bool value) const {
+  ROTATION_GET(PROS_ERR);
+  if (rotation->reversed != value) {
+    // Flipping keeps the position reading continuous in the new direction
+    double before = rotation->reading();
+    rotation->reversed = value;
+    rotation->offset += rotation->reading() + before;
+  }
+  return 1;
+}
+
+std::int32_t Rotation::reverse() const {
+  ROTATION_GET(PROS_ERR);
+  return set_reversed(!rotation->reversed);
+}
+
+std::int32_t Rotation::get_reversed() const {
+  ROTATION_GET(PROS_ERR);
+  return rotation->reversed;
+}
+
+}  // namespace v5
+
+////
+// ADI
+
+namespace adi {
+
+// Accepts 1-8, 'a'-'h' and 'A'-'H'
+static std::uint8_t adi_index(std::uint8_t port) {
+  if (port >= 'a' && port <= 'h') return port - 'a';
+  if (port >= 'A' && port <= 'H') return port - 'A';
+  if (port >= 1 && port <= sim::ADI_PORTS) return port - 1;
+  return PROS_ERR_BYTE;
+}
+
+static sim::Adi* adi_get(std::uint8_t smart_port, std::uint8_t adi_port) {
+  if (adi_port >= sim::ADI_PORTS) {
+    errno = ENXIO;
+    return nullptr;
+  }
+  sim::Adi* adi = sim::devices().adi_get(smart_port);
+  if (adi == nullptr) errno = ENODEV;
+  return adi;
+}
+
+Port::Port(std::uint8_t adi_port, adi_port_config_e_t type)
+    : _smart_port(sim::ADI_SMART_PORT), _adi_port(adi_index(adi_port)) {
+  if (type != E_ADI_TYPE_UNDEFINED) set_config(type);
+}
+
+Port::Port(ext_adi_port_pair_t port_pair, adi_port_config_e_t type)
+    : _smart_port(port_pair.first), _adi_port(adi_index(port_pair.second)) {
+  if (type != E_ADI_TYPE_UNDEFINED) set_config(type);
+}
+
+std::int32_t Port::get_config() const {
+  sim::Adi* adi = adi_get(_smart_port, _adi_port);
+  return adi == nullptr ? PROS_ERR : adi->config[_adi_port];
+}
+
+std::int32_t Port::get_value() const {
+  sim::Adi* adi = adi_get(_smart_port, _adi_port);
+  return adi == nullptr ? PROS_ERR : adi->value[_adi_port];
+}
+
+std::int32_t Port::set_config(adi_port_config_e_t type) const {
+  sim::Adi* adi = adi_get(_smart_port, _adi_port);
+  if (adi == nullptr) return PROS_ERR;
+  adi->config[_adi_port] = type;
+  return 1;
+}
+
+std::int32_t Port::set_value(std::int32_t value) const {
+  sim::Adi* adi = adi_get(_smart_port, _adi_port);
+  if (adi == nullptr) return PROS_ERR;
+  sim::shared_write(&adi->value[_adi_port], "three wire", _smart_port, 'A' + _adi_port);
+  if (adi->value[_adi_port] != value) {
+    adi->changed_us[_adi_port] = sim::now_us();
+    adi->changes[_adi_port]++;
+  }
+  adi->value[_adi_port] = value;
+  return 1;
+}
+
+ext_adi_port_tuple_t Port::get_port() const { return {_smart_port, _adi_port + 1, PROS_ERR_BYTE}; }
+
+DigitalOut::DigitalOut(std::uint8_t adi_port, bool init_state) : Port(adi_port, E_ADI_DIGITAL_OUT) {
+  set_value(init_state);
+}
+
+DigitalOut::DigitalOut(ext_adi_port_pair_t port_pair, bool init_state) : Port(port_pair, E_ADI_DIGITAL_OUT) {
+  set_value(init_state);
+}
+
+DigitalIn::DigitalIn(std::uint8_t adi_port) : Port(adi_port, E_ADI_DIGITAL_IN) {}
+
+DigitalIn::DigitalIn(ext_adi_port_pair_t port_pair) : Port(port_pair, E_ADI_DIGITAL_IN) {}
+
+std::int32_t DigitalIn::get_new_press() const {
+  // Same latch the brain keeps, one per port
+  static bool last[sim::SMART_PORTS + 2][sim::ADI_PORTS] = {};
+  std::int32_t value = get_value();
+  if (value == PROS_ERR) return PROS_ERR;
+  bool& was = last[_smart_port][_adi_port];
+  bool pressed = value && !was;
+  was = value;
+  return pressed;
+}
+
+// Encoders count on the top port, 360 ticks per revolution
+Encoder::Encoder(std::uint8_t adi_port_top, std::uint8_t adi_port_bottom, bool reversed)
+    : Port(adi_port_top, E_ADI_LEGACY_ENCODER), _port_pair{adi_port_top, adi_port_bottom} {
+  sim::Adi* adi = adi_get(_smart_port, _adi_port);
+  if (adi != nullptr) adi->config[_adi_port] = reversed ? -E_ADI_LEGACY_ENCODER : E_ADI_LEGACY_ENCODER;
+}
+
+Encoder::Encoder(ext_adi_port_tuple_t port_tuple, bool reversed)
+    : Port({std::get<0>(port_tuple), std::get<1>(port_tuple)}, E_ADI_LEGACY_ENCODER),
+      _port_pair{std::get<1>(port_tuple), std::get<2>(port_tuple)} {
+  sim::Adi* adi = adi_get(_smart_port, _adi_port);
+  if (adi != nullptr) adi->config[_adi_port] = reversed ? -E_ADI_LEGACY_ENCODER : E_ADI_LEGACY_ENCODER;
+}
+
+std::int32_t Encoder::reset() const {
+  sim::Adi* adi = adi_get(_smart_port, _adi_port);
+  if (adi == nullptr) return PROS_ERR;
+  adi->value[(_adi_port + 1) % sim::ADI_PORTS] = adi->value[_adi_port];  // Bottom port keeps the zero
+  return 1;
+}
+
+std::int32_t Encoder::get_value() const {
+  sim::Adi* adi = adi_get(_smart_port, _adi_port);
+  if (adi == nullptr) return PROS_ERR;
+  std::int32_t ticks = adi->value[_adi_port] - adi->value[(_adi_port + 1) % sim::ADI_PORTS];
+  return adi->config[_adi_port] < 0 ? -ticks : ticks;
+}
+
+ext_adi_port_tuple_t Encoder::get_port() const { return {_smart_port, _adi_port + 1, _adi_port + 2}; }
+
+}  // namespace adi
+
+////
+// Controller
+
+namespace c {
+
+static sim::Controller* controller_get(controller_id_e_t id) {
+  if (id != E_CONTROLLER_MASTER && id != E_CONTROLLER_PARTNER) {
+    errno = EINVAL;
+    return nullptr;
+  }
+  sim::Controller* controller = &sim::devices().controllers[id];
+  if (!controller->connected) {
+    errno = EACCES;
+    return nullptr;
+  }
+  return controller;
+}
+
+int32_t controller_is_connected(controller_id_e_t id) {
+  if (id != E_CONTROLLER_MASTER && id != E_CONTROLLER_PARTNER) return PROS_ERR;
+  return sim::devices().controllers[id].connected;
+}
+
+int32_t controller_get_analog(controller_id_e_t id, controller_analog_e_t channel) {
+  sim::Controller* controller = controller_get(id);
+  if (controller == nullptr || channel < 0 || channel > 3) return 0;
+  return controller->analog[channel];
+}
+
+int32_t controller_get_battery_capacity(controller_id_e_t id) {
+  sim::Controller* controller = controller_get(id);
+  return controller == nullptr ? PROS_ERR : controller->battery_level;
+}
+
+int32_t controller_get_battery_level(controller_id_e_t id) {
+  sim::Controller* controller = controller_get(id);
+  return controller == nullptr ? PROS_ERR : controller->battery_level;
+}
+
+int32_t controller_get_digital(controller_id_e_t id, controller_digital_e_t button) {
+  sim::Controller* controller = controller_get(id);
+  int index = button - E_CONTROLLER_DIGITAL_L1;
+  if (controller == nullptr || index < 0 || index >= sim::Controller::BUTTONS) return 0;
+  return controller->digital[index];
+}
+
+int32_t controller_get_digital_new_press(controller_id_e_t id, controller_digital_e_t button) {
+  sim::Controller* controller = controller_get(id);
+  int index = button - E_CONTROLLER_DIGITAL_L1;
+  if (controller == nullptr || index < 0 || index >= sim::Controller::BUTTONS) return 0;
+  bool pressed = controller->new_press[index];
+  controller->new_press[index] = false;
+  return pressed;
+}
+
+int32_t controller_set_text(controller_id_e_t id, uint8_t line, uint8_t col, const char* str) {
+  sim::Controller* controller = controller_get(id);
+  if (controller == nullptr) return PROS_ERR;
+  if (line > 2 || col > 18) {
+    errno = EINVAL;
+    return PROS_ERR;
+  }
+  char* row = controller->text[line];
+  std::size_t len = std::min(std::strlen(str), (std::size_t)(19 - col));
+  std::memcpy(row + col, str, len);
+  if (std::strlen(row) < col) std::memset(row + std::strlen(row), ' ', col - std::strlen(row));
+  row[19] = '\0';
+  return 1;
+}
+
+int32_t controller_print(controller_id_e_t id, uint8_t line, uint8_t col, const char* fmt, ...) {
+  char buf[20];
+  va_list args;
+  va_start(args, fmt);
+  std::vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  return controller_set_text(id, line, col, buf);
+}
+
+int32_t controller_clear_line(controller_id_e_t id, uint8_t line) {
+  sim::Controller* controller = controller_get(id);
+  if (controller == nullptr) return PROS_ERR;
+  if (line > 2) {
+    errno = EINVAL;
+    return PROS_ERR;
+  }
+  std::memset(controller->text[line], 0, sizeof(controller->text[line]));
+  return 1;
+}
+
+int32_t controller_clear(controller_id_e_t id) {
+  for (uint8_t line = 0; line < 3; line++)
+    if (controller_clear_line(id, line) == PROS_ERR) return PROS_ERR;
+  return 1;
+}
+
+int32_t controller_rumble(controller_id_e_t id, const char* rumble_pattern) {
+  sim::Controller* controller = controller_get(id);
+  if (controller == nullptr) return PROS_ERR;
+  controller->rumble = std::string(rumble_pattern).substr(0, 8);
+  controller->rumble_us = sim::now_us();
+  return 1;
+}
+
+}  // namespace c
+
+inline namespace v5 {
+
+Controller::Controller(controller_id_e_t id) : _id(id) {}
+
+std::int32_t Controller::is_connected(void) { return c::controller_is_connected(_id); }
+std::int32_t Controller::get_analog(controller_analog_e_t channel) { return c::controller_get_analog(_id, channel); }
+std::int32_t Controller::get_battery_capacity(void) { return c::controller_get_battery_capacity(_id); }
+std::int32_t Controller::get_battery_level(void) { return c::controller_get_battery_level(_id); }
+std::int32_t Controller::get_digital(controller_digital_e_t button) { return c::controller_get_digital(_id, button); }
+std::int32_t Controller::get_digital_new_press(controller_digital_e_t button) {
+  return c::controller_get_digital_new_press(_id, button);
+}
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const char* str) {
+  return c::controller_set_text(_id, line, col, str);
+}
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const std::string& str) {
+  return c::controller_set_text(_id, line, col, str.c_str());
+}
+std::int32_t Controller::clear_line(std::uint8_t line) { return c::controller_clear_line(_id, line); }
+std::int32_t Controller::rumble(const char* rumble_pattern) { return c::controller_rumble(_id, rumble_pattern); }
+std::int32_t Controller::clear(void) { return c::controller_clear(_id); }
+
+}  // namespace v5
+
+////
+// Battery, competition and SD card
+
+namespace battery {
+double get_capacity(void) { return sim::devices().battery.capacity; }
+int32_t get_current(void) { return (int32_t)sim::devices().battery.current; }
+double get_temperature(void) { return sim::devices().battery.temperature; }
+int32_t get_voltage(void) { return (int32_t)sim::devices().battery.voltage; }
+}  // namespace battery
+
+namespace competition {
+std::uint8_t get_status(void) {
+  const sim::Competition& comp = sim::devices().competition;
+  return (comp.disabled << 0) | (comp.autonomous << 1) | (comp.connected << 2);
+}
+std::uint8_t is_autonomous(void) { return sim::devices().competition.autonomous; }
+std::uint8_t is_connected(void) { return sim::devices().competition.connected; }
+std::uint8_t is_disabled(void) { return sim::devices().competition.disabled; }
+std::uint8_t is_field_control(void) { return sim::devices().competition.connected; }
+std::uint8_t is_competition_switch(void) { return 0; }
+}  // namespace competition
+
+namespace usd {
+std::int32_t is_installed(void) { return sim::devices().sd_card; }
+std::int32_t list_files(const char* /*path*/, char* /*buffer*/, std::int32_t /*len*/) {
+  errno = ENODEV;
+  return PROS_ERR;
+}
+}  // namespace usd
+
+}  // namespace pros
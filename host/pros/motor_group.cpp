@@ -0,0 +1,267 @@
+// pros::MotorGroup on top of the simulated C motor API
+
+#include "pros/motor_group.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+
+#include "pros/error.h"
+
+namespace pros {
+inline namespace v5 {
+
+MotorGroup::MotorGroup(const std::initializer_list<std::int8_t> ports, const MotorGears gearset, const MotorUnits encoder_units)
+    : MotorGroup(std::vector<std::int8_t>(ports), gearset, encoder_units) {}
+
+MotorGroup::MotorGroup(const std::vector<std::int8_t>& ports, const MotorGears gearset, const MotorUnits encoder_units)
+    : _ports(ports) {
+  for (std::int8_t port : _ports) Motor(port, gearset, encoder_units);
+}
+
+MotorGroup::MotorGroup(AbstractMotor& motor_group) : _ports(motor_group.get_port_all()) {}
+
+// Runs fn on every port, returning PROS_ERR if any of them failed
+template <typename F>
+static std::int32_t each(const std::vector<std::int8_t>& ports, F fn) {
+  std::int32_t out = 1;
+  for (std::int8_t port : ports)
+    if (fn(port) == PROS_ERR) out = PROS_ERR;
+  return out;
+}
+
+// Runs fn on the port at index, or returns error with errno set
+template <typename T, typename F>
+static T at(const std::vector<std::int8_t>& ports, std::uint8_t index, T error, F fn) {
+  if (index >= ports.size()) {
+    errno = ENXIO;
+    return error;
+  }
+  return fn(ports[index]);
+}
+
+// Collects fn for every port
+template <typename F>
+static auto all(const std::vector<std::int8_t>& ports, F fn) {
+  std::vector<decltype(fn(ports[0]))> out;
+  for (std::int8_t port : ports) out.push_back(fn(port));
+  return out;
+}
+
+std::int32_t MotorGroup::move(std::int32_t voltage) const {
+  return each(_ports, [&](std::int8_t p) { return c::motor_move(p, voltage); });
+}
+std::int32_t MotorGroup::move_absolute(const double position, const std::int32_t velocity) const {
+  return each(_ports, [&](std::int8_t p) { return c::motor_move_absolute(p, position, velocity); });
+}
+std::int32_t MotorGroup::move_relative(const double position, const std::int32_t velocity) const {
+  return each(_ports, [&](std::int8_t p) { return c::motor_move_relative(p, position, velocity); });
+}
+std::int32_t MotorGroup::move_velocity(const std::int32_t velocity) const {
+  return each(_ports, [&](std::int8_t p) { return c::motor_move_velocity(p, velocity); });
+}
+std::int32_t MotorGroup::move_voltage(const std::int32_t voltage) const {
+  return each(_ports, [&](std::int8_t p) { return c::motor_move_voltage(p, voltage); });
+}
+std::int32_t MotorGroup::brake(void) const {
+  return each(_ports, [&](std::int8_t p) { return c::motor_brake(p); });
+}
+std::int32_t MotorGroup::modify_profiled_velocity(const std::int32_t velocity) const {
+  return each(_ports, [&](std::int8_t p) { return c::motor_modify_profiled_velocity(p, velocity); });
+}
+
+double MotorGroup::get_target_position(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR_F, c::motor_get_target_position);
+}
+std::vector<double> MotorGroup::get_target_position_all(void) const { return all(_ports, c::motor_get_target_position); }
+std::int32_t MotorGroup::get_target_velocity(const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, c::motor_get_target_velocity);
+}
+std::vector<std::int32_t> MotorGroup::get_target_velocity_all(void) const { return all(_ports, c::motor_get_target_velocity); }
+double MotorGroup::get_actual_velocity(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR_F, c::motor_get_actual_velocity);
+}
+std::vector<double> MotorGroup::get_actual_velocity_all(void) const { return all(_ports, c::motor_get_actual_velocity); }
+std::int32_t MotorGroup::get_current_draw(const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, c::motor_get_current_draw);
+}
+std::vector<std::int32_t> MotorGroup::get_current_draw_all(void) const { return all(_ports, c::motor_get_current_draw); }
+std::int32_t MotorGroup::get_direction(const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, c::motor_get_direction);
+}
+std::vector<std::int32_t> MotorGroup::get_direction_all(void) const { return all(_ports, c::motor_get_direction); }
+double MotorGroup::get_efficiency(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR_F, c::motor_get_efficiency);
+}
+std::vector<double> MotorGroup::get_efficiency_all(void) const { return all(_ports, c::motor_get_efficiency); }
+std::uint32_t MotorGroup::get_faults(const std::uint8_t index) const {
+  return at(_ports, index, (std::uint32_t)PROS_ERR, c::motor_get_faults);
+}
+std::vector<std::uint32_t> MotorGroup::get_faults_all(void) const { return all(_ports, c::motor_get_faults); }
+std::uint32_t MotorGroup::get_flags(const std::uint8_t index) const {
+  return at(_ports, index, (std::uint32_t)PROS_ERR, c::motor_get_flags);
+}
+std::vector<std::uint32_t> MotorGroup::get_flags_all(void) const { return all(_ports, c::motor_get_flags); }
+double MotorGroup::get_position(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR_F, c::motor_get_position);
+}
+std::vector<double> MotorGroup::get_position_all(void) const { return all(_ports, c::motor_get_position); }
+double MotorGroup::get_power(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR_F, c::motor_get_power);
+}
+std::vector<double> MotorGroup::get_power_all(void) const { return all(_ports, c::motor_get_power); }
+std::int32_t MotorGroup::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, [&](std::int8_t p) { return c::motor_get_raw_position(p, timestamp); });
+}
+std::vector<std::int32_t> MotorGroup::get_raw_position_all(std::uint32_t* const timestamp) const {
+  return all(_ports, [&](std::int8_t p) { return c::motor_get_raw_position(p, timestamp); });
+}
+double MotorGroup::get_temperature(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR_F, c::motor_get_temperature);
+}
+std::vector<double> MotorGroup::get_temperature_all(void) const { return all(_ports, c::motor_get_temperature); }
+double MotorGroup::get_torque(const std::uint8_t index) const {
+  return at(_ports, index, PROS_ERR_F, c::motor_get_torque);
+}
+std::vector<double> MotorGroup::get_torque_all(void) const { return all(_ports, c::motor_get_torque); }
+std::int32_t MotorGroup::get_voltage(const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, c::motor_get_voltage);
+}
+std::vector<std::int32_t> MotorGroup::get_voltage_all(void) const { return all(_ports, c::motor_get_voltage); }
+std::int32_t MotorGroup::is_over_current(const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, c::motor_is_over_current);
+}
+std::vector<std::int32_t> MotorGroup::is_over_current_all(void) const { return all(_ports, c::motor_is_over_current); }
+std::int32_t MotorGroup::is_over_temp(const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, c::motor_is_over_temp);
+}
+std::vector<std::int32_t> MotorGroup::is_over_temp_all(void) const { return all(_ports, c::motor_is_over_temp); }
+
+MotorBrake MotorGroup::get_brake_mode(const std::uint8_t index) const {
+  return at(_ports, index, MotorBrake::invalid, [](std::int8_t p) { return (MotorBrake)c::motor_get_brake_mode(p); });
+}
+std::vector<MotorBrake> MotorGroup::get_brake_mode_all(void) const {
+  return all(_ports, [](std::int8_t p) { return (MotorBrake)c::motor_get_brake_mode(p); });
+}
+std::int32_t MotorGroup::get_current_limit(const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, c::motor_get_current_limit);
+}
+std::vector<std::int32_t> MotorGroup::get_current_limit_all(void) const { return all(_ports, c::motor_get_current_limit); }
+MotorUnits MotorGroup::get_encoder_units(const std::uint8_t index) const {
+  return at(_ports, index, MotorUnits::invalid, [](std::int8_t p) { return (MotorUnits)c::motor_get_encoder_units(p); });
+}
+std::vector<MotorUnits> MotorGroup::get_encoder_units_all(void) const {
+  return all(_ports, [](std::int8_t p) { return (MotorUnits)c::motor_get_encoder_units(p); });
+}
+MotorGears MotorGroup::get_gearing(const std::uint8_t index) const {
+  return at(_ports, index, MotorGears::invalid, [](std::int8_t p) { return (MotorGears)c::motor_get_gearing(p); });
+}
+std::vector<MotorGears> MotorGroup::get_gearing_all(void) const {
+  return all(_ports, [](std::int8_t p) { return (MotorGears)c::motor_get_gearing(p); });
+}
+std::vector<std::int8_t> MotorGroup::get_port_all(void) const { return _ports; }
+std::int32_t MotorGroup::get_voltage_limit(const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, c::motor_get_voltage_limit);
+}
+std::vector<std::int32_t> MotorGroup::get_voltage_limit_all(void) const { return all(_ports, c::motor_get_voltage_limit); }
+std::int32_t MotorGroup::is_reversed(const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, [](std::int8_t p) { return (std::int32_t)(p < 0); });
+}
+std::vector<std::int32_t> MotorGroup::is_reversed_all(void) const {
+  return all(_ports, [](std::int8_t p) { return (std::int32_t)(p < 0); });
+}
+
+std::int32_t MotorGroup::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const {
+  return set_brake_mode((motor_brake_mode_e_t)mode, index);
+}
+std::int32_t MotorGroup::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, [&](std::int8_t p) { return c::motor_set_brake_mode(p, mode); });
+}
+std::int32_t MotorGroup::set_brake_mode_all(const MotorBrake mode) const { return set_brake_mode_all((motor_brake_mode_e_t)mode); }
+std::int32_t MotorGroup::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const {
+  return each(_ports, [&](std::int8_t p) { return c::motor_set_brake_mode(p, mode); });
+}
+std::int32_t MotorGroup::set_current_limit(const std::int32_t limit, const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, [&](std::int8_t p) { return c::motor_set_current_limit(p, limit); });
+}
+std::int32_t MotorGroup::set_current_limit_all(const std::int32_t limit) const {
+  return each(_ports, [&](std::int8_t p) { return c::motor_set_current_limit(p, limit); });
+}
+std::int32_t MotorGroup::set_encoder_units(const MotorUnits units, const std::uint8_t index) const {
+  return set_encoder_units((motor_encoder_units_e_t)units, index);
+}
+std::int32_t MotorGroup::set_encoder_units(const pros::motor_encoder_units_e_t units, const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, [&](std::int8_t p) { return c::motor_set_encoder_units(p, units); });
+}
+std::int32_t MotorGroup::set_encoder_units_all(const MotorUnits units) const { return set_encoder_units_all((motor_encoder_units_e_t)units); }
+std::int32_t MotorGroup::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const {
+  return each(_ports, [&](std::int8_t p) { return c::motor_set_encoder_units(p, units); });
+}
+std::int32_t MotorGroup::set_gearing(std::vector<pros::motor_gearset_e_t> gearsets) const {
+  std::int32_t out = 1;
+  for (std::size_t i = 0; i < gearsets.size() && i < _ports.size(); i++)
+    if (c::motor_set_gearing(_ports[i], gearsets[i]) == PROS_ERR) out = PROS_ERR;
+  return out;
+}
+std::int32_t MotorGroup::set_gearing(const pros::motor_gearset_e_t gearset, const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, [&](std::int8_t p) { return c::motor_set_gearing(p, gearset); });
+}
+std::int32_t MotorGroup::set_gearing(std::vector<MotorGears> gearsets) const {
+  std::vector<pros::motor_gearset_e_t> out;
+  for (MotorGears g : gearsets) out.push_back((motor_gearset_e_t)g);
+  return set_gearing(out);
+}
+std::int32_t MotorGroup::set_gearing(const MotorGears gearset, const std::uint8_t index) const {
+  return set_gearing((motor_gearset_e_t)gearset, index);
+}
+std::int32_t MotorGroup::set_gearing_all(const MotorGears gearset) const { return set_gearing_all((motor_gearset_e_t)gearset); }
+std::int32_t MotorGroup::set_gearing_all(const pros::motor_gearset_e_t gearset) const {
+  return each(_ports, [&](std::int8_t p) { return c::motor_set_gearing(p, gearset); });
+}
+std::int32_t MotorGroup::set_reversed(const bool reverse, const std::uint8_t index) {
+  if (index >= _ports.size()) {
+    errno = ENXIO;
+    return PROS_ERR;
+  }
+  _ports[index] = reverse ? -std::abs(_ports[index]) : std::abs(_ports[index]);
+  return 1;
+}
+std::int32_t MotorGroup::set_reversed_all(const bool reverse) {
+  for (std::uint8_t i = 0; i < _ports.size(); i++) set_reversed(reverse, i);
+  return 1;
+}
+std::int32_t MotorGroup::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, [&](std::int8_t p) { return c::motor_set_voltage_limit(p, limit); });
+}
+std::int32_t MotorGroup::set_voltage_limit_all(const std::int32_t limit) const {
+  return each(_ports, [&](std::int8_t p) { return c::motor_set_voltage_limit(p, limit); });
+}
+std::int32_t MotorGroup::set_zero_position(const double position, const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, [&](std::int8_t p) { return c::motor_set_zero_position(p, position); });
+}
+std::int32_t MotorGroup::set_zero_position_all(const double position) const {
+  return each(_ports, [&](std::int8_t p) { return c::motor_set_zero_position(p, position); });
+}
+std::int32_t MotorGroup::tare_position(const std::uint8_t index) const {
+  return at(_ports, index, (std::int32_t)PROS_ERR, c::motor_tare_position);
+}
+std::int32_t MotorGroup::tare_position_all(void) const { return each(_ports, c::motor_tare_position); }
+
+std::int8_t MotorGroup::size(void) const { return _ports.size(); }
+
+std::int8_t MotorGroup::get_port(const std::uint8_t index) const {
+  return at(_ports, index, (std::int8_t)PROS_ERR_BYTE, [](std::int8_t p) { return p; });
+}
+
+void MotorGroup::operator+=(AbstractMotor& other) { append(other); }
+
+void MotorGroup::append(AbstractMotor& other) {
+  for (std::int8_t port : other.get_port_all()) _ports.push_back(port);
+}
+
+void MotorGroup::erase_port(std::int8_t port) {
+  _ports.erase(std::remove_if(_ports.begin(), _ports.end(), [&](std::int8_t p) { return std::abs(p) == std::abs(port); }), _ports.end());
+}
+
+}  // namespace v5
+}  // namespace pros
@@ -0,0 +1,522 @@
+// pros/motors.h and pros::Motor on the simulated devices
+
+#include "pros/motors.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+
+#include "pros/device.hpp"
+#include "pros/error.h"
+#include "sim/devices.hpp"
+#include "sim/scheduler.hpp"
+
+namespace sim = pls::sim;
+
+namespace pros {
+namespace c {
+
+// The motor on a port, or nullptr with errno set like PROS does
+static sim::Motor* motor_get(int8_t port) {
+  sim::Motor* m = sim::devices().motor(port);
+  if (m == nullptr) errno = std::abs(port) > sim::SMART_PORTS || port == 0 ? ENXIO : ENODEV;
+  return m;
+}
+
+// The motor on a port for a new command, noted for the scheduler's race check
+static sim::Motor* motor_command(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m != nullptr) sim::shared_write(m, "motor", std::abs(port));
+  return m;
+}
+
+static double sign(int8_t port) { return port < 0 ? -1.0 : 1.0; }
+
+static double gear_rpm(motor_gearset_e_t gearset) {
+  return gearset == E_MOTOR_GEARSET_36 ? 100.0 : gearset == E_MOTOR_GEARSET_06 ? 600.0 : 200.0;
+}
+
+int32_t motor_move(int8_t port, int32_t voltage) {
+  if (voltage > 127) voltage = 127;
+  if (voltage < -127) voltage = -127;
+  return motor_move_voltage(port, voltage * 12000 / 127);
+}
+
+int32_t motor_brake(int8_t port) {
+  sim::Motor* m = motor_command(port);
+  if (m == nullptr) return PROS_ERR;
+  m->mode = sim::Motor::STOP;
+  m->hold_position = m->position;
+  return 1;
+}
+
+int32_t motor_move_absolute(int8_t port, double position, const int32_t velocity) {
+  sim::Motor* m = motor_command(port);
+  if (m == nullptr) return PROS_ERR;
+  m->mode = sim::Motor::ABSOLUTE;
+  m->target_position = sign(port) * position / m->units_per_rev() + m->zero;
+  m->profiled_velocity = std::abs(velocity);
+  return 1;
+}
+
+int32_t motor_move_relative(int8_t port, double position, const int32_t velocity) {
+  sim::Motor* m = motor_command(port);
+  if (m == nullptr) return PROS_ERR;
+  double base = m->mode == sim::Motor::ABSOLUTE ? m->target_position : m->position;
+  m->mode = sim::Motor::ABSOLUTE;
+  m->target_position = base + sign(port) * position / m->units_per_rev();
+  m->profiled_velocity = std::abs(velocity);
+  return 1;
+}
+
+int32_t motor_move_velocity(int8_t port, const int32_t velocity) {
+  sim::Motor* m = motor_command(port);
+  if (m == nullptr) return PROS_ERR;
+  if (velocity == 0) return motor_brake(port);
+  m->mode = sim::Motor::VELOCITY;
+  m->command = sign(port) * velocity;
+  return 1;
+}
+
+int32_t motor_move_voltage(int8_t port, const int32_t voltage) {
+  sim::Motor* m = motor_command(port);
+  if (m == nullptr) return PROS_ERR;
+  // Zero volts lets the brake mode take over, like the V5 firmware
+  if (voltage == 0) {
+    if (m->mode != sim::Motor::STOP) m->hold_position = m->position;
+    m->mode = sim::Motor::STOP;
+    return 1;
+  }
+  m->mode = sim::Motor::VOLTAGE;
+  m->command = sign(port) * voltage;
+  return 1;
+}
+
+int32_t motor_modify_profiled_velocity(int8_t port, const int32_t velocity) {
+  sim::Motor* m = motor_command(port);
+  if (m == nullptr) return PROS_ERR;
+  m->profiled_velocity = std::abs(velocity);
+  return 1;
+}
+
+double motor_get_target_position(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR_F;
+  return sign(port) * (m->target_position - m->zero) * m->units_per_rev();
+}
+
+int32_t motor_get_target_velocity(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  return m->mode == sim::Motor::VELOCITY ? (int32_t)(sign(port) * m->command) : 0;
+}
+
+double motor_get_actual_velocity(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR_F;
+  return sign(port) * m->velocity;
+}
+
+int32_t motor_get_current_draw(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  return (int32_t)std::fabs(m->current);
+}
+
+int32_t motor_get_direction(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  return sign(port) * m->velocity < 0 ? -1 : 1;
+}
+
+double motor_get_efficiency(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR_F;
+  double in = std::fabs(m->voltage * m->current) / 1e6;
+  double out = std::fabs(m->torque * m->velocity * 2.0 * M_PI / 60.0);
+  return in > 1e-6 ? 100.0 * std::fmin(out / in, 1.0) : 0.0;
+}
+
+int32_t motor_is_over_current(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  return std::fabs(m->current) >= std::fmin(m->current_limit, sim::MOTOR_MAX_MA) - 1.0;
+}
+
+int32_t motor_is_over_temp(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  return m->temperature >= 55.0;
+}
+
+uint32_t motor_get_faults(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  uint32_t faults = 0;
+  if (motor_is_over_temp(port)) faults |= E_MOTOR_FAULT_MOTOR_OVER_TEMP;
+  if (motor_is_over_current(port)) faults |= E_MOTOR_FAULT_OVER_CURRENT;
+  return faults;
+}
+
+uint32_t motor_get_flags(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  uint32_t flags = 0;
+  if (std::fabs(m->velocity) < 0.5) flags |= E_MOTOR_FLAGS_ZERO_VELOCITY;
+  if (m->position == m->zero) flags |= E_MOTOR_FLAGS_ZERO_POSITION;
+  return flags;
+}
+
+int32_t motor_get_raw_position(int8_t port, uint32_t* const timestamp) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  if (timestamp != nullptr) *timestamp = sim::now_ms();
+  // Raw counts are always 50 per revolution of the motor inside the cartridge
+  return (int32_t)std::lround(sign(port) * m->position * 50.0 * 3600.0 / m->cartridge_rpm);
+}
+
+double motor_get_position(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR_F;
+  return sign(port) * (m->position - m->zero) * m->units_per_rev();
+}
+
+double motor_get_power(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR_F;
+  return std::fabs(m->voltage * m->current) / 1e6;
+}
+
+double motor_get_temperature(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR_F;
+  return std::round(m->temperature / 5.0) * 5.0;  // The motor reports in 5C steps
+}
+
+double motor_get_torque(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR_F;
+  return sign(port) * m->torque;
+}
+
+int32_t motor_get_voltage(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  return (int32_t)(sign(port) * m->voltage);
+}
+
+int32_t motor_set_zero_position(int8_t port, const double position) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  m->zero = m->position - sign(port) * position / m->units_per_rev();
+  return 1;
+}
+
+int32_t motor_tare_position(int8_t port) { return motor_set_zero_position(port, 0.0); }
+
+int32_t motor_set_brake_mode(int8_t port, const motor_brake_mode_e_t mode) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  if (mode == E_MOTOR_BRAKE_HOLD && m->brake_mode != E_MOTOR_BRAKE_HOLD) m->hold_position = m->position;
+  m->brake_mode = mode;
+  return 1;
+}
+
+int32_t motor_set_current_limit(int8_t port, const int32_t limit) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  m->current_limit = limit;
+  return 1;
+}
+
+int32_t motor_set_encoder_units(int8_t port, const motor_encoder_units_e_t units) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  m->encoder_units = units;
+  return 1;
+}
+
+int32_t motor_set_gearing(int8_t port, const motor_gearset_e_t gearset) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  if (!m->cartridge_fixed) m->cartridge_rpm = gear_rpm(gearset);
+  return 1;
+}
+
+int32_t motor_set_voltage_limit(int8_t port, const int32_t limit) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  m->voltage_limit = limit;
+  return 1;
+}
+
+motor_brake_mode_e_t motor_get_brake_mode(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return E_MOTOR_BRAKE_INVALID;
+  return (motor_brake_mode_e_t)m->brake_mode;
+}
+
+int32_t motor_get_current_limit(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  return m->current_limit;
+}
+
+motor_encoder_units_e_t motor_get_encoder_units(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return E_MOTOR_ENCODER_INVALID;
+  return (motor_encoder_units_e_t)m->encoder_units;
+}
+
+motor_gearset_e_t motor_get_gearing(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return E_MOTOR_GEARSET_INVALID;
+  return m->cartridge_rpm == 100.0 ? E_MOTOR_GEARSET_36 : m->cartridge_rpm == 600.0 ? E_MOTOR_GEARSET_06 : E_MOTOR_GEARSET_18;
+}
+
+int32_t motor_get_voltage_limit(int8_t port) {
+  sim::Motor* m = motor_get(port);
+  if (m == nullptr) return PROS_ERR;
+  return m->voltage_limit;
+}
+
+}  // namespace c
+
+inline namespace v5 {
+
+Device::Device(const std::uint8_t port) : _port(port), _deviceType(DeviceType::undefined) {}
+
+std::uint8_t Device::get_port(void) const { return _port; }
+
+bool Device::is_installed() { return sim::devices().type[_port] != sim::NONE; }
+
+pros::DeviceType Device::get_plugged_type() const { return get_plugged_type(_port); }
+
+pros::DeviceType Device::get_plugged_type(std::uint8_t port) {
+  if (port < 1 || port > sim::SMART_PORTS) return DeviceType::undefined;
+  switch (sim::devices().type[port]) {
+    case sim::MOTOR:
+      return DeviceType::motor;
+    case sim::IMU:
+      return DeviceType::imu;
+    case sim::ROTATION:
+      return DeviceType::rotation;
+    case sim::ADI:
+      return DeviceType::adi;
+    default:
+      return DeviceType::none;
+  }
+}
+
+std::vector<Device> Device::get_all_devices(pros::DeviceType device_type) {
+  std::vector<Device> out;
+  for (std::uint8_t port = 1; port <= sim::SMART_PORTS; port++)
+    if (get_plugged_type(port) == device_type) out.push_back(Device(port));
+  return out;
+}
+
+Motor::Motor(const std::int8_t port, const MotorGears gearset, const MotorUnits encoder_units)
+    : Device(std::abs(port), DeviceType::motor), _port(port) {
+  sim::devices().motor(port);
+  if (gearset != MotorGears::invalid) set_gearing(gearset);
+  if (encoder_units != MotorUnits::invalid) set_encoder_units(encoder_units);
+}
+
+std::int32_t Motor::move(std::int32_t voltage) const { return c::motor_move(_port, voltage); }
+std::int32_t Motor::move_absolute(const double position, const std::int32_t velocity) const { return c::motor_move_absolute(_port, position, velocity); }
+std::int32_t Motor::move_relative(const double position, const std::int32_t velocity) const { return c::motor_move_relative(_port, position, velocity); }
+std::int32_t Motor::move_velocity(const std::int32_t velocity) const { return c::motor_move_velocity(_port, velocity); }
+std::int32_t Motor::move_voltage(const std::int32_t voltage) const { return c::motor_move_voltage(_port, voltage); }
+std::int32_t Motor::brake(void) const { return c::motor_brake(_port); }
+std::int32_t Motor::modify_profiled_velocity(const std::int32_t velocity) const { return c::motor_modify_profiled_velocity(_port, velocity); }
+
+// A single motor only has index 0
+#define MOTOR_INDEX_CHECK(error) \
+  if (index != 0) {              \
+    errno = EOVERFLOW;           \
+    return error;                \
+  }
+
+double Motor::get_target_position(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR_F);
+  return c::motor_get_target_position(_port);
+}
+std::int32_t Motor::get_target_velocity(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_get_target_velocity(_port);
+}
+double Motor::get_actual_velocity(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR_F);
+  return c::motor_get_actual_velocity(_port);
+}
+std::int32_t Motor::get_current_draw(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_get_current_draw(_port);
+}
+std::int32_t Motor::get_direction(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_get_direction(_port);
+}
+double Motor::get_efficiency(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR_F);
+  return c::motor_get_efficiency(_port);
+}
+std::uint32_t Motor::get_faults(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_get_faults(_port);
+}
+std::uint32_t Motor::get_flags(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_get_flags(_port);
+}
+double Motor::get_position(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR_F);
+  return c::motor_get_position(_port);
+}
+double Motor::get_power(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR_F);
+  return c::motor_get_power(_port);
+}
+std::int32_t Motor::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_get_raw_position(_port, timestamp);
+}
+double Motor::get_temperature(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR_F);
+  return c::motor_get_temperature(_port);
+}
+double Motor::get_torque(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR_F);
+  return c::motor_get_torque(_port);
+}
+std::int32_t Motor::get_voltage(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_get_voltage(_port);
+}
+std::int32_t Motor::is_over_current(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_is_over_current(_port);
+}
+std::int32_t Motor::is_over_temp(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_is_over_temp(_port);
+}
+MotorBrake Motor::get_brake_mode(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(MotorBrake::invalid);
+  return (MotorBrake)c::motor_get_brake_mode(_port);
+}
+std::int32_t Motor::get_current_limit(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_get_current_limit(_port);
+}
+MotorUnits Motor::get_encoder_units(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(MotorUnits::invalid);
+  return (MotorUnits)c::motor_get_encoder_units(_port);
+}
+MotorGears Motor::get_gearing(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(MotorGears::invalid);
+  return (MotorGears)c::motor_get_gearing(_port);
+}
+std::int32_t Motor::get_voltage_limit(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_get_voltage_limit(_port);
+}
+std::int32_t Motor::is_reversed(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return _port < 0;
+}
+std::int32_t Motor::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_set_brake_mode(_port, (motor_brake_mode_e_t)mode);
+}
+std::int32_t Motor::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_set_brake_mode(_port, mode);
+}
+std::int32_t Motor::set_current_limit(const std::int32_t limit, const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_set_current_limit(_port, limit);
+}
+std::int32_t Motor::set_encoder_units(const MotorUnits units, const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_set_encoder_units(_port, (motor_encoder_units_e_t)units);
+}
+std::int32_t Motor::set_encoder_units(const pros::motor_encoder_units_e_t units, const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_set_encoder_units(_port, units);
+}
+std::int32_t Motor::set_gearing(const MotorGears gearset, const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_set_gearing(_port, (motor_gearset_e_t)gearset);
+}
+std::int32_t Motor::set_gearing(const pros::motor_gearset_e_t gearset, const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_set_gearing(_port, gearset);
+}
+std::int32_t Motor::set_reversed(const bool reverse, const std::uint8_t index) {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  _port = reverse ? -std::abs(_port) : std::abs(_port);
+  return 1;
+}
+std::int32_t Motor::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_set_voltage_limit(_port, limit);
+}
+std::int32_t Motor::set_zero_position(const double position, const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_set_zero_position(_port, position);
+}
+std::int32_t Motor::tare_position(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR);
+  return c::motor_tare_position(_port);
+}
+std::int8_t Motor::get_port(const std::uint8_t index) const {
+  MOTOR_INDEX_CHECK(PROS_ERR_BYTE);
+  return _port;
+}
+std::int8_t Motor::size(void) const { return 1; }
+
+std::vector<Motor> Motor::get_all_devices() {
+  std::vector<Motor> out;
+  for (std::int8_t port = 1; port <= sim::SMART_PORTS; port++)
+    if (sim::devices().type[port] == sim::MOTOR) out.push_back(Motor(port));
+  return out;
+}
+
+std::vector<double> Motor::get_target_position_all(void) const { return {get_target_position()}; }
+std::vector<std::int32_t> Motor::get_target_velocity_all(void) const { return {get_target_velocity()}; }
+std::vector<double> Motor::get_actual_velocity_all(void) const { return {get_actual_velocity()}; }
+std::vector<std::int32_t> Motor::get_current_draw_all(void) const { return {get_current_draw()}; }
+std::vector<std::int32_t> Motor::get_direction_all(void) const { return {get_direction()}; }
+std::vector<double> Motor::get_efficiency_all(void) const { return {get_efficiency()}; }
+std::vector<std::uint32_t> Motor::get_faults_all(void) const { return {get_faults()}; }
+std::vector<std::uint32_t> Motor::get_flags_all(void) const { return {get_flags()}; }
+std::vector<double> Motor::get_position_all(void) const { return {get_position()}; }
+std::vector<double> Motor::get_power_all(void) const { return {get_power()}; }
+std::vector<std::int32_t> Motor::get_raw_position_all(std::uint32_t* const timestamp) const { return {get_raw_position(timestamp)}; }
+std::vector<double> Motor::get_temperature_all(void) const { return {get_temperature()}; }
+std::vector<double> Motor::get_torque_all(void) const { return {get_torque()}; }
+std::vector<std::int32_t> Motor::get_voltage_all(void) const { return {get_voltage()}; }
+std::vector<std::int32_t> Motor::is_over_current_all(void) const { return {is_over_current()}; }
+std::vector<std::int32_t> Motor::is_over_temp_all(void) const { return {is_over_temp()}; }
+std::vector<MotorBrake> Motor::get_brake_mode_all(void) const { return {get_brake_mode()}; }
+std::vector<std::int32_t> Motor::get_current_limit_all(void) const { return {get_current_limit()}; }
+std::vector<MotorUnits> Motor::get_encoder_units_all(void) const { return {get_encoder_units()}; }
+std::vector<MotorGears> Motor::get_gearing_all(void) const { return {get_gearing()}; }
+std::vector<std::int8_t> Motor::get_port_all(void) const { return {_port}; }
+std::vector<std::int32_t> Motor::get_voltage_limit_all(void) const { return {get_voltage_limit()}; }
+std::vector<std::int32_t> Motor::is_reversed_all(void) const { return {is_reversed()}; }
+std::int32_t Motor::set_brake_mode_all(const MotorBrake mode) const { return set_brake_mode(mode); }
+std::int32_t Motor::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const { return set_brake_mode(mode); }
+std::int32_t Motor::set_current_limit_all(const std::int32_t limit) const { return set_current_limit(limit); }
+std::int32_t Motor::set_encoder_units_all(const MotorUnits units) const { return set_encoder_units(units); }
+std::int32_t Motor::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const { return set_encoder_units(units); }
+std::int32_t Motor::set_gearing_all(const MotorGears gearset) const { return set_gearing(gearset); }
+std::int32_t Motor::set_gearing_all(const pros::motor_gearset_e_t gearset) const { return set_gearing(gearset); }
+std::int32_t Motor::set_reversed_all(const bool reverse) { return set_reversed(reverse); }
+std::int32_t Motor::set_voltage_limit_all(const std::int32_t limit) const { return set_voltage_limit(limit); }
+std::int32_t Motor::set_zero_position_all(const double position) const { return set_zero_position(position); }
+std::int32_t Motor::tare_position_all(void) const { return tare_position(); }
+
+}  // namespace v5
+}  // namespace pros
@@ -0,0 +1,147 @@
+// pros/rtos.h and pros/rtos.hpp on the host scheduler
+
+#include "pros/rtos.hpp"
+
+#include <cerrno>
+#include <system_error>
+
+#include "sim/scheduler.hpp"
+
+namespace sim = pls::sim;
+
+namespace pros {
+namespace c {
+
+static sim::Task* handle(task_t task) {
+  return task == nullptr ? sim::task_current() : static_cast<sim::Task*>(task);
+}
+
+uint32_t millis(void) { return sim::now_ms(); }
+
+uint64_t micros(void) { return sim::now_us(); }
+
+task_t task_create(task_fn_t function, void* const parameters, uint32_t prio, const uint16_t stack_depth, const char* const name) {
+  (void)stack_depth;
+  return sim::task_create(function, parameters, prio, name);
+}
+
+void task_delete(task_t task) { sim::task_delete(handle(task)); }
+
+void task_delay(const uint32_t milliseconds) { sim::task_sleep_until(sim::now_us() + milliseconds * 1000ull); }
+
+void delay(const uint32_t milliseconds) { task_delay(milliseconds); }
+
+void task_delay_until(uint32_t* const prev_time, const uint32_t delta) {
+  *prev_time += delta;
+  sim::task_sleep_until(*prev_time * 1000ull);
+}
+
+uint32_t task_get_priority(task_t task) { return sim::task_priority_get(handle(task)); }
+
+void task_set_priority(task_t task, uint32_t prio) { sim::task_priority_set(handle(task), prio); }
+
+task_state_e_t task_get_state(task_t task) { return (task_state_e_t)sim::task_state_get(handle(task)); }
+
+void task_suspend(task_t task) { sim::task_suspend(handle(task)); }
+
+void task_resume(task_t task) { sim::task_resume(handle(task)); }
+
+uint32_t task_get_count(void) { return sim::task_count(); }
+
+char* task_get_name(task_t task) { return const_cast<char*>(sim::task_name_get(handle(task))); }
+
+task_t task_get_by_name(const char* name) { return sim::task_by_name(name); }
+
+task_t task_get_current() { return sim::task_current(); }
+
+uint32_t task_notify(task_t task) { return sim::task_notify(handle(task), 0, E_NOTIFY_ACTION_INCR, nullptr); }
+
+void task_join(task_t task) { sim::task_join(handle(task)); }
+
+uint32_t task_notify_ext(task_t task, uint32_t value, notify_action_e_t action, uint32_t* prev_value) {
+  return sim::task_notify(handle(task), value, action, prev_value);
+}
+
+uint32_t task_notify_take(bool clear_on_exit, uint32_t timeout) { return sim::task_notify_take(clear_on_exit, timeout); }
+
+bool task_notify_clear(task_t task) { return sim::task_notify_clear(handle(task)); }
+
+mutex_t mutex_create(void) { return sim::mutex_create(); }
+
+bool mutex_take(mutex_t mutex, uint32_t timeout) { return sim::mutex_take(static_cast<sim::Mutex*>(mutex), timeout); }
+
+bool mutex_give(mutex_t mutex) { return sim::mutex_give(static_cast<sim::Mutex*>(mutex)); }
+
+void mutex_delete(mutex_t mutex) { sim::mutex_delete(static_cast<sim::Mutex*>(mutex)); }
+
+}  // namespace c
+
+inline namespace rtos {
+
+Task::Task(task_fn_t function, void* parameters, std::uint32_t prio, std::uint16_t stack_depth, const char* name)
+    : task(c::task_create(function, parameters, prio, stack_depth, name)) {}
+
+Task::Task(task_fn_t function, void* parameters, const char* name)
+    : Task(function, parameters, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name) {}
+
+Task::Task(task_t task) : task(task) {}
+
+Task Task::current() { return Task(c::task_get_current()); }
+
+Task& Task::operator=(const task_t in) {
+  task = in;
+  return *this;
+}
+
+void Task::remove() { c::task_delete(task); }
+
+std::uint32_t Task::get_priority() { return c::task_get_priority(task); }
+
+void Task::set_priority(std::uint32_t prio) { c::task_set_priority(task, prio); }
+
+std::uint32_t Task::get_state() { return c::task_get_state(task); }
+
+void Task::suspend() { c::task_suspend(task); }
+
+void Task::resume() { c::task_resume(task); }
+
+const char* Task::get_name() { return c::task_get_name(task); }
+
+std::uint32_t Task::notify() { return c::task_notify(task); }
+
+void Task::join() { c::task_join(task); }
+
+std::uint32_t Task::notify_ext(std::uint32_t value, notify_action_e_t action, std::uint32_t* prev_value) {
+  return c::task_notify_ext(task, value, action, prev_value);
+}
+
+std::uint32_t Task::notify_take(bool clear_on_exit, std::uint32_t timeout) { return c::task_notify_take(clear_on_exit, timeout); }
+
+bool Task::notify_clear() { return c::task_notify_clear(task); }
+
+void Task::delay(const std::uint32_t milliseconds) { c::task_delay(milliseconds); }
+
+void Task::delay_until(std::uint32_t* const prev_time, const std::uint32_t delta) { c::task_delay_until(prev_time, delta); }
+
+std::uint32_t Task::get_count() { return c::task_get_count(); }
+
+Clock::time_point Clock::now() { return time_point{duration{c::millis()}}; }
+
+Mutex::Mutex() : mutex(c::mutex_create(), c::mutex_delete) {}
+
+bool Mutex::take() { return c::mutex_take(mutex.get(), TIMEOUT_MAX); }
+
+bool Mutex::take(std::uint32_t timeout) { return c::mutex_take(mutex.get(), timeout); }
+
+bool Mutex::give() { return c::mutex_give(mutex.get()); }
+
+void Mutex::lock() {
+  if (!take(TIMEOUT_MAX)) throw std::system_error(errno, std::system_category(), "Cannot obtain lock!");
+}
+
+void Mutex::unlock() { give(); }
+
+bool Mutex::try_lock() { return take(0); }
+
+}  // namespace rtos
+}  // namespace pros
@@ -0,0 +1,180 @@
+#include "sim/devices.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "sim/scheduler.hpp"
+
+namespace pls {
+namespace sim {
+
+// 11W motor: 3.67A stall current at 12V without the limit, 2.1Nm at 2.5A on a 100rpm cartridge
+constexpr double WINDING_OHMS = 12.0 / 3.67;
+constexpr double RED_NM_PER_A = 2.1 / 2.5;
+constexpr double THERMAL_MASS = 100.0;  // J/K
+constexpr double THERMAL_RESISTANCE = 2.0;  // K/W
+constexpr double AMBIENT = 25.0;
+
+static double clamp(double input, double limit) { return std::max(-limit, std::min(limit, input)); }
+
+static double nm_per_amp(const Motor& m) { return RED_NM_PER_A * 100.0 / m.cartridge_rpm * m.strength; }
+
+double Motor::stall_torque() const { return nm_per_amp(*this) * std::min<double>(current_limit, MOTOR_MAX_MA) / 1000.0; }
+
+double Motor::units_per_rev() const {
+  switch (encoder_units) {
+    case 1:  // Rotations
+      return 1.0;
+    case 2:  // Counts
+      return cartridge_rpm == 100.0 ? 1800.0 : cartridge_rpm == 600.0 ? 300.0 : 900.0;
+    default:  // Degrees
+      return 360.0;
+  }
+}
+
+// The motor's own velocity loop, roughly as stiff as the V5 firmware's
+static double velocity_loop(const Motor& m, double target_rpm) {
+  double feedforward = target_rpm / m.free_rpm() * MOTOR_MAX_MV;
+  double feedback = (target_rpm - m.velocity) / m.free_rpm() * MOTOR_MAX_MV * 2.0;
+  return feedforward + feedback;
+}
+
+static double position_loop(const Motor& m, double target_rev, double max_rpm) {
+  double target_rpm = clamp((target_rev - m.position) * 600.0, max_rpm);
+  return velocity_loop(m, target_rpm);
+}
+
+double Motor::voltage_commanded() const {
+  double out = 0.0;
+  switch (mode) {
+    case VOLTAGE:
+      out = command;
+      break;
+    case VELOCITY:
+      out = velocity_loop(*this, command);
+      break;
+    case ABSOLUTE:
+      out = position_loop(*this, target_position, profiled_velocity);
+      break;
+    case STOP:
+      out = brake_mode == 2 ? position_loop(*this, hold_position, free_rpm()) : 0.0;
+      break;
+  }
+  double limit = std::min(MOTOR_MAX_MV, devices().battery.voltage - 300.0);
+  if (voltage_limit > 0) limit = std::min<double>(limit, voltage_limit);
+  return clamp(out, limit);
+}
+
+double Motor::torque_at(double rpm) {
+  double ma;
+  if (mode == STOP && brake_mode == 0) {
+    ma = 0.0;  // Coast leaves the windings open
+  } else {
+    double back_emf = MOTOR_MAX_MV * rpm / free_rpm();
+    ma = (voltage - back_emf) / WINDING_OHMS;
+    ma = clamp(ma, std::min<double>(current_limit, MOTOR_MAX_MA));
+  }
+  double nm = nm_per_amp(*this) * ma / 1000.0;
+  double drag = rpm > 0.5 ? friction : rpm < -0.5 ? -friction : friction * rpm / 0.5;
+  current = ma;
+  torque = nm - drag;
+  return torque;
+}
+
+double Motor::torque_slope(double rpm) const {
+  if (mode == STOP && brake_mode == 0) return 0.0;
+  double back_emf = MOTOR_MAX_MV * rpm / free_rpm();
+  double ma = (voltage - back_emf) / WINDING_OHMS;
+  if (std::fabs(ma) >= std::min<double>(current_limit, MOTOR_MAX_MA)) return 0.0;
+  return back_emf_slope();
+}
+
+double Motor::back_emf_slope() const { return nm_per_amp(*this) / 1000.0 * MOTOR_MAX_MV / free_rpm() / WINDING_OHMS; }
+
+bool Imu::calibrating() const { return now_us() < calibrated_us; }
+
+double Imu::rotation() const { return yaw * scale + drift_total - rotation_offset; }
+
+void Controller::button_set(int index, bool pressed) {
+  if (index < 0 || index >= BUTTONS) return;
+  if (pressed && !digital[index]) new_press[index] = true;
+  digital[index] = pressed;
+}
+
+template <typename T>
+static T* claim(Devices& d, int port, device_type type, T* table) {
+  port = std::abs(port);
+  if (port < 1 || port > SMART_PORTS) return nullptr;
+  if (d.type[port] == NONE) d.type[port] = type;
+  return d.type[port] == type ? &table[port] : nullptr;
+}
+
+Motor* Devices::motor(int port) { return claim(*this, port, MOTOR, motors); }
+
+Imu* Devices::imu(int port) { return claim(*this, port, IMU, imus); }
+
+Rotation* Devices::rotation(int port) { return claim(*this, port, ROTATION, rotations); }
+
+Adi* Devices::adi_get(int port) {
+  port = std::abs(port);
+  if (port == ADI_SMART_PORT) return &adi[port];
+  if (port < 1 || port > SMART_PORTS) return nullptr;
+  if (type[port] == NONE) type[port] = ADI;
+  return type[port] == ADI ? &adi[port] : nullptr;
+}
+
+void Devices::step(double dt) {
+  // Voltages hold through the step unless a motor's own loop has to react inside it
+  int steps = 1;
+  for (int port = 1; port <= SMART_PORTS; port++)
+    if (type[port] == MOTOR && motors[port].looping() && dt > STEP_FINE) steps = (int)std::ceil(dt / STEP_FINE - 1e-9);
+  for (int i = 0; i < steps; i++) step_once(dt / steps);
+}
+
+void Devices::step_once(double dt) {
+  double total_ma = 500.0;  // Brain and radio
+
+  for (int port = 1; port <= SMART_PORTS; port++) {
+    if (type[port] != MOTOR) continue;
+    Motor& m = motors[port];
+    m.voltage = m.voltage_commanded();
+  }
+
+  for (Plant* plant : plants) plant->step(dt);
+
+  for (int port = 1; port <= SMART_PORTS; port++) {
+    if (type[port] == IMU) {
+      Imu& imu = imus[port];
+      if (!imu.calibrating()) imu.drift_total += imu.drift * dt;
+      continue;
+    }
+    if (type[port] != MOTOR) continue;
+    Motor& m = motors[port];
+    if (!m.driven) {
+      // Linearized implicit Euler, the back EMF is too stiff for a plain step on a 100rpm cartridge
+      double to_rad = 2.0 * M_PI / 60.0;
+      double nm = m.torque_at(m.velocity);
+      double slope = m.torque_slope(m.velocity) / to_rad;  // Nm per rad/s
+      double omega = m.velocity * to_rad;
+      omega += dt * nm / (m.load_inertia + dt * slope);
+      m.velocity = omega / to_rad;
+      m.position += m.velocity / 60.0 * dt;
+    }
+    m.torque_at(m.velocity);
+
+    double watts = m.current * m.current / 1e6 * WINDING_OHMS;
+    m.temperature += (watts - (m.temperature - AMBIENT) / THERMAL_RESISTANCE) / THERMAL_MASS * dt;
+    total_ma += std::fabs(m.current * m.voltage) / std::max(battery.voltage, 1.0);
+  }
+
+  battery.current = total_ma;
+  battery.voltage = battery.open_voltage - battery.resistance * total_ma;
+}
+
+Devices& devices() {
+  static Devices brain;
+  return brain;
+}
+
+}  // namespace sim
+}  // namespace pls
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pls {
+namespace sim {
+/**
+ * Simulated V5 devices behind the host pros:: classes.
+ *
+ * Each smart port holds one device.  Ports are filled by the robot description
+ * (host/sim/robot.cpp), and any port the robot code opens that isn't described
+ * gets a device of the type it was opened as.
+ */
+
+constexpr int SMART_PORTS = 21;
+constexpr int ADI_PORTS = 8;
+constexpr int ADI_SMART_PORT = 22;  // Smart port number PROS uses for the brain's own ADI
+
+/**
+ * Most voltage the motors apply, in mV.
+ */
+constexpr double MOTOR_MAX_MV = 12000.0;
+
+/**
+ * Current the motors allow by default, in mA.
+ */
+constexpr double MOTOR_MAX_MA = 2500.0;
+
+/**
+ * Step the motors' own velocity and position loops run at, in seconds.
+ * Anything else stiff, like a slipping wheel, steps this fine too.
+ */
+constexpr double STEP_FINE = 0.001;
+
+enum device_type { NONE = 0,
+                   MOTOR,
+                   IMU,
+                   ROTATION,
+                   ADI };
+
+/**
+ * V5 smart motor.  Positions and velocities are of the output shaft, after the
+ * cartridge, in the motor's own direction.
+ */
+struct Motor {
+  // Hardware
+  double cartridge_rpm = 200.0;  // 100, 200 or 600
+  bool cartridge_fixed = false;  // Set by the robot description, set_gearing can't change it
+  double load_inertia = 2e-4;    // kg m^2 on the output shaft when no plant drives it
+  double friction = 0.01;        // Nm
+  double strength = 1.0;         // Torque per amp against a new motor
+
+  // Commands
+  enum mode_e { VOLTAGE,
+                VELOCITY,
+                ABSOLUTE,
+                STOP };
+  mode_e mode = VOLTAGE;
+  double command = 0.0;  // mV in VOLTAGE, rpm in VELOCITY
+  double target_position = 0.0;  // Revolutions
+  double profiled_velocity = 0.0;
+  double hold_position = 0.0;    // Revolutions, where STOP with hold was entered
+  int brake_mode = 0;            // pros::motor_brake_mode_e_t
+  int encoder_units = 0;         // pros::motor_encoder_units_e_t
+  int current_limit = 2500;      // mA
+  int voltage_limit = 0;         // mV, 0 for none
+
+  // State
+  double position = 0.0;  // Revolutions since power on
+  double zero = 0.0;      // Revolutions subtracted by tare and set_zero_position
+  double velocity = 0.0;  // rpm
+  double voltage = 0.0;   // mV applied this step
+  double current = 0.0;   // mA
+  double torque = 0.0;    // Nm
+  double temperature = 25.0;
+  bool driven = false;    // A plant owns velocity and position
+
+  /**
+   * Voltage the motor's firmware applies this step for the current command.
+   */
+  double voltage_commanded() const;
+
+  /**
+   * True while the firmware's velocity or position loop sets the voltage,
+   * which has to be stepped every STEP_FINE.
+   */
+  bool looping() const { return mode == VELOCITY || mode == ABSOLUTE || (mode == STOP && brake_mode == 2); }
+
+  /**
+   * Output torque at a shaft speed for the voltage applied this step, with the
+   * current limit, back EMF and friction.  Also updates current and torque.
+   *
+   * \param rpm
+   *        output shaft speed
+   */
+  double torque_at(double rpm);
+
+  /**
+   * How much torque drops per rpm of speed, 0 while the current limit holds.
+   * Plants use it to take stable implicit steps.
+   */
+  double torque_slope(double rpm) const;
+
+  /**
+   * torque_slope() with the current limit out of the way, how stiff the motor can get.
+   */
+  double back_emf_slope() const;
+
+  /**
+   * Counts per output revolution in the encoder units the motor reports in.
+   */
+  double units_per_rev() const;
+
+  /**
+   * rpm at 12V with nothing on the shaft.
+   */
+  double free_rpm() const { return cartridge_rpm; }
+
+  /**
+   * Nm at the current limit.
+   */
+  double stall_torque() const;
+};
+
+/**
+ * Inertial sensor.  Angles are in degrees, clockwise positive, like PROS.
+ */
+struct Imu {
+  double yaw = 0.0;        // True rotation, set by the plant
+  double pitch = 0.0;
+  double roll = 0.0;
+  double yaw_rate = 0.0;   // deg/s
+  double accel_x = 0.0, accel_y = 0.0, accel_z = 1.0;  // g
+  double scale = 1.0;      // Reading is yaw * scale, real IMUs read a little short
+  double drift = 0.0;      // deg/s of drift while not calibrating
+  double drift_total = 0.0;
+  double rotation_offset = 0.0;
+  double heading_offset = 0.0;
+  double pitch_offset = 0.0, roll_offset = 0.0, yaw_offset = 0.0;
+  std::uint64_t calibrated_us = 0;  // Time calibration finishes
+  std::uint32_t calibration_ms = 2000;
+
+  bool calibrating() const;
+  double rotation() const;
+};
+
+/**
+ * Rotation sensor.  Angles are in centidegrees, like PROS.
+ */
+struct Rotation {
+  double angle = 0.0;   // True angle in degrees, set by the plant
+  double velocity = 0.0;  // True deg/s
+  double offset = 0.0;
+  bool reversed = false;
+
+  double reading() const { return (reversed ? -angle : angle) - offset; }
+};
+
+/**
+ * Eight three wire ports on the brain or an expander.
+ */
+struct Adi {
+  int config[ADI_PORTS] = {};
+  int value[ADI_PORTS] = {};
+  std::uint64_t changed_us[ADI_PORTS] = {};  // Last time an output changed
+  int changes[ADI_PORTS] = {};
+};
+
+/**
+ * V5 controller.  Buttons are indexed by pros::controller_digital_e_t - 6.
+ */
+struct Controller {
+  static constexpr int BUTTONS = 12;
+  bool connected = true;
+  int analog[4] = {};
+  bool digital[BUTTONS] = {};
+  bool new_press[BUTTONS] = {};  // Latched on a press, cleared when read
+  char text[3][20] = {};
+  std::string rumble;
+  std::uint64_t rumble_us = 0;
+  int battery_level = 100;
+
+  /**
+   * Sets a button, latching new presses like the brain does.
+   */
+  void button_set(int index, bool pressed);
+};
+
+struct Competition {
+  bool connected = false;
+  bool autonomous = false;
+  bool disabled = false;
+};
+
+struct Battery {
+  double voltage = 12800.0;  // mV
+  double current = 0.0;      // mA
+  double capacity = 100.0;
+  double temperature = 25.0;
+  double resistance = 0.03;  // Ohm, voltage sags by resistance * current
+  double open_voltage = 12800.0;
+};
+
+/**
+ * Anything that drives motor shafts and sensors from the outside, like a
+ * drivetrain.  step() runs after every motor has its voltage for the step,
+ * which can be many ms long while no motor is looping(), so a plant splits it
+ * into whatever steps it stays accurate at.
+ */
+class Plant {
+ public:
+  virtual ~Plant() = default;
+  virtual void step(double dt) = 0;
+};
+
+/**
+ * Everything plugged into the simulated brain.
+ */
+struct Devices {
+  device_type type[SMART_PORTS + 2] = {};
+  Motor motors[SMART_PORTS + 1];
+  Imu imus[SMART_PORTS + 1];
+  Rotation rotations[SMART_PORTS + 1];
+  Adi adi[SMART_PORTS + 2];
+  Controller controllers[2];
+  Competition competition;
+  Battery battery;
+  bool sd_card = false;
+  std::string screen[8];  // Brain screen rows, as ez::screen_print draws them
+  std::vector<Plant*> plants;  // Stepped in order, the drivetrain and then the mechanisms
+
+  /**
+   * Returns the device on a port, installing one if the port is empty.
+   * Returns nullptr if the port holds something else.
+   *
+   * \param port
+   *        1 to 21, negative ports are treated as positive
+   */
+  Motor* motor(int port);
+  Imu* imu(int port);
+  Rotation* rotation(int port);
+  Adi* adi_get(int port);
+
+  /**
+   * Advances every device by dt seconds, every STEP_FINE while a motor is looping().
+   */
+  void step(double dt);
+
+ private:
+  void step_once(double dt);
+};
+
+/**
+ * The one brain the host build runs on.
+ */
+Devices& devices();
+}  // namespace sim
+}  // namespace pls
@@ -0,0 +1,183 @@
+#include "sim/mechanisms.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+#include "sim/scheduler.hpp"
+
+namespace pls {
+namespace sim {
+
+namespace {
+constexpr double RPM_PER_RAD_S = 60.0 / (2.0 * M_PI);
+}  // namespace
+
+int Mechanisms::link_add(const LinkDescription& link) {
+  angle.push_back(0.0);
+  velocity.push_back(0.0);
+  inertia.push_back(link.inertia);
+  damping.push_back(link.damping);
+  gravity.push_back(link.gravity);
+  min_angle.push_back(link.min_angle);
+  max_angle.push_back(link.max_angle);
+  gear.push_back(link.gear);
+  motor_begin.push_back(motors.size());
+  for (int port : link.ports) {
+    Motor* motor = devices().motor(port);
+    if (motor == nullptr) continue;
+    motor->driven = true;
+    motors.push_back(motor);
+    directions.push_back(port < 0 ? -1.0 : 1.0);
+  }
+  motor_end.push_back(motors.size());
+  return angle.size() - 1;
+}
+
+int Mechanisms::piston_add(const PistonDescription& piston) {
+  position.push_back(0.0);
+  speed.push_back(0.0);
+  pressure.push_back(-1.0);
+  stroke.push_back(piston.stroke);
+  force.push_back(piston.force);
+  mass.push_back(piston.mass);
+  load.push_back(piston.load);
+  piston_damping.push_back(piston.damping);
+  valve_time.push_back(piston.valve_time);
+  solenoid_adi.push_back(devices().adi_get(piston.smart_port));
+  solenoid_index.push_back(std::toupper(piston.port) - 'A');
+  settled_us.push_back(0);
+  return position.size() - 1;
+}
+
+void Mechanisms::clear() {
+  for (Motor* motor : motors) motor->driven = false;
+  for (auto* v : {&angle, &velocity, &inertia, &damping, &gravity, &min_angle, &max_angle, &gear, &directions, &position, &speed, &pressure, &stroke,
+                  &force, &mass, &load, &piston_damping, &valve_time})
+    v->clear();
+  motor_begin.clear();
+  motor_end.clear();
+  motors.clear();
+  solenoid_adi.clear();
+  solenoid_index.clear();
+  settled_us.clear();
+}
+
+// Angular acceleration of a link at a trial state, with its motors' voltages held
+double Mechanisms::link_accel(int link, double theta, double omega) {
+  double torque = -damping[link] * omega;
+  if (gravity[link] != 0.0) torque -= gravity[link] * std::cos(theta);  // Rollers spin far enough that cos is slow
+  for (int i = motor_begin[link]; i < motor_end[link]; i++) {
+    double rpm = directions[i] * omega * gear[link] * RPM_PER_RAD_S;
+    torque += directions[i] * motors[i]->torque_at(rpm) * gear[link];
+  }
+  return torque / inertia[link];
+}
+
+// Steps no longer than the link's time constant against its damping and its motors' back EMF, where RK4 is accurate
+void Mechanisms::links_step(double dt) {
+  for (int link = 0; link < links(); link++) {
+    double stiffness = damping[link];
+    for (int i = motor_begin[link]; i < motor_end[link]; i++)
+      stiffness += motors[i]->back_emf_slope() * gear[link] * gear[link] * RPM_PER_RAD_S;
+    int steps = std::max(1, (int)std::ceil(dt * stiffness / inertia[link] - 1e-9));
+    for (int i = 0; i < steps; i++) link_step(link, dt / steps);
+  }
+}
+
+void Mechanisms::link_step(int link, double dt) {
+  double theta = angle[link];
+  double omega = velocity[link];
+  double k1_theta = omega;
+  double k1_omega = link_accel(link, theta, omega);
+  double k2_theta = omega + dt / 2.0 * k1_omega;
+  double k2_omega = link_accel(link, theta + dt / 2.0 * k1_theta, k2_theta);
+  double k3_theta = omega + dt / 2.0 * k2_omega;
+  double k3_omega = link_accel(link, theta + dt / 2.0 * k2_theta, k3_theta);
+  double k4_theta = omega + dt * k3_omega;
+  double k4_omega = link_accel(link, theta + dt * k3_theta, k4_theta);
+  theta += dt / 6.0 * (k1_theta + 2.0 * k2_theta + 2.0 * k3_theta + k4_theta);
+  omega += dt / 6.0 * (k1_omega + 2.0 * k2_omega + 2.0 * k3_omega + k4_omega);
+
+  // Hard stops take all the speed going into them
+  if (theta < min_angle[link] || theta > max_angle[link]) {
+    theta = std::clamp(theta, min_angle[link], max_angle[link]);
+    if ((theta == min_angle[link] && omega < 0.0) || (theta == max_angle[link] && omega > 0.0)) omega = 0.0;
+  }
+
+  double turned = theta - angle[link];
+  angle[link] = theta;
+  velocity[link] = omega;
+  for (int i = motor_begin[link]; i < motor_end[link]; i++) {
+    motors[i]->velocity = directions[i] * omega * gear[link] * RPM_PER_RAD_S;
+    motors[i]->position += directions[i] * turned * gear[link] / (2.0 * M_PI);
+  }
+}
+
+// Steps no longer than the valve takes, or than the air damps the rod in unless it rests where the valve pushes it
+void Mechanisms::pistons_step(double dt) {
+  for (int p = 0; p < pistons(); p++) {
+    const Adi* adi = solenoid_adi[p];
+    bool out = adi != nullptr && adi->value[solenoid_index[p]] != 0;
+    bool resting = speed[p] == 0.0 && position[p] == (out ? stroke[p] : 0.0);
+
+    // A rod held at its end by full pressure stays there, which is where pistons spend nearly all their time
+    double target = out ? 1.0 : -1.0;
+    double push = target * force[p] - load[p];
+    if (resting && std::abs(pressure[p] - target) < 1e-9 && (out ? push >= 0.0 : push <= 0.0)) {
+      pressure[p] = target;
+      continue;
+    }
+    double most = resting ? valve_time[p] : std::min(valve_time[p], mass[p] / piston_damping[p]);
+    int steps = std::max(1, (int)std::ceil(dt / most - 1e-9));
+    for (int i = 0; i < steps; i++) piston_step(p, dt / steps, now_us() + (std::uint64_t)(i * dt / steps * 1e6));
+  }
+}
+
+// Valve pressure, rod position and rod speed, one RK4 step
+void Mechanisms::piston_step(int p, double dt, std::uint64_t now) {
+  const Adi* adi = solenoid_adi[p];
+  double target = adi != nullptr && adi->value[solenoid_index[p]] != 0 ? 1.0 : -1.0;
+  double tau = valve_time[p];
+  double a = 1.0 / mass[p];
+  double c = piston_damping[p] * a;
+
+  auto dp = [&](double pr) { return (target - pr) / tau; };
+  auto dv = [&](double pr, double v) { return (pr * force[p] - load[p]) * a - c * v; };
+
+  double p0 = pressure[p], x0 = position[p], v0 = speed[p];
+  double k1_p = dp(p0), k1_x = v0, k1_v = dv(p0, v0);
+  double p1 = p0 + dt / 2.0 * k1_p, v1 = v0 + dt / 2.0 * k1_v;
+  double k2_p = dp(p1), k2_x = v1, k2_v = dv(p1, v1);
+  double p2 = p0 + dt / 2.0 * k2_p, v2 = v0 + dt / 2.0 * k2_v;
+  double k3_p = dp(p2), k3_x = v2, k3_v = dv(p2, v2);
+  double p3 = p0 + dt * k3_p, v3 = v0 + dt * k3_v;
+  double k4_p = dp(p3), k4_x = v3, k4_v = dv(p3, v3);
+  double pr = p0 + dt / 6.0 * (k1_p + 2.0 * k2_p + 2.0 * k3_p + k4_p);
+  double x = x0 + dt / 6.0 * (k1_x + 2.0 * k2_x + 2.0 * k3_x + k4_x);
+  double v = v0 + dt / 6.0 * (k1_v + 2.0 * k2_v + 2.0 * k3_v + k4_v);
+
+  // The cylinder's ends stop the rod dead
+  bool was_at_end = x0 <= 0.0 || x0 >= stroke[p];
+  if (x <= 0.0 || x >= stroke[p]) {
+    x = std::clamp(x, 0.0, stroke[p]);
+    if ((x == 0.0 && v < 0.0) || (x == stroke[p] && v > 0.0)) v = 0.0;
+    if (!was_at_end) settled_us[p] = now;
+  }
+  pressure[p] = pr;
+  position[p] = x;
+  speed[p] = v;
+}
+
+void Mechanisms::step(double dt) {
+  links_step(dt);
+  pistons_step(dt);
+}
+
+Mechanisms& mechanisms() {
+  static Mechanisms all;
+  return all;
+}
+
+}  // namespace sim
+}  // namespace pls
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+
+#include "sim/devices.hpp"
+
+namespace pls {
+namespace sim {
+/**
+ * A shaft turned by motors, like intake rollers or an arm.
+ */
+struct LinkDescription {
+  std::vector<int> ports;  // Motors on the shaft, negative when reversed
+  double gear = 1.0;       // Motor turns per link turn
+  double inertia = 2e-4;   // kg m^2 at the link, rollers, chain and whatever they hold
+  double damping = 0.0;    // Nm per rad/s, rubbing that grows with speed
+  double gravity = 0.0;    // Nm gravity pulls an arm down with at 0 rad, falling off with cos
+  double min_angle = -1e9;  // rad, hard stops
+  double max_angle = 1e9;
+};
+
+/**
+ * A double acting pneumatic cylinder on a three wire solenoid.
+ */
+struct PistonDescription {
+  int smart_port = ADI_SMART_PORT;  // Brain or expander the solenoid is on
+  char port = 'A';
+  double stroke = 0.025;     // m
+  double force = 50.0;       // N at full pressure, 100 psi on a 10mm bore
+  double mass = 0.1;         // kg moving with the rod
+  double load = 0.0;         // N pushing the rod in, like an arm's weight
+  double damping = 50.0;     // N per m/s, air through the fittings sets the top speed
+  double valve_time = 0.01;  // s for the pressure to swap sides after the solenoid does
+};
+
+/**
+ * Every mechanism on the robot besides the drivetrain, stepped together.
+ *
+ * State is kept as one array per quantity, with links and pistons in separate
+ * sets, and each link or piston takes as many equal steps of classic RK4 as
+ * it needs to stay accurate over the call.  Motor voltages are held through
+ * the call like the motors' own firmware does.
+ */
+class Mechanisms : public Plant {
+ public:
+  /**
+   * Adds a link and marks its motors as driven.  Returns its index.
+   */
+  int link_add(const LinkDescription& link);
+
+  /**
+   * Adds a piston.  Returns its index.
+   */
+  int piston_add(const PistonDescription& piston);
+
+  /**
+   * Removes every link and piston.
+   */
+  void clear();
+
+  void step(double dt) override;
+
+  int links() const { return angle.size(); }
+  int pistons() const { return position.size(); }
+
+  /**
+   * Link angle in rad and speed in rad/s.
+   */
+  double link_angle(int link) const { return angle[link]; }
+  double link_velocity(int link) const { return velocity[link]; }
+
+  /**
+   * How far a piston is out, 0 in to 1 all the way out.
+   */
+  double piston_extension(int piston) const { return position[piston] / stroke[piston]; }
+
+  /**
+   * Simulated time the piston last reached an end, in microseconds.
+   */
+  std::uint64_t piston_settled_us(int piston) const { return settled_us[piston]; }
+
+ private:
+  // Links
+  std::vector<double> angle, velocity;
+  std::vector<double> inertia, damping, gravity, min_angle, max_angle, gear;
+  std::vector<int> motor_begin, motor_end;  // Range in motors and directions
+  std::vector<Motor*> motors;
+  std::vector<double> directions;
+
+  // Pistons
+  std::vector<double> position, speed, pressure;  // pressure is -1 pushing in to 1 pushing out
+  std::vector<double> stroke, force, mass, load, piston_damping, valve_time;
+  std::vector<Adi*> solenoid_adi;
+  std::vector<int> solenoid_index;
+  std::vector<std::uint64_t> settled_us;
+
+  double link_accel(int link, double theta, double omega);
+  void links_step(double dt);
+  void link_step(int link, double dt);
+  void pistons_step(double dt);
+  void piston_step(int p, double dt, std::uint64_t now);
+};
+
+/**
+ * The robot's mechanisms, set up by robot_install().
+ */
+Mechanisms& mechanisms();
+}  // namespace sim
+}  // namespace pls
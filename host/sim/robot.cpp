@@ -0,0 +1,282 @@
+#include "sim/robot.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <utility>
+
+#include "sim/scheduler.hpp"
+
+namespace pls {
+namespace sim {
+
+constexpr double M_PER_IN = 0.0254;
+
+RobotDescription& robot() {
+  static RobotDescription description;
+  return description;
+}
+
+namespace {
+constexpr double GRAVITY = 9.81;
+constexpr double SLIP_TOLERANCE = 1e-4;  // m/s, slower than this and a side grips again
+constexpr double GRIP_STEP = 0.002;      // s, longest step while both sides grip, autons end within 0.03 s of 1 ms steps
+constexpr std::uint32_t STEP_MAX_MS = 10;  // Longest the devices go between tasks, EZ's loop time
+
+// Clamps input to +-limit
+double clamp(double input, double limit) { return input > limit ? limit : input < -limit ? -limit : input; }
+
+double sign(double input) { return input > 0.0 ? 1.0 : input < 0.0 ? -1.0 : 0.0; }
+
+// One side of the drive: its motors, the wheels they spin and how fast those
+// wheels' treads move, which is only the ground's speed while the side grips.
+struct Side {
+  std::vector<Motor*> motors;
+  std::vector<double> directions;  // -1 for reversed ports
+  double speed = 0.0;              // Tread speed, m/s
+  bool slipping = false;
+
+  // Force the motors push the treads with, N, and how much it drops per m/s
+  double force = 0.0;
+  double slope = 0.0;
+};
+
+// Rigid tank drive on tiles.  Steps are GRIP_STEP at most while both sides
+// grip and STEP_FINE while one slips, so every run is the same.
+//
+// Each side is the motors' torque-speed curve driving the wheels and rotors'
+// inertia.  While a side grips, its treads move with the ground and the body
+// and both sides are solved together.  When the force it needs is more than the
+// tiles give, it spins, pushing with slip friction until the treads and the
+// ground match again.  The body slides sideways the same way once a turn needs
+// more than the traction wheels hold.  Tracking wheels follow the ground.
+class TankPlant : public Plant {
+ public:
+  RobotPose pose;
+  double forward = 0.0;   // m/s
+  double sideways = 0.0;  // m/s, to the right
+  double turn = 0.0;      // rad/s, clockwise
+  Side left_side, right_side;
+  double vert_distance = 0.0;
+  double horiz_distance = 0.0;
+
+  // Filled in by setup()
+  double wheel_radius = 0.0;   // m
+  double half_track = 0.0;     // m
+  double gear = 0.0;           // Motor turns per wheel turn
+  double rpm_per_speed = 0.0;  // Motor rpm per m/s of tread
+  double side_mass = 0.0;      // Wheels and rotors of a side, as mass at the tread
+
+  void setup() {
+    const RobotDescription& r = robot();
+    wheel_radius = r.wheel_diameter / 2.0 * M_PER_IN;
+    half_track = r.track_width / 2.0 * M_PER_IN;
+    gear = r.cartridge_rpm / r.wheel_rpm;
+    rpm_per_speed = gear / wheel_radius * 60.0 / (2.0 * M_PI);
+    for (auto [side, ports] : {std::pair{&left_side, &r.left_ports}, std::pair{&right_side, &r.right_ports}}) {
+      side->motors.clear();
+      side->directions.clear();
+      for (int port : *ports) {
+        side->motors.push_back(devices().motor(port));
+        side->directions.push_back(port < 0 ? -1.0 : 1.0);
+      }
+    }
+    double inertia = r.wheels_per_side * r.wheel_inertia + r.left_ports.size() * r.motor_inertia * gear * gear;
+    side_mass = inertia / (wheel_radius * wheel_radius);
+  }
+
+  // Motor torque at the side's tread speed, as a force at the tread
+  void drive(Side& side) {
+    double to_force = gear / wheel_radius;
+    side.force = 0.0;
+    side.slope = 0.0;
+    for (size_t i = 0; i < side.motors.size(); i++) {
+      double rpm = side.directions[i] * side.speed * rpm_per_speed;
+      side.force += side.directions[i] * side.motors[i]->torque_at(rpm) * to_force;
+      side.slope += side.motors[i]->torque_slope(rpm) * rpm_per_speed * to_force;
+    }
+  }
+
+  void step(double dt) override {
+    // Equal steps to the end, shorter from wherever a side starts slipping
+    do {
+      double most = left_side.slipping || right_side.slipping ? STEP_FINE : GRIP_STEP;
+      double h = dt / std::max(1, (int)std::ceil(dt / most - 1e-9));
+      step_once(h);
+      dt -= h;
+    } while (dt > 1e-9);
+  }
+
+  void step_once(double dt) {
+    const RobotDescription& r = robot();
+    double m = r.mass;
+    double j = r.yaw_inertia;
+    double h = half_track;
+    double grip = r.wheel_friction * m * GRAVITY / 2.0;
+    double slide = r.wheel_slip_friction * m * GRAVITY / 2.0;
+
+    drive(left_side);
+    drive(right_side);
+
+    // Ground speed under each side, left goes faster turning clockwise
+    double ground_left = forward + turn * h;
+    double ground_right = forward - turn * h;
+    double traction_left = left_side.slipping ? slide * sign(left_side.speed - ground_left) : 0.0;
+    double traction_right = right_side.slipping ? slide * sign(right_side.speed - ground_right) : 0.0;
+
+    // Solve the gripping sides together so their treads accelerate with the
+    // ground.  A side that needs more than grip starts slipping, and the other
+    // side is solved again with it.
+    double coriolis = m * sideways * turn;
+    double a = 1.0 / side_mass + 1.0 / m + h * h / j;
+    double b = 1.0 / m - h * h / j;
+    for (int pass = 0; pass < 2; pass++) {
+      double rhs_left = left_side.force / side_mass - coriolis / m;
+      double rhs_right = right_side.force / side_mass - coriolis / m;
+      if (!left_side.slipping && !right_side.slipping) {
+        double det = a * a - b * b;
+        traction_left = (a * rhs_left - b * rhs_right) / det;
+        traction_right = (a * rhs_right - b * rhs_left) / det;
+      } else if (!left_side.slipping) {
+        traction_left = (rhs_left - b * traction_right) / a;
+      } else if (!right_side.slipping) {
+        traction_right = (rhs_right - b * traction_left) / a;
+      }
+
+      bool changed = false;
+      for (auto [side, traction] : {std::pair{&left_side, &traction_left}, std::pair{&right_side, &traction_right}}) {
+        if (!side->slipping && std::fabs(*traction) > grip) {
+          side->slipping = true;
+          *traction = slide * sign(*traction);
+          changed = true;
+        }
+      }
+      if (!changed) break;
+    }
+
+    // Body
+    double forward_accel = (traction_left + traction_right + coriolis) / m;
+    double turn_accel = (traction_left - traction_right) * h / j;
+    double last_sideways = sideways;
+    forward += forward_accel * dt;
+    turn += turn_accel * dt;
+
+    // Sideways the robot only moves by sliding, traction wheels stop it up to their friction
+    double sideways_free = sideways - forward * turn * dt;
+    sideways = sideways_free + clamp(-sideways_free, r.lateral_friction * GRAVITY * dt);
+
+    // Treads.  Spinning sides take a linearized implicit step against their
+    // motors' back EMF, and grip again once they reach the ground's speed.
+    ground_left = forward + turn * h;
+    ground_right = forward - turn * h;
+    for (auto [side, traction, ground] : {std::tuple{&left_side, traction_left, ground_left}, std::tuple{&right_side, traction_right, ground_right}}) {
+      if (side->slipping) {
+        double before = side->speed - ground;
+        side->speed += dt * (side->force - traction) / (side_mass + dt * side->slope);
+        double after = side->speed - ground;
+        if (sign(before) != sign(after) || std::fabs(after) < SLIP_TOLERANCE) side->slipping = false;
+      }
+      if (!side->slipping) side->speed = ground;
+      for (size_t i = 0; i < side->motors.size(); i++) {
+        Motor* motor = side->motors[i];
+        motor->velocity = side->directions[i] * side->speed * rpm_per_speed;
+        motor->position += motor->velocity / 60.0 * dt;
+      }
+    }
+
+    // Integrate along the arc's middle heading, in inches
+    double theta = pose.theta * M_PI / 180.0;
+    double mid = theta + turn * dt / 2.0;
+    double forward_in = forward / M_PER_IN;
+    double right_in = sideways / M_PER_IN;
+    pose.x += (forward_in * sin(mid) + right_in * cos(mid)) * dt;
+    pose.y += (forward_in * cos(mid) - right_in * sin(mid)) * dt;
+    theta += turn * dt;
+    pose.theta = theta * 180.0 / M_PI;
+
+    // Off center tracking wheels also roll while the robot turns
+    double vert_velocity = forward_in - turn * r.vert_tracker_offset;
+    double horiz_velocity = right_in + turn * r.horiz_tracker_offset;
+    vert_distance += vert_velocity * dt;
+    horiz_distance += horiz_velocity * dt;
+
+    Devices& d = devices();
+    Imu* imu = d.imu(r.imu_port);
+    imu->yaw = pose.theta;
+    imu->yaw_rate = turn * 180.0 / M_PI;
+    imu->accel_y = forward_accel / GRAVITY;
+    imu->accel_x = (dt > 0 ? (sideways - last_sideways) / dt + forward * turn : 0.0) / GRAVITY;
+
+    // Rotation sensors count down going forward and right, so the robot reverses their ports
+    Rotation* vert = d.rotation(r.vert_tracker_port);
+    vert->angle = -vert_distance / (M_PI * r.vert_tracker_diameter) * 360.0;
+    vert->velocity = -vert_velocity / (M_PI * r.vert_tracker_diameter) * 360.0;
+    Rotation* horiz = d.rotation(r.horiz_tracker_port);
+    horiz->angle = -horiz_distance / (M_PI * r.horiz_tracker_diameter) * 360.0;
+    horiz->velocity = -horiz_velocity / (M_PI * r.horiz_tracker_diameter) * 360.0;
+  }
+};
+
+TankPlant& plant() {
+  static TankPlant tank;
+  return tank;
+}
+
+void step_devices(double dt) { devices().step(dt); }
+}  // namespace
+
+void robot_install() {
+  const RobotDescription& r = robot();
+  Devices& d = devices();
+
+  for (const auto* side : {&r.left_ports, &r.right_ports}) {
+    for (int port : *side) {
+      Motor* m = d.motor(port);
+      m->cartridge_rpm = r.cartridge_rpm;
+      m->cartridge_fixed = true;
+      m->driven = true;
+    }
+  }
+  d.imu(r.imu_port);
+  d.rotation(r.vert_tracker_port);
+  d.rotation(r.horiz_tracker_port);
+
+  plant().setup();
+
+  Mechanisms& m = mechanisms();
+  m.clear();
+  m.link_add(r.intake);
+  m.piston_add(r.scraper);
+  m.piston_add(r.switcher);
+  m.piston_add(r.descore);
+
+  d.plants = {&plant(), &m};
+  step_callback_set(step_devices, STEP_MAX_MS);
+}
+
+RobotPose robot_pose() { return plant().pose; }
+
+void robot_place(RobotPose pose) {
+  const RobotDescription& r = robot();
+  TankPlant& tank = plant();
+  Imu* imu = devices().imu(r.imu_port);
+  double turned = (pose.theta - tank.pose.theta) * imu->scale;
+  imu->rotation_offset += turned;
+  imu->heading_offset += turned;
+  imu->yaw_offset += turned;
+  tank.pose = pose;
+}
+
+RobotVelocity robot_velocity() {
+  const TankPlant& tank = plant();
+  RobotVelocity velocity;
+  velocity.forward = tank.forward / M_PER_IN;
+  velocity.right = tank.sideways / M_PER_IN;
+  velocity.turn = tank.turn * 180.0 / M_PI;
+  velocity.left_slip = (tank.left_side.speed - (tank.forward + tank.turn * tank.half_track)) / M_PER_IN;
+  velocity.right_slip = (tank.right_side.speed - (tank.forward - tank.turn * tank.half_track)) / M_PER_IN;
+  return velocity;
+}
+
+}  // namespace sim
+}  // namespace pls
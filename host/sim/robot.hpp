@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vector>
+
+#include "sim/devices.hpp"
+#include "sim/mechanisms.hpp"
+
+namespace pls {
+namespace sim {
+/**
+ * The robot the host build drives, matching the ports in src/main.cpp and
+ * include/subsystems.hpp.  Lengths are in inches, everything else is SI.
+ */
+struct RobotDescription {
+  std::vector<int> left_ports = {-11, -12, -13};
+  std::vector<int> right_ports = {14, 15, 16};
+  int imu_port = 7;
+  double cartridge_rpm = 600.0;
+  double wheel_rpm = 450.0;
+  double wheel_diameter = 3.25;
+  double track_width = 11.5;  // Not measured yet, wheel center to wheel center
+  double mass = 6.8;          // kg
+  double yaw_inertia = 0.15;  // kg m^2 about the center, a 14" square of this mass
+
+  // Drivetrain, per side
+  int wheels_per_side = 3;
+  double wheel_inertia = 8e-5;    // kg m^2 of one 3.25" wheel
+  double motor_inertia = 1.8e-4;  // kg m^2 of one motor seen at its output shaft
+
+  // Tiles, as fractions of the weight on the wheels
+  double wheel_friction = 1.0;       // Most a side can push before it spins
+  double wheel_slip_friction = 0.8;  // What a spinning side still pushes with
+  double lateral_friction = 0.5;     // Sideways, only the traction wheels grip
+
+  // Tracking wheels, offsets are right and forward of the center, positive
+  int vert_tracker_port = -20;
+  double vert_tracker_diameter = 2.0;
+  double vert_tracker_offset = -3.75;
+  int horiz_tracker_port = -19;
+  double horiz_tracker_diameter = 2.0;
+  double horiz_tracker_offset = -2.25;
+
+  // Mechanisms, matching include/subsystems.hpp
+  LinkDescription intake = {{9, -10}, 1.0, 4e-4, 2e-4};  // Rollers and chain, not measured yet
+  PistonDescription scraper = {ADI_SMART_PORT, 'A'};
+  PistonDescription switcher = {ADI_SMART_PORT, 'C'};
+  PistonDescription descore = {ADI_SMART_PORT, 'H', 0.025, 50.0, 0.15, 6.0};  // The arm's weight holds it in
+};
+
+/**
+ * Where the robot really is, clockwise from +y like odom.  Degrees and inches.
+ */
+struct RobotPose {
+  double x = 0.0;
+  double y = 0.0;
+  double theta = 0.0;
+};
+
+/**
+ * The simulated robot's description.  Change it before robot_install().
+ */
+RobotDescription& robot();
+
+/**
+ * Sets up the drive motors, imu, tracking wheels and mechanisms from robot(),
+ * puts the drivetrain on the field and starts stepping the devices with the clock.
+ */
+void robot_install();
+
+/**
+ * Where the robot really is, to compare against odom.
+ */
+RobotPose robot_pose();
+
+/**
+ * Moves the robot on the field without the sensors noticing, like setting it
+ * down a little off its mark.  Odom and the imu keep reading what they read.
+ */
+void robot_place(RobotPose pose);
+
+/**
+ * How fast the robot is really moving, in the robot's frame.
+ */
+struct RobotVelocity {
+  double forward = 0.0;  // in/s
+  double right = 0.0;    // in/s, sliding sideways
+  double turn = 0.0;     // deg/s, clockwise
+  double left_slip = 0.0;   // in/s the left wheels spin faster than the ground under them
+  double right_slip = 0.0;  // in/s the right wheels spin faster than the ground under them
+};
+
+/**
+ * How fast the robot is really moving, and how much its wheels are slipping.
+ */
+RobotVelocity robot_velocity();
+}  // namespace sim
+}  // namespace pls
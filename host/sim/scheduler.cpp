@@ -0,0 +1,577 @@
+#include "sim/scheduler.hpp"
+
+#include <ucontext.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pls {
+namespace sim {
+
+// Host stacks are much bigger than the brain's, printf and iostream use a lot
+constexpr std::size_t STACK_SIZE = 512 * 1024;
+constexpr std::uint64_t NEVER = std::numeric_limits<std::uint64_t>::max();
+
+// Vector clock, one count per task id, for what a task has synchronized with
+using Clock = std::vector<std::uint32_t>;
+
+struct Task {
+  ucontext_t context;
+  std::unique_ptr<char[]> stack;
+  void (*function)(void*);
+  void* parameters;
+  std::uint32_t priority;
+  std::uint32_t base_priority;  // priority without what a mutex lent it
+  int id;
+  char name[32];
+  task_state state = READY;
+  bool started = false;
+  std::uint64_t wake_us = 0;  // When a blocked task times out, NEVER to wait forever
+  std::uint64_t order = 0;    // Breaks ties between tasks waking at the same time
+  std::uint32_t notify_value = 0;
+  bool notify_pending = false;
+  bool waiting_notify = false;
+  Mutex* waiting_mutex = nullptr;
+  std::vector<Task*> joiners;
+  Clock clock;
+  Clock notify_clock;  // Joined from whoever notified it, taken with the notification
+  bool taking_over = false;  // See takeover_begin
+};
+
+struct Mutex {
+  Task* owner = nullptr;
+  std::deque<Task*> waiters;
+  Clock clock;  // The last owner's clock when it gave the mutex
+};
+
+namespace {
+struct Scheduler {
+  std::vector<std::unique_ptr<Task>> tasks;
+  std::vector<std::unique_ptr<Mutex>> mutexes;
+  Task* current = nullptr;
+  ucontext_t context;
+  std::uint64_t now = 0;
+  std::uint64_t order = 0;
+  std::uint64_t switches = 0;
+  void (*step)(double dt) = nullptr;
+  std::uint32_t step_ms = 1;
+
+  // Interleavings, see schedule_seed_set
+  std::uint64_t seed = 0;
+  std::uint64_t random = 0;
+  double preempt_chance = 0.0;
+
+  // The last task to command each device, see shared_write
+  struct Write {
+    Task* task = nullptr;
+    std::uint32_t epoch = 0;  // The writer's own count in its clock at the write
+  };
+  std::unordered_map<const void*, Write> writes;
+  std::unordered_map<const void*, Clock> handoffs;  // The last clock through each, see handoff
+  std::vector<Issue> issues;
+};
+
+// Function local so tasks made by global constructors in other files are safe
+Scheduler& s() {
+  static Scheduler scheduler;
+  return scheduler;
+}
+
+Task* starting = nullptr;
+
+// splitmix64, so a seed gives the same interleaving on every computer
+std::uint64_t random_next() {
+  std::uint64_t z = (s().random += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+double random_uniform() { return (random_next() >> 11) * (1.0 / 9007199254740992.0); }
+
+void clock_join(Clock& into, const Clock& from) {
+  if (into.size() < from.size()) into.resize(from.size(), 0);
+  for (size_t i = 0; i < from.size(); i++) into[i] = std::max(into[i], from[i]);
+}
+
+// A task hands what it has done so far to whoever synchronizes with it next
+void clock_tick(Task* task) {
+  if (task != nullptr) task->clock[task->id]++;
+}
+
+// Adds an issue, or counts it again if the same one was already found.  Details
+// are collected once each, like the ports a race was seen on.
+void issue_add(issue_kind kind, const std::string& text, std::uint64_t duration_us = 0, const std::string& detail = "") {
+  Issue* found = nullptr;
+  for (Issue& issue : s().issues) {
+    if (issue.kind == kind && issue.text == text) found = &issue;
+  }
+  if (found == nullptr) {
+    s().issues.push_back({kind, text, "", s().now, 0, 0});
+    found = &s().issues.back();
+  }
+  found->count++;
+  found->worst_us = std::max(found->worst_us, duration_us);
+  if (!detail.empty() && (", " + found->details + ", ").find(", " + detail + ", ") == std::string::npos)
+    found->details += (found->details.empty() ? "" : ", ") + detail;
+}
+
+// Task name for reports, PROS leaves tasks made without one blank
+std::string task_label(const Task* task) { return task->name[0] != '\0' ? task->name : "task " + std::to_string(task->id); }
+
+void make_ready(Task* task) {
+  task->state = READY;
+  task->wake_us = s().now;
+  task->order = s().order++;
+}
+
+void finish(Task* task) {
+  task->state = DELETED;
+  for (Task* joiner : task->joiners) make_ready(joiner);
+  task->joiners.clear();
+  if (task->waiting_mutex != nullptr) {
+    auto& waiters = task->waiting_mutex->waiters;
+    for (auto it = waiters.begin(); it != waiters.end(); it++) {
+      if (*it == task) {
+        waiters.erase(it);
+        break;
+      }
+    }
+    task->waiting_mutex = nullptr;
+  }
+}
+
+void entry() {
+  Task* task = starting;
+  task->function(task->parameters);
+  finish(task);
+  setcontext(&s().context);
+}
+
+// Gives control back to the scheduler until this task is picked again
+void switch_out() {
+  Task* task = s().current;
+  swapcontext(&task->context, &s().context);
+}
+
+void advance_to(std::uint64_t time_us) {
+  Scheduler& sc = s();
+  while (sc.now < time_us) {
+    std::uint64_t next = std::min((sc.now / 1000 + sc.step_ms) * 1000, (time_us + 999) / 1000 * 1000);
+    if (sc.step != nullptr) sc.step((next - sc.now) / 1e6);
+    sc.now = next;
+  }
+}
+
+bool runnable(const Task* t) { return t->state == READY || (t->state == BLOCKED && t->wake_us <= s().now); }
+
+// Highest priority task that can run now, the earliest waking one on ties.
+// With a seed, ties go to a random one of them instead.
+Task* pick() {
+  Task* best = nullptr;
+  int ties = 0;
+  for (auto& ptr : s().tasks) {
+    Task* t = ptr.get();
+    if (!runnable(t)) continue;
+    if (best != nullptr && t->priority == best->priority && s().seed != 0) {
+      if (random_next() % ++ties == 0) best = t;  // Reservoir sampling keeps every tie equally likely
+      continue;
+    }
+    if (best == nullptr || t->priority > best->priority ||
+        (t->priority == best->priority && (t->wake_us < best->wake_us || (t->wake_us == best->wake_us && t->order < best->order)))) {
+      best = t;
+      ties = 1;
+    }
+  }
+  return best;
+}
+
+std::uint64_t next_wake() {
+  std::uint64_t next = NEVER;
+  for (auto& t : s().tasks)
+    if (t->state == BLOCKED && t->wake_us < next) next = t->wake_us;
+  return next;
+}
+
+void resume(Task* task) {
+  Scheduler& sc = s();
+  task->state = RUNNING;
+  sc.current = task;
+  sc.switches++;
+  if (!task->started) {
+    task->started = true;
+    getcontext(&task->context);
+    task->context.uc_stack.ss_sp = task->stack.get();
+    task->context.uc_stack.ss_size = STACK_SIZE;
+    task->context.uc_link = nullptr;
+    makecontext(&task->context, entry, 0);
+    starting = task;
+  }
+  swapcontext(&sc.context, &task->context);
+  sc.current = nullptr;
+  if (task->state == RUNNING) make_ready(task);
+}
+
+run_result loop(Task* main, std::uint64_t end_us) {
+  while (main == nullptr || main->state != DELETED) {
+    Task* task = pick();
+    if (task != nullptr) {
+      resume(task);
+      continue;
+    }
+    std::uint64_t next = next_wake();
+    if (next >= end_us) {
+      advance_to(end_us);
+      return main == nullptr ? FINISHED : TIMED_OUT;
+    }
+    if (next == NEVER) return DEADLOCKED;
+    advance_to(next);
+  }
+  return FINISHED;
+}
+}  // namespace
+
+std::uint64_t now_us() { return s().now; }
+
+std::uint32_t now_ms() { return (std::uint32_t)(s().now / 1000); }
+
+Task* task_create(void (*function)(void*), void* parameters, std::uint32_t priority, const char* name) {
+  auto task = std::make_unique<Task>();
+  task->stack.reset(new char[STACK_SIZE]);
+  task->function = function;
+  task->parameters = parameters;
+  task->priority = priority;
+  task->base_priority = priority;
+  task->id = s().tasks.size();
+  std::snprintf(task->name, sizeof(task->name), "%s", name == nullptr ? "" : name);
+
+  // Everything the creator did happens before the new task starts
+  Task* parent = s().current;
+  if (parent != nullptr) task->clock = parent->clock;
+  task->clock.resize(task->id + 1, 0);
+  task->clock[task->id] = 1;
+  clock_tick(parent);
+
+  make_ready(task.get());
+  s().tasks.push_back(std::move(task));
+  return s().tasks.back().get();
+}
+
+Task* task_current() { return s().current; }
+
+void task_delete(Task* task) {
+  if (task == nullptr) task = s().current;
+  if (task == nullptr || task->state == DELETED) return;
+  finish(task);
+  if (task == s().current) switch_out();
+}
+
+void task_sleep_until(std::uint64_t wake_us) {
+  Task* task = s().current;
+  if (task == nullptr) {
+    advance_to(wake_us);
+    return;
+  }
+  task->state = BLOCKED;
+  task->wake_us = wake_us < s().now ? s().now : wake_us;
+  task->order = s().order++;
+  switch_out();
+}
+
+void task_yield() { task_sleep_until(s().now); }
+
+namespace {
+// Where a seeded schedule may switch tasks, like a tick interrupt landing mid-loop
+void preempt_point() {
+  Scheduler& sc = s();
+  Task* self = sc.current;
+  if (sc.seed == 0 || self == nullptr || random_uniform() >= sc.preempt_chance) return;
+  for (auto& t : sc.tasks) {
+    if (t.get() != self && runnable(t.get()) && t->priority >= self->priority) {
+      task_yield();
+      return;
+    }
+  }
+}
+}  // namespace
+
+void task_suspend(Task* task) {
+  if (task == nullptr) task = s().current;
+  if (task == nullptr || task->state == DELETED) return;
+  task->state = SUSPENDED;
+  if (task == s().current) switch_out();
+}
+
+void task_resume(Task* task) {
+  if (task != nullptr && task->state == SUSPENDED) make_ready(task);
+}
+
+std::uint32_t task_priority_get(Task* task) {
+  if (task == nullptr) task = s().current;
+  return task == nullptr ? 0 : task->priority;
+}
+
+void task_priority_set(Task* task, std::uint32_t priority) {
+  if (task == nullptr) task = s().current;
+  if (task == nullptr) return;
+  if (task->priority == task->base_priority || priority > task->priority) task->priority = priority;  // Keep a lent priority
+  task->base_priority = priority;
+}
+
+task_state task_state_get(Task* task) {
+  if (task == nullptr) return INVALID;
+  return task->state == BLOCKED && task->wake_us <= s().now ? READY : task->state;
+}
+
+const char* task_name_get(Task* task) {
+  if (task == nullptr) task = s().current;
+  return task == nullptr ? "" : task->name;
+}
+
+Task* task_by_name(const char* name) {
+  for (auto& t : s().tasks)
+    if (t->state != DELETED && std::strcmp(t->name, name) == 0) return t.get();
+  return nullptr;
+}
+
+std::uint32_t task_count() {
+  std::uint32_t count = 0;
+  for (auto& t : s().tasks)
+    if (t->state != DELETED) count++;
+  return count;
+}
+
+void task_join(Task* task) {
+  Task* self = s().current;
+  if (task == nullptr || self == nullptr) return;
+  while (task->state != DELETED) {
+    task->joiners.push_back(self);
+    task_sleep_until(NEVER);
+  }
+  clock_join(self->clock, task->clock);
+}
+
+// Actions match pros::notify_action_e_t
+std::uint32_t task_notify(Task* task, std::uint32_t value, int action, std::uint32_t* prev_value) {
+  if (task == nullptr || task->state == DELETED) return 0;
+  if (prev_value != nullptr) *prev_value = task->notify_value;
+  switch (action) {
+    case 1:  // Bits
+      task->notify_value |= value;
+      break;
+    case 2:  // Increment
+      task->notify_value++;
+      break;
+    case 3:  // Overwrite
+      task->notify_value = value;
+      break;
+    case 4:  // No overwrite
+      if (task->notify_pending) return 0;
+      task->notify_value = value;
+      break;
+    default:
+      break;
+  }
+  task->notify_pending = true;
+  Task* self = s().current;
+  if (self != nullptr) {
+    clock_join(task->notify_clock, self->clock);
+    clock_tick(self);
+  }
+  if (task->waiting_notify && task->state == BLOCKED) make_ready(task);
+  preempt_point();
+  return 1;
+}
+
+std::uint32_t task_notify_take(bool clear_on_exit, std::uint32_t timeout_ms) {
+  Task* task = s().current;
+  if (task == nullptr) return 0;
+  if (task->notify_value == 0 && timeout_ms > 0) {
+    task->waiting_notify = true;
+    task_sleep_until(timeout_ms == 0xffffffffu ? NEVER : s().now + timeout_ms * 1000ull);
+    task->waiting_notify = false;
+  }
+  std::uint32_t value = task->notify_value;
+  if (value != 0) clock_join(task->clock, task->notify_clock);
+  if (value != 0) task->notify_value = clear_on_exit ? 0 : value - 1;
+  task->notify_pending = false;
+  return value;
+}
+
+bool task_notify_clear(Task* task) {
+  if (task == nullptr) task = s().current;
+  if (task == nullptr) return false;
+  bool was = task->notify_pending;
+  task->notify_pending = false;
+  return was;
+}
+
+Mutex* mutex_create() {
+  s().mutexes.push_back(std::make_unique<Mutex>());
+  return s().mutexes.back().get();
+}
+
+namespace {
+// Reports a task about to wait forever on a mutex that can never come back
+void deadlock_check(Task* task, Mutex* mutex) {
+  std::string chain = task_label(task);
+  Task* owner = mutex->owner;
+  for (size_t steps = 0; owner != nullptr && steps <= s().tasks.size(); steps++) {
+    chain += " waits for " + task_label(owner);
+    if (owner == task) {
+      issue_add(DEADLOCK, "mutex cycle: " + chain);
+      return;
+    }
+    if (owner->state == DELETED) {
+      issue_add(DEADLOCK, "mutex never given back: " + chain + ", which ended");
+      return;
+    }
+    owner = owner->waiting_mutex == nullptr ? nullptr : owner->waiting_mutex->owner;
+  }
+}
+}  // namespace
+
+bool mutex_take(Mutex* mutex, std::uint32_t timeout_ms) {
+  Task* task = s().current;
+  if (mutex == nullptr) return false;
+  if (mutex->owner == nullptr) {
+    mutex->owner = task;
+    if (task != nullptr) clock_join(task->clock, mutex->clock);
+    return true;
+  }
+  if (timeout_ms == 0 || task == nullptr) return false;
+  if (timeout_ms == 0xffffffffu) deadlock_check(task, mutex);
+
+  // Like FreeRTOS, the owner runs at the waiter's priority until it gives the mutex back
+  Task* owner = mutex->owner;
+  bool inverted = owner->priority < task->priority;
+  if (inverted) owner->priority = task->priority;
+  std::uint64_t start_us = s().now;
+
+  // mutex_give hands the mutex straight to the first waiter
+  mutex->waiters.push_back(task);
+  task->waiting_mutex = mutex;
+  task_sleep_until(timeout_ms == 0xffffffffu ? NEVER : s().now + timeout_ms * 1000ull);
+  task->waiting_mutex = nullptr;
+  if (inverted) {
+    issue_add(INVERSION, task_label(task) + " (priority " + std::to_string(task->base_priority) + ") waited on a mutex held by " + task_label(owner) +
+                             " (priority " + std::to_string(owner->base_priority) + ")",
+              s().now - start_us);
+  }
+  if (mutex->owner == task) {
+    clock_join(task->clock, mutex->clock);
+    return true;
+  }
+  for (auto it = mutex->waiters.begin(); it != mutex->waiters.end(); it++) {
+    if (*it == task) {
+      mutex->waiters.erase(it);
+      break;
+    }
+  }
+  return false;
+}
+
+bool mutex_give(Mutex* mutex) {
+  Task* self = s().current;
+  if (mutex == nullptr || mutex->owner != self) return false;
+  if (self != nullptr) {
+    mutex->clock = self->clock;
+    clock_tick(self);
+    self->priority = self->base_priority;
+  }
+  mutex->owner = nullptr;
+  if (!mutex->waiters.empty()) {
+    // Highest priority waiter gets it, first come first served on ties
+    auto best = mutex->waiters.begin();
+    for (auto it = mutex->waiters.begin(); it != mutex->waiters.end(); it++)
+      if ((*it)->priority > (*best)->priority) best = it;
+    Task* next = *best;
+    mutex->waiters.erase(best);
+    mutex->owner = next;
+    make_ready(next);
+  }
+  preempt_point();
+  return true;
+}
+
+void mutex_delete(Mutex* mutex) {
+  if (mutex != nullptr) mutex->waiters.clear();
+}
+
+void step_callback_set(void (*callback)(double dt), std::uint32_t max_step_ms) {
+  s().step = callback;
+  s().step_ms = std::max<std::uint32_t>(max_step_ms, 1);
+}
+
+void schedule_seed_set(std::uint64_t seed, double preempt_chance) {
+  s().seed = seed;
+  s().random = seed;
+  s().preempt_chance = preempt_chance;
+}
+
+void shared_write(const void* device, const char* kind, int port, char letter) {
+  Scheduler& sc = s();
+  Task* self = sc.current;
+  if (self == nullptr) return;
+
+  // A write races the last one unless that task synchronized with this one
+  // since.  Tasks that have ended are left out, the competition switch or a
+  // join orders them.  A takeover lands after the last write whatever ran
+  // between them, so only a write after it can race.
+  Scheduler::Write& last = sc.writes[device];
+  if (last.task != nullptr && last.task != self && last.task->state != DELETED && !self->taking_over &&
+      (last.task->id >= (int)self->clock.size() || self->clock[last.task->id] < last.epoch)) {
+    std::string where = std::to_string(port);
+    if (letter != 0) where += letter;
+    issue_add(RACE, std::string(kind) + " commanded by " + task_label(last.task) + " then " + task_label(self) + " with nothing between them", 0,
+              where);
+  }
+  last.task = self;
+  last.epoch = self->clock[self->id];
+  preempt_point();
+}
+
+void handoff(const void* key) {
+  Task* self = s().current;
+  if (self == nullptr) return;
+  Clock& through = s().handoffs[key];
+  clock_join(self->clock, through);
+  through = self->clock;
+  clock_tick(self);
+}
+
+void takeover_begin() {
+  if (s().current != nullptr) s().current->taking_over = true;
+}
+
+void takeover_end() {
+  if (s().current != nullptr) s().current->taking_over = false;
+}
+
+const std::vector<Issue>& issues() { return s().issues; }
+
+void issues_clear() { s().issues.clear(); }
+
+run_result run(void (*function)(), const char* name, std::uint32_t limit_ms) {
+  Task* main = task_create([](void* fn) { reinterpret_cast<void (*)()>(fn)(); }, reinterpret_cast<void*>(function), 8, name);
+  run_result result = loop(main, s().now + limit_ms * 1000ull);
+
+  // Like the competition switch, a main task that runs out of time is stopped
+  if (result != FINISHED) finish(main);
+  return result;
+}
+
+run_result run_for(std::uint32_t ms) { return loop(nullptr, s().now + ms * 1000ull); }
+
+std::uint64_t switch_count() { return s().switches; }
+
+}  // namespace sim
+}  // namespace pls
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pls {
+namespace sim {
+/**
+ * Cooperative scheduler behind the simulated pros::Task, pros::Mutex and
+ * pros::delay.
+ *
+ * Every task runs on its own stack, but only one runs at a time and it keeps
+ * running until it blocks.  When every task is blocked the clock jumps straight
+ * to the next wake up, stepping the world 1ms at a time on the way, so a run
+ * takes as long as the code takes to execute and not as long as the delays.
+ */
+
+/**
+ * Task states, matching pros::task_state_e_t.
+ */
+enum task_state { RUNNING = 0,
+                  READY,
+                  BLOCKED,
+                  SUSPENDED,
+                  DELETED,
+                  INVALID };
+
+struct Task;
+struct Mutex;
+
+/**
+ * Simulated time since the program started, in microseconds.
+ */
+std::uint64_t now_us();
+
+/**
+ * Simulated time since the program started, in milliseconds.
+ */
+std::uint32_t now_ms();
+
+/**
+ * Creates a task.  Tasks created before run() start when it is called.
+ *
+ * \param function
+ *        task body
+ * \param parameters
+ *        passed to function
+ * \param priority
+ *        1 to 16, higher runs first
+ * \param name
+ *        task name, copied
+ */
+Task* task_create(void (*function)(void*), void* parameters, std::uint32_t priority, const char* name);
+
+/**
+ * Returns the running task, or nullptr outside of run().
+ */
+Task* task_current();
+
+/**
+ * Deletes a task.  Deleting the running task does not return.
+ */
+void task_delete(Task* task);
+
+/**
+ * Blocks the running task until the clock reaches wake_us.
+ *
+ * \param wake_us
+ *        absolute time to wake up, in microseconds
+ */
+void task_sleep_until(std::uint64_t wake_us);
+
+/**
+ * Lets other ready tasks of the same priority run.
+ */
+void task_yield();
+
+void task_suspend(Task* task);
+void task_resume(Task* task);
+std::uint32_t task_priority_get(Task* task);
+void task_priority_set(Task* task, std::uint32_t priority);
+task_state task_state_get(Task* task);
+const char* task_name_get(Task* task);
+Task* task_by_name(const char* name);
+std::uint32_t task_count();
+
+/**
+ * Blocks until task returns or is deleted.
+ */
+void task_join(Task* task);
+
+/**
+ * Task notifications, see pros::c::task_notify_ext for the actions.
+ */
+std::uint32_t task_notify(Task* task, std::uint32_t value, int action, std::uint32_t* prev_value);
+std::uint32_t task_notify_take(bool clear_on_exit, std::uint32_t timeout_ms);
+bool task_notify_clear(Task* task);
+
+Mutex* mutex_create();
+bool mutex_take(Mutex* mutex, std::uint32_t timeout_ms);
+bool mutex_give(Mutex* mutex);
+void mutex_delete(Mutex* mutex);
+
+/**
+ * Called as the clock moves, before tasks waking at the end of each step run.
+ * Steps end on whole milliseconds and wherever a task wakes, so nothing can
+ * read the devices partway through one.  Device models and physics hook in here.
+ *
+ * \param callback
+ *        called with the step length in seconds
+ * \param max_step_ms
+ *        longest step the callback takes, 1 calls it every simulated millisecond
+ */
+void step_callback_set(void (*callback)(double dt), std::uint32_t max_step_ms = 1);
+
+/**
+ * Why run() returned.
+ */
+enum run_result { FINISHED = 0,
+                  TIMED_OUT,
+                  DEADLOCKED };
+
+/**
+ * Runs function as a task, along with every other task, until it returns or the
+ * time limit is hit.  Other tasks are left where they are, so run() can be
+ * called again to continue, like the competition switch moving from
+ * initialize to autonomous.
+ *
+ * \param function
+ *        body of the task, like initialize or autonomous
+ * \param name
+ *        task name
+ * \param limit_ms
+ *        most simulated time to run for, from now
+ */
+run_result run(void (*function)(), const char* name, std::uint32_t limit_ms);
+
+/**
+ * Runs every task until the clock has moved forward ms, without a main task.
+ */
+run_result run_for(std::uint32_t ms);
+
+/**
+ * Number of task switches since the program started.
+ */
+std::uint64_t switch_count();
+
+/**
+ * Shuffles the order ready tasks of the same priority run in, and lets the
+ * running task be switched out at mutex gives, notifications and device
+ * commands, all from a seed.  The same seed always gives the same schedule.
+ * Seed 0, the default, runs the one fixed order.
+ *
+ * \param seed
+ *        schedule to run, 0 for the fixed order
+ * \param preempt_chance
+ *        chance of switching tasks at each of those points
+ */
+void schedule_seed_set(std::uint64_t seed, double preempt_chance = 0.1);
+
+/**
+ * Notes that the running task commanded a device, for the race check.  Two
+ * tasks commanding the same device without a mutex, notification, join or task
+ * creation ordering them is a race.
+ *
+ * \param device
+ *        the device, or the part of it, that was commanded
+ * \param kind
+ *        what it is for the report, like "motor"
+ * \param port
+ *        its port for the report
+ * \param letter
+ *        three wire port letter for the report, 0 for none
+ */
+void shared_write(const void* device, const char* kind, int port, char letter = 0);
+
+/**
+ * Notes that the running task read or set a variable other tasks poll, like
+ * EZ-Template's drive mode.  On the V5's one core such a variable behaves like
+ * an atomic, so each task to pass through the same key is ordered after the
+ * ones that did before it.
+ *
+ * \param key
+ *        the variable
+ */
+void handoff(const void* key);
+
+/**
+ * Device writes between these stop what another task was commanding, like
+ * EZ-Template's drive_mode_set(DISABLE) zeroing the drive the autonomous task
+ * was driving.  The stop lands after that task's last command, so it isn't a
+ * race.  The other task commanding again after the stop still is.
+ */
+void takeover_begin();
+void takeover_end();
+
+/**
+ * Concurrency problems seen while running.
+ */
+enum issue_kind { RACE = 0,  // Two tasks commanded a device with nothing ordering them
+                  DEADLOCK,  // A task waits forever on a mutex that can't come back
+                  INVERSION };  // A task waited on a mutex a lower priority task held
+
+struct Issue {
+  issue_kind kind;
+  std::string text;
+  std::string details;     // Ports a race was seen on
+  std::uint64_t first_us;  // When it was first seen
+  int count;
+  std::uint64_t worst_us;  // Longest an inversion lasted
+};
+
+/**
+ * Issues seen since the program started or issues_clear(), each once.
+ */
+const std::vector<Issue>& issues();
+
+void issues_clear();
+}  // namespace sim
+}  // namespace pls
@@ -0,0 +1,25 @@
+// Host build of squiggles' QuinticPolynomial, only the headers ship with the V5 library
+
+#include "math/quinticpolynomial.hpp"
+
+namespace squiggles {
+QuinticPolynomial::QuinticPolynomial(double s_p, double s_v, double s_a, double g_p, double g_v, double g_a, double t) {
+  double t2 = t * t;
+  double t3 = t2 * t;
+  double distance = g_p - s_p;
+  a0 = s_p;
+  a1 = s_v;
+  a2 = s_a / 2.0;
+  a3 = (20.0 * distance - (8.0 * g_v + 12.0 * s_v) * t - (3.0 * s_a - g_a) * t2) / (2.0 * t3);
+  a4 = (-30.0 * distance + (14.0 * g_v + 16.0 * s_v) * t + (3.0 * s_a - 2.0 * g_a) * t2) / (2.0 * t3 * t);
+  a5 = (12.0 * distance - 6.0 * (g_v + s_v) * t + (g_a - s_a) * t2) / (2.0 * t3 * t2);
+}
+
+double QuinticPolynomial::calc_point(double t) { return a0 + t * (a1 + t * (a2 + t * (a3 + t * (a4 + t * a5)))); }
+
+double QuinticPolynomial::calc_first_derivative(double t) { return a1 + t * (2.0 * a2 + t * (3.0 * a3 + t * (4.0 * a4 + t * 5.0 * a5))); }
+
+double QuinticPolynomial::calc_second_derivative(double t) { return 2.0 * a2 + t * (6.0 * a3 + t * (12.0 * a4 + t * 20.0 * a5)); }
+
+double QuinticPolynomial::calc_third_derivative(double t) { return 6.0 * a3 + t * (24.0 * a4 + t * 60.0 * a5); }
+}  // namespace squiggles
@@ -0,0 +1,256 @@
+// Host build of squiggles' SplineGenerator, only the headers ship with the V5 library
+
+#include "spline.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace squiggles {
+SplineGenerator::SplineGenerator(Constraints iconstraints, std::shared_ptr<PhysicalModel> imodel, double idt)
+    : constraints(iconstraints), model(imodel), dt(idt) {}
+
+std::vector<ProfilePoint> SplineGenerator::generate(std::vector<Pose> iwaypoints, bool fast) {
+  std::vector<ControlVector> vectors(iwaypoints.begin(), iwaypoints.end());
+  return _generate(vectors.begin(), vectors.end(), fast);
+}
+
+std::vector<ProfilePoint> SplineGenerator::generate(std::initializer_list<Pose> iwaypoints, bool fast) {
+  std::vector<ControlVector> vectors(iwaypoints.begin(), iwaypoints.end());
+  return _generate(vectors.begin(), vectors.end(), fast);
+}
+
+std::vector<ProfilePoint> SplineGenerator::generate(std::vector<ControlVector> iwaypoints) {
+  return _generate(iwaypoints.begin(), iwaypoints.end(), false);
+}
+
+std::vector<ProfilePoint> SplineGenerator::generate(std::initializer_list<ControlVector> iwaypoints) {
+  return _generate(iwaypoints.begin(), iwaypoints.end(), false);
+}
+
+template <class Iter>
+std::vector<ProfilePoint> SplineGenerator::_generate(Iter start, Iter end, bool fast) {
+  std::vector<ProfilePoint> result;
+  if (start == end) return result;
+  for (Iter it = start; std::next(it) != end; ++it) {
+    ControlVector from = *it;
+    ControlVector to = *std::next(it);
+    std::vector<GeneratedPoint> raw = gen_raw_path(from, to, fast);
+    double start_time = result.empty() ? 0.0 : result.back().time;
+    std::vector<ProfilePoint> segment = parameterize(from, to, raw, from.vel, to.vel, start_time);
+
+    // Segments share their end points
+    auto first = segment.begin();
+    if (!result.empty() && first != segment.end()) ++first;
+    result.insert(result.end(), first, segment.end());
+  }
+  return result;
+}
+
+std::vector<SplineGenerator::GeneratedVector> SplineGenerator::gen_single_raw_path(ControlVector start, ControlVector end, int duration, double start_vel,
+                                                                                  double end_vel) {
+  start.vel = start_vel;
+  end.vel = end_vel;
+  QuinticPolynomial x_qp = get_x_spline(start, end, duration);
+  QuinticPolynomial y_qp = get_y_spline(start, end, duration);
+
+  int steps = std::max(1, (int)std::ceil(duration / dt));
+  std::vector<GeneratedVector> path;
+  path.reserve(steps + 1);
+  for (int i = 0; i <= steps; i++) {
+    double t = duration * i / (double)steps;
+    double x = x_qp.calc_point(t), y = y_qp.calc_point(t);
+    double dx = x_qp.calc_first_derivative(t), dy = y_qp.calc_first_derivative(t);
+    double ddx = x_qp.calc_second_derivative(t), ddy = y_qp.calc_second_derivative(t);
+    double dddx = x_qp.calc_third_derivative(t), dddy = y_qp.calc_third_derivative(t);
+
+    double vel = std::hypot(dx, dy);
+    double curvature = vel < K_EPSILON ? 0.0 : (dx * ddy - dy * ddx) / (vel * vel * vel);
+    double yaw = vel < K_EPSILON ? (i == 0 ? start.pose.yaw : end.pose.yaw) : std::atan2(dy, dx);
+    path.emplace_back(GeneratedPoint(Pose(x, y, yaw), curvature), vel, std::hypot(ddx, ddy), std::hypot(dddx, dddy));
+  }
+  return path;
+}
+
+// Sum of squared acceleration, jerk and curvature, lower is smoother.  Infinite
+// if the path breaks the constraints.
+static double raw_path_cost(const std::vector<SplineGenerator::GeneratedVector>& path, const Constraints& constraints, bool* valid) {
+  double cost = 0.0;
+  *valid = true;
+  for (const auto& p : path) {
+    if (p.accel > constraints.max_accel || p.jerk > constraints.max_jerk || std::fabs(p.point.curvature) > constraints.max_curvature) *valid = false;
+    cost += p.accel * p.accel + p.jerk * p.jerk + p.point.curvature * p.point.curvature;
+  }
+  return cost / path.size();
+}
+
+static std::vector<SplineGenerator::GeneratedPoint> points_of(const std::vector<SplineGenerator::GeneratedVector>& path) {
+  std::vector<SplineGenerator::GeneratedPoint> points;
+  points.reserve(path.size());
+  for (const auto& p : path) points.push_back(p.point);
+  return points;
+}
+
+std::vector<SplineGenerator::GeneratedPoint> SplineGenerator::gen_raw_path(ControlVector& start, ControlVector& end, bool fast) {
+  if (std::isnan(start.vel) || std::isnan(end.vel)) return gradient_descent(start, end, fast);
+
+  // Zero velocities make cusps, the profile puts the real ones back
+  double start_vel = start.vel > K_EPSILON ? start.vel : K_DEFAULT_VEL;
+  double end_vel = end.vel > K_EPSILON ? end.vel : K_DEFAULT_VEL;
+  std::vector<GeneratedVector> path;
+  for (int duration = T_MIN; duration <= T_MAX; duration++) {
+    path = gen_single_raw_path(start, end, duration, start_vel, end_vel);
+    bool valid;
+    raw_path_cost(path, constraints, &valid);
+    if (valid) break;
+  }
+  return points_of(path);
+}
+
+std::vector<SplineGenerator::GeneratedPoint> SplineGenerator::gradient_descent(ControlVector& start, ControlVector& end, bool fast) {
+  double distance = start.pose.dist(end.pose);
+  std::vector<GeneratedVector> best;
+  double best_cost = std::numeric_limits<double>::infinity();
+  bool best_valid = false;
+
+  for (int duration = T_MIN; duration <= T_MAX; duration++) {
+    // Descend on the log of the dummy velocity, starting at the average speed
+    double log_vel = std::log(std::max(distance / duration, K_EPSILON) * K_DEFAULT_VEL);
+    double step = 0.5;
+    bool valid;
+    auto cost_at = [&](double lv, bool* v) { return raw_path_cost(gen_single_raw_path(start, end, duration, std::exp(lv), std::exp(lv)), constraints, v); };
+    double cost = cost_at(log_vel, &valid);
+    for (int i = 0; i < MAX_GRAD_DESCENT_ITERATIONS; i++) {
+      bool up_valid, down_valid;
+      double up = cost_at(log_vel + step, &up_valid);
+      double down = cost_at(log_vel - step, &down_valid);
+      if (up < cost && up <= down) {
+        log_vel += step;
+        cost = up;
+        valid = up_valid;
+      } else if (down < cost) {
+        log_vel -= step;
+        cost = down;
+        valid = down_valid;
+      } else {
+        step /= 2.0;
+      }
+    }
+
+    // Valid paths beat smooth ones
+    if ((valid && !best_valid) || (valid == best_valid && cost < best_cost)) {
+      best = gen_single_raw_path(start, end, duration, std::exp(log_vel), std::exp(log_vel));
+      best_cost = cost;
+      best_valid = valid;
+      if (fast && valid) break;
+    }
+  }
+  return points_of(best);
+}
+
+std::vector<ProfilePoint> SplineGenerator::parameterize(const ControlVector start, const ControlVector end, const std::vector<GeneratedPoint>& raw_path,
+                                                        const double preferred_start_vel, const double preferred_end_vel, const double start_time) {
+  if (raw_path.empty()) return {};
+
+  std::vector<ConstrainedState> states;
+  states.reserve(raw_path.size());
+  double distance = 0.0;
+  for (size_t i = 0; i < raw_path.size(); i++) {
+    if (i > 0) distance += raw_path[i].pose.dist(raw_path[i - 1].pose);
+    double max_vel = constraints.max_vel;
+    if (std::fabs(raw_path[i].curvature) > K_EPSILON) max_vel = std::min(max_vel, constraints.max_curvature / std::fabs(raw_path[i].curvature));
+    states.emplace_back(raw_path[i].pose, raw_path[i].curvature, distance, max_vel, constraints.min_accel, constraints.max_accel);
+    enforce_accel_lims(&states.back());
+  }
+
+  states.front().max_vel = std::isnan(preferred_start_vel) ? 0.0 : std::min(states.front().max_vel, preferred_start_vel);
+  for (size_t i = 1; i < states.size(); i++) forward_pass(&states[i - 1], &states[i]);
+  states.back().max_vel = std::isnan(preferred_end_vel) ? 0.0 : std::min(states.back().max_vel, preferred_end_vel);
+  for (size_t i = states.size() - 1; i > 0; i--) backward_pass(&states[i], &states[i - 1]);
+
+  std::vector<ProfilePoint> points = integrate_constrained_states(states);
+  double duration = points.back().time;
+  std::vector<ProfilePoint> output;
+  output.reserve(duration / dt + 2);
+  for (double t = 0.0; t < duration - K_EPSILON; t += dt) output.push_back(get_point_at_time(start, end, points, t));
+  output.push_back(points.back());
+  for (ProfilePoint& p : output) p.time += start_time;
+  return output;
+}
+
+std::vector<ProfilePoint> SplineGenerator::integrate_constrained_states(std::vector<ConstrainedState> constrainedStates) {
+  std::vector<ProfilePoint> points;
+  points.reserve(constrainedStates.size());
+  double time = 0.0;
+  for (size_t i = 0; i < constrainedStates.size(); i++) {
+    const ConstrainedState& state = constrainedStates[i];
+    if (i > 0) {
+      const ConstrainedState& last = constrainedStates[i - 1];
+      double ds = state.distance - last.distance;
+      double average = (state.max_vel + last.max_vel) / 2.0;
+      if (average > K_EPSILON) time += ds / average;
+    }
+    double accel = 0.0;
+    if (i + 1 < constrainedStates.size()) {
+      const ConstrainedState& next = constrainedStates[i + 1];
+      accel = ai(next.max_vel, state.max_vel, next.distance - state.distance);
+    }
+    points.emplace_back(ControlVector(state.pose, state.max_vel, accel, 0.0), model->linear_to_wheel_vels(state.max_vel, state.curvature), state.curvature,
+                        time);
+  }
+  return points;
+}
+
+ProfilePoint SplineGenerator::get_point_at_time(const ControlVector start, const ControlVector end, std::vector<ProfilePoint> points, double t) {
+  auto after = std::lower_bound(points.begin(), points.end(), t, [](const ProfilePoint& p, double time) { return p.time < time; });
+  if (after == points.begin()) return points.front();
+  if (after == points.end()) return points.back();
+  if (nearly_equal(after->time, t)) return *after;
+  const ProfilePoint& before = *std::prev(after);
+  double i = (t - before.time) / (after->time - before.time);
+  return lerp_point(get_x_spline(start, end, after->time), get_y_spline(start, end, after->time), before, *after, i);
+}
+
+ProfilePoint SplineGenerator::lerp_point([[maybe_unused]] QuinticPolynomial x_qp, [[maybe_unused]] QuinticPolynomial y_qp, ProfilePoint start, ProfilePoint end,
+                                         double i) {
+  auto lerp = [i](double a, double b) { return a + (b - a) * i; };
+  double yaw_change = std::remainder(end.vector.pose.yaw - start.vector.pose.yaw, 2.0 * M_PI);
+  Pose pose(lerp(start.vector.pose.x, end.vector.pose.x), lerp(start.vector.pose.y, end.vector.pose.y), start.vector.pose.yaw + yaw_change * i);
+  std::vector<double> wheels(start.wheel_velocities.size());
+  for (size_t w = 0; w < wheels.size() && w < end.wheel_velocities.size(); w++) wheels[w] = lerp(start.wheel_velocities[w], end.wheel_velocities[w]);
+  return ProfilePoint(ControlVector(pose, lerp(start.vector.vel, end.vector.vel), lerp(start.vector.accel, end.vector.accel), 0.0), wheels,
+                      lerp(start.curvature, end.curvature), lerp(start.time, end.time));
+}
+
+QuinticPolynomial SplineGenerator::get_x_spline(const ControlVector start, const ControlVector end, const double duration) {
+  return QuinticPolynomial(start.pose.x, start.vel * std::cos(start.pose.yaw), start.accel * std::cos(start.pose.yaw), end.pose.x,
+                           end.vel * std::cos(end.pose.yaw), end.accel * std::cos(end.pose.yaw), duration);
+}
+
+QuinticPolynomial SplineGenerator::get_y_spline(const ControlVector start, const ControlVector end, const double duration) {
+  return QuinticPolynomial(start.pose.y, start.vel * std::sin(start.pose.yaw), start.accel * std::sin(start.pose.yaw), end.pose.y,
+                           end.vel * std::sin(end.pose.yaw), end.accel * std::sin(end.pose.yaw), duration);
+}
+
+void SplineGenerator::enforce_accel_lims(ConstrainedState* state) {
+  Constraints limits = model->constraints(state->pose, state->curvature, state->max_vel);
+  state->max_vel = std::min(state->max_vel, limits.max_vel);
+  state->min_accel = std::max(constraints.min_accel, limits.min_accel);
+  state->max_accel = std::min(constraints.max_accel, limits.max_accel);
+}
+
+void SplineGenerator::forward_pass(ConstrainedState* predecessor, ConstrainedState* successor) {
+  double ds = successor->distance - predecessor->distance;
+  successor->max_vel = std::min(successor->max_vel, vf(predecessor->max_vel, predecessor->max_accel, ds));
+  enforce_accel_lims(successor);
+}
+
+void SplineGenerator::backward_pass(ConstrainedState* predecessor, ConstrainedState* successor) {
+  double ds = predecessor->distance - successor->distance;
+  successor->max_vel = std::min(successor->max_vel, vf(predecessor->max_vel, -predecessor->min_accel, ds));
+  enforce_accel_lims(successor);
+}
+
+double SplineGenerator::vf(double vi, double a, double ds) { return std::sqrt(std::max(0.0, vi * vi + 2.0 * a * ds)); }
+
+double SplineGenerator::ai(double vf, double vi, double s) { return s < K_EPSILON ? 0.0 : (vf * vf - vi * vi) / (2.0 * s); }
+}  // namespace squiggles
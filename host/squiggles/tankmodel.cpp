@@ -0,0 +1,30 @@
+// Host build of squiggles' TankModel, only the headers ship with the V5 library
+
+#include "physicalmodel/tankmodel.hpp"
+
+namespace squiggles {
+TankModel::TankModel(double itrack_width, Constraints ilinear_constraints) : track_width(itrack_width), linear_constraints(ilinear_constraints) {}
+
+Constraints TankModel::constraints(const Pose pose, double curvature, double vel) {
+  auto [min_accel, max_accel] = accel_constraint(pose, curvature, vel);
+  return Constraints(vel_constraint(pose, curvature, vel), max_accel, linear_constraints.max_jerk, linear_constraints.max_curvature, min_accel);
+}
+
+// Left then right, positive curvature turns left
+std::vector<double> TankModel::linear_to_wheel_vels(double lin_vel, double curvature) {
+  return {lin_vel * (1.0 - curvature * track_width / 2.0), lin_vel * (1.0 + curvature * track_width / 2.0)};
+}
+
+// Fastest the center can go with the outside wheel at its limit
+double TankModel::vel_constraint([[maybe_unused]] const Pose pose, double curvature, [[maybe_unused]] double vel) {
+  return linear_constraints.max_vel / (1.0 + std::fabs(curvature) * track_width / 2.0);
+}
+
+std::tuple<double, double> TankModel::accel_constraint([[maybe_unused]] const Pose pose, [[maybe_unused]] double curvature, [[maybe_unused]] double vel) const {
+  return {linear_constraints.min_accel, linear_constraints.max_accel};
+}
+
+std::string TankModel::to_string() const {
+  return "TankModel {track_width: " + std::to_string(track_width) + ", linear_constraints: " + linear_constraints.to_string() + "}";
+}
+}  // namespace squiggles
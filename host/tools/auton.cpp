@@ -0,0 +1,134 @@
+// Runs one autonomous routine on the simulated robot, the same way the field
+// does: initialize, then autonomous with the selector on that routine.
+//
+//   make host
+//   ./bin/host/auton RA7        Run RA7
+//   ./bin/host/auton -q skills  Run skills without the motion prints
+//   ./bin/host/auton -S 7 RA7   Run RA7 with tasks interleaved by seed 7, see host/tools/schedules.cpp
+//
+// Prints each motion's time and exit, the routine's time on the field clock, how
+// long the run took here and how far odom is from where the robot really ended up,
+// then any races, deadlocks or priority inversions the scheduler saw.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "main.h"
+#include "sim/robot.hpp"
+#include "sim/scheduler.hpp"
+#include "tools/routines.hpp"
+
+namespace {
+
+using pls::sim::Routine;
+using pls::sim::ROUTINES;
+
+void usage() {
+  fprintf(stderr, "usage: auton [-q] [-l limit_ms] [-S schedule_seed] [-P preempt_chance] <routine>\nroutines:");
+  for (const Routine& routine : ROUTINES) fprintf(stderr, " %s", routine.name);
+  fprintf(stderr, "\n");
+}
+
+const char* result_name(pls::sim::run_result result) {
+  switch (result) {
+    case pls::sim::FINISHED:
+      return "finished";
+    case pls::sim::TIMED_OUT:
+      return "timed out";
+    default:
+      return "deadlocked";
+  }
+}
+
+// Prints each motion autonomous() traced, how long it took and how it exited
+void motions_print() {
+  printf("\n  %-24s %9s %8s  %s\n", "motion", "target", "time", "exit");
+  double total_s = 0.0;
+  const pls::trace::Event* begin = nullptr;
+  for (int i = 0; i < pls::trace::size(); i++) {
+    const pls::trace::Event& e = pls::trace::event_get(i);
+    if (e.track != pls::trace::MOTION) continue;
+    if (e.phase == 'B') {
+      begin = &e;
+    } else if (e.phase == 'E' && begin != nullptr) {
+      double s = (e.time_us - begin->time_us) / 1e6;
+      total_s += s;
+      printf("  %-24s %9.2f %7.2fs  %s\n", begin->name, begin->value, s, ez::exit_to_string((ez::exit_output)e.value).c_str());
+      begin = nullptr;
+    }
+  }
+  printf("  %-24s %9s %7.2fs\n", "all motions", "", total_s);
+}
+
+// Prints what the scheduler saw go wrong between tasks
+void issues_print() {
+  const char* kinds[] = {"race", "deadlock", "inversion"};
+  for (const pls::sim::Issue& issue : pls::sim::issues()) {
+    printf("  %-9s at %.2fs, %d times", kinds[issue.kind], issue.first_us / 1e6, issue.count);
+    if (issue.kind == pls::sim::INVERSION) printf(", worst %.1fms", issue.worst_us / 1000.0);
+    printf("\n    %s%s%s\n", issue.text.c_str(), issue.details.empty() ? "" : ", on ", issue.details.c_str());
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool quiet = false;
+  std::uint32_t limit_ms = 0;
+  std::uint64_t seed = 0;
+  double preempt_chance = 0.1;
+  const Routine* routine = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-q")) {
+      quiet = true;
+    } else if (!strcmp(argv[i], "-l") && i + 1 < argc) {
+      limit_ms = std::atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "-S") && i + 1 < argc) {
+      seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (!strcmp(argv[i], "-P") && i + 1 < argc) {
+      preempt_chance = std::atof(argv[++i]);
+    } else {
+      routine = pls::sim::routine_find(argv[i]);
+      if (routine == nullptr) {
+        usage();
+        return 2;
+      }
+    }
+  }
+  if (routine == nullptr) {
+    usage();
+    return 2;
+  }
+  if (limit_ms == 0) limit_ms = routine->limit_ms;
+
+  pls::sim::schedule_seed_set(seed, preempt_chance);
+  pls::sim::robot_install();
+  pls::sim::Devices& brain = pls::sim::devices();
+
+  if (pls::sim::run(initialize, "initialize", 10000) != pls::sim::FINISHED) {
+    fprintf(stderr, "initialize didn't finish\n");
+    return 1;
+  }
+  if (quiet) chassis.pid_print_toggle(false);
+
+  pls::sim::routine_select(*routine);
+
+  brain.competition.connected = true;
+  brain.competition.autonomous = true;
+  std::uint64_t start_us = pls::sim::now_us();
+  auto wall_start = std::chrono::steady_clock::now();
+  pls::sim::run_result result = pls::sim::run(autonomous, "autonomous", limit_ms);
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+  double sim_s = (pls::sim::now_us() - start_us) / 1e6;
+
+  motions_print();
+  pls::sim::RobotPose truth = pls::sim::robot_pose();
+  ez::pose odom = chassis.odom_pose_get();
+  printf("\n%s %s in %.2fs (%.3fs wall, %.0fx real time)\n", routine->name, result_name(result), sim_s, wall_s, wall_s > 0 ? sim_s / wall_s : 0.0);
+  printf("  robot (%.2f, %.2f, %.2f)  odom (%.2f, %.2f, %.2f)\n", truth.x, truth.y, truth.theta, odom.x, odom.y, odom.theta);
+  issues_print();
+  return result == pls::sim::FINISHED ? 0 : 1;
+}
@@ -0,0 +1,2186 @@
+// Times the code that runs every tick on the robot, so a change that makes a
+// loop slower shows up here before it shows up on the field.
+//
+//   make bench                                   Run everything, write bin/host/bench.json
+//   make bench BENCH_ARGS="-f pid"               Only benchmarks with "pid" in the name
+//   make bench BENCH_ARGS="-c bench-base.json"   Fail if anything got slower than a saved run
+//
+// Each benchmark runs in batches long enough to time well, then repeats the
+// batch and reports the median time per call with its spread.  Medians and MADs
+// (median absolute deviation) shrug off the odd batch the OS interrupts.  A
+// benchmark only counts as slower than the baseline if its median moved by
+// more than the threshold and by more than 3 MADs, so noise doesn't fail builds.
+//
+// EZ-Template, okapi's VelMath and EKFFilter and squiggles only ship as headers
+// and a V5 library, so these time the host builds of them in host/.  They follow
+// the same algorithms, so they catch regressions in how the robot code calls
+// them and in our own code, not in the V5 library itself.  The mechanism step
+// times the simulator, so simulations that use it can budget for it.
+//
+// The trig benchmarks time pls::fast against the libm calls it replaces, and
+// -a sweeps pls::fast against double libm instead of timing anything, failing
+// if a kernel is off by more than its documented bound.  It checks
+// pls::format_fixed() against snprintf on ties, subnormals and the fallback,
+// throws random and edge case angles at pls::angle and fails on any answer that isn't the
+// one ez::util gives, and drives pls::sim::Pursuit down a long path next to EZ's
+// lookahead search, failing on any tick they pick different points.  Last it
+// drives a path given as points and as a pls::PreparedPath and fails if the
+// robot ends up anywhere different, which checks PreparedPath against EZ's
+// injection and smoothing as host/ez has them, not the V5 library's.  Host timings only
+// rank the two, the NEON array versions only build for the brain.
+
+#include <sched.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "main.h"
+#include "okapi/api/filter/averageFilter.hpp"
+#include "okapi/api/filter/ekfFilter.hpp"
+#include "okapi/api/filter/medianFilter.hpp"
+#include "okapi/api/filter/velMath.hpp"
+#include "okapi/squiggles/squiggles.hpp"
+#include "pls/angle.hpp"
+#include "pls/fastmath.hpp"
+#include "pls/follower.hpp"
+#include "pls/format.hpp"
+#include "pls/motormodel.hpp"
+#include "pls/path.hpp"
+#include "pls/replan.hpp"
+#include "pls/spline.hpp"
+#include "pls/stream.hpp"
+#include "pls/transform.hpp"
+#include "pls/trajectory.hpp"
+#include "sim/devices.hpp"
+#include "sim/robot.hpp"
+#include "sim/scheduler.hpp"
+#include "tools/pool.hpp"
+#include "tools/pursuit.hpp"
+#include "tools/random.hpp"
+
+namespace {
+
+// Keeps the compiler from deleting work whose result isn't used
+template <typename T>
+inline void keep(T&& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+struct Benchmark {
+  const char* name;
+  std::function<void(std::uint64_t iterations)> run;
+};
+
+struct Result {
+  std::string name;
+  std::uint64_t iterations;  // Per sample
+  int samples;
+  double median_ns, mad_ns, min_ns, p90_ns;
+};
+
+struct Options {
+  double min_batch_ms = 5.0;
+  int samples = 25;
+  const char* filter = nullptr;
+  const char* json = nullptr;
+  const char* compare = nullptr;
+  double threshold = 10.0;  // Percent
+  bool accuracy = false;
+};
+
+double percentile(std::vector<double> values, double p) {
+  std::sort(values.begin(), values.end());
+  double index = p / 100.0 * (values.size() - 1);
+  size_t low = (size_t)index;
+  size_t high = std::min(low + 1, values.size() - 1);
+  return values[low] + (values[high] - values[low]) * (index - low);
+}
+
+double batch_ns(const Benchmark& benchmark, std::uint64_t iterations) {
+  auto start = std::chrono::steady_clock::now();
+  benchmark.run(iterations);
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+Result measure(const Benchmark& benchmark, const Options& options) {
+  // Grow the batch until it's long enough for the clock, which also warms up caches
+  std::uint64_t iterations = 1;
+  while (batch_ns(benchmark, iterations) < options.min_batch_ms * 1e6 && iterations < (1ull << 40)) iterations *= 2;
+
+  std::vector<double> per_call;
+  for (int i = 0; i < options.samples; i++) per_call.push_back(batch_ns(benchmark, iterations) / iterations);
+  double median = percentile(per_call, 50);
+  std::vector<double> deviations;
+  for (double ns : per_call) deviations.push_back(std::fabs(ns - median));
+  return {benchmark.name, iterations, options.samples, median, percentile(deviations, 50), *std::min_element(per_call.begin(), per_call.end()),
+          percentile(per_call, 90)};
+}
+
+//
+// The benchmarks
+//
+
+// Numbers the brain screen and terminal print, odom and sensor readings
+double format_input(std::uint64_t i) { return (double)(i % 4096) * 0.173 - 350.0; }
+
+void format_fixed_2(std::uint64_t n) {
+  char text[32];
+  for (std::uint64_t i = 0; i < n; i++) {
+    pls::format_fixed(text, format_input(i), 2);
+    keep(text);
+  }
+}
+
+void snprintf_fixed_2(std::uint64_t n) {
+  char text[32];
+  for (std::uint64_t i = 0; i < n; i++) {
+    snprintf(text, sizeof(text), "%.2f", format_input(i));
+    keep(text);
+  }
+}
+
+void ostringstream_fixed_2(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) {
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(2);
+    out << format_input(i);
+    keep(out.str());
+  }
+}
+
+void pid_compute(std::uint64_t n) {
+  ez::PID pid(8.4, 0.0, 46.5, 0.0, "bench");
+  pid.target_set(24.0);
+  double current = 0.0;
+  for (std::uint64_t i = 0; i < n; i++) {
+    double out = pid.compute(current);
+    keep(out);
+    current = current < 24.0 ? current + 0.01 : 0.0;
+  }
+}
+
+void slew_iterate(std::uint64_t n) {
+  ez::slew slew(3.0, 70);
+  double current = 0.0;
+  slew.initialize(true, 110.0, 24.0, current);
+  for (std::uint64_t i = 0; i < n; i++) {
+    double out = slew.iterate(current);
+    keep(out);
+    current += 0.01;
+    if (current > 4.0) {
+      current = 0.0;
+      slew.initialize(true, 110.0, 24.0, current);
+    }
+  }
+}
+
+void turn_shortest(std::uint64_t n) {
+  double target = 0.0;
+  for (std::uint64_t i = 0; i < n; i++) {
+    double out = ez::util::turn_shortest(target, 45.0);
+    keep(out);
+    target = target < 720.0 ? target + 1.7 : -720.0;
+  }
+}
+
+void wrap_angle(std::uint64_t n) {
+  double theta = -1000.0;
+  for (std::uint64_t i = 0; i < n; i++) {
+    double out = ez::util::wrap_angle(theta);
+    keep(out);
+    theta = theta < 1000.0 ? theta + 3.3 : -1000.0;
+  }
+}
+
+void angle_turn_shortest(std::uint64_t n) {
+  double target = 0.0;
+  for (std::uint64_t i = 0; i < n; i++) {
+    double out = pls::angle::turn_shortest(target, 45.0);
+    keep(out);
+    target = target < 720.0 ? target + 1.7 : -720.0;
+  }
+}
+
+void angle_wrap(std::uint64_t n) {
+  double theta = -1000.0;
+  for (std::uint64_t i = 0; i < n; i++) {
+    double out = pls::angle::wrap(theta);
+    keep(out);
+    theta = theta < 1000.0 ? theta + 3.3 : -1000.0;
+  }
+}
+
+// 64 candidate headings per call
+void angle_wrap_array(std::uint64_t n) {
+  float theta[64], out[64];
+  for (int i = 0; i < 64; i++) theta[i] = -1000.0f + 31.3f * i;
+  for (std::uint64_t i = 0; i < n; i++) {
+    pls::angle::wrap(theta, out, 64);
+    keep(out);
+  }
+}
+
+void absolute_angle_to_point(std::uint64_t n) {
+  ez::pose current = {0.0, 0.0, 0.0};
+  for (std::uint64_t i = 0; i < n; i++) {
+    double out = ez::util::absolute_angle_to_point({24.0, 24.0, 0.0}, current);
+    keep(out);
+    current.x = current.x < 48.0 ? current.x + 0.1 : -48.0;
+  }
+}
+
+// One pass of the odom task on the simulated sensors, moving the robot forward and turning it
+void odometry_step(std::uint64_t n) {
+  pls::sim::Devices& brain = pls::sim::devices();
+  const pls::sim::RobotDescription& r = pls::sim::robot();
+  pls::sim::Rotation* vert = brain.rotation(r.vert_tracker_port);
+  pls::sim::Rotation* horiz = brain.rotation(r.horiz_tracker_port);
+  pls::sim::Imu* imu = brain.imu(r.imu_port);
+  for (std::uint64_t i = 0; i < n; i++) {
+    vert->angle -= 1.5;
+    horiz->angle += 0.2;
+    imu->yaw += 0.05;
+    chassis.ez_tracking_task();
+  }
+  ez::pose pose = chassis.odom_pose_get();
+  keep(pose);
+}
+
+// One 1ms step of the intake and pistons, with the intake running and the pistons cycling
+void mechanisms_step(std::uint64_t n) {
+  pls::sim::Devices& brain = pls::sim::devices();
+  pls::sim::Mechanisms& mechanisms = pls::sim::mechanisms();
+  const pls::sim::RobotDescription& r = pls::sim::robot();
+  for (int port : r.intake.ports) brain.motor(port)->voltage = port < 0 ? -12000.0 : 12000.0;
+  pls::sim::Adi* adi = brain.adi_get(pls::sim::ADI_SMART_PORT);
+  for (std::uint64_t i = 0; i < n; i++) {
+    if (i % 100 == 0)
+      for (const pls::sim::PistonDescription* piston : {&r.scraper, &r.switcher, &r.descore}) adi->value[piston->port - 'A'] ^= 1;
+    mechanisms.step(0.001);
+  }
+  double speed = mechanisms.link_velocity(0);
+  keep(speed);
+}
+
+void median_filter(std::uint64_t n) {
+  okapi::MedianFilter<5> filter;
+  double reading = 0.0;
+  for (std::uint64_t i = 0; i < n; i++) {
+    double out = filter.filter(reading);
+    keep(out);
+    reading = std::fmod(reading + 7.3, 100.0);
+  }
+}
+
+void average_filter(std::uint64_t n) {
+  okapi::AverageFilter<5> filter;
+  double reading = 0.0;
+  for (std::uint64_t i = 0; i < n; i++) {
+    double out = filter.filter(reading);
+    keep(out);
+    reading = std::fmod(reading + 7.3, 100.0);
+  }
+}
+
+void ekf_filter(std::uint64_t n) {
+  okapi::EKFFilter filter;
+  double reading = 0.0;
+  for (std::uint64_t i = 0; i < n; i++) {
+    double out = filter.filter(reading);
+    keep(out);
+    reading = std::fmod(reading + 7.3, 100.0);
+  }
+}
+
+// Timer the benchmark moves by hand, 10 ms a step like okapi's 100 Hz loops
+class StepTimer : public okapi::AbstractTimer {
+ public:
+  explicit StepTimer(okapi::QTime* inow) : AbstractTimer(*inow), now(inow) {}
+  okapi::QTime millis() const override { return *now; }
+
+ private:
+  okapi::QTime* now;
+};
+
+void vel_math_step(std::uint64_t n) {
+  using namespace okapi::literals;
+  okapi::QTime now = 0_ms;
+  okapi::VelMath vel_math(360.0, std::make_unique<okapi::AverageFilter<2>>(), 10_ms, std::make_unique<StepTimer>(&now));
+  double position = 0.0;
+  for (std::uint64_t i = 0; i < n; i++) {
+    now += 10_ms;
+    position += 12.0;
+    okapi::QAngularSpeed out = vel_math.step(position);
+    keep(out);
+  }
+}
+
+// A 24" s-curve with the drive's limits, in okapi's units of meters
+void spline_generate(std::uint64_t n) {
+  squiggles::Constraints limits(1.5, 3.0, 6.0);
+  auto model = std::make_shared<squiggles::TankModel>(0.29, limits);
+  squiggles::SplineGenerator generator(limits, model, 0.01);
+  for (std::uint64_t i = 0; i < n; i++) {
+    std::vector<squiggles::ProfilePoint> path = generator.generate({squiggles::Pose(0.0, 0.0, M_PI / 2.0), squiggles::Pose(0.3, 0.6, M_PI / 2.0)});
+    keep(path);
+  }
+}
+
+// The same s-curve held to what the motors and tires can do instead of fixed limits
+squiggles::Constraints motor_limits(3.0, 20.0, 60.0);
+squiggles::Pose s_curve_start(0.0, 0.0, M_PI / 2.0), s_curve_end(0.3, 0.6, M_PI / 2.0);
+
+// The same s-curve's segments with their distance tables
+void spline_segments(std::uint64_t n) {
+  squiggles::Constraints limits(1.5, 3.0, 6.0);
+  auto model = std::make_shared<squiggles::TankModel>(0.29, limits);
+  squiggles::SplineGenerator generator(limits, model, 0.01);
+  for (std::uint64_t i = 0; i < n; i++) {
+    std::vector<pls::Spline> segments = pls::Spline::segments(generator, {squiggles::Pose(0.0, 0.0, M_PI / 2.0), squiggles::Pose(0.3, 0.6, M_PI / 2.0)}, 0.01);
+    keep(segments);
+  }
+}
+
+void spline_generate_motor(std::uint64_t n) {
+  auto model = std::make_shared<pls::MotorModel>(pls::DrivetrainDescription{}, motor_limits);
+  squiggles::SplineGenerator generator(motor_limits, model, 0.01);
+  for (std::uint64_t i = 0; i < n; i++) {
+    std::vector<squiggles::ProfilePoint> path = generator.generate({s_curve_start, s_curve_end});
+    keep(path);
+  }
+}
+
+// The s-curve's spline as generate() first tries it, 2 made up seconds at 1 m/s each end
+constexpr double S_CURVE_DURATION = 2.0;
+squiggles::SplineGenerator s_curve_generator(squiggles::Constraints(1.5, 3.0, 6.0), std::make_shared<squiggles::TankModel>(0.29, squiggles::Constraints(1.5, 3.0, 6.0)), 0.01);
+pls::Spline s_curve_spline(s_curve_start, s_curve_end, S_CURVE_DURATION, 1.0, 1.0);
+
+// Distances along it to look up
+constexpr int DISTANCE_QUERIES = 64;
+double distance_query(int i) { return s_curve_spline.length() * (i * 37 % DISTANCE_QUERIES + 0.5) / DISTANCE_QUERIES; }
+
+// How parameterize() finds distance, adding up chords between points dt apart
+void march_distance(std::uint64_t n) {
+  squiggles::ControlVector start(s_curve_start, 1.0), end(s_curve_end, 1.0);
+  squiggles::QuinticPolynomial x = s_curve_generator.get_x_spline(start, end, S_CURVE_DURATION);
+  squiggles::QuinticPolynomial y = s_curve_generator.get_y_spline(start, end, S_CURVE_DURATION);
+  for (std::uint64_t i = 0; i < n; i++) {
+    double target = distance_query(i % DISTANCE_QUERIES), s = 0.0, t = 0.0;
+    double px = x.calc_point(0.0), py = y.calc_point(0.0);
+    while (s < target && t < S_CURVE_DURATION) {
+      t += 0.01;
+      double nx = x.calc_point(t), ny = y.calc_point(t);
+      s += std::hypot(nx - px, ny - py);
+      px = nx;
+      py = ny;
+    }
+    keep(t);
+  }
+}
+
+void spline_parameter_at(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) keep(s_curve_spline.parameter_at(distance_query(i % DISTANCE_QUERIES)));
+}
+
+void spline_distance_at(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) keep(s_curve_spline.distance_at(S_CURVE_DURATION * (i * 37 % DISTANCE_QUERIES + 0.5) / DISTANCE_QUERIES));
+}
+
+void spline_build(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) {
+    pls::Spline spline(s_curve_start, s_curve_end, S_CURVE_DURATION, 1.0, 1.0);
+    keep(spline);
+  }
+}
+
+// 64 points along the s-curve's spline, everything gen_single_raw_path() works out
+constexpr int SPLINE_SAMPLES = 64;
+struct SplineInputs {
+  std::vector<double> t;
+  std::vector<float> tf;
+  SplineInputs() : t(SPLINE_SAMPLES), tf(SPLINE_SAMPLES) {
+    for (int i = 0; i < SPLINE_SAMPLES; i++) tf[i] = t[i] = S_CURVE_DURATION * i / (SPLINE_SAMPLES - 1);
+  }
+};
+const SplineInputs& spline_inputs() {
+  static SplineInputs inputs;
+  return inputs;
+}
+
+void quintic_one_at_a_time(std::uint64_t n) {
+  squiggles::ControlVector start(s_curve_start, 1.0), end(s_curve_end, 1.0);
+  squiggles::QuinticPolynomial x = s_curve_generator.get_x_spline(start, end, S_CURVE_DURATION);
+  squiggles::QuinticPolynomial y = s_curve_generator.get_y_spline(start, end, S_CURVE_DURATION);
+  pls::SplineSamples<double> out;
+  out.resize(SPLINE_SAMPLES);
+  const std::vector<double>& ts = spline_inputs().t;
+  for (std::uint64_t i = 0; i < n; i++) {
+    for (int j = 0; j < SPLINE_SAMPLES; j++) {
+      double t = ts[j];
+      out.x[j] = x.calc_point(t);
+      out.y[j] = y.calc_point(t);
+      double dx = out.dx[j] = x.calc_first_derivative(t), dy = out.dy[j] = y.calc_first_derivative(t);
+      double ddx = out.ddx[j] = x.calc_second_derivative(t), ddy = out.ddy[j] = y.calc_second_derivative(t);
+      out.dddx[j] = x.calc_third_derivative(t);
+      out.dddy[j] = y.calc_third_derivative(t);
+      double v = out.speed[j] = std::hypot(dx, dy);
+      out.curvature[j] = v < squiggles::SplineGenerator::K_EPSILON ? 0.0 : (dx * ddy - dy * ddx) / (v * v * v);
+    }
+    keep(out);
+  }
+}
+
+void spline_evaluate(std::uint64_t n) {
+  pls::SplineSamples<double> out;
+  out.resize(SPLINE_SAMPLES);
+  for (std::uint64_t i = 0; i < n; i++) {
+    s_curve_spline.evaluate(spline_inputs().t.data(), SPLINE_SAMPLES, out);
+    keep(out);
+  }
+}
+
+void spline_evaluate_float(std::uint64_t n) {
+  pls::SplineSamples<float> out;
+  out.resize(SPLINE_SAMPLES);
+  for (std::uint64_t i = 0; i < n; i++) {
+    s_curve_spline.evaluate(spline_inputs().tf.data(), SPLINE_SAMPLES, out);
+    keep(out);
+  }
+}
+
+// Lookups by time into the generated s-curve
+std::vector<squiggles::ProfilePoint> s_curve_profile = s_curve_generator.generate({s_curve_start, s_curve_end});
+pls::Profile s_curve_lookup(s_curve_profile, 0.01);
+
+double time_query(int i) { return s_curve_profile.back().time * (i * 37 % DISTANCE_QUERIES + 0.5) / DISTANCE_QUERIES; }
+
+void get_point_at_time(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) {
+    squiggles::ProfilePoint p = s_curve_generator.get_point_at_time(s_curve_start, s_curve_end, s_curve_profile, time_query(i % DISTANCE_QUERIES));
+    keep(p);
+  }
+}
+
+void profile_point_at_time(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) {
+    squiggles::ProfilePoint p = s_curve_lookup.point_at_time(time_query(i % DISTANCE_QUERIES));
+    keep(p);
+  }
+}
+
+void profile_view_point_at_time(std::uint64_t n) {
+  pls::ProfileView mirrored(s_curve_lookup, pls::Transform::mirror());
+  for (std::uint64_t i = 0; i < n; i++) {
+    squiggles::ProfilePoint p = mirrored.point_at_time(time_query(i % DISTANCE_QUERIES));
+    keep(p);
+  }
+}
+
+void profile_build(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) {
+    pls::Profile profile(s_curve_profile, 0.01);
+    keep(profile);
+  }
+}
+
+// The s-curve and on up the field, pushed 12cm sideways partway through
+squiggles::Pose long_curve_end(0.3, 1.5, M_PI / 2.0);
+constexpr double BUMP = 0.12;
+
+const std::vector<squiggles::ProfilePoint>& long_curve() {
+  static std::vector<squiggles::ProfilePoint> points = s_curve_generator.generate({s_curve_start, s_curve_end, long_curve_end});
+  return points;
+}
+
+squiggles::Pose bumped(const squiggles::ProfilePoint& p, double by) {
+  const squiggles::Pose& pose = p.vector.pose;
+  return squiggles::Pose(pose.x - by * std::sin(pose.yaw), pose.y + by * std::cos(pose.yaw), pose.yaw);
+}
+
+pls::Replanner long_curve_replanner() {
+  return pls::Replanner(squiggles::Constraints(1.5, 3.0, 6.0), std::make_shared<squiggles::TankModel>(0.29, squiggles::Constraints(1.5, 3.0, 6.0)), 0.01);
+}
+
+// Back and forth across the path at the same time, each re-plan starting from the last
+void replan_warm(std::uint64_t n) {
+  pls::Replanner replanner = long_curve_replanner();
+  replanner.profile_set(long_curve());
+  const squiggles::ProfilePoint& at = long_curve()[long_curve().size() / 3];
+  for (std::uint64_t i = 0; i < n; i++) {
+    replanner.replan(bumped(at, i % 2 ? BUMP : -BUMP), at.vector.vel, at.time);
+    keep(replanner.profile());
+  }
+}
+
+// The same splice from scratch, from the bumped pose to where the re-plan rejoins
+void replan_generate(std::uint64_t n) {
+  const squiggles::ProfilePoint& at = long_curve()[long_curve().size() / 3];
+  const squiggles::ProfilePoint& rejoin = long_curve()[long_curve().size() / 3 + 55];
+  for (std::uint64_t i = 0; i < n; i++) {
+    std::vector<squiggles::ProfilePoint> path = s_curve_generator.generate({bumped(at, BUMP), rejoin.vector.pose});
+    keep(path);
+  }
+}
+
+// Laps around the middle of the field for about a minute, as long as a skills run
+std::vector<squiggles::Pose> skills_waypoints() {
+  std::vector<squiggles::Pose> waypoints;
+  for (int i = 0; i <= 52; i++) {
+    double around = i * M_PI / 4.0;
+    waypoints.emplace_back(1.8 + 1.2 * std::cos(around), 1.8 + 1.2 * std::sin(around), around + M_PI / 2.0);
+  }
+  return waypoints;
+}
+
+const std::vector<squiggles::ProfilePoint>& skills_path() {
+  static std::vector<squiggles::ProfilePoint> points = s_curve_generator.generate(skills_waypoints());
+  return points;
+}
+
+// What okapi's storePath() and loadPath() do, a line of text per point parsed a number at a time
+std::string text_store(const std::vector<squiggles::ProfilePoint>& points) {
+  std::string text;
+  for (const squiggles::ProfilePoint& p : points) text += p.to_csv() + "\n";
+  return text;
+}
+
+std::vector<squiggles::ProfilePoint> text_load(const std::string& text) {
+  std::vector<squiggles::ProfilePoint> points;
+  std::istringstream in(text);
+  std::string line, field;
+  while (std::getline(in, line)) {
+    std::istringstream fields(line);
+    std::vector<double> values;
+    while (std::getline(fields, field, ',')) values.push_back(std::stod(field));
+    if (values.size() < 8) continue;
+    squiggles::ControlVector vector(squiggles::Pose(values[0], values[1], values[2]), values[3], values[4], values[5]);
+    points.emplace_back(vector, std::vector<double>(values.begin() + 8, values.end()), values[6], values[7]);
+  }
+  return points;
+}
+
+const std::string& skills_text() {
+  static std::string text = text_store(skills_path());
+  return text;
+}
+
+const std::vector<std::uint8_t>& skills_bytes() {
+  static std::vector<std::uint8_t> bytes;
+  if (bytes.empty()) pls::trajectory::encode(skills_path(), 0.01, bytes);
+  return bytes;
+}
+
+void text_path_load(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) keep(text_load(skills_text()));
+}
+
+void trajectory_decode(std::uint64_t n) {
+  std::vector<squiggles::ProfilePoint> points;
+  for (std::uint64_t i = 0; i < n; i++) {
+    pls::trajectory::decode(skills_bytes().data(), skills_bytes().size(), points);
+    keep(points);
+  }
+}
+
+// Open and the first chunk, when a streamed path can start driving
+void trajectory_first_chunk(std::uint64_t n) {
+  squiggles::ProfilePoint points[pls::trajectory::CHUNK_POINTS];
+  for (std::uint64_t i = 0; i < n; i++) {
+    pls::trajectory::Reader reader;
+    reader.open(skills_bytes().data(), skills_bytes().size());
+    keep(reader.read(points));
+  }
+}
+
+// Generating the first segment, when a streamed path can start driving, against generating all of it first
+void generator_first_chunk(std::uint64_t n) {
+  squiggles::ProfilePoint points[pls::TrajectoryStream::CHUNK];
+  for (std::uint64_t i = 0; i < n; i++) {
+    pls::GeneratorSource source(s_curve_generator, skills_waypoints());
+    keep(source.read(points, pls::TrajectoryStream::CHUNK));
+  }
+}
+
+void generate_skills(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) keep(s_curve_generator.generate(skills_waypoints()));
+}
+
+void trajectory_encode(std::uint64_t n) {
+  std::vector<std::uint8_t> bytes;
+  for (std::uint64_t i = 0; i < n; i++) {
+    pls::trajectory::encode(skills_path(), 0.01, bytes);
+    keep(bytes);
+  }
+}
+
+// An s-curve 1.8m up the field from where odom_xyt_set(0, 0, 0) puts the robot, planned against the motors at
+// 10V so the follower has the rest to correct with
+squiggles::Constraints follow_limits(1.5, 3.0, 6.0);
+pls::DrivetrainDescription follow_drive_description() {
+  pls::DrivetrainDescription drive;
+  drive.voltage = 10.0;
+  return drive;
+}
+squiggles::SplineGenerator follow_generator(follow_limits, std::make_shared<pls::MotorModel>(follow_drive_description(), follow_limits), 0.01);
+
+const std::vector<squiggles::ProfilePoint>& follow_path() {
+  static std::vector<squiggles::ProfilePoint> points =
+      follow_generator.generate({squiggles::Pose(0.0, 0.0, M_PI / 2.0), squiggles::Pose(0.5, 1.0, M_PI / 2.0), squiggles::Pose(0.0, 1.8, M_PI / 2.0)});
+  return points;
+}
+
+// A tick of the follower, a few cm off the path
+void ltv_calculate(std::uint64_t n) {
+  static const pls::LtvFollower follower{pls::DrivetrainDescription()};
+  const std::vector<squiggles::ProfilePoint>& path = follow_path();
+  for (std::uint64_t i = 0; i < n; i++) {
+    const squiggles::ProfilePoint& target = path[i % path.size()];
+    squiggles::Pose pose(target.vector.pose.x + 0.02, target.vector.pose.y - 0.03, target.vector.pose.yaw + 0.05);
+    keep(follower.calculate(pose, target, 400.0, 410.0));
+  }
+}
+
+void ltv_build(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) keep(pls::LtvFollower(pls::DrivetrainDescription()));
+}
+
+// Angles a drive sees, a few turns either way
+constexpr int TRIG_INPUTS = 64;
+struct TrigInputs {
+  float angle[TRIG_INPUTS], x[TRIG_INPUTS], y[TRIG_INPUTS];
+  TrigInputs() {
+    for (int i = 0; i < TRIG_INPUTS; i++) {
+      angle[i] = -12.0f + 24.0f * i / TRIG_INPUTS;
+      x[i] = 48.0f * std::cos(i * 2.4f);
+      y[i] = 30.0f * std::sin(i * 1.3f);
+    }
+  }
+};
+const TrigInputs trig;
+
+void libm_sincos(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) {
+    double angle = trig.angle[i % TRIG_INPUTS];
+    double s = std::sin(angle), c = std::cos(angle);
+    keep(s);
+    keep(c);
+  }
+}
+
+void fast_sincos(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) {
+    float s, c;
+    pls::fast::sincos(trig.angle[i % TRIG_INPUTS], &s, &c);
+    keep(s);
+    keep(c);
+  }
+}
+
+void libm_atan2(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) {
+    double out = std::atan2((double)trig.y[i % TRIG_INPUTS], (double)trig.x[i % TRIG_INPUTS]);
+    keep(out);
+  }
+}
+
+void fast_atan2(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) {
+    float out = pls::fast::atan2(trig.y[i % TRIG_INPUTS], trig.x[i % TRIG_INPUTS]);
+    keep(out);
+  }
+}
+
+void libm_hypot(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) {
+    double out = std::hypot((double)trig.x[i % TRIG_INPUTS], (double)trig.y[i % TRIG_INPUTS]);
+    keep(out);
+  }
+}
+
+void fast_hypot(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) {
+    float out = pls::fast::hypot(trig.x[i % TRIG_INPUTS], trig.y[i % TRIG_INPUTS]);
+    keep(out);
+  }
+}
+
+// All 64 inputs per call, like a path's worth of headings
+void fast_sincos_array(std::uint64_t n) {
+  float s[TRIG_INPUTS], c[TRIG_INPUTS];
+  for (std::uint64_t i = 0; i < n; i++) {
+    pls::fast::sincos(trig.angle, s, c, TRIG_INPUTS);
+    keep(s);
+    keep(c);
+  }
+}
+
+void fast_atan2_array(std::uint64_t n) {
+  float out[TRIG_INPUTS];
+  for (std::uint64_t i = 0; i < n; i++) {
+    pls::fast::atan2(trig.y, trig.x, out, TRIG_INPUTS);
+    keep(out);
+  }
+}
+
+// A winding path with EZ's 0.5" spacing, like a long pid_odom_set path after inject_points
+std::vector<ez::odom> long_path(int points) {
+  std::vector<ez::odom> path;
+  for (int i = 0; i < points; i++) {
+    double s = i * 0.5;
+    path.push_back({{s, 24.0 * std::sin(s / 40.0), ez::ANGLE_NOT_SET}, ez::FWD, 110});
+  }
+  return path;
+}
+
+// EZ's pp_task and ptp_task as host/ez/drive/pid_tasks.cpp has them, unchanged: step the lookahead forward, then sum
+// the path left after it
+struct EzLookahead {
+  const std::vector<ez::odom>* path;
+  int index = 0;
+
+  int advance(ez::pose current, double look_ahead) {
+    int last = path->size() - 1;
+    while (index < last && ez::util::distance_to_point((*path)[index].target, current) < look_ahead) index++;
+    return index;
+  }
+
+  double remaining(ez::pose current) const {
+    double error = ez::util::distance_to_point((*path)[index].target, current);
+    for (size_t i = index + 1; i < path->size(); i++) error += ez::util::distance_to_point((*path)[i].target, (*path)[i - 1].target);
+    return error;
+  }
+};
+
+// The robot a little off the path, a hair behind point i
+ez::pose along(const std::vector<ez::odom>& path, std::uint64_t i) {
+  const ez::pose& p = path[i % path.size()].target;
+  return {p.x - 0.2, p.y + 1.5, 0.0};
+}
+
+const std::vector<ez::odom> path_10k = long_path(10000);
+
+// One tick of finding the lookahead point and the path left on a 10000 point path, the robot 2 points further each tick
+template <typename Search>
+void pursuit_10k(std::uint64_t n, Search search) {
+  for (std::uint64_t i = 0; i < n; i++) {
+    if (i % (path_10k.size() / 2) == 0) search.reset();
+    ez::pose current = along(path_10k, 2 * (i % (path_10k.size() / 2)));
+    int index = search.advance(current);
+    double left = search.remaining(current);
+    keep(index);
+    keep(left);
+  }
+}
+
+void ez_pursuit_10k(std::uint64_t n) {
+  struct {
+    EzLookahead ez = {&path_10k};
+    void reset() { ez.index = 0; }
+    int advance(ez::pose current) { return ez.advance(current, 7.0); }
+    double remaining(ez::pose current) { return ez.remaining(current); }
+  } search;
+  pursuit_10k(n, search);
+}
+
+void pls_pursuit_10k(std::uint64_t n) {
+  struct {
+    pls::sim::Pursuit pursuit;
+    void reset() { pursuit.path_set(path_10k); }
+    int advance(ez::pose current) { return pursuit.advance(current, 7.0); }
+    double remaining(ez::pose current) { return pursuit.remaining(current); }
+  } search;
+  pursuit_10k(n, search);
+}
+
+// odom_pure_pursuit_example()'s path, in inches
+const std::vector<ez::odom> example_path = {{{6.0, 10.0, ez::ANGLE_NOT_SET}, ez::FWD, 110},
+                                            {{0.0, 20.0, ez::ANGLE_NOT_SET}, ez::FWD, 110},
+                                            {{0.0, 30.0, ez::ANGLE_NOT_SET}, ez::FWD, 110}};
+
+void path_prepare(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) {
+    pls::PreparedPath path = chassis.path_prepare({0.0, 0.0, 0.0}, example_path);
+    keep(path);
+  }
+}
+
+// Starting the motion, which is where EZ injects and smooths
+void path_set(std::uint64_t n) {
+  for (std::uint64_t i = 0; i < n; i++) chassis.pid_odom_set(example_path, true);
+  chassis.drive_mode_set(ez::DISABLE);
+}
+
+void prepared_path_set(std::uint64_t n) {
+  pls::PreparedPath path = chassis.path_prepare({0.0, 0.0, 0.0}, example_path);
+  for (std::uint64_t i = 0; i < n; i++) chassis.pid_odom_set(path, true);
+  chassis.drive_mode_set(ez::DISABLE);
+}
+
+void prepared_path_set_mirrored(std::uint64_t n) {
+  pls::PreparedPath path = chassis.path_prepare({0.0, 0.0, 0.0}, example_path);
+  pls::Transform mirror = pls::Transform::mirror();
+  for (std::uint64_t i = 0; i < n; i++) chassis.pid_odom_set(path, mirror, true);
+  chassis.drive_mode_set(ez::DISABLE);
+}
+
+const Benchmark BENCHMARKS[] = {
+    {"pls::format_fixed, 2 places", format_fixed_2},
+    {"snprintf %.2f", snprintf_fixed_2},
+    {"std::ostringstream fixed, 2 places", ostringstream_fixed_2},
+    {"ez::PID::compute", pid_compute},
+    {"ez::slew::iterate", slew_iterate},
+    {"ez::util::turn_shortest", turn_shortest},
+    {"ez::util::wrap_angle", wrap_angle},
+    {"pls::angle::turn_shortest", angle_turn_shortest},
+    {"pls::angle::wrap", angle_wrap},
+    {"pls::angle::wrap, 64 floats", angle_wrap_array},
+    {"ez pure pursuit lookahead, 10k points", ez_pursuit_10k},
+    {"pls::sim::Pursuit, 10k points", pls_pursuit_10k},
+    {"pls::PreparedPath, 3 points", path_prepare},
+    {"ez::Drive::pid_odom_set, 3 points", path_set},
+    {"pls::Drive::pid_odom_set, prepared", prepared_path_set},
+    {"pls::Drive::pid_odom_set, mirrored", prepared_path_set_mirrored},
+    {"ez::util::absolute_angle_to_point", absolute_angle_to_point},
+    {"ez::Drive::ez_tracking_task", odometry_step},
+    {"pls::sim::Mechanisms::step", mechanisms_step},
+    {"okapi::MedianFilter<5>::filter", median_filter},
+    {"okapi::AverageFilter<5>::filter", average_filter},
+    {"okapi::EKFFilter::filter", ekf_filter},
+    {"okapi::VelMath::step", vel_math_step},
+    {"squiggles::SplineGenerator::generate", spline_generate},
+    {"pls::Spline::segments", spline_segments},
+    {"squiggles::SplineGenerator, pls::MotorModel", spline_generate_motor},
+    {"squiggles distance, marching chords", march_distance},
+    {"pls::Spline::parameter_at", spline_parameter_at},
+    {"pls::Spline::distance_at", spline_distance_at},
+    {"pls::Spline, building the table", spline_build},
+    {"squiggles::QuinticPolynomial, 64 points", quintic_one_at_a_time},
+    {"pls::Spline::evaluate, 64 points", spline_evaluate},
+    {"pls::Spline::evaluate, 64 float points", spline_evaluate_float},
+    {"squiggles::SplineGenerator::get_point_at_time", get_point_at_time},
+    {"pls::Profile::point_at_time", profile_point_at_time},
+    {"pls::ProfileView::point_at_time", profile_view_point_at_time},
+    {"pls::Profile, from generate", profile_build},
+    {"pls::Replanner::replan, warm", replan_warm},
+    {"squiggles::SplineGenerator::generate, splice", replan_generate},
+    {"okapi text path, skills load", text_path_load},
+    {"pls::trajectory::decode, skills", trajectory_decode},
+    {"pls::trajectory::Reader, first chunk", trajectory_first_chunk},
+    {"pls::trajectory::encode, skills", trajectory_encode},
+    {"squiggles::SplineGenerator, skills", generate_skills},
+    {"pls::GeneratorSource, first chunk", generator_first_chunk},
+    {"pls::LtvFollower::calculate", ltv_calculate},
+    {"pls::LtvFollower, solving the gains", ltv_build},
+    {"libm sin and cos", libm_sincos},
+    {"pls::fast::sincos", fast_sincos},
+    {"libm atan2", libm_atan2},
+    {"pls::fast::atan2", fast_atan2},
+    {"libm hypot", libm_hypot},
+    {"pls::fast::hypot", fast_hypot},
+    {"pls::fast::sincos, 64 angles", fast_sincos_array},
+    {"pls::fast::atan2, 64 points", fast_atan2_array},
+};
+
+//
+// Accuracy
+//
+
+struct Worst {
+  const char* name;
+  double bound;
+  double error = 0.0;
+  double at = 0.0;
+
+  void check(double value, double exact, double input) {
+    double e = std::fabs(value - exact);
+    if (e > error) {
+      error = e;
+      at = input;
+    }
+  }
+};
+
+// Sweeps every kernel and its array version against double libm, returns how many are out of bounds
+int accuracy() {
+  constexpr int N = 1 << 20;
+  std::vector<float> a(N), b(N), out1(N), out2(N);
+  Worst sin = {"sin", pls::fast::TRIG_MAX_ERROR}, cos = {"cos", pls::fast::TRIG_MAX_ERROR};
+  Worst sin_array = {"sin, array", pls::fast::TRIG_MAX_ERROR}, cos_array = {"cos, array", pls::fast::TRIG_MAX_ERROR};
+  Worst atan2 = {"atan2", pls::fast::ATAN2_MAX_ERROR}, atan2_array = {"atan2, array", pls::fast::ATAN2_MAX_ERROR};
+  Worst hypot = {"hypot, relative", pls::fast::HYPOT_MAX_RELATIVE_ERROR}, hypot_array = {"hypot, array, relative", pls::fast::HYPOT_MAX_RELATIVE_ERROR};
+
+  // Every float in [-1000, 1000] is too many, so sweep near 0 densely and the rest evenly
+  for (int range : {4, 1000}) {
+    for (int i = 0; i < N; i++) a[i] = -range + 2.0 * range * i / (N - 1);
+    pls::fast::sincos(a.data(), out1.data(), out2.data(), N);
+    for (int i = 0; i < N; i++) {
+      float s, c;
+      pls::fast::sincos(a[i], &s, &c);
+      sin.check(s, std::sin((double)a[i]), a[i]);
+      cos.check(c, std::cos((double)a[i]), a[i]);
+      sin_array.check(out1[i], std::sin((double)a[i]), a[i]);
+      cos_array.check(out2[i], std::cos((double)a[i]), a[i]);
+    }
+  }
+
+  // Points all the way around, on circles from tiny to across the field
+  for (double radius : {1e-3, 1.0, 144.0}) {
+    for (int i = 0; i < N; i++) {
+      double angle = -M_PI + 2.0 * M_PI * i / (N - 1);
+      a[i] = radius * std::sin(angle);
+      b[i] = radius * std::cos(angle);
+    }
+    pls::fast::atan2(a.data(), b.data(), out1.data(), N);
+    pls::fast::hypot(b.data(), a.data(), out2.data(), N);
+    for (int i = 0; i < N; i++) {
+      double exact_angle = std::atan2((double)a[i], (double)b[i]);
+      double exact_length = std::hypot((double)a[i], (double)b[i]);
+      atan2.check(pls::fast::atan2(a[i], b[i]), exact_angle, exact_angle);
+      atan2_array.check(out1[i], exact_angle, exact_angle);
+      hypot.check(pls::fast::hypot(b[i], a[i]) / exact_length, 1.0, exact_angle);
+      hypot_array.check(out2[i] / exact_length, 1.0, exact_angle);
+    }
+  }
+
+  int failed = 0;
+  printf("%-24s %11s %11s %11s\n", "kernel", "worst", "bound", "at");
+  for (const Worst* w : {&sin, &cos, &sin_array, &cos_array, &atan2, &atan2_array, &hypot, &hypot_array}) {
+    bool over = w->error > w->bound;
+    if (over) failed++;
+    printf("%-24s %11.3g %11.3g %11.4f%s\n", w->name, w->error, w->bound, w->at, over ? "  OVER" : "");
+  }
+  if (pls::fast::atan2(0.0f, 0.0f) != 0.0f || pls::fast::hypot(0.0f, 0.0f) != 0.0f) {
+    printf("atan2(0, 0) or hypot(0, 0) isn't 0\n");
+    failed++;
+  }
+  return failed;
+}
+
+//
+// Output
+//
+
+// Formats a time in ns, us or ms so every column lines up
+std::string time_format(double ns) {
+  char text[32];
+  if (ns < 1e4)
+    snprintf(text, sizeof(text), "%.1fns", ns);
+  else if (ns < 1e7)
+    snprintf(text, sizeof(text), "%.1fus", ns / 1e3);
+  else
+    snprintf(text, sizeof(text), "%.1fms", ns / 1e6);
+  return text;
+}
+
+void json_write(FILE* out, const std::vector<Result>& results, const Options& options) {
+  fprintf(out, "{\n  \"samples\": %d,\n  \"min_batch_ms\": %g,\n  \"benchmarks\": [\n", options.samples, options.min_batch_ms);
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    fprintf(out, "    {\"name\": \"%s\", \"iterations\": %llu, \"median_ns\": %.3f, \"mad_ns\": %.3f, \"min_ns\": %.3f, \"p90_ns\": %.3f}%s\n",
+            r.name.c_str(), (unsigned long long)r.iterations, r.median_ns, r.mad_ns, r.min_ns, r.p90_ns, i + 1 < results.size() ? "," : "");
+  }
+  fprintf(out, "  ]\n}\n");
+}
+
+// Reads back the results json_write() wrote.  Not a general JSON reader.
+std::vector<Result> json_read(const char* path) {
+  std::vector<Result> results;
+  FILE* in = fopen(path, "r");
+  if (in == nullptr) return results;
+  char line[512];
+  while (fgets(line, sizeof(line), in)) {
+    const char* name = strstr(line, "\"name\": \"");
+    const char* median = strstr(line, "\"median_ns\": ");
+    const char* mad = strstr(line, "\"mad_ns\": ");
+    if (name == nullptr || median == nullptr || mad == nullptr) continue;
+    name += strlen("\"name\": \"");
+    Result r = {};
+    r.name.assign(name, strchr(name, '"'));
+    r.median_ns = atof(median + strlen("\"median_ns\": "));
+    r.mad_ns = atof(mad + strlen("\"mad_ns\": "));
+    results.push_back(r);
+  }
+  fclose(in);
+  return results;
+}
+
+// Prints how each benchmark moved against the baseline, returns how many got slower
+int compare(const std::vector<Result>& results, const Options& options) {
+  std::vector<Result> baseline = json_read(options.compare);
+  if (baseline.empty()) {
+    fprintf(stderr, "bench: no results in %s\n", options.compare);
+    return 1;
+  }
+  int slower = 0;
+  printf("\n%-40s %11s %11s %8s\n", "against", "baseline", "now", "change");
+  for (const Result& r : results) {
+    auto base = std::find_if(baseline.begin(), baseline.end(), [&](const Result& b) { return b.name == r.name; });
+    if (base == baseline.end()) continue;
+    double change = (r.median_ns - base->median_ns) / base->median_ns * 100.0;
+    bool regressed = change > options.threshold && r.median_ns - base->median_ns > 3.0 * std::max(r.mad_ns, base->mad_ns);
+    if (regressed) slower++;
+    printf("%-40s %11s %11s %+7.1f%%%s\n", r.name.c_str(), time_format(base->median_ns).c_str(), time_format(r.median_ns).c_str(), change,
+           regressed ? "  SLOWER" : "");
+  }
+  return slower;
+}
+
+// The angle semantics pls::angle is checked against, written out here rather than taken from host/ez, which is
+// itself only written from EZ's headers.  wrap takes whole turns off exactly, fmod is exact, and lands in -180 to
+// 180 with both ends kept: 180 and 540 stay 180, -180 and -540 stay -180, 181 is -179.  That is EZ-Template 3.2's
+// wrap_angle, one correction each way after the fmod.  The turn helpers are current plus the wrapped error, the
+// longest going the other way around, and clamp checks max before min.
+template <typename T>
+T wrap_reference(T theta) {
+  theta = std::fmod(theta, T(360));
+  if (theta > T(180)) theta -= T(360);
+  if (theta < T(-180)) theta += T(360);
+  return theta;
+}
+
+double turn_shortest_reference(double target, double current) { return current + wrap_reference(target - current); }
+
+double turn_longest_reference(double target, double current) {
+  double error = wrap_reference(target - current);
+  return current + (error > 0.0 ? error - 360.0 : error + 360.0);
+}
+
+double clamp_reference(double input, double max, double min) {
+  if (input > max) return max;
+  if (input < min) return min;
+  return input;
+}
+
+// wrap() at the edges, {theta, expected}
+constexpr double WRAP_EDGES[][2] = {{180.0, 180.0},   {-180.0, -180.0}, {540.0, 180.0},  {-540.0, -180.0}, {181.0, -179.0}, {-181.0, 179.0},
+                                    {360.0, 0.0},     {-360.0, 0.0},    {720.5, 0.5},    {179.5, 179.5},   {0.0, 0.0},      {1e12, -80.0},
+                                    {-1e12, 80.0},    {900.0, 180.0},   {-900.0, -180.0}};
+
+static_assert(pls::angle::wrap(540.0) == 180.0 && pls::angle::wrap(-540.0) == -180.0 && pls::angle::wrap(725.0f) == 5.0f);
+static_assert(pls::angle::turn_shortest(350.0, 10.0) == -10.0 && pls::angle::turn_longest(20.0, 10.0) == -340.0);
+static_assert(pls::angle::clamp(5.0, 0.0, 10.0) == 0.0 && pls::angle::clamp(-5.0, 0.0, 10.0) == 10.0);
+
+// A number format_fixed() might see: everyday readings, exact halves at every place, subnormals, near and past the
+// snprintf fallback, and any bit pattern at all
+double format_sample(pls::sim::Random& random) {
+  double sign = random.next() % 2 ? -1.0 : 1.0;
+  switch (random.next() % 7) {
+    case 0:
+      return sign * random.uniform(0.0, 1000.0);
+    case 1:
+      // k / 2^m is exact, and a tie at some number of places when m is small
+      return sign * std::ldexp((double)(random.next() % 2000001), -(int)(random.next() % 12));
+    case 2:
+      return sign * ((double)(random.next() % 20000) + 0.5) / std::pow(10.0, (double)(random.next() % 11));
+    case 3:
+      return sign * std::ldexp((double)(random.next() >> 12), -1074);  // Subnormals
+    case 4: {
+      double edge = pls::FORMAT_MAX_MAGNITUDE;
+      for (int steps = random.next() % 4; steps > 0; steps--) edge = std::nextafter(edge, random.next() % 2 ? 1e10 : 0.0);
+      return sign * edge;
+    }
+    case 5: {
+      std::uint64_t bits = random.next();
+      double any;
+      std::memcpy(&any, &bits, sizeof(any));
+      return any;
+    }
+    default:
+      return sign * random.uniform(0.0, 2e9);
+  }
+}
+
+// format_fixed() against snprintf("%.*f") at 0 to 10 places, returns 1 if any text or length differs
+int format_matches() {
+  constexpr int N = 1 << 20;
+  pls::sim::Random random{26};
+  long failures = 0, fallbacks = 0, ties = 0, truncated_failures = 0;
+  for (int i = 0; i < N; i++) {
+    double input = format_sample(random);
+    int places = random.next() % 11;
+    char got[400], want[400];
+    int got_n = pls::format_fixed(got, sizeof(got), input, places);
+    int want_n = snprintf(want, sizeof(want), "%.*f", places, input);
+    if (places > pls::FORMAT_MAX_PLACES || !std::isfinite(input) || std::fabs(input) >= pls::FORMAT_MAX_MAGNITUDE) fallbacks++;
+    double scaled = std::fabs(input) * std::pow(10.0, places);
+    if (std::isfinite(scaled) && scaled - std::floor(scaled) == 0.5) ties++;
+    if (got_n != want_n || strcmp(got, want) != 0) {
+      if (failures++ < 3) printf("  format_fixed(%.17g, %d) gave \"%s\", snprintf gives \"%s\"\n", input, places, got, want);
+    }
+
+    // Cut short like snprintf, null terminated with the full length returned
+    std::size_t size = random.next() % 12;
+    char short_got[12] = "xxxxxxxxxxx", short_want[12] = "xxxxxxxxxxx";
+    int short_got_n = pls::format_fixed(short_got, size, input, places);
+    int short_want_n = snprintf(short_want, size, "%.*f", places, input);
+    if (short_got_n != short_want_n || memcmp(short_got, short_want, sizeof(short_got)) != 0) truncated_failures++;
+  }
+  bool ok = failures == 0 && truncated_failures == 0;
+  printf("\n%-24s %11s\n", "pls::format_fixed", "failures");
+  printf("  %-22s %11ld%s\n", "against snprintf", failures, failures > 0 ? "  FAILED" : "");
+  printf("  %-22s %11ld%s\n", "cut short", truncated_failures, truncated_failures > 0 ? "  FAILED" : "");
+  printf("  %d numbers, %ld exact ties, %ld on the snprintf fallback\n", N, ties, fallbacks);
+  return ok ? 0 : 1;
+}
+
+// An angle the helpers might see: everyday headings, turns near the edges and their neighbors, and huge ones
+double angle_sample(pls::sim::Random& random) {
+  switch (random.next() % 6) {
+    case 0:
+      return random.uniform(-720.0, 720.0);
+    case 1:
+      return random.uniform(-1e6, 1e6);
+    case 2: {
+      double edge = 90.0 * ((int)(random.next() % 41) - 20);
+      for (int steps = random.next() % 5; steps > 0; steps--) edge = std::nextafter(edge, random.next() % 2 ? 1e9 : -1e9);
+      return edge;
+    }
+    case 3:
+      return random.normal(1e-6);
+    case 4:
+      return random.next() % 2 ? ANGLE_NOT_SET : -0.0;
+    default:
+      return random.uniform(-1e12, 1e12);
+  }
+}
+
+// Counts one property failing and prints the first few
+struct Property {
+  const char* name;
+  long failures = 0;
+
+  void check(bool held, double a, double b, double got, double expected) {
+    if (held) return;
+    if (failures++ < 3) printf("  %s(%.17g, %.17g) gave %.17g, the reference gives %.17g\n", name, a, b, got, expected);
+  }
+};
+
+// Random inputs to every pls::angle function against the references above, returns how many properties failed
+int angle_properties() {
+  constexpr int N = 1 << 20;
+  pls::sim::Random random{2024};
+  Property wrap = {"wrap"}, wrap_float = {"wrap<float>"}, wrap_array = {"wrap, array"}, wrap_float_array = {"wrap<float>, array"};
+  Property edges = {"wrap, edges"}, turns = {"wrap, whole turns"};
+  Property shortest = {"turn_shortest"}, longest = {"turn_longest"}, shortest_array = {"turn_shortest, array"};
+  Property deg = {"to_deg"}, rad = {"to_rad"}, clamp = {"clamp"}, clamp_symmetric = {"clamp, symmetric"};
+
+  std::vector<double> a(N), b(N), out(N);
+  std::vector<float> af(N), outf(N);
+  for (int i = 0; i < N; i++) {
+    a[i] = angle_sample(random);
+    b[i] = angle_sample(random);
+    af[i] = a[i];
+  }
+  pls::angle::wrap(a.data(), out.data(), N);
+  pls::angle::wrap(af.data(), outf.data(), N);
+  for (int i = 0; i < N; i++) {
+    bool float_exact = std::fabs(af[i]) < 1.3e8f;
+    double w = pls::angle::wrap(a[i]);
+    wrap.check(w == wrap_reference(a[i]), a[i], 0, w, wrap_reference(a[i]));
+    turns.check(w >= -180.0 && w <= 180.0 && std::fmod(a[i] - w, 360.0) == 0.0, a[i], 0, w, wrap_reference(a[i]));
+    wrap_array.check(out[i] == pls::angle::wrap(a[i]), a[i], 0, out[i], pls::angle::wrap(a[i]));
+    if (float_exact) {
+      wrap_float.check(pls::angle::wrap(af[i]) == wrap_reference(af[i]), af[i], 0, pls::angle::wrap(af[i]), wrap_reference(af[i]));
+      wrap_float_array.check(outf[i] == wrap_reference(af[i]), af[i], 0, outf[i], wrap_reference(af[i]));
+    }
+    double s = pls::angle::turn_shortest(a[i], b[i]), l = pls::angle::turn_longest(a[i], b[i]);
+    shortest.check(s == turn_shortest_reference(a[i], b[i]), a[i], b[i], s, turn_shortest_reference(a[i], b[i]));
+    longest.check(l == turn_longest_reference(a[i], b[i]), a[i], b[i], l, turn_longest_reference(a[i], b[i]));
+    deg.check(pls::angle::to_deg(a[i]) == a[i] * (180.0 / M_PI), a[i], 0, pls::angle::to_deg(a[i]), a[i] * (180.0 / M_PI));
+    rad.check(pls::angle::to_rad(a[i]) == a[i] * (M_PI / 180.0), a[i], 0, pls::angle::to_rad(a[i]), a[i] * (M_PI / 180.0));
+    double low = random.uniform(-200.0, 200.0), high = random.uniform(-200.0, 200.0);
+    double input = random.uniform(-250.0, 250.0);
+    clamp.check(pls::angle::clamp(input, high, low) == clamp_reference(input, high, low), input, high, pls::angle::clamp(input, high, low),
+                clamp_reference(input, high, low));
+    clamp_symmetric.check(pls::angle::clamp(input, high) == clamp_reference(input, std::fabs(high), -std::fabs(high)), input, high,
+                          pls::angle::clamp(input, high), clamp_reference(input, std::fabs(high), -std::fabs(high)));
+  }
+  double current = b[0];
+  pls::angle::turn_shortest(a.data(), current, out.data(), N);
+  for (int i = 0; i < N; i++)
+    shortest_array.check(out[i] == turn_shortest_reference(a[i], current), a[i], current, out[i], turn_shortest_reference(a[i], current));
+  for (const auto& edge : WRAP_EDGES) {
+    edges.check(pls::angle::wrap(edge[0]) == edge[1], edge[0], 0, pls::angle::wrap(edge[0]), edge[1]);
+    edges.check(pls::angle::wrap((float)edge[0]) == (float)edge[1] || std::fabs(edge[0]) >= 1.3e8, edge[0], 0, pls::angle::wrap((float)edge[0]), edge[1]);
+  }
+
+  int failed = 0;
+  printf("\n%-24s %11s\n", "pls::angle property", "failures");
+  for (const Property* p : {&wrap, &edges, &turns, &wrap_float, &wrap_array, &wrap_float_array, &shortest, &longest, &shortest_array, &deg, &rad, &clamp, &clamp_symmetric}) {
+    if (p->failures > 0) failed++;
+    printf("%-24s %11ld%s\n", p->name, p->failures, p->failures > 0 ? "  FAILED" : "");
+  }
+  return failed;
+}
+
+// Drives both lookahead searches down paths at every speed the robot could go, returns 1 if they ever disagree
+int pursuit_matches() {
+  pls::sim::Random random{7};
+  long ticks = 0, index_failures = 0, remaining_failures = 0, point_failures = 0;
+  for (int points : {2, 3, 40, 10000}) {
+    std::vector<ez::odom> path = long_path(points);
+    for (double look_ahead : {0.3, 7.0, 11.0, 30.0}) {
+      pls::sim::Pursuit pursuit;
+      pursuit.path_set(path);
+      EzLookahead ez = {&path};
+      double s = 0.0;
+      while (pursuit.index() < points - 1 && s < points) {
+        // Up to 15 points a tick, with the robot wandering up to a few inches off the path
+        s += random.uniform(0.0, 15.0);
+        const ez::pose& p = path[std::min<int>(s, points - 1)].target;
+        ez::pose current = {p.x + random.normal(2.0), p.y + random.normal(2.0), 0.0};
+        int expected = ez.advance(current, look_ahead);
+        int index = pursuit.advance(current, look_ahead);
+        ticks++;
+        if (index != expected && index_failures++ < 3) printf("  %d points, lookahead %.1f: pls::sim::Pursuit picked %d, EZ %d\n", points, look_ahead, index, expected);
+        if (std::fabs(pursuit.remaining(current) - ez.remaining(current)) > 1e-9 * std::max(1.0, ez.remaining(current))) remaining_failures++;
+
+        // The lookahead point is look_ahead away on the segment into the cursor, or the cursor's point
+        ez::pose point = pursuit.look_ahead_point(current, look_ahead);
+        const ez::pose& end = path[index].target;
+        if (point.x != end.x || point.y != end.y) {
+          const ez::pose& start = path[index - 1].target;
+          double away = ez::util::distance_to_point(point, current);
+          double off_segment = ez::util::distance_to_point(point, start) + ez::util::distance_to_point(point, end) - ez::util::distance_to_point(end, start);
+          if (std::fabs(away - look_ahead) > 1e-9 || off_segment > 1e-9) point_failures++;
+        }
+      }
+    }
+  }
+  printf("\n%-24s %11s\n", "Pursuit, in ticks", "failures");
+  printf("%-24s %11ld%s\n", "index", index_failures, index_failures > 0 ? "  FAILED" : "");
+  printf("%-24s %11ld%s\n", "remaining", remaining_failures, remaining_failures > 0 ? "  FAILED" : "");
+  printf("%-24s %11ld%s\n", "look_ahead_point", point_failures, point_failures > 0 ? "  FAILED" : "");
+  printf("%ld ticks\n", ticks);
+  return index_failures + remaining_failures + point_failures > 0 ? 1 : 0;
+}
+
+pls::PreparedPath example_prepared;
+bool drive_prepared = false;
+ez::pose example_start = {0.0, 0.0, 0.0};
+
+void drive_example() {
+  chassis.odom_xyt_set(example_start.x, example_start.y, example_start.theta);
+  if (drive_prepared)
+    chassis.pid_odom_set(example_prepared, true);
+  else
+    chassis.pid_odom_set(example_path, true);
+  chassis.pid_wait();
+}
+
+// Drives the example path both ways, each on a fresh robot in its own process, returns 1 if they end up apart
+int prepared_path_matches() {
+  struct Drove {
+    bool done;
+    float time_s;
+    pls::sim::RobotPose end;
+    int points;
+    std::size_t bytes;
+  };
+  // Points, then prepared, from where the path was prepared and then from somewhere else
+  Drove* drove = pls::sim::shared_array<Drove>(4);
+  pls::sim::fork_pool(4, 4, [&](int run) {
+    pls::sim::robot_install();
+    if (pls::sim::run(initialize, "initialize", 10000) != pls::sim::FINISHED) return;
+    chassis.pid_print_toggle(false);
+    example_prepared = chassis.path_prepare({0.0, 0.0, 0.0}, example_path);
+    drive_prepared = run % 2;
+    if (run >= 2) example_start = {5.0, -3.0, 20.0};
+    std::uint64_t start_us = pls::sim::now_us();
+    pls::sim::run(drive_example, "path", 10000);
+    drove[run] = {true, (float)((pls::sim::now_us() - start_us) / 1e6), pls::sim::robot_pose(), example_prepared.size(), example_prepared.bytes()};
+  });
+  for (int run = 0; run < 4; run++)
+    if (!drove[run].done) return 1;
+
+  int failures = 0;
+  printf("\n%-24s %11s %11s\n", "odom path", "time", "end");
+  const char* names[4] = {"as points", "as PreparedPath", "as points, moved", "as PreparedPath, moved"};
+  for (int run = 0; run < 4; run++) {
+    const Drove& points = drove[run & ~1];
+    double apart = std::hypot(drove[run].end.x - points.end.x, drove[run].end.y - points.end.y);
+    bool same = apart < 1e-6 && std::fabs(drove[run].end.theta - points.end.theta) < 1e-6 && drove[run].time_s == points.time_s;
+    if (!same) failures++;
+    printf("%-24s %10.2fs  (%.2f, %.2f, %.1f)%s\n", names[run], drove[run].time_s, drove[run].end.x, drove[run].end.y, drove[run].end.theta,
+           same ? "" : "  DIFFERENT");
+  }
+  printf("PreparedPath holds %d points in %zu bytes\n", drove[1].points, drove[1].bytes);
+
+  // No spacing would inject points forever
+  for (double spacing : {0.0, -0.5, std::nan("")}) {
+    pls::PreparedPath bad({0.0, 0.0, 0.0}, example_path, spacing, 0.75, 0.03, 0.0001);
+    if (!bad.empty() || bad.size() != 0) {
+      printf("PreparedPath with spacing %g prepared %d points  FAILED\n", spacing, bad.size());
+      failures++;
+    }
+  }
+  return failures > 0 ? 1 : 0;
+}
+
+// m/s^2 a path may ask past what the motors have, against about 10 they push from a stop
+constexpr double MOTOR_ACCEL_SLACK = 0.5;
+
+// Plans paths with pls::MotorModel, returns 1 if one asks for more than the motors or tires have
+int motor_model_limits() {
+  pls::DrivetrainDescription drive;
+  auto model = std::make_shared<pls::MotorModel>(drive, motor_limits);
+  squiggles::SplineGenerator generator(motor_limits, model, 0.01);
+  double top = model->side_top_speed();
+  double grip = drive.tire_friction * 9.81;
+  long points = 0, speed_failures = 0, grip_failures = 0, motor_failures = 0;
+  double fastest = 0.0, most_grip = 0.0, most_over = 0.0;
+  printf("\n%-24s %11s %11s\n", "pls::MotorModel path", "time", "points");
+  for (squiggles::Pose end : {s_curve_end, squiggles::Pose(0.0, 1.5, M_PI / 2.0), squiggles::Pose(1.0, 1.0, 0.0), squiggles::Pose(-0.6, 0.6, M_PI)}) {
+    std::vector<squiggles::ProfilePoint> path = generator.generate({s_curve_start, end});
+    printf("(%4.1f, %4.1f, %4.0f deg) %10.2fs %11zu\n", end.x, end.y, end.yaw * 180.0 / M_PI, path.back().time, path.size());
+    for (std::size_t i = 1; i < path.size(); i++) {
+      const squiggles::ProfilePoint& p = path[i];
+      double dt = p.time - path[i - 1].time;
+      if (dt <= 0.0) continue;
+      points++;
+      double accel = (p.vector.vel - path[i - 1].vector.vel) / dt;
+      double lateral = p.vector.vel * p.vector.vel * p.curvature;
+      double used = std::hypot(accel, lateral) / grip;
+      most_grip = std::max(most_grip, used);
+      if (used > 1.05) grip_failures++;
+      for (double wheel : p.wheel_velocities) {
+        fastest = std::max(fastest, std::fabs(wheel) / top);
+        if (std::fabs(wheel) > top * 1.001) speed_failures++;
+      }
+
+      // What the motors have at the start of the step.  Riding the top speed as the curvature changes is the outside
+      // wheel holding its speed, and the generator takes a step's acceleration from where it starts, so the motors
+      // fall a little behind as back EMF builds
+      double cap = model->constraints(p.vector.pose, p.curvature, p.vector.vel).max_vel;
+      if (p.vector.vel > cap * 0.999) continue;
+      squiggles::Constraints limits = model->constraints(path[i - 1].vector.pose, path[i - 1].curvature, path[i - 1].vector.vel);
+      double over = std::max(accel - limits.max_accel, limits.min_accel - accel);
+      most_over = std::max(most_over, over);
+      if (over > MOTOR_ACCEL_SLACK) motor_failures++;
+    }
+  }
+  printf("%-24s %10.0f%%%s\n", "fastest wheel", fastest * 100.0, speed_failures > 0 ? "  FAILED" : "");
+  printf("%-24s %10.0f%%%s\n", "most grip", most_grip * 100.0, grip_failures > 0 ? "  FAILED" : "");
+  printf("%-24s %7.2fm/s2%s\n", "most past the motors", most_over, motor_failures > 0 ? "  FAILED" : "");
+  printf("%ld points, side top speed %.2f m/s\n", points, top);
+  return speed_failures + grip_failures + motor_failures > 0 ? 1 : 0;
+}
+
+// Spline tables against integrating the speed finely, and Profile lookups against squiggles, returns 1 if either is off
+int spline_tables() {
+  pls::sim::Random random{44};
+  constexpr int SPLINES = 200, STEPS = 20000;
+  double worst_distance = 0.0, worst_parameter = 0.0;
+  for (int n = 0; n < SPLINES; n++) {
+    squiggles::Pose start(random.uniform(-1.0, 1.0), random.uniform(-1.0, 1.0), random.uniform(-M_PI, M_PI));
+    squiggles::Pose end(random.uniform(-1.0, 1.0), random.uniform(-1.0, 1.0), random.uniform(-M_PI, M_PI));
+    double duration = (int)random.uniform(2.0, 16.0), vel = std::exp(random.uniform(-2.0, 1.0));
+    pls::Spline spline(start, end, duration, vel, vel);
+
+    // Simpson's rule on pairs of steps
+    double h = duration / STEPS, s = 0.0;
+    for (int i = 0; i <= STEPS; i += 2) {
+      double t = i * h;
+      if (i > 0) s += h / 3.0 * (spline.speed_at(t - 2.0 * h) + 4.0 * spline.speed_at(t - h) + spline.speed_at(t));
+      if (i % 250 != 0) continue;
+      worst_distance = std::max(worst_distance, std::fabs(spline.distance_at(t) - s) / spline.length());
+      worst_parameter = std::max(worst_parameter, std::fabs(spline.distance_at(spline.parameter_at(s)) - s) / spline.length());
+    }
+  }
+
+  // Three waypoints, so the lookup has a segment end to step past
+  std::vector<squiggles::ProfilePoint> path =
+      s_curve_generator.generate({s_curve_start, s_curve_end, squiggles::Pose(0.9, 0.9, 0.0)});
+  pls::Profile profile(path, 0.01);
+  long lookup_failures = 0;
+  for (int i = 0; i <= 10000; i++) {
+    double t = path.back().time * (i / 10000.0) + (i % 3 == 0 ? 0.0 : random.uniform(-0.01, 0.01));
+    squiggles::ProfilePoint want = s_curve_generator.get_point_at_time(s_curve_start, s_curve_end, path, t);
+    squiggles::ProfilePoint got = profile.point_at_time(t);
+    if (got.vector.pose.x != want.vector.pose.x || got.vector.pose.y != want.vector.pose.y || got.vector.pose.yaw != want.vector.pose.yaw ||
+        got.vector.vel != want.vector.vel || got.time != want.time || got.wheel_velocities != want.wheel_velocities)
+      lookup_failures++;
+  }
+
+  bool distance_ok = worst_distance <= pls::Spline::MAX_ERROR, parameter_ok = worst_parameter <= pls::Spline::MAX_ERROR;
+  printf("\n%-24s %11s %11s\n", "pls::Spline tables", "worst", "bound");
+  printf("%-24s %11.2g %11.2g%s\n", "distance_at", worst_distance, pls::Spline::MAX_ERROR, distance_ok ? "" : "  FAILED");
+  printf("%-24s %11.2g %11.2g%s\n", "parameter_at", worst_parameter, pls::Spline::MAX_ERROR, parameter_ok ? "" : "  FAILED");
+  printf("%d splines, %zu bytes each\n", SPLINES, pls::Spline().bytes());
+  printf("pls::Profile::point_at_time differs from squiggles %ld times in 10001%s\n", lookup_failures, lookup_failures > 0 ? "  FAILED" : "");
+  return distance_ok && parameter_ok && lookup_failures == 0 ? 0 : 1;
+}
+
+// Spline::segments() against the raw points host/squiggles' gen_raw_path() gives for each segment, returns 1 if a segment isn't the
+// same shape.  Only as good as host/squiggles, the V5 library's squiggles isn't here to check against
+int spline_segments_match() {
+  pls::sim::Random random{44};
+  constexpr double DT = 0.01;
+  squiggles::Constraints limits(1.5, 3.0, 6.0);
+  squiggles::SplineGenerator generator(limits, std::make_shared<squiggles::TankModel>(0.29, limits), DT);
+  double worst = 0.0;
+  int segments = 0, count_failures = 0;
+  for (int n = 0; n < 12; n++) {
+    // Speeds left for gradient descent to pick in half the paths, given in the rest, some of them 0
+    std::vector<squiggles::ControlVector> waypoints;
+    for (int w = 0, points = 2 + n % 3; w < points; w++) {
+      squiggles::Pose pose(random.uniform(0.0, 3.6), random.uniform(0.0, 3.6), random.uniform(-M_PI, M_PI));
+      waypoints.push_back(n % 2 ? squiggles::ControlVector(pose, random.next() % 3 == 0 ? 0.0 : random.uniform(0.2, 1.5)) : squiggles::ControlVector(pose));
+    }
+    std::vector<pls::Spline> splines = pls::Spline::segments(generator, waypoints, DT);
+    if (splines.size() != waypoints.size() - 1) count_failures++;
+    for (std::size_t i = 0; i < splines.size() && i + 1 < waypoints.size(); i++) {
+      std::vector<squiggles::SplineGenerator::GeneratedPoint> raw = generator.gen_raw_path(waypoints[i], waypoints[i + 1], false);
+      int steps = raw.size() - 1;
+      for (int j = 0; j <= steps; j++) {
+        squiggles::Pose at = splines[i].pose_at(splines[i].duration() * j / steps);
+        worst = std::max(worst, std::hypot(at.x - raw[j].pose.x, at.y - raw[j].pose.y));
+      }
+      segments++;
+    }
+  }
+  constexpr double BOUND = 1e-9;
+  bool ok = worst <= BOUND && count_failures == 0;
+  printf("\n%-24s %11s %11s\n", "pls::Spline::segments", "worst", "bound");
+  printf("%-24s %11.2g %11.2g%s\n", "position, m", worst, BOUND, worst <= BOUND ? "" : "  FAILED");
+  printf("%d segments%s\n", segments, count_failures > 0 ? ", some paths with the wrong count  FAILED" : "");
+  return ok ? 0 : 1;
+}
+
+// Batches against squiggles::QuinticPolynomial one point at a time, and floats against doubles, returns 1 if either is off
+int spline_batches() {
+  pls::sim::Random random{45};
+  constexpr int SPLINES = 2000, N = 103;  // Not a multiple of 4, so the leftovers after NEON get checked
+  double worst_double = 0.0, worst_float = 0.0, worst_curvature = 0.0;
+  std::vector<double> t(N);
+  std::vector<float> tf(N);
+  pls::SplineSamples<double> d;
+  pls::SplineSamples<float> f;
+  d.resize(N);
+  f.resize(N);
+  squiggles::SplineGenerator generator(squiggles::Constraints(1.5, 3.0, 6.0));
+  for (int n = 0; n < SPLINES; n++) {
+    // Anywhere on the field facing anywhere, with the durations and made up speeds squiggles picks from
+    squiggles::ControlVector start(squiggles::Pose(random.uniform(0.0, 3.6), random.uniform(0.0, 3.6), random.uniform(-M_PI, M_PI)));
+    squiggles::ControlVector end(squiggles::Pose(random.uniform(0.0, 3.6), random.uniform(0.0, 3.6), random.uniform(-M_PI, M_PI)));
+    double duration = (int)random.uniform(2.0, 16.0), vel = std::exp(random.uniform(-2.0, 1.0));
+    pls::Spline spline(start, end, duration, vel, vel);
+    for (int i = 0; i < N; i++) t[i] = tf[i] = duration * i / (N - 1);
+    spline.evaluate(t.data(), N, d);
+    spline.evaluate(tf.data(), N, f);
+
+    start.vel = end.vel = vel;
+    squiggles::QuinticPolynomial x = generator.get_x_spline(start, end, duration), y = generator.get_y_spline(start, end, duration);
+    for (int i = 0; i < N; i++) {
+      double want[] = {x.calc_point(t[i]),           y.calc_point(t[i]),           x.calc_first_derivative(t[i]), y.calc_first_derivative(t[i]),
+                       x.calc_second_derivative(t[i]), y.calc_second_derivative(t[i]), x.calc_third_derivative(t[i]), y.calc_third_derivative(t[i])};
+      double got[] = {d.x[i], d.y[i], d.dx[i], d.dy[i], d.ddx[i], d.ddy[i], d.dddx[i], d.dddy[i]};
+      double got_float[] = {f.x[i], f.y[i], f.dx[i], f.dy[i], f.ddx[i], f.ddy[i], f.dddx[i], f.dddy[i]};
+      for (int k = 0; k < 8; k++) {
+        worst_double = std::max(worst_double, std::fabs(got[k] - want[k]) / std::max(1.0, std::fabs(want[k])));
+        worst_float = std::max(worst_float, std::fabs(got_float[k] - got[k]));
+      }
+      worst_float = std::max(worst_float, std::fabs(f.speed[i] - d.speed[i]));
+      if (d.speed[i] > 0.05) worst_curvature = std::max(worst_curvature, std::fabs(f.curvature[i] - d.curvature[i]) / std::max(1.0, std::fabs(d.curvature[i])));
+    }
+  }
+
+  bool double_ok = worst_double < 1e-12, float_ok = worst_float <= pls::Spline::FLOAT_MAX_ERROR,
+       curvature_ok = worst_curvature <= pls::Spline::FLOAT_CURVATURE_MAX_ERROR;
+  printf("\n%-24s %11s %11s\n", "pls::Spline::evaluate", "worst", "bound");
+  printf("%-24s %11.2g %11.2g%s\n", "double, squiggles", worst_double, 1e-12, double_ok ? "" : "  FAILED");
+  printf("%-24s %11.2g %11.2g%s\n", "float, double", worst_float, pls::Spline::FLOAT_MAX_ERROR, float_ok ? "" : "  FAILED");
+  printf("%-24s %11.2g %11.2g%s\n", "float curvature", worst_curvature, pls::Spline::FLOAT_CURVATURE_MAX_ERROR, curvature_ok ? "" : "  FAILED");
+  printf("%d splines, %d points each\n", SPLINES, N);
+  return double_ok && float_ok && curvature_ok ? 0 : 1;
+}
+
+// Follows the long curve exactly, then bumped, returns 1 if the re-planner fires when it shouldn't or splices badly
+int replan_splices() {
+  pls::Replanner replanner = long_curve_replanner();
+  const std::vector<squiggles::ProfilePoint>& original = long_curve();
+  replanner.profile_set(original);
+  double end_time = original.back().time;
+  int false_replans = 0;
+  for (double t = 0.0; t < end_time; t += 0.01) {
+    squiggles::ProfilePoint p = replanner.profile().point_at_time(t);
+    if (replanner.update(p.vector.pose, p.vector.vel, t)) false_replans++;
+  }
+
+  // Pushed sideways, then driven exactly along whatever it re-planned
+  replanner.profile_set(original);
+  const squiggles::ProfilePoint& at = original[original.size() / 3];
+  squiggles::Pose pose = bumped(at, BUMP);
+  bool fired = replanner.update(pose, at.vector.vel, at.time);
+  const std::vector<squiggles::ProfilePoint>& next = replanner.profile().points();
+  double start_off = pose.dist(next.front().vector.pose), start_vel = next.front().vector.vel;
+  double end_off = next.back().vector.pose.dist(original.back().vector.pose);
+  double fastest = 0.0, backwards = 0.0;
+  for (std::size_t i = 0; i < next.size(); i++) {
+    fastest = std::max(fastest, next[i].vector.vel);
+    if (i > 0) backwards = std::max(backwards, next[i - 1].time - next[i].time);
+  }
+  for (double t = at.time; t < next.back().time; t += 0.01) {
+    squiggles::ProfilePoint p = replanner.profile().point_at_time(t);
+    if (replanner.update(p.vector.pose, p.vector.vel, t)) false_replans++;
+  }
+
+  // A second bump starts from the first's shape
+  const squiggles::ProfilePoint& later = replanner.profile().points()[replanner.profile().points().size() / 2];
+  bool fired_again = replanner.update(bumped(later, -BUMP), later.vector.vel, later.time);
+
+  // Rolling backward when bumped, the splice starts from a stop instead of reversing the heading
+  pls::Replanner rolling = long_curve_replanner();
+  rolling.profile_set(original);
+  bool rolled = rolling.update(pose, -at.vector.vel, at.time);
+  double rolled_vel = rolling.profile().points().front().vector.vel;
+
+  // Backward profiles aren't taken at all
+  std::vector<squiggles::ProfilePoint> reversed = original;
+  for (squiggles::ProfilePoint& p : reversed) p.vector.vel = -p.vector.vel;
+  bool rejected = !rolling.profile_set(reversed) && rolling.profile().empty();
+
+  bool ok = fired && fired_again && false_replans == 0 && start_off < 1e-9 && start_vel <= at.vector.vel + 1e-9 && end_off < 1e-9 &&
+            fastest <= 1.5 + 1e-9 && backwards <= 0.0 && rolled && rolled_vel == 0.0 && rejected;
+  printf("\n%-24s\n", "pls::Replanner");
+  printf("  bumped %.2fm at %.2fs, re-planned %s, %s the second time\n", BUMP, at.time, fired ? "yes" : "no", fired_again ? "yes" : "no");
+  printf("  splice starts %.2g m from the robot at %.2f m/s, ends %.2g m from the original end, fastest %.2f m/s\n", start_off, start_vel, end_off,
+         fastest);
+  printf("  rolling backward splices from %.2f m/s, backward profile %s\n", rolled_vel, rejected ? "rejected" : "taken");
+  printf("  %.2fs to the end instead of %.2fs, %d re-plans on the path exactly%s\n", next.back().time, end_time, false_replans, ok ? "" : "  FAILED");
+  return ok ? 0 : 1;
+}
+
+// Round trips the skills path through a file and through bad ones, returns 1 if a value comes back off by more than its
+// chunk's bound or a bad file isn't caught
+int trajectory_round_trip() {
+  namespace traj = pls::trajectory;
+  const std::vector<squiggles::ProfilePoint>& original = skills_path();
+  const std::vector<std::uint8_t>& bytes = skills_bytes();
+  std::vector<squiggles::ProfilePoint> points;
+  double dt = 0.0;
+  traj::status_e decoded = traj::decode(bytes.data(), bytes.size(), points, &dt);
+  bool ok = decoded == traj::OK && points.size() == original.size() && std::fabs(dt - 0.01) < 1e-9;
+
+  // Each value within half a step of its column's range over its chunk, the base and step being floats
+  const char* names[] = {"x", "y", "yaw", "vel", "accel", "jerk", "curvature", "time", "left wheel", "right wheel"};
+  constexpr int COLUMNS = traj::FIXED_COLUMNS + 2;
+  auto value = [](const squiggles::ProfilePoint& p, int c) {
+    const double fixed[] = {p.vector.pose.x, p.vector.pose.y, p.vector.pose.yaw, p.vector.vel, p.vector.accel, p.vector.jerk, p.curvature, p.time};
+    return c < traj::FIXED_COLUMNS ? fixed[c] : p.wheel_velocities[c - traj::FIXED_COLUMNS];
+  };
+  double worst[COLUMNS] = {}, worst_of_bound[COLUMNS] = {};
+  for (std::size_t start = 0; ok && start < original.size(); start += traj::CHUNK_POINTS) {
+    std::size_t end = std::min(original.size(), start + traj::CHUNK_POINTS);
+    for (int c = 0; c < COLUMNS; c++) {
+      double low = INFINITY, high = -INFINITY;
+      for (std::size_t i = start; i < end; i++) {
+        low = std::min(low, value(original[i], c));
+        high = std::max(high, value(original[i], c));
+      }
+      double bound = (high - low + std::fabs(low) * 0x1p-23) / 65535.0 * (1.0 + 0x1p-22) / 2.0 + 1e-12;
+      for (std::size_t i = start; i < end; i++) {
+        double error = std::fabs(value(points[i], c) - value(original[i], c));
+        worst[c] = std::max(worst[c], error);
+        worst_of_bound[c] = std::max(worst_of_bound[c], error / bound);
+      }
+    }
+  }
+  printf("\n%-24s %11s %11s\n", "pls::trajectory", "worst", "of bound");
+  for (int c = 0; c < COLUMNS; c++) {
+    printf("  %-22s %11.2g %11.2f%s\n", names[c], worst[c], worst_of_bound[c], worst_of_bound[c] <= 1.0 ? "" : "  FAILED");
+    ok = ok && worst_of_bound[c] <= 1.0;
+  }
+
+  // okapi's text keeps 6 decimals
+  std::vector<squiggles::ProfilePoint> text_points = text_load(skills_text());
+  double text_worst = 0.0;
+  for (std::size_t i = 0; i < original.size() && i < text_points.size(); i++)
+    for (int c = 0; c < COLUMNS; c++) text_worst = std::max(text_worst, std::fabs(value(text_points[i], c) - value(original[i], c)));
+
+  // Through a file, then the ways a file goes bad
+  const char* path = "/tmp/pls_bench.traj";
+  std::vector<squiggles::ProfilePoint> from_file;
+  bool file_ok = traj::store(path, original, 0.01) == traj::OK && traj::load(path, from_file) == traj::OK && from_file == points;
+  remove(path);
+
+  std::vector<std::uint8_t> bad = bytes;
+  bad[traj::HEADER_BYTES + 3 * traj::chunk_bytes(2) + 100] ^= 0x10;
+  traj::Reader reader;
+  reader.open(bad.data(), bad.size());
+  squiggles::ProfilePoint chunk[traj::CHUNK_POINTS];
+  int before = 0;
+  while (reader.read(chunk) > 0) before++;
+  bool flipped = reader.status() == traj::BAD_CHUNK && before == 3;
+
+  bad = bytes;
+  bad[9] ^= 0x01;
+  bool header = traj::decode(bad.data(), bad.size(), points) == traj::BAD_HEADER;
+  bool truncated = traj::decode(bytes.data(), bytes.size() - 1, points) == traj::TRUNCATED;
+  ok = ok && file_ok && flipped && header && truncated;
+
+  printf("  %zu points, %.1fs, %zu bytes, %.1f a point, text takes %zu, %.1f a point and is off by up to %.2g\n", original.size(),
+         original.back().time, bytes.size(), (double)bytes.size() / original.size(), skills_text().size(),
+         (double)skills_text().size() / original.size(), text_worst);
+  printf("  reader holds %zu bytes, file round trip %s, caught a flipped bit after %d good chunks %s, bad header %s, short file %s%s\n",
+         sizeof(traj::Reader), file_ok ? "matches" : "differs", before, flipped ? "yes" : "no", header ? "yes" : "no", truncated ? "yes" : "no",
+         ok ? "" : "  FAILED");
+  return ok ? 0 : 1;
+}
+
+// Follows the skills path through a pls::TrajectoryStream from each kind of source, each in its own process
+enum StreamFrom { FROM_TABLE, FROM_FILE, FROM_GENERATOR };
+struct Streamed {
+  bool done;
+  bool ready;
+  bool finished;
+  int ticks;
+  int underruns;
+  double worst;  // Farthest any value got from pls::Profile on the whole path
+  std::uint32_t peak_points;
+  std::size_t peak_bytes;
+};
+StreamFrom stream_from;
+Streamed* streamed;
+
+void stream_follow() {
+  std::vector<squiggles::ProfilePoint> whole;
+  pls::trajectory::decode(skills_bytes().data(), skills_bytes().size(), whole);
+  if (stream_from != FROM_FILE) whole = skills_path();
+  pls::Profile profile(whole, 0.01);
+
+  pls::TableSource table(skills_path());
+  pls::FileSource file(skills_bytes().data(), skills_bytes().size());
+  pls::GeneratorSource generator(s_curve_generator, skills_waypoints());
+  pls::TrajectorySource* sources[] = {&table, &file, &generator};
+  Streamed& out = *streamed;
+  {
+    pls::TrajectoryStream stream(*sources[stream_from]);
+    out.ready = stream.wait_ready(100);
+    for (double t = 0.0; out.ready && !stream.finished() && t < whole.back().time + 1.0; t += 0.01, out.ticks++) {
+      squiggles::ProfilePoint got = stream.point_at_time(t), want = profile.point_at_time(t);
+      const double diffs[] = {got.vector.pose.x - want.vector.pose.x, got.vector.pose.y - want.vector.pose.y, got.vector.pose.yaw - want.vector.pose.yaw,
+                              got.vector.vel - want.vector.vel, got.curvature - want.curvature, got.time - want.time,
+                              got.wheel_velocities[0] - want.wheel_velocities[0], got.wheel_velocities[1] - want.wheel_velocities[1]};
+      for (double d : diffs) out.worst = std::max(out.worst, std::fabs(d));
+      pros::delay(10);
+    }
+    out.finished = stream.finished();
+    out.underruns = stream.underruns();
+    out.peak_points = stream.peak_points();
+    out.peak_bytes = stream.peak_bytes();
+  }
+  out.done = true;
+}
+
+// Returns 1 if a stream ever differs from following the whole path, runs dry or holds more than its ring
+int stream_matches() {
+  const char* names[] = {"baked table", "trajectory file", "generator"};
+  Streamed* runs = pls::sim::shared_array<Streamed>(3);
+  pls::sim::fork_pool(3, 3, [&](int from) {
+    stream_from = (StreamFrom)from;
+    streamed = &runs[from];
+    pls::sim::run(stream_follow, "stream", 120000);
+  });
+
+  std::size_t whole_bytes = skills_path().size() * (sizeof(squiggles::ProfilePoint) + 2 * sizeof(double));
+  bool ok = true;
+  printf("\n%-24s %11s %11s %11s %11s\n", "pls::TrajectoryStream", "worst", "underruns", "peak points", "peak bytes");
+  for (int i = 0; i < 3; i++) {
+    const Streamed& r = runs[i];
+    bool good = r.done && r.ready && r.finished && r.worst < 1e-9 && r.underruns == 0 && r.peak_points <= pls::TrajectoryStream::CAPACITY;
+    ok = ok && good;
+    printf("  %-22s %11.2g %11d %11u %11zu%s\n", names[i], r.worst, r.underruns, r.peak_points, r.peak_bytes, good ? "" : "  FAILED");
+  }
+  printf("  %d ticks to the end of %.1fs, the whole path holds %zu bytes\n", runs[0].ticks, skills_path().back().time, whole_bytes);
+  return ok ? 0 : 1;
+}
+
+// Gains from iterating the Riccati equation one step at a time, to check the doubling against
+std::array<double, 6> riccati_gains(double vel, double dt, const pls::LtvSettings& s) {
+  double ad[3][3] = {{1.0, 0.0, 0.0}, {0.0, 1.0, vel * dt}, {0.0, 0.0, 1.0}};
+  double bd[3][2] = {{dt, 0.0}, {0.0, vel * dt * dt / 2.0}, {0.0, dt}};
+  double r[2] = {1.0 / (s.vel_tolerance * s.vel_tolerance), 1.0 / (s.turn_tolerance * s.turn_tolerance)};
+  double q[3] = {1.0 / (s.x_tolerance * s.x_tolerance), 1.0 / (s.y_tolerance * s.y_tolerance), 1.0 / (s.heading_tolerance * s.heading_tolerance)};
+  double p[3][3] = {{q[0], 0.0, 0.0}, {0.0, q[1], 0.0}, {0.0, 0.0, q[2]}};
+  std::array<double, 6> k = {};
+  for (int step = 0; step < 200000; step++) {
+    double pb[3][2] = {}, bpb[2][2] = {}, bpa[2][3] = {}, pa[3][3] = {};
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++) {
+        for (int l = 0; l < 3; l++) pa[i][j] += p[i][l] * ad[l][j];
+        if (j < 2)
+          for (int l = 0; l < 3; l++) pb[i][j] += p[i][l] * bd[l][j];
+      }
+    for (int a = 0; a < 2; a++) {
+      for (int b = 0; b < 2; b++)
+        for (int i = 0; i < 3; i++) bpb[a][b] += bd[i][a] * pb[i][b];
+      for (int j = 0; j < 3; j++)
+        for (int i = 0; i < 3; i++) bpa[a][j] += bd[i][a] * pa[i][j];
+    }
+    bpb[0][0] += r[0];
+    bpb[1][1] += r[1];
+    double det = bpb[0][0] * bpb[1][1] - bpb[0][1] * bpb[1][0];
+    for (int j = 0; j < 3; j++) {
+      k[j] = (bpb[1][1] * bpa[0][j] - bpb[0][1] * bpa[1][j]) / det;
+      k[3 + j] = (bpb[0][0] * bpa[1][j] - bpb[1][0] * bpa[0][j]) / det;
+    }
+    // P = Q + Ad' P Ad - Ad' P Bd K
+    double next[3][3];
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++) {
+        next[i][j] = i == j ? q[i] : 0.0;
+        for (int l = 0; l < 3; l++) next[i][j] += ad[l][i] * pa[l][j];
+        for (int a = 0; a < 2; a++) next[i][j] -= bpa[a][i] * k[a * 3 + j];
+      }
+    std::memcpy(p, next, sizeof(p));
+  }
+  return k;
+}
+
+// The example path mirrored through a view and from mirrored waypoints
+bool drive_mirrored_view;
+
+void drive_mirrored() {
+  chassis.odom_xyt_set(0.0, 0.0, 0.0);
+  if (drive_mirrored_view)
+    chassis.pid_odom_set(example_prepared, pls::Transform::mirror(), true);
+  else
+    chassis.pid_odom_set(example_prepared, true);
+  chassis.pid_wait();
+}
+
+double heading_apart(double a, double b) { return std::fabs(std::remainder(a - b, 2.0 * M_PI)); }
+
+// Returns 1 if transforms don't compose, or a view differs from transforming the waypoints and generating or preparing again
+int transforms_match() {
+  // Composing against applying one after the other, in both frames
+  const pls::Transform transforms[] = {pls::Transform::mirror(), pls::Transform::rotate(90.0), pls::Transform::rotate(-33.0),
+                                       pls::Transform::translate(12.0, -6.0), pls::Transform::reflect(30.0),
+                                       pls::Transform::mirror().then(pls::Transform::translate(-24.0, 0.0)).then(pls::Transform::rotate(180.0))};
+  const ez::pose poses[] = {{0.0, 0.0, 0.0}, {4.0, 25.0, 15.0}, {-34.5, 6.0, -135.0}, {24.0, 2.0, ez::ANGLE_NOT_SET}};
+  double worst_compose = 0.0, worst_frames = 0.0, worst_twice = 0.0;
+  for (const pls::Transform& a : transforms) {
+    for (const ez::pose& pose : poses) {
+      for (const pls::Transform& b : transforms) {
+        ez::pose once = a.then(b).apply(pose), each = b.apply(a.apply(pose));
+        worst_compose = std::max(worst_compose, std::hypot(once.x - each.x, once.y - each.y));
+        if (pose.theta != ez::ANGLE_NOT_SET) worst_compose = std::max(worst_compose, std::fabs(std::remainder(once.theta - each.theta, 360.0)));
+      }
+      if (pose.theta == ez::ANGLE_NOT_SET) continue;
+      squiggles::Pose odom_first = pls::pose_from_odom(a.apply(pose)), squiggles_first = a.apply(pls::pose_from_odom(pose));
+      worst_frames = std::max({worst_frames, odom_first.dist(squiggles_first), heading_apart(odom_first.yaw, squiggles_first.yaw)});
+    }
+  }
+  for (double line : {0.0, 30.0, 90.0, -45.0}) {
+    for (const ez::pose& pose : poses) {
+      ez::pose back = pls::Transform::reflect(line).then(pls::Transform::reflect(line)).apply(pose);
+      worst_twice = std::max(worst_twice, std::hypot(back.x - pose.x, back.y - pose.y));
+    }
+  }
+
+  // The follower's s-curve generated once and mirrored, against generating it from mirrored waypoints
+  pls::Transform mirror = pls::Transform::mirror();
+  std::vector<squiggles::Pose> right = {squiggles::Pose(0.0, 0.0, M_PI / 2.0), squiggles::Pose(0.5, 1.0, M_PI / 2.0), squiggles::Pose(0.0, 1.8, M_PI / 2.0)};
+  std::vector<squiggles::Pose> left;
+  for (const squiggles::Pose& pose : right) left.push_back(mirror.apply(pose));
+  auto start = std::chrono::steady_clock::now();
+  pls::Profile right_profile(follow_generator.generate(right), 0.01);
+  double generate_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  pls::Profile left_profile(follow_generator.generate(left), 0.01);
+  pls::ProfileView left_view(right_profile, mirror);
+  double worst_point = 0.0, worst_speed = 0.0;
+  bool same_size = left_view.size() == left_profile.points().size();
+  for (std::size_t i = 0; same_size && i < left_view.size(); i++) {
+    squiggles::ProfilePoint viewed = left_view.point(i);
+    const squiggles::ProfilePoint& generated = left_profile.points()[i];
+    worst_point = std::max({worst_point, viewed.vector.pose.dist(generated.vector.pose), heading_apart(viewed.vector.pose.yaw, generated.vector.pose.yaw),
+                            std::fabs(viewed.curvature - generated.curvature), std::fabs(viewed.time - generated.time)});
+    worst_speed = std::max(worst_speed, std::fabs(viewed.vector.vel - generated.vector.vel));
+    for (std::size_t w = 0; w < viewed.wheel_velocities.size(); w++)
+      worst_speed = std::max(worst_speed, std::fabs(viewed.wheel_velocities[w] - generated.wheel_velocities[w]));
+  }
+  std::size_t profile_bytes = right_profile.points().size() * (sizeof(squiggles::ProfilePoint) + 2 * sizeof(double)) + right_profile.points().size() * sizeof(double);
+
+  // The example path prepared once and mirrored, against preparing mirrored waypoints
+  pls::PreparedPath prepared = chassis.path_prepare({0.0, 0.0, 0.0}, example_path);
+  pls::PreparedPath mirrored = chassis.path_prepare({0.0, 0.0, 0.0}, pls::transformed(example_path, mirror));
+  std::vector<ez::odom> viewed = pls::transformed(prepared.points(), mirror);
+  double worst_prepared = viewed.size() == mirrored.points().size() ? 0.0 : INFINITY;
+  for (std::size_t i = 0; i < viewed.size() && i < mirrored.points().size(); i++)
+    worst_prepared = std::max(worst_prepared, std::hypot(viewed[i].target.x - mirrored.points()[i].target.x, viewed[i].target.y - mirrored.points()[i].target.y));
+
+  // Both mirrors driven, each on a fresh robot in its own process
+  struct Drove {
+    bool done;
+    float time_s;
+    pls::sim::RobotPose end;
+  };
+  Drove* drove = pls::sim::shared_array<Drove>(2);
+  pls::sim::fork_pool(2, 2, [&](int view) {
+    pls::sim::robot_install();
+    if (pls::sim::run(initialize, "initialize", 10000) != pls::sim::FINISHED) return;
+    chassis.pid_print_toggle(false);
+    example_prepared = view ? chassis.path_prepare({0.0, 0.0, 0.0}, example_path) : chassis.path_prepare({0.0, 0.0, 0.0}, pls::transformed(example_path, mirror));
+    drive_mirrored_view = view;
+    std::uint64_t start_us = pls::sim::now_us();
+    pls::sim::run(drive_mirrored, "mirrored path", 10000);
+    drove[view] = {true, (float)((pls::sim::now_us() - start_us) / 1e6), pls::sim::robot_pose()};
+  });
+  double apart = std::hypot(drove[1].end.x - drove[0].end.x, drove[1].end.y - drove[0].end.y);
+
+  bool ok = worst_compose < 1e-9 && worst_frames < 1e-9 && worst_twice < 1e-9 && same_size && worst_point < 1e-9 && worst_speed < 1e-9 &&
+            worst_prepared < 1e-9 && drove[0].done && drove[1].done && apart < 0.01 && std::fabs(drove[1].time_s - drove[0].time_s) < 0.02;
+  printf("\n%-24s %11s\n", "pls::Transform", "worst");
+  printf("  %-22s %11.2g\n", "composed", worst_compose);
+  printf("  %-22s %11.2g\n", "odom and squiggles", worst_frames);
+  printf("  %-22s %11.2g\n", "reflected twice", worst_twice);
+  printf("  %-22s %11.2g\n", "mirrored profile", std::max(worst_point, worst_speed));
+  printf("  %-22s %11.2g\n", "mirrored prepared", worst_prepared);
+  printf("  mirrored example path driven %.2fs to (%.2f, %.2f), prepared mirrored %.2fs to (%.2f, %.2f)\n", drove[1].time_s, drove[1].end.x, drove[1].end.y,
+         drove[0].time_s, drove[0].end.x, drove[0].end.y);
+  printf("  one side generated in %.2f ms and about %zu bytes, the other is a %zu byte view%s\n", generate_ms, profile_bytes, sizeof(pls::ProfileView),
+         ok ? "" : "  FAILED");
+  return ok ? 0 : 1;
+}
+
+// Drives the s-curve with the follower, EZ's pure pursuit through points on it and boomerang to its end
+enum FollowMode { FOLLOW_LTV, FOLLOW_PURSUIT, FOLLOW_BOOMERANG };
+struct Followed {
+  bool done;
+  float time_s;
+  double worst_off;  // m from the planned path, wherever along it
+  double mean_off;
+  double end_off;    // m from the planned end
+  double end_deg;
+};
+FollowMode follow_mode;
+Followed* followed;
+
+double off_path(squiggles::Pose pose) {
+  const std::vector<squiggles::ProfilePoint>& path = follow_path();
+  double best = INFINITY;
+  for (std::size_t i = 1; i < path.size(); i++) {
+    const squiggles::Pose &a = path[i - 1].vector.pose, &b = path[i].vector.pose;
+    double dx = b.x - a.x, dy = b.y - a.y, length2 = dx * dx + dy * dy;
+    double f = length2 > 0.0 ? std::clamp(((pose.x - a.x) * dx + (pose.y - a.y) * dy) / length2, 0.0, 1.0) : 0.0;
+    best = std::min(best, std::hypot(pose.x - a.x - f * dx, pose.y - a.y - f * dy));
+  }
+  return best;
+}
+
+squiggles::Pose true_pose() {
+  pls::sim::RobotPose truth = pls::sim::robot_pose();
+  return pls::pose_from_odom({truth.x, truth.y, truth.theta});
+}
+
+void follow_drive() {
+  chassis.odom_xyt_set(0.0, 0.0, 0.0);
+  const std::vector<squiggles::ProfilePoint>& path = follow_path();
+  Followed& out = *followed;
+  std::atomic<bool> running{true};
+  double total_off = 0.0;
+  int samples = 0;
+  pros::Task sampler([&] {
+    while (running) {
+      double off = off_path(true_pose());
+      out.worst_off = std::max(out.worst_off, off);
+      total_off += off;
+      samples++;
+      pros::delay(10);
+    }
+  });
+
+  std::uint64_t start_us = pls::sim::now_us();
+  const squiggles::Pose& end = path.back().vector.pose;
+  double end_theta = 90.0 - end.yaw * 180.0 / M_PI;
+  if (follow_mode == FOLLOW_LTV) {
+    pls::LtvFollower follower{pls::DrivetrainDescription()};
+    chassis.profile_follow(pls::Profile(path, 0.01), follower);
+  } else if (follow_mode == FOLLOW_PURSUIT) {
+    // Points every 15cm along the path, ending on its heading
+    std::vector<ez::odom> points;
+    for (std::size_t i = 15; i < path.size(); i += 15)
+      points.push_back({{path[i].vector.pose.x / 0.0254, path[i].vector.pose.y / 0.0254, ez::ANGLE_NOT_SET}, ez::FWD, 110});
+    points.push_back({{end.x / 0.0254, end.y / 0.0254, end_theta}, ez::FWD, 110});
+    chassis.pid_odom_set(points, true);
+    chassis.pid_wait();
+  } else {
+    chassis.pid_odom_set({{end.x / 0.0254, end.y / 0.0254, end_theta}, ez::FWD, 110}, true);
+    chassis.pid_wait();
+  }
+  out.time_s = (pls::sim::now_us() - start_us) / 1e6;
+  running = false;
+  sampler.join();
+
+  squiggles::Pose at = true_pose();
+  out.end_off = at.dist(end);
+  out.end_deg = std::fabs(std::remainder(at.yaw - end.yaw, 2.0 * M_PI)) * 180.0 / M_PI;
+  out.mean_off = samples > 0 ? total_off / samples : 0.0;
+  out.done = true;
+}
+
+// Returns 1 if the gains don't match iterating the Riccati equation or the follower tracks worse than EZ's odom modes
+int follower_tracks() {
+  pls::LtvSettings settings;
+  pls::LtvFollower follower{pls::DrivetrainDescription(), 0.01, settings};
+  double worst_gain = 0.0;
+  for (int bin : {1, 4, 16, pls::LtvFollower::BINS - 1}) {
+    std::array<double, 6> want = riccati_gains(follower.bin_vel(bin), 0.01, settings);
+    for (int i = 0; i < 6; i++) worst_gain = std::max(worst_gain, std::fabs(follower.gains(bin)[i] - want[i]) / std::max(1.0, std::fabs(want[i])));
+  }
+
+  const char* names[] = {"pls::LtvFollower", "EZ pure pursuit", "EZ boomerang"};
+  Followed* runs = pls::sim::shared_array<Followed>(3);
+  pls::sim::fork_pool(3, 3, [&](int mode) {
+    pls::sim::robot_install();
+    if (pls::sim::run(initialize, "initialize", 10000) != pls::sim::FINISHED) return;
+    chassis.pid_print_toggle(false);
+    follow_mode = (FollowMode)mode;
+    followed = &runs[mode];
+    pls::sim::run(follow_drive, "follow", 20000);
+  });
+
+  const Followed& ltv = runs[FOLLOW_LTV];
+  bool done = runs[0].done && runs[1].done && runs[2].done;
+  bool ok = done && worst_gain < 1e-6 && ltv.worst_off < runs[FOLLOW_PURSUIT].worst_off && ltv.end_off < 0.0254;
+  printf("\n%-24s %11s %11s %11s %11s %11s\n", "following the s-curve", "time", "worst off", "mean off", "end off", "end deg");
+  for (int i = 0; i < 3; i++)
+    printf("  %-22s %10.2fs %10.1fmm %10.1fmm %10.1fmm %11.1f\n", names[i], runs[i].time_s, runs[i].worst_off * 1000.0, runs[i].mean_off * 1000.0,
+           runs[i].end_off * 1000.0, runs[i].end_deg);
+  printf("  profile takes %.2fs, gains off iterating the Riccati equation by %.2g%s\n", follow_path().back().time, worst_gain, ok ? "" : "  FAILED");
+  return ok ? 0 : 1;
+}
+
+// The s-curve's first points, then nothing for STALL_MS before it runs out
+class StallSource : public pls::TrajectorySource {
+ public:
+  static constexpr std::uint32_t STALL_MS = 5000;
+  explicit StallSource(int points) : table(follow_path().data(), points) {}
+
+  int read(squiggles::ProfilePoint* out, int max) override {
+    int n = table.read(out, max);
+    if (n == 0) pros::delay(STALL_MS);
+    return n;
+  }
+  std::size_t bytes() const override { return sizeof(*this); }
+
+ private:
+  pls::TableSource table;
+};
+
+struct TimedOut {
+  bool done;
+  bool timed_out;
+  float time_s;
+  float latest_s;  // Last point the follower got, the re-planned end when held
+  int exit;        // The motion's exit in the trace, 0 if it was left open
+  int replans;
+  float moved;     // in the robot really moved
+};
+TimedOut* timed_out;
+int stall_points;
+
+void follow_stalled() {
+  chassis.odom_xyt_set(0.0, 0.0, 0.0);
+  StallSource source(stall_points);
+  pls::TrajectoryStream stream(source);
+  pls::LtvFollower follower{pls::DrivetrainDescription()};
+  std::uint64_t start_us = pls::sim::now_us();
+  TimedOut& out = *timed_out;
+  pls::trace::start("stalled");
+  out.timed_out = chassis.profile_follow(stream, follower).timed_out;
+  out.time_s = (pls::sim::now_us() - start_us) / 1e6;
+  out.latest_s = stream.time();
+  for (int i = 0; i < pls::trace::size(); i++) {
+    const pls::trace::Event& e = pls::trace::event_get(i);
+    if (e.track == pls::trace::MOTION) out.exit = e.phase == 'E' ? (int)e.value : 0;
+  }
+  pls::trace::stop();
+  out.done = true;
+}
+
+// A source with no points at all, from away from the origin the empty stream used to drive to
+void follow_empty() {
+  chassis.odom_xyt_set(24.0, 24.0, 0.0);
+  pls::sim::RobotPose before = pls::sim::robot_pose();
+  pls::TableSource source(follow_path().data(), 0);
+  pls::TrajectoryStream stream(source);
+  pls::LtvFollower follower{pls::DrivetrainDescription()};
+  TimedOut& out = *timed_out;
+  std::uint64_t start_us = pls::sim::now_us();
+  pls::trace::start("empty");
+  out.timed_out = chassis.profile_follow(stream, follower).timed_out;
+  out.time_s = (pls::sim::now_us() - start_us) / 1e6;
+  out.latest_s = stream.time();
+  for (int i = 0; i < pls::trace::size(); i++) {
+    const pls::trace::Event& e = pls::trace::event_get(i);
+    if (e.track == pls::trace::MOTION) out.exit = e.phase == 'E' ? (int)e.value : 0;
+  }
+  pls::trace::stop();
+  pros::delay(500);  // Anything it set the drive to gets to move the robot
+  pls::sim::RobotPose after = pls::sim::robot_pose();
+  out.moved = std::hypot(after.x - before.x, after.y - before.y);
+  out.done = true;
+}
+
+// Odom held where the robot is for HOLD_MS partway along the s-curve, like a robot pinned by another, re-planning all the while
+constexpr std::uint32_t HOLD_MS = 2000;
+
+void follow_held() {
+  chassis.odom_xyt_set(0.0, 0.0, 0.0);
+  pls::Replanner replanner(follow_limits, std::make_shared<pls::MotorModel>(follow_drive_description(), follow_limits), 0.01);
+  pls::LtvFollower follower{pls::DrivetrainDescription()};
+  TimedOut& out = *timed_out;
+  pros::Task holder([] {
+    pros::delay(400);
+    ez::pose held = chassis.odom_pose_get();
+    for (std::uint32_t start = pros::millis(); pros::millis() - start < HOLD_MS;) {
+      chassis.odom_xyt_set(held.x, held.y, held.theta);
+      pros::delay(1);
+    }
+  });
+  std::uint64_t start_us = pls::sim::now_us();
+  pls::trace::start("held");
+  pls::FollowResult result = chassis.profile_follow(pls::Profile(follow_path(), 0.01), follower, &replanner);
+  out.timed_out = result.timed_out;
+  out.replans = result.replans;
+  out.time_s = (pls::sim::now_us() - start_us) / 1e6;
+  out.latest_s = replanner.profile().empty() ? 0.0 : replanner.profile().points().back().time;
+  for (int i = 0; i < pls::trace::size(); i++) {
+    const pls::trace::Event& e = pls::trace::event_get(i);
+    if (e.track == pls::trace::MOTION) out.exit = e.phase == 'E' ? (int)e.value : 0;
+  }
+  pls::trace::stop();
+  holder.join();
+  out.done = true;
+}
+
+// Returns 1 if following a stream that stalls doesn't give up FOLLOW_TIMEOUT_MS past its last point, or leaves the motion open,
+// if a re-planned profile held back for longer than that gives up before its re-planned end, or if an empty source drives
+int follow_timeouts() {
+  const char* names[] = {"stalls before ready", "stalls after a chunk", "held, re-planned", "empty source"};
+  const int points[] = {0, (int)pls::TrajectoryStream::CHUNK};
+  TimedOut* runs = pls::sim::shared_array<TimedOut>(4);
+  pls::sim::fork_pool(4, 4, [&](int i) {
+    pls::sim::robot_install();
+    if (pls::sim::run(initialize, "initialize", 10000) != pls::sim::FINISHED) return;
+    chassis.pid_print_toggle(false);
+    timed_out = &runs[i];
+    if (i >= 2) {
+      pls::sim::run(i == 2 ? follow_held : follow_empty, "follow", 20000);
+      return;
+    }
+    stall_points = points[i];
+    pls::sim::run(follow_stalled, "follow", 20000);
+  });
+
+  bool ok = true;
+  double limit = pls::Drive::FOLLOW_TIMEOUT_MS / 1000.0;
+  printf("\n%-24s %11s %11s %11s\n", "profile_follow timeouts", "gave up", "last point", "exit");
+  for (int i = 0; i < 4; i++) {
+    const TimedOut& r = runs[i];
+    // Held, the re-planned end is more than the timeout past the original and the follower has to get there.  Empty, there's
+    // nowhere to go
+    bool good = i == 3   ? r.done && !r.timed_out && r.exit == ez::SMALL_EXIT && r.moved < 0.1 && r.time_s < 0.1
+                : i == 2 ? r.done && !r.timed_out && r.replans > 0 && r.latest_s > follow_path().back().time + limit && r.exit != ez::VELOCITY_EXIT
+                         : r.done && r.timed_out && r.exit == ez::VELOCITY_EXIT && r.time_s < r.latest_s + limit + 0.1;
+    ok = ok && good;
+    printf("  %-22s %10.2fs %10.2fs %11s%s\n", names[i], r.time_s, r.latest_s, r.exit ? ez::exit_to_string((ez::exit_output)r.exit).c_str() : "open",
+           good ? "" : "  FAILED");
+  }
+  printf("  the source stalls %.1fs, profile_follow gives up %.1fs past the last point it got\n", StallSource::STALL_MS / 1000.0, limit);
+  printf("  held %.1fs, %d re-plans moved the end from %.2fs\n", HOLD_MS / 1000.0, runs[2].replans, follow_path().back().time);
+  printf("  empty source from (24, 24), the robot moved %.2fin\n", runs[3].moved);
+  return ok ? 0 : 1;
+}
+
+void usage() {
+  fprintf(stderr,
+          "usage: bench [-a] [-f filter] [-r samples] [-t batch_ms] [-j json_file] [-c baseline.json] [-x threshold_percent]\n"
+          "  -a  check pls::fast, pls::format_fixed, pls::angle, pls::sim::Pursuit, pls::PreparedPath and pls::Profile against what they replace,\n"
+          "      pls::MotorModel paths against its limits, pls::Spline against integrating and squiggles and\n"
+          "      pls::Replanner splices and\n"
+          "      pls::trajectory files round tripping and pls::TrajectoryStream from each source,\n"
+          "      pls::LtvFollower against EZ's odom modes, stalled streams and held re-plans in the simulator and pls::Transform views against\n"
+          "      transforming waypoints, instead of timing\n"
+          "benchmarks:\n");
+  for (const Benchmark& benchmark : BENCHMARKS) fprintf(stderr, "  %s\n", benchmark.name);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    bool has_value = i + 1 < argc;
+    if (!strcmp(argv[i], "-a")) {
+      options.accuracy = true;
+    } else if (!strcmp(argv[i], "-f") && has_value) {
+      options.filter = argv[++i];
+    } else if (!strcmp(argv[i], "-r") && has_value) {
+      options.samples = std::max(3, atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "-t") && has_value) {
+      options.min_batch_ms = std::max(0.1, atof(argv[++i]));
+    } else if (!strcmp(argv[i], "-j") && has_value) {
+      options.json = argv[++i];
+    } else if (!strcmp(argv[i], "-c") && has_value) {
+      options.compare = argv[++i];
+    } else if (!strcmp(argv[i], "-x") && has_value) {
+      options.threshold = atof(argv[++i]);
+    } else {
+      usage();
+      return 2;
+    }
+  }
+
+  if (options.accuracy) return accuracy() + format_matches() + angle_properties() + pursuit_matches() + prepared_path_matches() + motor_model_limits() + spline_tables() + spline_segments_match() + spline_batches() + replan_splices() + trajectory_round_trip() + stream_matches() + follower_tracks() + follow_timeouts() + transforms_match() > 0 ? 1 : 0;
+
+  // Stay on one core so samples don't pay for migrating
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(sched_getcpu(), &cpus);
+  sched_setaffinity(0, sizeof(cpus), &cpus);
+
+  // The odometry benchmark needs the chassis set up with its trackers
+  pls::sim::robot_install();
+  if (pls::sim::run(initialize, "initialize", 10000) != pls::sim::FINISHED) {
+    fprintf(stderr, "initialize didn't finish\n");
+    return 1;
+  }
+  chassis.odom_enable(false);  // Only the benchmark steps odom
+  chassis.pid_print_toggle(false);
+
+  std::vector<Result> results;
+  printf("%-40s %11s %11s %11s %11s\n", "benchmark", "median", "mad", "min", "p90");
+  for (const Benchmark& benchmark : BENCHMARKS) {
+    if (options.filter != nullptr && strstr(benchmark.name, options.filter) == nullptr) continue;
+    Result r = measure(benchmark, options);
+    printf("%-40s %11s %11s %11s %11s\n", r.name.c_str(), time_format(r.median_ns).c_str(), time_format(r.mad_ns).c_str(),
+           time_format(r.min_ns).c_str(), time_format(r.p90_ns).c_str());
+    fflush(stdout);
+    results.push_back(r);
+  }
+
+  if (options.json != nullptr) {
+    FILE* out = strcmp(options.json, "-") ? fopen(options.json, "w") : stdout;
+    if (out == nullptr) {
+      perror(options.json);
+      return 1;
+    }
+    json_write(out, results, options);
+    if (out != stdout) fclose(out);
+  }
+  return options.compare != nullptr && compare(results, options) > 0 ? 1 : 0;
+}
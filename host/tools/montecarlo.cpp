@@ -0,0 +1,241 @@
+// Runs autonomous routines thousands of times on the simulated robot with the
+// robot set down a little off its mark, a different battery and worn motors
+// each time, to see how often they still work.
+//
+//   make host
+//   ./bin/host/montecarlo                  1000 runs of every routine
+//   ./bin/host/montecarlo -n 5000 RA7 LA7  5000 runs of RA7 and LA7
+//   ./bin/host/montecarlo -j 4 -s 7        4 workers, seed 7
+//   ./bin/host/montecarlo -w -j 8 -n 200   the same runs on 1, 2, 4 and 8 workers
+//
+// initialize() runs once, then fork_pool() (host/tools/pool.hpp) gives every
+// run its own copy of that brain on one worker per core.
+//
+// Each run's randomness comes only from the seed, the routine and the run
+// number, so the report is the same for any number of workers.  Run 0 of each
+// routine has no randomness and is what the others are measured against.
+//
+// -w runs the same batch on 1, 2, 4 and so on up to -j workers and prints how
+// much faster each count was than one, since that depends on the machine.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "main.h"
+#include "sim/robot.hpp"
+#include "sim/scheduler.hpp"
+#include "tools/pool.hpp"
+#include "tools/random.hpp"
+#include "tools/routines.hpp"
+
+namespace {
+
+using pls::sim::Random;
+using pls::sim::Routine;
+using pls::sim::ROUTINES;
+
+// How much each run varies
+struct Spread {
+  double start_xy = 0.5;     // in, standard deviation of where the robot is set down
+  double start_theta = 1.0;  // deg, standard deviation of how it's turned
+  double battery_low = 12.2;  // V, open circuit, picked evenly between these
+  double battery_high = 13.0;
+  double battery_resistance = 0.01;  // Ohm, standard deviation around the default
+  double motor_strength = 0.05;      // Standard deviation of torque per amp
+  double motor_friction = 0.5;       // Friction is picked up to this fraction either way
+};
+
+// Farther than this from run 0 and a run missed
+constexpr double MISS_INCHES = 3.0;
+constexpr double MISS_DEGREES = 5.0;
+
+enum outcome_e { OK = 0,
+                 TIMED_OUT,
+                 DEADLOCKED,
+                 STALLED,  // A motion exited on velocity or current, the robot got stuck
+                 MISSED,
+                 CRASHED,
+                 OUTCOMES };
+
+const char* OUTCOME_NAMES[OUTCOMES] = {"ok", "timed out", "deadlocked", "stalled", "missed", "crashed"};
+
+// What a run sends back to the parent
+struct Sample {
+  bool done;
+  int result;  // pls::sim::run_result
+  int stalls;
+  float time_s;
+  pls::sim::RobotPose end;
+};
+
+// Changes the robot for one run.  Run 0 is left alone.
+void vary(const Spread& spread, Random& random) {
+  pls::sim::RobotPose start = pls::sim::robot_pose();
+  start.x += random.normal(spread.start_xy);
+  start.y += random.normal(spread.start_xy);
+  start.theta += random.normal(spread.start_theta);
+  pls::sim::robot_place(start);
+
+  pls::sim::Battery& battery = pls::sim::devices().battery;
+  battery.open_voltage = random.uniform(spread.battery_low, spread.battery_high) * 1000.0;
+  battery.voltage = battery.open_voltage;
+  battery.resistance = std::max(0.005, battery.resistance + random.normal(spread.battery_resistance));
+
+  const pls::sim::RobotDescription& r = pls::sim::robot();
+  for (const auto* side : {&r.left_ports, &r.right_ports}) {
+    for (int port : *side) {
+      pls::sim::Motor* motor = pls::sim::devices().motor(port);
+      motor->strength = std::clamp(1.0 + random.normal(spread.motor_strength), 0.7, 1.1);
+      motor->friction *= random.uniform(1.0 - spread.motor_friction, 1.0 + spread.motor_friction);
+    }
+  }
+}
+
+// Runs one routine in this process, which is a throwaway copy of the brain
+Sample run_once(const Routine& routine, const Spread& spread, std::uint64_t seed, int routine_index, int run) {
+  if (run > 0) {
+    Random random = Random::stream(seed, routine_index, run);
+    vary(spread, random);
+  }
+  pls::sim::routine_select(routine);
+  pls::sim::Devices& brain = pls::sim::devices();
+  brain.competition.connected = true;
+  brain.competition.autonomous = true;
+
+  Sample sample = {};
+  std::uint64_t start_us = pls::sim::now_us();
+  sample.result = pls::sim::run(autonomous, "autonomous", routine.limit_ms);
+  sample.time_s = (pls::sim::now_us() - start_us) / 1e6;
+  sample.end = pls::sim::robot_pose();
+  for (int i = 0; i < pls::trace::size(); i++) {
+    const pls::trace::Event& e = pls::trace::event_get(i);
+    if (e.track == pls::trace::MOTION && e.phase == 'E' && ((int)e.value == ez::VELOCITY_EXIT || (int)e.value == ez::mA_EXIT))
+      sample.stalls++;
+  }
+  sample.done = true;
+  return sample;
+}
+
+double percentile(std::vector<double> values, double p) {
+  if (values.empty()) return 0.0;
+  std::sort(values.begin(), values.end());
+  double index = p / 100.0 * (values.size() - 1);
+  size_t low = (size_t)index;
+  size_t high = std::min(low + 1, values.size() - 1);
+  return values[low] + (values[high] - values[low]) * (index - low);
+}
+
+double angle_error(double a, double b) { return pls::angle::wrap(a - b); }
+
+outcome_e outcome_of(const Sample& sample, const Sample& nominal) {
+  if (!sample.done) return CRASHED;
+  if (sample.result == pls::sim::TIMED_OUT) return TIMED_OUT;
+  if (sample.result == pls::sim::DEADLOCKED) return DEADLOCKED;
+  if (sample.stalls > nominal.stalls) return STALLED;
+  double miss = std::hypot(sample.end.x - nominal.end.x, sample.end.y - nominal.end.y);
+  if (miss > MISS_INCHES || std::fabs(angle_error(sample.end.theta, nominal.end.theta)) > MISS_DEGREES) return MISSED;
+  return OK;
+}
+
+void report(const Routine& routine, const Sample* samples, int runs) {
+  const Sample& nominal = samples[0];
+  std::vector<double> times, x, y, theta, miss;
+  int outcomes[OUTCOMES] = {};
+  for (int run = 1; run <= runs; run++) {
+    const Sample& s = samples[run];
+    outcomes[outcome_of(s, nominal)]++;
+    if (!s.done) continue;
+    if (s.result == pls::sim::FINISHED) times.push_back(s.time_s);
+    x.push_back(s.end.x - nominal.end.x);
+    y.push_back(s.end.y - nominal.end.y);
+    theta.push_back(angle_error(s.end.theta, nominal.end.theta));
+    miss.push_back(std::hypot(x.back(), y.back()));
+  }
+
+  printf("\n%s, %d runs, run 0 ended at (%.2f, %.2f, %.2f) in %.2fs\n", routine.name, runs, nominal.end.x, nominal.end.y, nominal.end.theta, nominal.time_s);
+  printf("  time      p5 %.2fs  p50 %.2fs  p95 %.2fs  p99 %.2fs  max %.2fs\n", percentile(times, 5), percentile(times, 50), percentile(times, 95),
+         percentile(times, 99), percentile(times, 100));
+  printf("  end x     p5 %+.2f  p50 %+.2f  p95 %+.2f in\n", percentile(x, 5), percentile(x, 50), percentile(x, 95));
+  printf("  end y     p5 %+.2f  p50 %+.2f  p95 %+.2f in\n", percentile(y, 5), percentile(y, 50), percentile(y, 95));
+  printf("  end theta p5 %+.2f  p50 %+.2f  p95 %+.2f deg\n", percentile(theta, 5), percentile(theta, 50), percentile(theta, 95));
+  printf("  miss      p50 %.2f  p95 %.2f  max %.2f in\n", percentile(miss, 50), percentile(miss, 95), percentile(miss, 100));
+  printf("  outcomes ");
+  for (int i = 0; i < OUTCOMES; i++)
+    if (outcomes[i] > 0 || i == OK) printf("  %s %d (%.1f%%)", OUTCOME_NAMES[i], outcomes[i], 100.0 * outcomes[i] / std::max(runs, 1));
+  printf("\n");
+}
+
+void usage() {
+  fprintf(stderr, "usage: montecarlo [-n runs] [-j workers] [-s seed] [-w] [routine...]\nroutines:");
+  for (const Routine& routine : ROUTINES) fprintf(stderr, " %s", routine.name);
+  fprintf(stderr, "\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int runs = 1000;
+  int workers = pls::sim::pool_workers_default();
+  std::uint64_t seed = 1;
+  bool sweep = false;
+  std::vector<const Routine*> routines;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+      runs = std::max(1, std::atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "-j") && i + 1 < argc) {
+      workers = std::max(1, std::atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+      seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (!strcmp(argv[i], "-w")) {
+      sweep = true;
+    } else if (const Routine* routine = pls::sim::routine_find(argv[i])) {
+      routines.push_back(routine);
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (routines.empty())
+    for (const Routine& routine : ROUTINES) routines.push_back(&routine);
+
+  pls::sim::robot_install();
+  if (pls::sim::run(initialize, "initialize", 10000) != pls::sim::FINISHED) {
+    fprintf(stderr, "initialize didn't finish\n");
+    return 1;
+  }
+  chassis.pid_print_toggle(false);
+
+  int total = routines.size() * (runs + 1);
+  Sample* samples = pls::sim::shared_array<Sample>(total);
+  // Every batch gives the same samples, so only the last one's are reported
+  auto batch = [&](int batch_workers) {
+    auto wall_start = std::chrono::steady_clock::now();
+    pls::sim::fork_pool(batch_workers, total, [&](int job) {
+      const Routine& routine = *routines[job / (runs + 1)];
+      samples[job] = run_once(routine, Spread(), seed, int(&routine - ROUTINES), job % (runs + 1));
+    });
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+  };
+  std::vector<int> counts;
+  for (int count = 1; sweep && count < workers; count *= 2) counts.push_back(count);
+  counts.push_back(workers);
+  std::vector<double> walls;
+  for (int count : counts) walls.push_back(batch(count));
+  double wall_s = walls.back();
+
+  double sim_s = 0.0;
+  for (int i = 0; i < total; i++) sim_s += samples[i].time_s;
+  for (size_t i = 0; i < routines.size(); i++) report(*routines[i], samples + i * (runs + 1), runs);
+  if (sweep) {
+    printf("\nworkers  wall s   runs/s  speedup  per worker\n");
+    for (size_t i = 0; i < counts.size(); i++)
+      printf("%7d  %6.2f  %7.0f  %6.2fx  %9.0f%%\n", counts[i], walls[i], total / walls[i], walls[0] / walls[i], 100.0 * walls[0] / walls[i] / counts[i]);
+  }
+  printf("\n%d runs in %.2fs on %d workers, %.0f runs/s, %.0f sim s per wall s\n", total, wall_s, workers, total / wall_s, sim_s / wall_s);
+  return 0;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace pls {
+namespace sim {
+/**
+ * Zeroed memory that forked runs write their results into and the parent reads.
+ * Exits if the memory can't be mapped.
+ *
+ * \param count
+ *        number of T to make room for
+ */
+template <typename T>
+T* shared_array(int count) {
+  void* memory = mmap(nullptr, sizeof(T) * std::max(count, 1), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) {
+    perror("shared_array");
+    exit(1);
+  }
+  return static_cast<T*>(memory);
+}
+
+/**
+ * One worker per core.
+ */
+inline int pool_workers_default() { return std::max(1u, std::thread::hardware_concurrency()); }
+
+/**
+ * Runs job(0) to job(total - 1), each in its own forked copy of this process.
+ *
+ * The robot code and the simulator are one set of globals, so runs can't share
+ * a process or run on threads.  Instead each worker process takes the next job
+ * from a shared counter and forks a throwaway copy of the brain for it, so a
+ * worker on a long job doesn't hold the others back.  Jobs print to /dev/null
+ * and send results back through shared_array() memory.  Returns once every job
+ * has finished or crashed.
+ *
+ * \param workers
+ *        worker processes, usually pool_workers_default()
+ * \param total
+ *        number of jobs
+ * \param job
+ *        runs in the forked copy
+ */
+inline void fork_pool(int workers, int total, const std::function<void(int)>& job) {
+  auto* next = new (shared_array<std::atomic<int>>(1)) std::atomic<int>(0);
+  fflush(stdout);
+  fflush(stderr);
+
+  std::vector<pid_t> pids;
+  for (int i = 0; i < workers; i++) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      int null = open("/dev/null", O_WRONLY);
+      if (null >= 0) dup2(null, STDOUT_FILENO);
+      for (int index = next->fetch_add(1); index < total; index = next->fetch_add(1)) {
+        pid_t child = fork();
+        if (child == 0) {
+          job(index);
+          _exit(0);
+        }
+        if (child > 0) waitpid(child, nullptr, 0);
+      }
+      _exit(0);
+    }
+    if (pid > 0) pids.push_back(pid);
+  }
+  for (pid_t pid : pids) waitpid(pid, nullptr, 0);
+  munmap(next, sizeof(std::atomic<int>));
+}
+}  // namespace sim
+}  // namespace pls
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "EZ-Template/api.hpp"
+
+namespace pls {
+namespace sim {
+/**
+ * Pure pursuit's place on a path, found in the same time per tick however long
+ * the path is.
+ *
+ * EZ starts the lookahead at the first point and steps it forward past every
+ * point inside the lookahead circle, then sums the path left after it.  That's
+ * one distance per passed point and one per point left, every tick.  This keeps
+ * the cursor between ticks, looks a bounded window past it, and keeps the
+ * length left after each point from path_set(), so a tick costs the same on a
+ * 10 point path and a 10000 point one.
+ *
+ * The window is WINDOW points plus however many points fit in two lookaheads,
+ * since the whole circle can be passed at once at the start of a path.  The
+ * cursor lands on the same point as EZ's search as long as the robot travels
+ * less than WINDOW points in one tick, 16" a tick with EZ's 0.5" spacing.
+ *
+ * Nothing on the robot runs it.  EZ's pure pursuit lives in the prebuilt V5
+ * library and keeps its own search, so this stays a host tool until a follower
+ * of our own drives paths with it.  ./bin/host/bench -a checks it tick by tick
+ * against EZ's search as host/ez/drive/pid_tasks.cpp runs it, and make bench
+ * times both.
+ */
+class Pursuit {
+ public:
+  /**
+   * Points the cursor can move in one call to advance() past the lookahead's own.
+   */
+  static constexpr int WINDOW = 32;
+
+  /**
+   * Starts over on a new path with the cursor on its first point.
+   */
+  void path_set(const std::vector<ez::odom>& path) {
+    int n = path.size();
+    x.resize(n);
+    y.resize(n);
+    after.assign(n, 0.0);
+    for (int i = 0; i < n; i++) {
+      x[i] = path[i].target.x;
+      y[i] = path[i].target.y;
+    }
+    for (int i = n - 2; i >= 0; i--) after[i] = after[i + 1] + std::hypot(x[i + 1] - x[i], y[i + 1] - y[i]);
+    spacing = n > 1 ? after[0] / (n - 1) : 0.0;
+    cursor = 0;
+  }
+
+  /**
+   * Moves the cursor past every point within look_ahead of current, stopping at
+   * the first point outside it or the end of the path.  Returns the cursor.
+   */
+  int advance(ez::pose current, double look_ahead) {
+    double span = spacing > 0.0 ? std::min(2.0 * look_ahead / spacing, (double)size()) : 0.0;
+    int stop = std::min(cursor + WINDOW + (int)span, size() - 1);
+    while (cursor < stop && std::hypot(x[cursor] - current.x, y[cursor] - current.y) < look_ahead) cursor++;
+    return cursor;
+  }
+
+  /**
+   * Point the cursor is on, the last point once the path is done.
+   */
+  int index() const { return cursor; }
+
+  /**
+   * Number of points on the path.
+   */
+  int size() const { return x.size(); }
+
+  /**
+   * Length of the whole path.
+   */
+  double length() const { return after.empty() ? 0.0 : after[0]; }
+
+  /**
+   * Distance from current to the cursor plus the length of the path after it.
+   */
+  double remaining(ez::pose current) const {
+    if (x.empty()) return 0.0;
+    return std::hypot(x[cursor] - current.x, y[cursor] - current.y) + after[cursor];
+  }
+
+  /**
+   * Where the lookahead circle crosses the segment into the cursor, farthest
+   * along the segment when it crosses twice.  That's exactly look_ahead away,
+   * unlike the cursor's point, which can be up to one spacing past it.  Gives
+   * the cursor's point when the circle misses the segment, like when the robot
+   * is off the path by more than look_ahead.
+   */
+  ez::pose look_ahead_point(ez::pose current, double look_ahead) const {
+    if (x.empty()) return current;
+    ez::pose point = {x[cursor], y[cursor], ez::ANGLE_NOT_SET};
+    if (cursor == 0) return point;
+
+    // |start + t (end - start) - current| = look_ahead is a quadratic in t
+    double dx = x[cursor] - x[cursor - 1], dy = y[cursor] - y[cursor - 1];
+    double fx = x[cursor - 1] - current.x, fy = y[cursor - 1] - current.y;
+    double a = dx * dx + dy * dy;
+    double b = 2.0 * (fx * dx + fy * dy);
+    double c = fx * fx + fy * fy - look_ahead * look_ahead;
+    double discriminant = b * b - 4.0 * a * c;
+    if (a == 0.0 || discriminant < 0.0) return point;
+
+    double t = (-b + std::sqrt(discriminant)) / (2.0 * a);
+    if (t < 0.0 || t > 1.0) return point;
+    point.x = x[cursor - 1] + t * dx;
+    point.y = y[cursor - 1] + t * dy;
+    return point;
+  }
+
+ private:
+  std::vector<double> x, y;
+  std::vector<double> after;  // Path length from each point to the end
+  double spacing = 0.0;       // Average distance between points
+  int cursor = 0;
+};
+}  // namespace sim
+}  // namespace pls
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace pls {
+namespace sim {
+/**
+ * splitmix64, small and the same on every compiler and standard library, so a
+ * seed always gives the same runs.
+ */
+struct Random {
+  std::uint64_t state;
+
+  /**
+   * Random generator for one of many streams, like one run of a routine.
+   * Streams with different numbers don't overlap in any way that matters here.
+   *
+   * \param seed
+   *        seed for the whole batch
+   * \param stream
+   *        which stream
+   * \param index
+   *        which member of the stream
+   */
+  static Random stream(std::uint64_t seed, int stream, int index) {
+    Random random{seed};
+    random.state = random.next() ^ ((std::uint64_t)stream << 32 | (std::uint32_t)index);
+    random.next();
+    return random;
+  }
+
+  std::uint64_t next() {
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  /**
+   * Evenly between 0 and 1.
+   */
+  double uniform() { return (next() >> 11) * 0x1.0p-53; }
+
+  /**
+   * Evenly between low and high.
+   */
+  double uniform(double low, double high) { return low + (high - low) * uniform(); }
+
+  /**
+   * Normally around 0.
+   *
+   * \param deviation
+   *        standard deviation
+   */
+  double normal(double deviation = 1.0) {
+    double u = 1.0 - uniform();  // (0, 1], log can't see 0
+    return deviation * std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * M_PI * uniform());
+  }
+};
+}  // namespace sim
+}  // namespace pls
@@ -0,0 +1,272 @@
+// Feeds a controller recording from pls::input back into opcontrol() on the
+// simulated robot, tick for tick, so driver control changes can be measured
+// and compared without a driver.
+//
+//   make host
+//   ./bin/host/replay input.txt                    Replay, print latency and where the robot ended
+//   ./bin/host/replay -o commands.txt input.txt    Also write every motor and three wire command
+//   ./bin/host/replay -c commands.txt input.txt    Compare commands against another revision's
+//
+// input.txt is what disabled() writes to /usd/input.txt, or a terminal log with
+// the INPUT lines in it.
+//
+// Each sample goes to the controller a few ms before the opcontrol tick that
+// recorded it, like the radio delivering it partway through a loop, so every
+// tick sees what it saw on the robot.  Latency is the time from a sample that
+// changed something to the first motor or three wire command that changed after it.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "main.h"
+#include "sim/devices.hpp"
+#include "sim/robot.hpp"
+#include "sim/scheduler.hpp"
+
+namespace {
+
+// Longer than this and a sample didn't change anything
+constexpr std::uint32_t NO_RESPONSE_MS = 200;
+
+struct Recording {
+  std::string name;
+  bool competition = false;
+  std::vector<pls::input::Sample> samples;
+};
+
+// Reads the INPUT lines pls::input::dump() writes, skipping anything else
+bool recording_read(const char* path, Recording& recording) {
+  FILE* in = fopen(path, "r");
+  if (in == nullptr) return false;
+  char line[256];
+  while (fgets(line, sizeof(line), in)) {
+    const char* text = strstr(line, "INPUT ");
+    if (text == nullptr) continue;
+    text += strlen("INPUT ");
+    int competition;
+    char name[64] = "";
+    unsigned long time_ms;
+    int analog[4];
+    unsigned buttons;
+    if (sscanf(text, "START %d %63[^\r\n]", &competition, name) >= 1) {
+      recording.competition = competition;
+      recording.name = name;
+      recording.samples.clear();
+    } else if (sscanf(text, "%lu %d %d %d %d %x", &time_ms, &analog[0], &analog[1], &analog[2], &analog[3], &buttons) == 6) {
+      pls::input::Sample s = {};
+      s.time_ms = time_ms;
+      for (int i = 0; i < 4; i++) s.analog[i] = (std::int8_t)std::clamp(analog[i], -127, 127);
+      s.buttons = buttons;
+      recording.samples.push_back(s);
+    }
+  }
+  fclose(in);
+  return !recording.samples.empty();
+}
+
+// What the robot code last told a motor or three wire port to do
+struct Output {
+  std::string name;
+  long long value[2];
+};
+
+std::vector<Output> outputs_read() {
+  std::vector<Output> outputs;
+  pls::sim::Devices& brain = pls::sim::devices();
+  for (int port = 1; port <= pls::sim::SMART_PORTS; port++) {
+    if (brain.type[port] != pls::sim::MOTOR) continue;
+    const pls::sim::Motor& m = brain.motors[port];
+    double command = m.mode == pls::sim::Motor::ABSOLUTE ? m.target_position * 1000.0 : m.command;
+    outputs.push_back({"motor " + std::to_string(port), {m.mode, std::llround(command)}});
+  }
+  for (int port = 1; port <= pls::sim::SMART_PORTS + 1; port++) {
+    for (int i = 0; i < pls::sim::ADI_PORTS; i++) {
+      if (brain.adi[port].changes[i] == 0) continue;
+      std::string name = "adi " + std::to_string(port) + char('A' + i);
+      outputs.push_back({name, {brain.adi[port].config[i], brain.adi[port].value[i]}});
+    }
+  }
+  return outputs;
+}
+
+struct Replay {
+  const Recording* recording;
+  std::uint32_t lead_ms;
+  std::uint64_t start_us;
+  size_t next = 0;  // Next sample to hand the controller
+  std::vector<Output> outputs;
+  std::vector<std::string> commands;  // Every output change, "<ms> <name> <values>"
+  std::int64_t pending_us = -1;       // When a sample changed the controller and nothing responded yet
+  std::vector<double> latency_ms;
+  int unanswered = 0;
+};
+
+Replay replay;
+
+void controller_set(const pls::input::Sample& s) {
+  pls::sim::Controller& controller = pls::sim::devices().controllers[0];
+  for (int i = 0; i < 4; i++) controller.analog[i] = s.analog[i];
+  for (int i = 0; i < pls::input::BUTTONS; i++) controller.button_set(i, s.buttons & (1 << i));
+}
+
+bool sample_changes(size_t index) {
+  if (index == 0) return true;
+  const pls::input::Sample& a = replay.recording->samples[index - 1];
+  const pls::input::Sample& b = replay.recording->samples[index];
+  return a.buttons != b.buttons || memcmp(a.analog, b.analog, sizeof(a.analog)) != 0;
+}
+
+// Runs every simulated ms, after the tasks before it and before the tasks waking at the end of it
+void step_devices_and_replay(double dt) {
+  pls::sim::devices().step(dt);
+  std::uint64_t now_us = pls::sim::now_us() - replay.start_us;
+
+  std::vector<Output> outputs = outputs_read();
+  bool changed = false;
+  for (const Output& o : outputs) {
+    auto old = std::find_if(replay.outputs.begin(), replay.outputs.end(), [&](const Output& p) { return p.name == o.name; });
+    if (old != replay.outputs.end() && old->value[0] == o.value[0] && old->value[1] == o.value[1]) continue;
+    replay.commands.push_back(std::to_string(now_us / 1000) + " " + o.name + " " + std::to_string(o.value[0]) + " " + std::to_string(o.value[1]));
+    changed = true;
+  }
+  replay.outputs = std::move(outputs);
+
+  if (replay.pending_us >= 0) {
+    if (changed) {
+      replay.latency_ms.push_back((now_us - replay.pending_us) / 1000.0);
+      replay.pending_us = -1;
+    } else if (now_us - replay.pending_us > NO_RESPONSE_MS * 1000) {
+      replay.unanswered++;
+      replay.pending_us = -1;
+    }
+  }
+
+  const std::vector<pls::input::Sample>& samples = replay.recording->samples;
+  while (replay.next < samples.size() && (std::uint64_t)samples[replay.next].time_ms * 1000 <= now_us + replay.lead_ms * 1000) {
+    controller_set(samples[replay.next]);
+    if (sample_changes(replay.next) && replay.pending_us < 0) replay.pending_us = now_us;
+    replay.next++;
+  }
+}
+
+double percentile(std::vector<double> values, double p) {
+  if (values.empty()) return 0.0;
+  std::sort(values.begin(), values.end());
+  double index = p / 100.0 * (values.size() - 1);
+  size_t low = (size_t)index;
+  size_t high = std::min(low + 1, values.size() - 1);
+  return values[low] + (values[high] - values[low]) * (index - low);
+}
+
+// Prints the first command that differs from another run's, returns false if any do
+bool commands_compare(const char* path, const std::vector<std::string>& commands) {
+  FILE* in = fopen(path, "r");
+  if (in == nullptr) {
+    perror(path);
+    return false;
+  }
+  std::vector<std::string> other;
+  char line[256];
+  while (fgets(line, sizeof(line), in)) {
+    line[strcspn(line, "\r\n")] = '\0';
+    other.push_back(line);
+  }
+  fclose(in);
+
+  size_t n = std::min(commands.size(), other.size());
+  for (size_t i = 0; i < n; i++) {
+    if (commands[i] == other[i]) continue;
+    printf("\ncommands differ from %s at change %zu:\n  was %s\n  now %s\n", path, i + 1, other[i].c_str(), commands[i].c_str());
+    return false;
+  }
+  if (commands.size() != other.size()) {
+    printf("\ncommands match %s for %zu changes, then %s has %zu more\n", path, n, commands.size() > other.size() ? "this run" : path,
+           std::max(commands.size(), other.size()) - n);
+    return false;
+  }
+  printf("\ncommands match %s, all %zu changes\n", path, n);
+  return true;
+}
+
+void usage() { fprintf(stderr, "usage: replay [-o commands_out] [-c commands_to_compare] [-l lead_ms] <recording>\n"); }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const char* out_path = nullptr;
+  const char* compare_path = nullptr;
+  const char* recording_path = nullptr;
+  std::uint32_t lead_ms = 5;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+      out_path = argv[++i];
+    } else if (!strcmp(argv[i], "-c") && i + 1 < argc) {
+      compare_path = argv[++i];
+    } else if (!strcmp(argv[i], "-l") && i + 1 < argc) {
+      lead_ms = std::clamp(std::atoi(argv[++i]), 0, (int)ez::util::DELAY_TIME - 1);
+    } else if (recording_path == nullptr && argv[i][0] != '-') {
+      recording_path = argv[i];
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (recording_path == nullptr) {
+    usage();
+    return 2;
+  }
+
+  Recording recording;
+  if (!recording_read(recording_path, recording)) {
+    fprintf(stderr, "no INPUT lines in %s\n", recording_path);
+    return 1;
+  }
+
+  pls::sim::robot_install();
+  if (pls::sim::run(initialize, "initialize", 10000) != pls::sim::FINISHED) {
+    fprintf(stderr, "initialize didn't finish\n");
+    return 1;
+  }
+  chassis.pid_print_toggle(false);
+
+  pls::sim::Devices& brain = pls::sim::devices();
+  brain.competition.connected = recording.competition;
+  brain.competition.autonomous = false;
+  replay.recording = &recording;
+  replay.lead_ms = lead_ms;
+  replay.start_us = pls::sim::now_us();
+  replay.outputs = outputs_read();
+  pls::sim::step_callback_set(step_devices_and_replay);
+  step_devices_and_replay(0.0);  // The first sample is on the controller when opcontrol starts
+
+  // opcontrol never returns, so it runs until the recording ends
+  std::uint32_t length_ms = recording.samples.back().time_ms + ez::util::DELAY_TIME;
+  pls::sim::run_result result = pls::sim::run(opcontrol, "opcontrol", length_ms);
+
+  pls::sim::RobotPose end = pls::sim::robot_pose();
+  printf("\n%s, %zu samples over %.2fs%s\n", recording.name.c_str(), recording.samples.size(), length_ms / 1000.0,
+         recording.competition ? " on competition control" : "");
+  if (result == pls::sim::DEADLOCKED) printf("  deadlocked at %.2fs\n", (pls::sim::now_us() - replay.start_us) / 1e6);
+  printf("  latency   p50 %.1fms  p95 %.1fms  max %.1fms over %zu changes, %d changed nothing\n", percentile(replay.latency_ms, 50),
+         percentile(replay.latency_ms, 95), percentile(replay.latency_ms, 100), replay.latency_ms.size(), replay.unanswered);
+  printf("  commands  %zu changes\n", replay.commands.size());
+  printf("  ended at  (%.2f, %.2f, %.2f), odom (%.2f, %.2f, %.2f)\n", end.x, end.y, end.theta, chassis.odom_x_get(), chassis.odom_y_get(),
+         chassis.odom_theta_get());
+
+  if (out_path != nullptr) {
+    FILE* out = fopen(out_path, "w");
+    if (out == nullptr) {
+      perror(out_path);
+      return 1;
+    }
+    for (const std::string& command : replay.commands) fprintf(out, "%s\n", command.c_str());
+    fclose(out);
+  }
+  if (compare_path != nullptr && !commands_compare(compare_path, replay.commands)) return 1;
+  return result == pls::sim::DEADLOCKED ? 1 : 0;
+}
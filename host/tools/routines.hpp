@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "main.h"
+
+namespace pls {
+namespace sim {
+/**
+ * An autonomous routine the host tools can run, and how long the field gives it.
+ */
+struct Routine {
+  const char* name;
+  void (*function)();
+  std::uint32_t limit_ms;
+};
+
+inline const Routine ROUTINES[] = {
+    {"RA7", RA7, 15000},
+    {"RA34", RA34, 15000},
+    {"LA7", LA7, 15000},
+    {"LA34", LA34, 15000},
+    {"skills", skills, 60000},
+    {"WinForPoint", WinForPoint, 15000},
+};
+
+/**
+ * Returns the routine with this name, or nullptr.
+ */
+inline const Routine* routine_find(const char* name) {
+  for (const Routine& routine : ROUTINES)
+    if (!strcmp(name, routine.name)) return &routine;
+  return nullptr;
+}
+
+/**
+ * Points the auton selector at a routine so autonomous() runs it, and traces
+ * it by its name.
+ */
+inline void routine_select(const Routine& routine) {
+  auto& selector = ez::as::auton_selector;
+  for (size_t i = 0; i < selector.Autons.size(); i++) {
+    auto* function = selector.Autons[i].auton_call.target<void (*)()>();
+    if (function != nullptr && *function == routine.function) selector.auton_page_current = i;
+  }
+}
+}  // namespace sim
+}  // namespace pls
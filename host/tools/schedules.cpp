@@ -0,0 +1,207 @@
+// Runs autonomous routines under many different task interleavings to find
+// races, deadlocks and priority inversions that only happen in some of them.
+//
+//   make host
+//   ./bin/host/schedules                   200 schedules of every routine
+//   ./bin/host/schedules -n 1000 RA7       1000 schedules of RA7
+//   ./bin/host/schedules -p 0.3 -s 500     Switch tasks more often, seeds from 500
+//   ./bin/host/auton -S 512 RA7            Run one schedule again and print what it found
+//
+// Schedule 0 is the fixed order every other tool runs.  The others each use
+// their own seed for pls::sim::schedule_seed_set, from initialize() on, so any
+// schedule can be run again on its own.  Besides what the scheduler reports, a
+// routine that ends somewhere else depending on the schedule depends on timing
+// between tasks that nothing pins down.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "main.h"
+#include "sim/robot.hpp"
+#include "sim/scheduler.hpp"
+#include "tools/pool.hpp"
+#include "tools/routines.hpp"
+
+namespace {
+
+using pls::sim::Routine;
+using pls::sim::ROUTINES;
+
+// Farther than this from schedule 0 and the end pose depends on the schedule
+constexpr double SPREAD_INCHES = 0.5;
+constexpr double SPREAD_DEGREES = 1.0;
+
+constexpr int MAX_ISSUES = 8;
+const char* KIND_NAMES[] = {"race", "deadlock", "inversion"};
+
+// What a schedule sends back to the parent
+struct Sample {
+  bool done;
+  int result;  // pls::sim::run_result
+  float time_s;
+  pls::sim::RobotPose end;
+  int issue_count;
+  struct {
+    int kind;
+    int count;
+    float worst_ms;
+    char text[152];
+    char details[64];
+  } issues[MAX_ISSUES];
+};
+
+std::uint64_t seed_of(std::uint64_t first_seed, int schedule) { return schedule == 0 ? 0 : first_seed + schedule - 1; }
+
+Sample run_once(const Routine& routine, std::uint64_t seed, double preempt_chance) {
+  Sample sample = {};
+  pls::sim::schedule_seed_set(seed, preempt_chance);
+  pls::sim::robot_install();
+  if (pls::sim::run(initialize, "initialize", 10000) != pls::sim::FINISHED) {
+    sample.result = pls::sim::DEADLOCKED;
+  } else {
+    chassis.pid_print_toggle(false);
+    pls::sim::routine_select(routine);
+    pls::sim::Devices& brain = pls::sim::devices();
+    brain.competition.connected = true;
+    brain.competition.autonomous = true;
+    std::uint64_t start_us = pls::sim::now_us();
+    sample.result = pls::sim::run(autonomous, "autonomous", routine.limit_ms);
+    sample.time_s = (pls::sim::now_us() - start_us) / 1e6;
+  }
+  sample.end = pls::sim::robot_pose();
+
+  for (const pls::sim::Issue& issue : pls::sim::issues()) {
+    if (sample.issue_count == MAX_ISSUES) break;
+    auto& out = sample.issues[sample.issue_count++];
+    out.kind = issue.kind;
+    out.count = issue.count;
+    out.worst_ms = issue.worst_us / 1000.0;
+    snprintf(out.text, sizeof(out.text), "%s", issue.text.c_str());
+    snprintf(out.details, sizeof(out.details), "%s", issue.details.c_str());
+  }
+  sample.done = true;
+  return sample;
+}
+
+double angle_error(double a, double b) { return pls::angle::wrap(a - b); }
+
+// An issue and the schedules it showed up in
+struct Found {
+  int kind;
+  std::string text;
+  std::string details;  // From the first schedule it showed up in
+  int schedules = 0;
+  int first_schedule = -1;
+  float worst_ms = 0.0f;
+};
+
+// Prints what the schedules of one routine found, returns the number of problems
+int report(const Routine& routine, const Sample* samples, int schedules, std::uint64_t first_seed) {
+  const Sample& fixed = samples[0];
+  std::vector<Found> found;
+  int results[3] = {}, crashed = 0, spread = 0, spread_first = -1;
+  double worst_in = 0.0, worst_deg = 0.0, fastest = 1e9, slowest = 0.0;
+  for (int i = 0; i < schedules; i++) {
+    const Sample& s = samples[i];
+    if (!s.done) {
+      crashed++;
+      continue;
+    }
+    results[std::clamp(s.result, 0, 2)]++;
+    fastest = std::min<double>(fastest, s.time_s);
+    slowest = std::max<double>(slowest, s.time_s);
+    double in = std::hypot(s.end.x - fixed.end.x, s.end.y - fixed.end.y);
+    double deg = std::fabs(angle_error(s.end.theta, fixed.end.theta));
+    worst_in = std::max(worst_in, in);
+    worst_deg = std::max(worst_deg, deg);
+    if (in > SPREAD_INCHES || deg > SPREAD_DEGREES) {
+      spread++;
+      if (spread_first < 0) spread_first = i;
+    }
+    for (int j = 0; j < s.issue_count; j++) {
+      auto it = std::find_if(found.begin(), found.end(), [&](const Found& f) { return f.kind == s.issues[j].kind && f.text == s.issues[j].text; });
+      if (it == found.end()) {
+        found.push_back({s.issues[j].kind, s.issues[j].text, s.issues[j].details});
+        it = found.end() - 1;
+      }
+      if (it->first_schedule < 0) it->first_schedule = i;
+      it->schedules++;
+      it->worst_ms = std::max(it->worst_ms, s.issues[j].worst_ms);
+    }
+  }
+
+  printf("\n%s, %d schedules\n", routine.name, schedules);
+  printf("  finished %d  timed out %d  deadlocked %d%s\n", results[pls::sim::FINISHED], results[pls::sim::TIMED_OUT], results[pls::sim::DEADLOCKED],
+         crashed > 0 ? ("  crashed " + std::to_string(crashed)).c_str() : "");
+  printf("  time      %.2fs to %.2fs, schedule 0 took %.2fs\n", fastest, slowest, fixed.time_s);
+  printf("  end pose  up to %.2f in and %.2f deg from schedule 0", worst_in, worst_deg);
+  if (spread > 0)
+    printf(", %d schedules farther than %.1f in or %.1f deg, first with seed %llu", spread, SPREAD_INCHES, SPREAD_DEGREES,
+           (unsigned long long)seed_of(first_seed, spread_first));
+  printf("\n");
+  for (const Found& f : found) {
+    printf("  %-9s in %d schedules, first with seed %llu", KIND_NAMES[f.kind], f.schedules, (unsigned long long)seed_of(first_seed, f.first_schedule));
+    if (f.kind == pls::sim::INVERSION) printf(", worst %.1fms", f.worst_ms);
+    printf("\n    %s%s%s\n", f.text.c_str(), f.details.empty() ? "" : ", on ", f.details.c_str());
+  }
+
+  int problems = crashed + results[pls::sim::DEADLOCKED];
+  for (const Found& f : found)
+    if (f.kind != pls::sim::INVERSION || f.worst_ms > 0.0f) problems++;  // Inversions the owner ends in no time are harmless
+  return problems;
+}
+
+void usage() {
+  fprintf(stderr, "usage: schedules [-n schedules] [-j workers] [-s first_seed] [-p preempt_chance] [routine...]\nroutines:");
+  for (const Routine& routine : ROUTINES) fprintf(stderr, " %s", routine.name);
+  fprintf(stderr, "\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int schedules = 200;
+  int workers = pls::sim::pool_workers_default();
+  std::uint64_t first_seed = 1;
+  double preempt_chance = 0.1;
+  std::vector<const Routine*> routines;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+      schedules = std::max(1, std::atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "-j") && i + 1 < argc) {
+      workers = std::max(1, std::atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+      first_seed = std::max(1ull, std::strtoull(argv[++i], nullptr, 10));
+    } else if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+      preempt_chance = std::clamp(std::atof(argv[++i]), 0.0, 1.0);
+    } else if (const Routine* routine = pls::sim::routine_find(argv[i])) {
+      routines.push_back(routine);
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (routines.empty())
+    for (const Routine& routine : ROUTINES) routines.push_back(&routine);
+
+  int total = routines.size() * schedules;
+  Sample* samples = pls::sim::shared_array<Sample>(total);
+  auto wall_start = std::chrono::steady_clock::now();
+  pls::sim::fork_pool(workers, total, [&](int job) {
+    samples[job] = run_once(*routines[job / schedules], seed_of(first_seed, job % schedules), preempt_chance);
+  });
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+  int problems = 0;
+  double sim_s = 0.0;
+  for (int i = 0; i < total; i++) sim_s += samples[i].time_s;
+  for (size_t i = 0; i < routines.size(); i++) problems += report(*routines[i], samples + i * schedules, schedules, first_seed);
+  printf("\n%d schedules in %.2fs on %d workers, %.0f schedules/s, %.0f sim s per wall s\n", total, wall_s, workers, total / wall_s, sim_s / wall_s);
+  return problems > 0 ? 1 : 0;
+}
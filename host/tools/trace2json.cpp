@@ -0,0 +1,173 @@
+// Converts a trace printed by pls::trace::dump() into Chrome trace JSON, which
+// opens in chrome://tracing or https://ui.perfetto.dev.
+//
+//   g++ -std=c++17 -O2 host/tools/trace2json.cpp -o trace2json
+//   ./trace2json trace.txt > trace.json
+//
+// Lines that don't start with TRACE are skipped, so a whole terminal log works
+// as input.  A summary of where the run spent its time goes to stderr.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Event {
+  char phase;
+  unsigned long time_us;
+  int track;
+  double value;
+  std::string name;
+};
+
+struct Span {
+  std::string name;
+  double value;
+  unsigned long start_us;
+  unsigned long end_us;
+  std::string reason;
+};
+
+const char* track_name(int track) {
+  switch (track) {
+    case 1:
+      return "motion";
+    case 2:
+      return "auton task";
+    case 3:
+      return "mechanisms";
+    default:
+      return "other";
+  }
+}
+
+std::string escape(const std::string& input) {
+  std::string out;
+  for (char c : input) {
+    if (c == '"' || c == '\\') out += '\\';
+    out += c;
+  }
+  return out;
+}
+
+// Pairs begin and end events on one track
+std::vector<Span> spans_get(const std::vector<Event>& events, int track) {
+  std::vector<Span> spans;
+  std::vector<size_t> open;
+  for (const Event& e : events) {
+    if (e.track != track) continue;
+    if (e.phase == 'B') {
+      open.push_back(spans.size());
+      spans.push_back({e.name, e.value, e.time_us, e.time_us, ""});
+    } else if (e.phase == 'E' && !open.empty()) {
+      Span& s = spans[open.back()];
+      open.pop_back();
+      s.end_us = e.time_us;
+      s.reason = e.name;
+    }
+  }
+  return spans;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::ifstream file;
+  if (argc > 1) {
+    file.open(argv[1]);
+    if (!file) {
+      std::cerr << "trace2json: could not open " << argv[1] << "\n";
+      return 1;
+    }
+  }
+  std::istream& in = argc > 1 ? file : std::cin;
+
+  std::string run = "auton";
+  std::vector<Event> events;
+  int dropped = 0;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    size_t at = line.find("TRACE ");
+    if (at == std::string::npos) continue;
+    std::istringstream fields(line.substr(at + 6));
+    std::string phase;
+    fields >> phase;
+    if (phase == "START") {
+      events.clear();
+      std::getline(fields >> std::ws, run);
+    } else if (phase == "DONE") {
+      int count;
+      fields >> count >> dropped;
+    } else if (phase.size() == 1) {
+      Event e;
+      e.phase = phase[0];
+      if (!(fields >> e.time_us >> e.track >> e.value)) continue;
+      std::getline(fields >> std::ws, e.name);
+      events.push_back(e);
+    }
+  }
+  if (events.empty()) {
+    std::cerr << "trace2json: no TRACE lines found\n";
+    return 1;
+  }
+
+  // Motion end events carry the exit reason, keep the motion name on them
+  std::vector<Span> motions = spans_get(events, 1);
+  std::vector<Span> waits = spans_get(events, 2);
+
+  std::ostream& out = std::cout;
+  out << "{\"traceEvents\":[\n";
+  out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"" << escape(run) << "\"}}";
+  for (int track = 1; track <= 3; track++)
+    out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << track << ",\"args\":{\"name\":\"" << track_name(track) << "\"}}";
+  for (const Span& s : motions)
+    out << ",\n{\"name\":\"" << escape(s.name) << "\",\"cat\":\"motion\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << s.start_us
+        << ",\"dur\":" << s.end_us - s.start_us << ",\"args\":{\"target\":" << s.value << ",\"exit\":\"" << escape(s.reason) << "\"}}";
+  for (const Span& s : waits)
+    out << ",\n{\"name\":\"" << escape(s.name) << "\",\"cat\":\"wait\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":" << s.start_us
+        << ",\"dur\":" << s.end_us - s.start_us << ",\"args\":{\"value\":" << s.value << "}}";
+  for (const Event& e : events) {
+    if (e.phase != 'i') continue;
+    out << ",\n{\"name\":\"" << escape(e.name) << "\",\"cat\":\"mechanism\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":" << e.track
+        << ",\"ts\":" << e.time_us << ",\"args\":{\"value\":" << e.value << "}}";
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  // Summary of where the auton spent its time
+  unsigned long total_us = events.back().time_us;
+  unsigned long delay_us = 0, wait_us = 0;
+  for (const Span& s : waits) {
+    if (s.name == "delay")
+      delay_us += s.end_us - s.start_us;
+    else
+      wait_us += s.end_us - s.start_us;
+  }
+  std::fprintf(stderr, "%s: %.3f s, %zu motions, %zu events", run.c_str(), total_us / 1e6, motions.size(), events.size());
+  if (dropped > 0) std::fprintf(stderr, " (%d dropped, raise pls::trace::MAX_EVENTS)", dropped);
+  std::fprintf(stderr, "\n  waiting on motions %7.3f s\n  in delays          %7.3f s\n", wait_us / 1e6, delay_us / 1e6);
+
+  std::vector<std::pair<std::string, int>> reasons;
+  for (const Span& s : motions) {
+    auto it = std::find_if(reasons.begin(), reasons.end(), [&](const auto& r) { return r.first == s.reason; });
+    if (it == reasons.end())
+      reasons.push_back({s.reason, 1});
+    else
+      it->second++;
+  }
+  std::fprintf(stderr, "exit reasons:\n");
+  for (const auto& r : reasons) std::fprintf(stderr, "  %-20s %d\n", r.first.empty() ? "(never ended)" : r.first.c_str(), r.second);
+
+  std::vector<Span> slowest = motions;
+  std::sort(slowest.begin(), slowest.end(), [](const Span& a, const Span& b) { return a.end_us - a.start_us > b.end_us - b.start_us; });
+  if (slowest.size() > 5) slowest.resize(5);
+  std::fprintf(stderr, "slowest motions:\n");
+  for (const Span& s : slowest)
+    std::fprintf(stderr, "  %7.3f s at %7.3f s  %-24s %8.2f  %s\n", (s.end_us - s.start_us) / 1e6, s.start_us / 1e6, s.name.c_str(), s.value, s.reason.c_str());
+  return 0;
+}
@@ -0,0 +1,525 @@
+// Tunes the PID constants and exit conditions in default_constants() on the
+// simulated robot, and prints a default_constants() to paste back in.
+//
+//   make host
+//   ./bin/host/tune                    Tune on every routine
+//   ./bin/host/tune -g 40 RA7 skills   40 generations on RA7 and skills
+//   ./bin/host/tune -p 24 -j 8 -s 3    24 candidates a generation, 8 workers, seed 3
+//
+// Candidates are scored on the autons themselves, so the mix of drives, turns,
+// swings and odom motions is the one the robot really runs.  A candidate's cost
+// is how long the routines take, plus penalties for overshooting motion
+// targets, for ending somewhere other than the hand tuned constants do, and for
+// routines that stall, time out or crash.
+//
+// The search is CMA-ES, each generation samples candidates around the best so
+// far and learns which directions improve.  Every candidate runs each routine in
+// its own process through fork_pool() (host/tools/pool.hpp), one worker per core.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "main.h"
+#include "sim/robot.hpp"
+#include "sim/scheduler.hpp"
+#include "tools/pool.hpp"
+#include "tools/random.hpp"
+#include "tools/routines.hpp"
+
+namespace {
+
+using pls::sim::Random;
+using pls::sim::Routine;
+using pls::sim::ROUTINES;
+
+// What's tuned, starting from the values in src/autons.cpp
+struct Parameter {
+  const char* name;
+  double value;
+  double low;
+  double high;
+};
+
+enum parameter_e { DRIVE_P = 0,
+                   DRIVE_D,
+                   HEADING_P,
+                   HEADING_D,
+                   TURN_P,
+                   TURN_I,
+                   TURN_D,
+                   SWING_P,
+                   SWING_D,
+                   ODOM_ANGULAR_P,
+                   ODOM_ANGULAR_D,
+                   BOOMERANG_P,
+                   BOOMERANG_D,
+                   TURN_EXIT_MS,
+                   TURN_EXIT_DEG,
+                   DRIVE_EXIT_MS,
+                   DRIVE_EXIT_IN,
+                   PARAMETERS };
+
+const Parameter PARAMETER_TABLE[PARAMETERS] = {
+    {"drive kp", 8.4, 2.0, 20.0},
+    {"drive kd", 46.5, 0.0, 120.0},
+    {"heading kp", 10.0, 2.0, 25.0},
+    {"heading kd", 22.75, 0.0, 60.0},
+    {"turn kp", 3.0, 1.0, 8.0},
+    {"turn ki", 0.05, 0.0, 0.3},
+    {"turn kd", 20.0, 0.0, 60.0},
+    {"swing kp", 6.0, 2.0, 15.0},
+    {"swing kd", 65.0, 0.0, 150.0},
+    {"odom angular kp", 3.5, 1.0, 10.0},
+    {"odom angular kd", 35.0, 0.0, 80.0},
+    {"boomerang kp", 5.8, 1.0, 12.0},
+    {"boomerang kd", 32.5, 0.0, 80.0},
+    {"turn exit ms", 90.0, 30.0, 200.0},
+    {"turn exit deg", 3.0, 1.0, 5.0},
+    {"drive exit ms", 90.0, 30.0, 200.0},
+    {"drive exit in", 1.0, 0.3, 2.0},
+};
+
+// Cost of each thing that can go wrong, in seconds
+constexpr double COST_PER_OVERSHOOT = 0.05;  // Per inch or degree past a target
+constexpr double COST_PER_MISS_INCH = 0.5;   // Per inch from where the hand tuned constants end
+constexpr double COST_PER_MISS_DEGREE = 0.1;
+constexpr double COST_PER_STALL = 5.0;  // Per motion that exits on velocity or current
+constexpr double COST_FAILED = 30.0;    // Timed out, deadlocked or crashed
+
+using Candidate = std::array<double, PARAMETERS>;
+
+// Sets everything tuned.  Anything default_constants() sets that isn't tuned keeps its value.
+void apply(const Candidate& v) {
+  chassis.pid_drive_constants_set(v[DRIVE_P], 0.0, v[DRIVE_D]);
+  chassis.pid_heading_constants_set(v[HEADING_P], 0.0, v[HEADING_D]);
+  chassis.pid_turn_constants_set(v[TURN_P], v[TURN_I], v[TURN_D], 15.0);
+  chassis.pid_swing_constants_set(v[SWING_P], 0.0, v[SWING_D]);
+  chassis.pid_odom_angular_constants_set(v[ODOM_ANGULAR_P], 0.0, v[ODOM_ANGULAR_D]);
+  chassis.pid_odom_boomerang_constants_set(v[BOOMERANG_P], 0.0, v[BOOMERANG_D]);
+
+  int turn_ms = std::lround(v[TURN_EXIT_MS]);
+  int drive_ms = std::lround(v[DRIVE_EXIT_MS]);
+  chassis.pid_turn_exit_condition_set(turn_ms, v[TURN_EXIT_DEG], 250, 7, 500, 500);
+  chassis.pid_swing_exit_condition_set(turn_ms, v[TURN_EXIT_DEG], 250, 7, 500, 500);
+  chassis.pid_drive_exit_condition_set(drive_ms, v[DRIVE_EXIT_IN], 250, 3, 500, 500);
+  chassis.pid_odom_turn_exit_condition_set(turn_ms, v[TURN_EXIT_DEG], 250, 7, 500, 750);
+  chassis.pid_odom_drive_exit_condition_set(drive_ms, v[DRIVE_EXIT_IN], 250, 3, 500, 750);
+}
+
+// A number as a C++ literal with 3 significant figures
+std::string literal(double value) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.3g", value);
+  std::string text = buf;
+  if (text.find_first_of(".e") == std::string::npos) text += ".0";
+  return text;
+}
+
+void default_constants_print(const Candidate& v) {
+  int turn_ms = std::lround(v[TURN_EXIT_MS]);
+  int drive_ms = std::lround(v[DRIVE_EXIT_MS]);
+  std::string turn_deg = literal(v[TURN_EXIT_DEG]);
+  std::string drive_in = literal(v[DRIVE_EXIT_IN]);
+  printf("void default_constants() {\n");
+  printf("  // P, I, D\n");
+  printf("  chassis.pid_drive_constants_set(%s, 0.0, %s);\n", literal(v[DRIVE_P]).c_str(), literal(v[DRIVE_D]).c_str());
+  printf("  chassis.pid_heading_constants_set(%s, 0.0, %s);\n", literal(v[HEADING_P]).c_str(), literal(v[HEADING_D]).c_str());
+  printf("  chassis.pid_turn_constants_set(%s, %s, %s, 15.0);\n", literal(v[TURN_P]).c_str(), literal(v[TURN_I]).c_str(), literal(v[TURN_D]).c_str());
+  printf("  chassis.pid_swing_constants_set(%s, 0.0, %s);\n", literal(v[SWING_P]).c_str(), literal(v[SWING_D]).c_str());
+  printf("\n  // Odom angular\n");
+  printf("  chassis.pid_odom_angular_constants_set(%s, 0.0, %s);\n", literal(v[ODOM_ANGULAR_P]).c_str(), literal(v[ODOM_ANGULAR_D]).c_str());
+  printf("  chassis.pid_odom_boomerang_constants_set(%s, 0.0, %s);\n", literal(v[BOOMERANG_P]).c_str(), literal(v[BOOMERANG_D]).c_str());
+  printf("\n  // Exit conditions (keep yours mostly normal)\n");
+  printf("  chassis.pid_turn_exit_condition_set(%d_ms, %s_deg, 250_ms, 7_deg, 500_ms, 500_ms);\n", turn_ms, turn_deg.c_str());
+  printf("  chassis.pid_swing_exit_condition_set(%d_ms, %s_deg, 250_ms, 7_deg, 500_ms, 500_ms);\n", turn_ms, turn_deg.c_str());
+  printf("  chassis.pid_drive_exit_condition_set(%d_ms, %s_in, 250_ms, 3_in, 500_ms, 500_ms);\n", drive_ms, drive_in.c_str());
+  printf("\n");
+  printf("  chassis.pid_odom_turn_exit_condition_set(%d_ms, %s_deg, 250_ms, 7_deg, 500_ms, 750_ms);\n", turn_ms, turn_deg.c_str());
+  printf("  chassis.pid_odom_drive_exit_condition_set(%d_ms, %s_in, 250_ms, 3_in, 500_ms, 750_ms);\n", drive_ms, drive_in.c_str());
+  printf(R"(
+  chassis.pid_turn_chain_constant_set(3_deg);
+  chassis.pid_swing_chain_constant_set(5_deg);
+  chassis.pid_drive_chain_constant_set(3_in);
+
+  chassis.slew_turn_constants_set(3_deg, 70);
+  chassis.slew_drive_constants_set(3_in, 70);
+  chassis.slew_swing_constants_set(3_in, 80);
+
+  // Bias
+  chassis.odom_turn_bias_set(0.7);
+
+  chassis.odom_look_ahead_set(9.5_in);
+  chassis.odom_boomerang_distance_set(16_in);
+  chassis.odom_boomerang_dlead_set(0.625);
+
+  chassis.pid_angle_behavior_set(ez::shortest);
+}
+)");
+}
+
+// How one routine went for one candidate
+struct Run {
+  bool done;
+  int result;  // pls::sim::run_result
+  int stalls;
+  float time_s;
+  float overshoot;  // Inches and degrees past targets, over every motion
+  pls::sim::RobotPose end;
+};
+
+// Watches how far past its target each motion goes, every simulated ms
+struct OvershootMonitor {
+  int events_seen = 0;
+  int direction = 0;  // Sign of the motion's error before it reaches the target
+  double motion = 0.0;
+  double total = 0.0;
+
+  static double error() {
+    switch (chassis.mode) {
+      case ez::DRIVE:
+        return (chassis.leftPID.error + chassis.rightPID.error) / 2.0;
+      case ez::TURN:
+      case ez::TURN_TO_POINT:
+        return chassis.turnPID.error;
+      case ez::SWING:
+        return chassis.swingPID.error;
+      case ez::POINT_TO_POINT:
+      case ez::PURE_PURSUIT:
+        return chassis.xyPID.error;
+      default:
+        return 0.0;
+    }
+  }
+
+  void step() {
+    int size = pls::trace::size();
+    if (size < events_seen) events_seen = 0;  // Trace started over
+    for (; events_seen < size; events_seen++) {
+      const pls::trace::Event& e = pls::trace::event_get(events_seen);
+      if (e.track == pls::trace::MOTION && e.phase == 'B') {
+        total += motion;
+        motion = 0.0;
+        direction = 0;
+      }
+    }
+    double now = error();
+    if (direction == 0 && std::fabs(now) > 0.5) direction = now > 0 ? 1 : -1;
+    if (direction != 0) motion = std::max(motion, -now * direction);
+  }
+};
+
+OvershootMonitor monitor;
+
+void step_devices_and_monitor(double dt) {
+  pls::sim::devices().step(dt);
+  monitor.step();
+}
+
+// Runs one routine in this process, which is a throwaway copy of the brain
+Run run_once(const Routine& routine, const Candidate& candidate) {
+  apply(candidate);
+  pls::sim::routine_select(routine);
+  pls::sim::step_callback_set(step_devices_and_monitor);
+  pls::sim::Devices& brain = pls::sim::devices();
+  brain.competition.connected = true;
+  brain.competition.autonomous = true;
+
+  Run run = {};
+  std::uint64_t start_us = pls::sim::now_us();
+  run.result = pls::sim::run(autonomous, "autonomous", routine.limit_ms);
+  run.time_s = (pls::sim::now_us() - start_us) / 1e6;
+  run.end = pls::sim::robot_pose();
+  run.overshoot = monitor.total + monitor.motion;
+  for (int i = 0; i < pls::trace::size(); i++) {
+    const pls::trace::Event& e = pls::trace::event_get(i);
+    if (e.track == pls::trace::MOTION && e.phase == 'E' && ((int)e.value == ez::VELOCITY_EXIT || (int)e.value == ez::mA_EXIT))
+      run.stalls++;
+  }
+  run.done = true;
+  return run;
+}
+
+double median(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  size_t half = values.size() / 2;
+  return values.size() % 2 ? values[half] : (values[half - 1] + values[half]) / 2.0;
+}
+
+double angle_error(double a, double b) { return pls::angle::wrap(a - b); }
+
+double cost(const Run& run, const Run& reference) {
+  if (!run.done || run.result != pls::sim::FINISHED) return run.time_s + COST_FAILED;
+  double miss_in = std::hypot(run.end.x - reference.end.x, run.end.y - reference.end.y);
+  double miss_deg = std::fabs(angle_error(run.end.theta, reference.end.theta));
+  return run.time_s + COST_PER_OVERSHOOT * run.overshoot + COST_PER_MISS_INCH * miss_in + COST_PER_MISS_DEGREE * miss_deg +
+         COST_PER_STALL * std::max(0, run.stalls - reference.stalls);
+}
+
+// Runs every candidate on every routine across the worker pool
+std::vector<Run> evaluate(const std::vector<Candidate>& candidates, const std::vector<const Routine*>& routines, int workers) {
+  int total = candidates.size() * routines.size();
+  Run* shared = pls::sim::shared_array<Run>(total);
+  pls::sim::fork_pool(workers, total, [&](int job) {
+    shared[job] = run_once(*routines[job % routines.size()], candidates[job / routines.size()]);
+  });
+  std::vector<Run> runs(shared, shared + total);
+  munmap(shared, sizeof(Run) * total);
+  return runs;
+}
+
+// Eigenvalues and vectors of a symmetric matrix by Jacobi rotations, small
+// matrices only.  Vectors are the columns of vectors.
+void eigen_symmetric(std::vector<double> a, int n, std::vector<double>& values, std::vector<double>& vectors) {
+  vectors.assign(n * n, 0.0);
+  for (int i = 0; i < n; i++) vectors[i * n + i] = 1.0;
+  for (int sweep = 0; sweep < 50; sweep++) {
+    double off = 0.0;
+    for (int p = 0; p < n; p++)
+      for (int q = p + 1; q < n; q++) off += a[p * n + q] * a[p * n + q];
+    if (off < 1e-22) break;
+    for (int p = 0; p < n; p++) {
+      for (int q = p + 1; q < n; q++) {
+        if (std::fabs(a[p * n + q]) < 1e-300) continue;
+        double theta = (a[q * n + q] - a[p * n + p]) / (2.0 * a[p * n + q]);
+        double t = (theta >= 0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+        double c = 1.0 / std::sqrt(t * t + 1.0);
+        double s = t * c;
+        for (int k = 0; k < n; k++) {
+          double kp = a[k * n + p], kq = a[k * n + q];
+          a[k * n + p] = c * kp - s * kq;
+          a[k * n + q] = s * kp + c * kq;
+        }
+        for (int k = 0; k < n; k++) {
+          double pk = a[p * n + k], qk = a[q * n + k];
+          a[p * n + k] = c * pk - s * qk;
+          a[q * n + k] = s * pk + c * qk;
+        }
+        for (int k = 0; k < n; k++) {
+          double kp = vectors[k * n + p], kq = vectors[k * n + q];
+          vectors[k * n + p] = c * kp - s * kq;
+          vectors[k * n + q] = s * kp + c * kq;
+        }
+      }
+    }
+  }
+  values.resize(n);
+  for (int i = 0; i < n; i++) values[i] = std::max(a[i * n + i], 1e-20);
+}
+
+// CMA-ES over the parameters scaled to 0 to 1 between their limits
+class Search {
+ public:
+  static constexpr int N = PARAMETERS;
+
+  Search(int population, std::uint64_t seed) : lambda(population), random{seed} {
+    mu = lambda / 2;
+    weights.resize(mu);
+    for (int i = 0; i < mu; i++) weights[i] = std::log(mu + 0.5) - std::log(i + 1.0);
+    double sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    for (double& w : weights) w /= sum;
+    double squares = 0.0;
+    for (double w : weights) squares += w * w;
+    mueff = 1.0 / squares;
+
+    cc = (4.0 + mueff / N) / (N + 4.0 + 2.0 * mueff / N);
+    cs = (mueff + 2.0) / (N + mueff + 5.0);
+    c1 = 2.0 / ((N + 1.3) * (N + 1.3) + mueff);
+    cmu = std::min(1.0 - c1, 2.0 * (mueff - 2.0 + 1.0 / mueff) / ((N + 2.0) * (N + 2.0) + mueff));
+    damps = 1.0 + 2.0 * std::max(0.0, std::sqrt((mueff - 1.0) / (N + 1.0)) - 1.0) + cs;
+    chi_n = std::sqrt(N) * (1.0 - 1.0 / (4.0 * N) + 1.0 / (21.0 * N * N));
+
+    for (int i = 0; i < N; i++) {
+      const Parameter& p = PARAMETER_TABLE[i];
+      mean[i] = (p.value - p.low) / (p.high - p.low);
+    }
+    c.assign(N * N, 0.0);
+    b.assign(N * N, 0.0);
+    d.assign(N, 1.0);
+    for (int i = 0; i < N; i++) c[i * N + i] = b[i * N + i] = 1.0;
+  }
+
+  // New candidates around the mean, in real units
+  std::vector<Candidate> sample() {
+    samples.assign(lambda, {});
+    std::vector<Candidate> candidates(lambda);
+    for (int k = 0; k < lambda; k++) {
+      double z[N];
+      for (double& zi : z) zi = random.normal();
+      for (int i = 0; i < N; i++) {
+        double y = 0.0;
+        for (int j = 0; j < N; j++) y += b[i * N + j] * d[j] * z[j];
+        samples[k][i] = mean[i] + sigma * y;
+      }
+      candidates[k] = to_units(samples[k]);
+    }
+    return candidates;
+  }
+
+  // Moves toward the best of the last sample
+  void update(const std::vector<double>& costs) {
+    std::vector<int> order(lambda);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return costs[a] < costs[b]; });
+
+    Candidate old = mean;
+    for (int i = 0; i < N; i++) {
+      mean[i] = 0.0;
+      for (int k = 0; k < mu; k++) mean[i] += weights[k] * samples[order[k]][i];
+    }
+    double step[N];
+    for (int i = 0; i < N; i++) step[i] = (mean[i] - old[i]) / sigma;
+
+    // C^-1/2 * step, through the eigenvectors
+    double whitened[N] = {};
+    for (int j = 0; j < N; j++) {
+      double projection = 0.0;
+      for (int i = 0; i < N; i++) projection += b[i * N + j] * step[i];
+      for (int i = 0; i < N; i++) whitened[i] += b[i * N + j] * projection / d[j];
+    }
+    double ps_norm = 0.0;
+    for (int i = 0; i < N; i++) {
+      ps[i] = (1.0 - cs) * ps[i] + std::sqrt(cs * (2.0 - cs) * mueff) * whitened[i];
+      ps_norm += ps[i] * ps[i];
+    }
+    ps_norm = std::sqrt(ps_norm);
+    generation++;
+    bool hsig = ps_norm / std::sqrt(1.0 - std::pow(1.0 - cs, 2.0 * generation)) / chi_n < 1.4 + 2.0 / (N + 1.0);
+    for (int i = 0; i < N; i++) pc[i] = (1.0 - cc) * pc[i] + (hsig ? std::sqrt(cc * (2.0 - cc) * mueff) : 0.0) * step[i];
+
+    for (int i = 0; i < N; i++) {
+      for (int j = 0; j <= i; j++) {
+        double rank_mu = 0.0;
+        for (int k = 0; k < mu; k++) {
+          const Candidate& x = samples[order[k]];
+          rank_mu += weights[k] * (x[i] - old[i]) * (x[j] - old[j]) / (sigma * sigma);
+        }
+        double value = (1.0 - c1 - cmu) * c[i * N + j] + c1 * (pc[i] * pc[j] + (hsig ? 0.0 : cc * (2.0 - cc) * c[i * N + j])) + cmu * rank_mu;
+        c[i * N + j] = c[j * N + i] = value;
+      }
+    }
+    sigma *= std::exp(cs / damps * (ps_norm / chi_n - 1.0));
+
+    eigen_symmetric(c, N, d, b);
+    for (double& di : d) di = std::sqrt(di);
+  }
+
+  double step_size() const { return sigma; }
+
+  // Parameters in real units, clamped to their limits
+  static Candidate to_units(const Candidate& scaled) {
+    Candidate units;
+    for (int i = 0; i < N; i++) {
+      const Parameter& p = PARAMETER_TABLE[i];
+      units[i] = p.low + std::clamp(scaled[i], 0.0, 1.0) * (p.high - p.low);
+    }
+    return units;
+  }
+
+ private:
+  int lambda, mu;
+  std::vector<double> weights;
+  double mueff, cc, cs, c1, cmu, damps, chi_n;
+  double sigma = 0.15;
+  int generation = 0;
+  Candidate mean = {}, ps = {}, pc = {};
+  std::vector<double> c, b, d;  // Covariance, its eigenvectors and the square roots of its eigenvalues
+  std::vector<Candidate> samples;
+  Random random;
+};
+
+void usage() {
+  fprintf(stderr, "usage: tune [-g generations] [-p population] [-j workers] [-s seed] [routine...]\nroutines:");
+  for (const Routine& routine : ROUTINES) fprintf(stderr, " %s", routine.name);
+  fprintf(stderr, "\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int generations = 20;
+  int population = 16;
+  int workers = pls::sim::pool_workers_default();
+  std::uint64_t seed = 1;
+  std::vector<const Routine*> routines;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-g") && i + 1 < argc) {
+      generations = std::max(1, std::atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+      population = std::max(4, std::atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "-j") && i + 1 < argc) {
+      workers = std::max(1, std::atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+      seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (const Routine* routine = pls::sim::routine_find(argv[i])) {
+      routines.push_back(routine);
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (routines.empty())
+    for (const Routine& routine : ROUTINES) routines.push_back(&routine);
+
+  pls::sim::robot_install();
+  if (pls::sim::run(initialize, "initialize", 10000) != pls::sim::FINISHED) {
+    fprintf(stderr, "initialize didn't finish\n");
+    return 1;
+  }
+  chassis.pid_print_toggle(false);
+
+  // The hand tuned constants set where each routine should end
+  Candidate hand_tuned;
+  for (int i = 0; i < PARAMETERS; i++) hand_tuned[i] = PARAMETER_TABLE[i].value;
+  std::vector<Run> reference = evaluate({hand_tuned}, routines, workers);
+  auto total_cost = [&](const Run* runs) {
+    double sum = 0.0;
+    for (size_t r = 0; r < routines.size(); r++) sum += cost(runs[r], reference[r]);
+    return sum;
+  };
+  double hand_tuned_cost = total_cost(reference.data());
+  printf("hand tuned cost %.2f over %zu routines\n", hand_tuned_cost, routines.size());
+
+  Search search(population, seed);
+  Candidate best = hand_tuned;
+  double best_cost = hand_tuned_cost;
+  std::vector<Run> best_runs = reference;
+  int evaluations = 0;
+  auto wall_start = std::chrono::steady_clock::now();
+  for (int g = 1; g <= generations; g++) {
+    auto generation_start = std::chrono::steady_clock::now();
+    std::vector<Candidate> candidates = search.sample();
+    std::vector<Run> runs = evaluate(candidates, routines, workers);
+    std::vector<double> costs(candidates.size());
+    for (size_t k = 0; k < candidates.size(); k++) {
+      costs[k] = total_cost(&runs[k * routines.size()]);
+      if (costs[k] < best_cost) {
+        best_cost = costs[k];
+        best = candidates[k];
+        best_runs.assign(runs.begin() + k * routines.size(), runs.begin() + (k + 1) * routines.size());
+      }
+    }
+    search.update(costs);
+    evaluations += candidates.size();
+    double generation_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - generation_start).count();
+    printf("generation %2d  best %.2f  median %.2f  step %.3f  %.1f evals/s\n", g, best_cost, median(costs), search.step_size(),
+           candidates.size() / generation_s);
+  }
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+  printf("\n%-12s %10s %10s %10s %10s\n", "routine", "hand time", "tuned", "hand over", "tuned");
+  for (size_t r = 0; r < routines.size(); r++)
+    printf("%-12s %9.2fs %9.2fs %10.2f %10.2f\n", routines[r]->name, reference[r].time_s, best_runs[r].time_s, reference[r].overshoot, best_runs[r].overshoot);
+  printf("cost %.2f -> %.2f\n", hand_tuned_cost, best_cost);
+  for (int i = 0; i < PARAMETERS; i++) printf("  %-16s %8.3g -> %.3g\n", PARAMETER_TABLE[i].name, hand_tuned[i], best[i]);
+  printf("%d evaluations of %zu routines in %.1fs on %d workers, %.1f evals/s\n\n", evaluations, routines.size(), wall_s, workers, evaluations / wall_s);
+  default_constants_print(best);
+  return 0;
+}
@@ -44,6 +44,10 @@
 #include "EZ-Template/api.hpp"
 
 // More includes here...
+#include "pls/angle.hpp"
+#include "pls/format.hpp"
+#include "pls/input.hpp"
+#include "pls/profiler.hpp"
 #include "autons.hpp"
 #include "subsystems.hpp"
 
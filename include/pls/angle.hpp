@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace pls {
+/**
+ * EZ's angle helpers as branch-free constexpr functions, in float and double.
+ *
+ * Every function gives exactly what its ez::util namesake in EZ-Template 3.2
+ * gives, besides 0 sometimes coming out as -0 or the other way around.
+ * ./bin/host/bench -a checks them against references written out from those
+ * semantics, and wrap() at the +-180 edges against a table.  Comparisons only pick between values, so the compiler
+ * turns them into selects instead of branches, and the array versions are
+ * loops with nothing in the way of vectorizing.  The turn helpers don't print.
+ */
+namespace angle {
+/**
+ * Converts radians to degrees.
+ */
+template <typename T>
+constexpr T to_deg(T input) {
+  return input * T(180.0 / 3.14159265358979323846);
+}
+
+/**
+ * Converts degrees to radians.
+ */
+template <typename T>
+constexpr T to_rad(T input) {
+  return input * T(3.14159265358979323846 / 180.0);
+}
+
+/**
+ * Returns max above max, min below min, input otherwise.  Checked in that
+ * order like ez::util::clamp, so it still means something with max < min.
+ */
+template <typename T>
+constexpr T clamp(T input, T max, T min) {
+  return input > max ? max : input < min ? min : input;
+}
+
+/**
+ * Clamps input to -|max| to |max|.
+ */
+template <typename T>
+constexpr T clamp(T input, T max) {
+  T limit = max < T(0) ? -max : max;
+  return clamp(input, limit, -limit);
+}
+
+/**
+ * Wraps an angle in degrees to -180 to 180.  180 stays 180 and -180 stays -180.
+ * theta must be finite, and floats are only exact below 1.3e8 degrees, where
+ * whole turns stop fitting in one.
+ *
+ * Takes off whole turns the way fmod does, so the answer is exact: the turn
+ * count can be off by one from rounding theta / 360, but then the difference
+ * is still exact and the last two steps take care of it.
+ */
+template <typename T>
+constexpr T wrap(T theta) {
+  T turns = T(std::int64_t(theta * T(1.0 / 360.0)));
+  T out = theta - turns * T(360);
+  out -= out > T(180) ? T(360) : T(0);
+  out += out < T(-180) ? T(360) : T(0);
+  return out;
+}
+
+/**
+ * The target in the same turn as current, so turning to it is at most 180 degrees.
+ */
+template <typename T>
+constexpr T turn_shortest(T target, T current) {
+  return current + wrap(target - current);
+}
+
+/**
+ * The target the other way around from turn_shortest(), at least 180 degrees away.
+ */
+template <typename T>
+constexpr T turn_longest(T target, T current) {
+  T error = wrap(target - current);
+  return current + (error + (error > T(0) ? T(-360) : T(360)));
+}
+
+/**
+ * wrap() of n angles.  out may be theta.
+ */
+template <typename T>
+inline void wrap(const T* theta, T* out, int n) {
+  for (int i = 0; i < n; i++) out[i] = wrap(theta[i]);
+}
+
+#if defined(__ARM_NEON)
+// NEON has no 64 bit float to int conversion, but floats stop being exact long
+// before their turn counts outgrow 32 bits
+template <>
+inline void wrap(const float* theta, float* out, int n) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t x = vld1q_f32(theta + i);
+    float32x4_t turns = vcvtq_f32_s32(vcvtq_s32_f32(vmulq_n_f32(x, 1.0f / 360.0f)));
+    float32x4_t a = vmlsq_n_f32(x, turns, 360.0f);
+    a = vsubq_f32(a, vbslq_f32(vcgtq_f32(a, vdupq_n_f32(180.0f)), vdupq_n_f32(360.0f), vdupq_n_f32(0.0f)));
+    a = vaddq_f32(a, vbslq_f32(vcltq_f32(a, vdupq_n_f32(-180.0f)), vdupq_n_f32(360.0f), vdupq_n_f32(0.0f)));
+    vst1q_f32(out + i, a);
+  }
+  for (; i < n; i++) out[i] = wrap(theta[i]);
+}
+#endif
+
+/**
+ * turn_shortest() of n targets from the same current heading, like candidate
+ * headings from one pose.  out may be target.
+ */
+template <typename T>
+inline void turn_shortest(const T* target, T current, T* out, int n) {
+  for (int i = 0; i < n; i++) out[i] = turn_shortest(target[i], current);
+}
+
+/**
+ * turn_longest() of n targets from the same current heading.  out may be target.
+ */
+template <typename T>
+inline void turn_longest(const T* target, T current, T* out, int n) {
+  for (int i = 0; i < n; i++) out[i] = turn_longest(target[i], current);
+}
+
+/**
+ * to_deg() and to_rad() of n angles.  out may be input.
+ */
+template <typename T>
+inline void to_deg(const T* input, T* out, int n) {
+  for (int i = 0; i < n; i++) out[i] = to_deg(input[i]);
+}
+
+template <typename T>
+inline void to_rad(const T* input, T* out, int n) {
+  for (int i = 0; i < n; i++) out[i] = to_rad(input[i]);
+}
+}  // namespace angle
+}  // namespace pls
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "api.h"
+
+namespace pls {
+/**
+ * Coalescing output queue for a V5 controller's screen and rumble motor.
+ *
+ * The controller only accepts one update about every 50ms, so writes made faster
+ * than that get dropped.  Writes here only copy into a pending slot and return.
+ * A background task sends one pending update per 50ms, with rumble first and
+ * then the three screen lines in turn.  Writing a line that is still pending
+ * replaces it, so the controller always gets the newest text and never a backlog.
+ */
+class ControllerQueue {
+ public:
+  /**
+   * Number of text lines on the controller screen.
+   */
+  static constexpr int LINES = 3;
+
+  /**
+   * Characters that fit on one line of the controller screen.
+   */
+  static constexpr int LINE_LENGTH = 15;
+
+  /**
+   * Longest rumble pattern the controller supports.
+   */
+  static constexpr int RUMBLE_LENGTH = 8;
+
+  /**
+   * Time between updates sent to the controller, in ms.
+   */
+  static constexpr int UPDATE_TIME = 50;
+
+  /**
+   * Creates the queue and starts its background task.
+   *
+   * \param controller
+   *        controller to send updates to
+   */
+  explicit ControllerQueue(pros::Controller& controller);
+
+  /**
+   * Sets the text of a line, replacing anything pending for that line.
+   *
+   * \param line
+   *        line to print on, 0 to 2
+   * \param text
+   *        text to show, cut to LINE_LENGTH characters
+   */
+  void set_text(int line, const char* text);
+
+  /**
+   * Sets the text of a line with printf formatting, replacing anything pending for that line.
+   *
+   * \param line
+   *        line to print on, 0 to 2
+   * \param fmt
+   *        printf format string
+   */
+  void print(int line, const char* fmt, ...) __attribute__((format(printf, 3, 4)));
+
+  /**
+   * Blanks a line.
+   *
+   * \param line
+   *        line to clear, 0 to 2
+   */
+  void clear_line(int line);
+
+  /**
+   * Blanks every line.
+   */
+  void clear();
+
+  /**
+   * Queues a rumble pattern, replacing any pattern that hasn't been sent yet.
+   *
+   * \param pattern
+   *        '.' for short, '-' for long, ' ' for a pause, cut to RUMBLE_LENGTH characters
+   */
+  void rumble(const char* pattern);
+
+  /**
+   * Returns the number of updates waiting to be sent.
+   */
+  int pending();
+
+  /**
+   * Returns the number of writes that replaced an update before it was sent.
+   */
+  int coalesced();
+
+ private:
+  struct Line {
+    char text[LINE_LENGTH + 1] = "";
+    char shown[LINE_LENGTH + 1] = "";
+    bool dirty = false;
+  };
+
+  void line_store(int line, const char* text);
+  void task();
+
+  pros::Controller& controller;
+  pros::Mutex mutex;
+  Line lines[LINES];
+  char rumble_pattern[RUMBLE_LENGTH + 1] = "";
+  bool rumble_dirty = false;
+  int next_line = 0;
+  int coalesced_count = 0;
+  pros::Task output_task;
+};
+}  // namespace pls
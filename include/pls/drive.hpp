@@ -0,0 +1,240 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "EZ-Template/api.hpp"
+#include "pls/follower.hpp"
+#include "pls/path.hpp"
+#include "pls/replan.hpp"
+#include "pls/spline.hpp"
+#include "pls/stream.hpp"
+#include "pls/trace.hpp"
+#include "pls/transform.hpp"
+
+namespace pls {
+namespace drive_detail {
+// Number shown with a motion in the trace, the target when the argument has one
+template <typename T>
+double trace_value(const T& input) {
+  using U = std::decay_t<T>;
+  if constexpr (std::is_arithmetic_v<U>)
+    return input;
+  else if constexpr (std::is_same_v<U, okapi::QLength>)
+    return input.convert(okapi::inch);
+  else if constexpr (std::is_same_v<U, okapi::QAngle>)
+    return input.convert(okapi::degree);
+  else
+    return 0.0;
+}
+}  // namespace drive_detail
+
+/**
+ * How a profile_follow() went.
+ */
+struct FollowResult {
+  int ticks = 0;
+  double worst_error = 0.0;  // m from where the profile had the robot
+  double mean_error = 0.0;
+  double end_error = 0.0;    // m from the profile's last point when done
+  std::uint32_t worst_tick_us = 0;  // LtvFollower::calculate() and setting the motors
+  double mean_tick_us = 0.0;
+  int replans = 0;  // Splices the Replanner made, if there was one
+  bool timed_out = false;  // Gave up FOLLOW_TIMEOUT_MS past the end
+};
+
+/**
+ * ez::Drive that records every motion and wait into pls::trace.
+ *
+ * Motions are forwarded to ez::Drive unchanged, so autons don't need to change
+ * beyond the type of the chassis.
+ */
+class Drive : public ez::Drive {
+ public:
+  using ez::Drive::Drive;
+
+  /**
+   * Traced ez::Drive::pid_drive_set().
+   */
+  template <typename T, typename... Args>
+  void pid_drive_set(T&& target, Args&&... args) {
+    motion_begin("pid_drive_set", drive_detail::trace_value(target));
+    ez::Drive::pid_drive_set(std::forward<T>(target), std::forward<Args>(args)...);
+  }
+
+  /**
+   * Traced ez::Drive::pid_turn_set().
+   */
+  template <typename T, typename... Args>
+  void pid_turn_set(T&& target, Args&&... args) {
+    motion_begin("pid_turn_set", drive_detail::trace_value(target));
+    ez::Drive::pid_turn_set(std::forward<T>(target), std::forward<Args>(args)...);
+  }
+
+  /**
+   * Traced ez::Drive::pid_turn_relative_set().
+   */
+  template <typename T, typename... Args>
+  void pid_turn_relative_set(T&& target, Args&&... args) {
+    motion_begin("pid_turn_relative_set", drive_detail::trace_value(target));
+    ez::Drive::pid_turn_relative_set(std::forward<T>(target), std::forward<Args>(args)...);
+  }
+
+  /**
+   * Traced ez::Drive::pid_swing_set().
+   */
+  template <typename T, typename... Args>
+  void pid_swing_set(ez::e_swing type, T&& target, Args&&... args) {
+    motion_begin(type == ez::LEFT_SWING ? "pid_swing_set left" : "pid_swing_set right", drive_detail::trace_value(target));
+    ez::Drive::pid_swing_set(type, std::forward<T>(target), std::forward<Args>(args)...);
+  }
+
+  /**
+   * Traced ez::Drive::pid_swing_relative_set().
+   */
+  template <typename T, typename... Args>
+  void pid_swing_relative_set(ez::e_swing type, T&& target, Args&&... args) {
+    motion_begin(type == ez::LEFT_SWING ? "pid_swing_relative_set left" : "pid_swing_relative_set right", drive_detail::trace_value(target));
+    ez::Drive::pid_swing_relative_set(type, std::forward<T>(target), std::forward<Args>(args)...);
+  }
+
+  // Odom motions are often called with braced lists, which templates can't take
+  void pid_odom_set(double target, int speed);
+  void pid_odom_set(double target, int speed, bool slew_on);
+  void pid_odom_set(okapi::QLength p_target, int speed);
+  void pid_odom_set(okapi::QLength p_target, int speed, bool slew_on);
+  void pid_odom_set(ez::odom imovement);
+  void pid_odom_set(ez::odom imovement, bool slew_on);
+  void pid_odom_set(ez::united_odom p_imovement);
+  void pid_odom_set(ez::united_odom p_imovement, bool slew_on);
+  void pid_odom_set(std::vector<ez::odom> imovements);
+  void pid_odom_set(std::vector<ez::odom> imovements, bool slew_on);
+  void pid_odom_set(std::vector<ez::united_odom> p_imovements);
+  void pid_odom_set(std::vector<ez::united_odom> p_imovements, bool slew_on);
+
+  /**
+   * Pure pursuit along a path prepared ahead of time, see pls::PreparedPath.
+   * Until the next motion, pid_wait_until_index() counts the path's waypoints
+   * like it does for a list of points.  The path has to last until the motion
+   * is done.  If the robot isn't at the path's start, the waypoints are
+   * injected and smoothed from where it is, like a list of points.
+   */
+  void pid_odom_set(const PreparedPath& path);
+  void pid_odom_set(const PreparedPath& path, bool slew_on);
+
+  /**
+   * Odom motions through a Transform, so left and right variants of an auton
+   * share one list or prepared path.  A prepared path's points are transformed
+   * into the copy EZ takes, injection and smoothing don't change under a
+   * mirror, rotation or translation.  The start the path was prepared from
+   * is transformed the same way to check the robot is there.
+   */
+  void pid_odom_set(ez::odom imovement, const Transform& transform);
+  void pid_odom_set(ez::odom imovement, const Transform& transform, bool slew_on);
+  void pid_odom_set(std::vector<ez::odom> imovements, const Transform& transform);
+  void pid_odom_set(std::vector<ez::odom> imovements, const Transform& transform, bool slew_on);
+  void pid_odom_set(ez::united_odom p_imovement, const Transform& transform);
+  void pid_odom_set(ez::united_odom p_imovement, const Transform& transform, bool slew_on);
+  void pid_odom_set(std::vector<ez::united_odom> p_imovements, const Transform& transform);
+  void pid_odom_set(std::vector<ez::united_odom> p_imovements, const Transform& transform, bool slew_on);
+  void pid_odom_set(const PreparedPath& path, const Transform& transform);
+  void pid_odom_set(const PreparedPath& path, const Transform& transform, bool slew_on);
+
+  /**
+   * Prepares a path with this chassis's spacing and smoothing constants, so set
+   * those first.
+   */
+  PreparedPath path_prepare(ez::pose start, const std::vector<ez::odom>& waypoints);
+  PreparedPath path_prepare(ez::united_pose start, const std::vector<ez::united_odom>& waypoints);
+
+  /**
+   * Settling time profile_follow() holds the profile's last point for, in ms.
+   */
+  static constexpr std::uint32_t FOLLOW_SETTLE_MS = 250;
+
+  /**
+   * How long past the profile's end profile_follow() gives up, in ms.
+   */
+  static constexpr std::uint32_t FOLLOW_TIMEOUT_MS = 1000;
+
+  /**
+   * Drives a squiggles profile with an LtvFollower every 10ms, blocking until
+   * the profile is over and FOLLOW_SETTLE_MS more have passed.  Profile
+   * coordinates are odom's, through pls::pose_from_odom().  EZ's motions are
+   * disabled while it runs, and the drive is stopped after.  Running
+   * FOLLOW_TIMEOUT_MS past the end stops it and ends the motion with
+   * ez::VELOCITY_EXIT, like EZ's own timeouts.
+   *
+   * With a Replanner, the profile is handed to its profile_set() and each tick
+   * calls update() with the robot's pose and speed before following the
+   * replanner's profile, so a bump gets spliced back onto the path.  A profile
+   * the replanner won't take is followed without it.
+   */
+  FollowResult profile_follow(const Profile& profile, const LtvFollower& follower, Replanner* replanner = nullptr);
+
+  /**
+   * The same for a profile through a Transform, see pls::ProfileView.
+   */
+  FollowResult profile_follow(const ProfileView& profile, const LtvFollower& follower);
+
+  /**
+   * The same for a profile still being read or generated.  Starts once the
+   * stream is ready(), and times out FOLLOW_TIMEOUT_MS past the last point it
+   * got, so a producer that stalls doesn't hold the auton forever.  A source
+   * that runs out without a point, like a missing file, doesn't drive at all.
+   */
+  FollowResult profile_follow(TrajectoryStream& stream, const LtvFollower& follower);
+
+  /**
+   * Traced ez::Drive::pid_wait(), ends the motion with its exit reason.
+   */
+  void pid_wait();
+
+  /**
+   * Traced ez::Drive::pid_wait_quick().
+   */
+  void pid_wait_quick();
+
+  /**
+   * Traced ez::Drive::pid_wait_quick_chain().
+   */
+  void pid_wait_quick_chain();
+
+  /**
+   * Traced ez::Drive::pid_wait_until().  The motion keeps running after this returns.
+   */
+  template <typename T>
+  void pid_wait_until(T target) {
+    trace::span_begin("pid_wait_until", drive_detail::trace_value(target));
+    ez::Drive::pid_wait_until(target);
+    trace::span_end();
+  }
+
+  /**
+   * Traced ez::Drive::pid_wait_until_index().  The motion keeps running after this returns.
+   */
+  void pid_wait_until_index(int index);
+
+  /**
+   * Returns why the last motion exited.
+   *
+   * EZ-Template doesn't hand the exit out of pid_wait, so this looks at the PIDs for
+   * the current mode once the wait is over.
+   */
+  ez::exit_output exit_reason_get();
+
+  /**
+   * The same for a motion in a mode read before the wait, EZ's odom waits
+   * leave the drive disabled.
+   */
+  ez::exit_output exit_reason_get(ez::e_mode mode);
+
+ private:
+  const PreparedPath* prepared = nullptr;  // Path of the current motion, if it was prepared
+
+  void motion_begin(const char* name, double target);
+  double distance_to(ez::pose target);  // Inches from odom
+  bool at_start(const PreparedPath& path, const Transform& transform);
+  void wait_traced(const char* name, void (ez::Drive::*wait)());
+};
+}  // namespace pls
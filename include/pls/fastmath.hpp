@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#ifndef PLS_FAST_MATH
+#define PLS_FAST_MATH 0
+#endif
+
+// The NEON array kernels only build with FAST_MATH on the brain.  bench -a runs
+// on the host, so it checks the scalar loops they replace and not them
+#if defined(__ARM_NEON) && PLS_FAST_MATH
+#define PLS_FAST_NEON 1
+#include <arm_neon.h>
+#else
+#define PLS_FAST_NEON 0
+#endif
+
+namespace pls {
+/**
+ * Float trig for the per-tick math on the brain.
+ *
+ * newlib's double sin, cos and atan2 are slow on the Cortex-A9, and hypot scales
+ * its inputs to avoid overflow that field lengths never get near.  These are
+ * float polynomials with no table lookups and no branches, so a call costs the
+ * same for every input.  Each one states its worst absolute error against double
+ * libm, checked by ./bin/host/bench -a.
+ *
+ * With FAST_MATH:=1 the array versions take 4 at a time with NEON on the brain.
+ * Those use the NEON reciprocal and square root estimates, which the host can't
+ * run, so the bounds below aren't checked for them.  Cross-check them on a
+ * brain before trusting a bound there.
+ */
+namespace fast {
+/**
+ * Worst absolute error of sin, cos and sincos for |x| <= 1000 rad.  Past that
+ * the range reduction loses bits, turn angles don't get near it.
+ */
+constexpr float TRIG_MAX_ERROR = 1.5e-7f;
+
+/**
+ * Worst absolute error of atan2, in radians.  Most of it is rounding the answer
+ * to a float near pi.
+ */
+constexpr float ATAN2_MAX_ERROR = 4e-7f;
+
+/**
+ * Worst error of hypot relative to the answer, about 1 ulp in float.
+ */
+constexpr float HYPOT_MAX_RELATIVE_ERROR = 2e-7f;
+
+namespace fast_detail {
+constexpr float TWO_OVER_PI = 0.636619772f;
+// pi/2 in three parts with few enough bits that k times each is exact, from Cephes
+constexpr float PI_OVER_2_A = 1.5703125f;
+constexpr float PI_OVER_2_B = 4.837512969970703125e-4f;
+constexpr float PI_OVER_2_C = 7.54978995489188216e-8f;
+constexpr float PI = 3.14159265f;
+constexpr float PI_OVER_2 = 1.57079633f;
+constexpr float PI_OVER_4 = 0.785398163f;
+constexpr float TAN_PI_OVER_8 = 0.414213562f;
+
+inline std::uint32_t bits(float x) {
+  std::uint32_t u;
+  std::memcpy(&u, &x, sizeof(u));
+  return u;
+}
+
+inline float from_bits(std::uint32_t u) {
+  float x;
+  std::memcpy(&x, &u, sizeof(x));
+  return x;
+}
+
+// Minimax polynomials on [-pi/4, pi/4], from Cephes sinf and cosf
+inline float sin_poly(float r, float z) { return r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f)); }
+inline float cos_poly(float z) { return 1.0f - 0.5f * z + z * z * (4.166664568e-2f + z * (-1.388731625e-3f + z * 2.443315711e-5f)); }
+
+// atan on [0, 1], halved to [-tan(pi/8), tan(pi/8)] around pi/4, from Cephes atanf
+inline float atan_unit(float t) {
+  bool high = t > TAN_PI_OVER_8;
+  float base = high ? PI_OVER_4 : 0.0f;
+  t = high ? (t - 1.0f) / (t + 1.0f) : t;
+  float z = t * t;
+  return base + t + t * z * (-3.33329491539e-1f + z * (1.99777106478e-1f + z * (-1.38776856032e-1f + z * 8.05374449538e-2f)));
+}
+
+#if PLS_FAST_NEON
+// ARMv7 NEON has no divide or square root, so these take the estimate and refine it twice
+inline float32x4_t reciprocal(float32x4_t x) {
+  float32x4_t r = vrecpeq_f32(x);
+  r = vmulq_f32(r, vrecpsq_f32(x, r));
+  return vmulq_f32(r, vrecpsq_f32(x, r));
+}
+
+inline float32x4_t square_root(float32x4_t x) {
+  float32x4_t r = vrsqrteq_f32(x);
+  r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(x, r), r));
+  r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(x, r), r));
+  uint32x4_t zero = vceqq_f32(x, vdupq_n_f32(0.0f));
+  return vbslq_f32(zero, x, vmulq_f32(x, r));  // 1/sqrt(0) is inf, and 0 * inf isn't 0
+}
+#endif
+}  // namespace fast_detail
+
+/**
+ * sin and cos of x in radians together, sharing the range reduction.
+ */
+inline void sincos(float x, float* s, float* c) {
+  using namespace fast_detail;
+  float kf = (float)(std::int32_t)(x * TWO_OVER_PI + std::copysign(0.5f, x));
+  std::uint32_t q = (std::uint32_t)(std::int32_t)kf;
+  float r = ((x - kf * PI_OVER_2_A) - kf * PI_OVER_2_B) - kf * PI_OVER_2_C;
+  float z = r * r;
+  float sr = sin_poly(r, z);
+  float cr = cos_poly(z);
+
+  // Odd quadrants swap sin and cos, and the quadrant picks the signs
+  bool swap = q & 1;
+  float sv = swap ? cr : sr;
+  float cv = swap ? sr : cr;
+  *s = from_bits(bits(sv) ^ ((q & 2) << 30));
+  *c = from_bits(bits(cv) ^ (((q + 1) & 2) << 30));
+}
+
+inline float sin(float x) {
+  float s, c;
+  sincos(x, &s, &c);
+  return s;
+}
+
+inline float cos(float x) {
+  float s, c;
+  sincos(x, &s, &c);
+  return c;
+}
+
+/**
+ * Angle of (x, y) from the +x axis in radians, -pi to pi.  atan2(0, 0) is 0.
+ */
+inline float atan2(float y, float x) {
+  using namespace fast_detail;
+  float ax = std::fabs(x), ay = std::fabs(y);
+  float big = std::fmax(ax, ay), small = std::fmin(ax, ay);
+  float a = atan_unit(big > 0.0f ? small / big : 0.0f);
+  a = ay > ax ? PI_OVER_2 - a : a;
+  a = x < 0.0f ? PI - a : a;
+  return std::copysign(a, y);
+}
+
+/**
+ * Length of (x, y).  Doesn't guard against overflow, fine below 1e19.
+ */
+inline float hypot(float x, float y) { return std::sqrt(x * x + y * y); }
+
+/**
+ * sin and cos of n angles, s and c may not overlap x.
+ */
+void sincos(const float* x, float* s, float* c, int n);
+
+/**
+ * atan2 of n points.
+ */
+void atan2(const float* y, const float* x, float* out, int n);
+
+/**
+ * hypot of n points.
+ */
+void hypot(const float* x, const float* y, float* out, int n);
+}  // namespace fast
+
+/**
+ * Trig the pls code calls.  FAST_MATH:=1 in the Makefile uses pls::fast, 0 uses
+ * libm, so a change in behavior can be checked against the precise version.
+ */
+namespace math {
+#if PLS_FAST_MATH
+inline double sin(double x) { return fast::sin((float)x); }
+inline double cos(double x) { return fast::cos((float)x); }
+inline void sincos(double x, double* s, double* c) {
+  float sf, cf;
+  fast::sincos((float)x, &sf, &cf);
+  *s = sf;
+  *c = cf;
+}
+inline double atan2(double y, double x) { return fast::atan2((float)y, (float)x); }
+inline double hypot(double x, double y) { return fast::hypot((float)x, (float)y); }
+#else
+inline double sin(double x) { return std::sin(x); }
+inline double cos(double x) { return std::cos(x); }
+inline void sincos(double x, double* s, double* c) {
+  *s = std::sin(x);
+  *c = std::cos(x);
+}
+inline double atan2(double y, double x) { return std::atan2(y, x); }
+inline double hypot(double x, double y) { return std::hypot(x, y); }
+#endif
+}  // namespace math
+}  // namespace pls
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "EZ-Template/api.hpp"
+#include "okapi/squiggles/squiggles.hpp"
+#include "pls/motormodel.hpp"
+
+namespace pls {
+/**
+ * An odom pose in squiggles' frame: inches to meters, and degrees clockwise
+ * from +y to radians counterclockwise from +x.  A profile starting at
+ * (0, 0, pi/2) starts where odom_xyt_set(0, 0, 0) puts the robot.
+ */
+squiggles::Pose pose_from_odom(ez::pose pose);
+
+/**
+ * How hard LtvFollower works on each error, by Bryson's rule: the error or
+ * correction that should cost the same as the others.
+ */
+struct LtvSettings {
+  double x_tolerance = 0.0625;     // m along the robot
+  double y_tolerance = 0.125;      // m across it
+  double heading_tolerance = 0.25; // rad
+  double vel_tolerance = 1.0;      // m/s of correction
+  double turn_tolerance = 2.0;     // rad/s of correction
+  double max_vel = 2.0;            // m/s, the table covers 0 to this
+  double wheel_kp = 20.0;          // V per m/s a side turns slower than asked
+};
+
+/**
+ * What LtvFollower asks of the drive for one tick.
+ */
+struct LtvOutput {
+  double vel;      // m/s
+  double turn;     // rad/s, counterclockwise
+  double left;     // m/s at the wheels
+  double right;
+  double left_volts;
+  double right_volts;
+};
+
+/**
+ * Time parameterized trajectory follower, a linear time varying unicycle
+ * controller fed forward from squiggles profile points.
+ *
+ * EZ's odom modes steer at a point with the odom angular PID and drive at it
+ * with the xy PID, so speed along a path comes from PID tuning and
+ * odom_turn_bias_set().  A profile already says how fast to go and how hard to
+ * turn at every moment, so this drives the profile's velocity and curvature
+ * and only corrects the error from where the profile has the robot.
+ *
+ * The correction is an LQR gain for the unicycle linearized at the profile's
+ * speed.  Solving the Riccati equation takes doubling steps, so it's done at
+ * construction for BINS speeds from 0 to max_vel.  A tick rotates the error
+ * into the robot's frame, blends the gains of the two bins around the speed
+ * and multiplies, a few dozen flops.  Driving backwards flips the sign of the
+ * gains on the sideways error.  Wheel speeds become volts through
+ * MotorModel::side_voltage(), with each side pushing half the mass at the
+ * profile's acceleration, plus wheel_kp on how far each side is off its speed
+ * for the scrub and spin the model leaves out.
+ */
+class LtvFollower {
+ public:
+  static constexpr int BINS = 32;
+
+  /**
+   * \param drive
+   *        the drivetrain, for track width and the motors' volts
+   * \param dt
+   *        seconds between calls to calculate()
+   */
+  explicit LtvFollower(DrivetrainDescription drive, double dt = 0.01, LtvSettings settings = {});
+
+  /**
+   * What to drive for a pose, in squiggles' frame, and where the profile has
+   * the robot now.
+   *
+   * \param left_rpm
+   *        drive_velocity_left(), the left cartridge's rpm
+   * \param right_rpm
+   *        drive_velocity_right()
+   */
+  LtvOutput calculate(squiggles::Pose pose, const squiggles::ProfilePoint& target, double left_rpm, double right_rpm) const;
+
+  /**
+   * Forward speed in m/s from the same rpms.
+   */
+  double speed(double left_rpm, double right_rpm) const { return (motors.wheel_speed(left_rpm) + motors.wheel_speed(right_rpm)) / 2.0; }
+
+  /**
+   * Gains at a bin, velocity then turn rows against along, across and heading errors.
+   */
+  const std::array<double, 6>& gains(int bin) const { return table[bin]; }
+  double bin_vel(int bin) const { return settings.max_vel * bin / (BINS - 1); }
+
+ private:
+  DrivetrainDescription drive;
+  MotorModel motors;
+  LtvSettings settings;
+  std::array<std::array<double, 6>, BINS> table;
+};
+}  // namespace pls
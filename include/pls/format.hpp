@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace pls {
+
+/**
+ * Largest number of decimal places handled by the fast path.  Anything beyond
+ * this falls back to snprintf.
+ */
+constexpr int FORMAT_MAX_PLACES = 9;
+
+/**
+ * Largest magnitude handled by the fast path.  Anything beyond this falls back
+ * to snprintf.
+ */
+constexpr double FORMAT_MAX_MAGNITUDE = 1e9;
+
+namespace format_detail {
+constexpr std::uint32_t POW10[FORMAT_MAX_PLACES + 1] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+// 128 bit unsigned integer built from two halves, the V5 toolchain has no __int128
+struct u128 {
+  std::uint64_t hi;
+  std::uint64_t lo;
+};
+
+inline u128 mul_64x32(std::uint64_t a, std::uint32_t b) {
+  std::uint64_t a_lo = a & 0xffffffffu;
+  std::uint64_t a_hi = a >> 32;
+  std::uint64_t lo = a_lo * b;
+  std::uint64_t mid = a_hi * b + (lo >> 32);
+  return {mid >> 32, (mid << 32) | (lo & 0xffffffffu)};
+}
+
+inline bool bit_at(u128 n, int k) {
+  if (k >= 128) return false;
+  return k >= 64 ? (n.hi >> (k - 64)) & 1u : (n.lo >> k) & 1u;
+}
+
+inline bool any_below(u128 n, int k) {
+  if (k <= 0) return false;
+  if (k >= 128) return n.hi || n.lo;
+  if (k > 64) return n.lo || (n.hi & ((std::uint64_t(1) << (k - 64)) - 1));
+  if (k == 64) return n.lo;
+  return n.lo & ((std::uint64_t(1) << k) - 1);
+}
+
+inline std::uint64_t shift_right(u128 n, int s) {
+  if (s >= 128) return 0;
+  if (s >= 64) return n.hi >> (s - 64);
+  if (s == 0) return n.lo;
+  return (n.lo >> s) | (n.hi << (64 - s));
+}
+
+inline int write_digits(char* out, std::uint64_t value, int min_digits) {
+  char tmp[20];
+  int n = 0;
+  while (value > 0 || n < min_digits) {
+    tmp[n++] = char('0' + value % 10);
+    value /= 10;
+  }
+  for (int i = 0; i < n; i++) out[i] = tmp[n - 1 - i];
+  return n;
+}
+}  // namespace format_detail
+
+/**
+ * Writes input with a fixed number of decimal places into buf, without allocating.
+ *
+ * Output matches printf("%.*f", places, input) exactly, including round half to even
+ * on exact ties and "-0.00" for small negative numbers.  Works like snprintf: the
+ * output is always null terminated and the return is the length the full text needs.
+ *
+ * \param buf
+ *        output buffer
+ * \param size
+ *        size of the output buffer in bytes
+ * \param input
+ *        your input value
+ * \param places
+ *        the amount of decimals you want to display, defaults to 2
+ */
+inline int format_fixed(char* buf, std::size_t size, double input, int places = 2) {
+  using namespace format_detail;
+  if (places < 0) places = 0;
+  if (places > FORMAT_MAX_PLACES || !std::isfinite(input) || std::fabs(input) >= FORMAT_MAX_MAGNITUDE)
+    return std::snprintf(buf, size, "%.*f", places, input);
+
+  // input = mantissa * 2^exponent exactly
+  int exponent = 0;
+  double fraction = std::frexp(std::fabs(input), &exponent);
+  std::uint64_t mantissa = (std::uint64_t)std::ldexp(fraction, 53);
+  int shift = 53 - exponent;  // Always > 0 because |input| < 2^30
+
+  // Scale by 10^places, then divide by 2^shift with round half to even
+  u128 scaled = mul_64x32(mantissa, POW10[places]);
+  std::uint64_t q = shift_right(scaled, shift);
+  if (bit_at(scaled, shift - 1) && (any_below(scaled, shift - 1) || (q & 1u)))
+    q++;
+
+  char out[32];
+  int n = 0;
+  if (std::signbit(input)) out[n++] = '-';
+  n += write_digits(out + n, q / POW10[places], 1);
+  if (places > 0) {
+    out[n++] = '.';
+    n += write_digits(out + n, q % POW10[places], places);
+  }
+
+  if (size > 0) {
+    std::size_t copy = (std::size_t)n < size ? n : size - 1;
+    std::memcpy(buf, out, copy);
+    buf[copy] = '\0';
+  }
+  return n;
+}
+
+/**
+ * Writes input with a fixed number of decimal places into buf, without allocating.
+ *
+ * \param buf
+ *        output buffer
+ * \param input
+ *        your input value
+ * \param places
+ *        the amount of decimals you want to display, defaults to 2
+ */
+template <std::size_t N>
+inline int format_fixed(char (&buf)[N], double input, int places = 2) {
+  return format_fixed(buf, N, input, places);
+}
+
+/**
+ * Returns the amount of places after a decimal, maxing out at 6.
+ *
+ * \param input
+ *        your input value with decimals
+ * \param min
+ *        minimum number of decimal places to print, this is defaulted to 0
+ */
+inline int places_after_decimal(double input, int min = 0) {
+  char buf[32];
+  int n = format_fixed(buf, sizeof(buf), input, 6);
+  if (n >= (int)sizeof(buf)) return min > 6 ? min : 6;
+  int places = 6;
+  while (places > 0 && buf[n - 1] == '0') {
+    n--;
+    places--;
+  }
+  return places < min ? min : places;
+}
+
+/**
+ * Builds a line of text in a fixed size buffer, for screen and terminal prints
+ * that run every loop.  Text past the end of the buffer is dropped.
+ */
+template <std::size_t N>
+class TextBuffer {
+ public:
+  TextBuffer() { clear(); }
+
+  /**
+   * Empties the buffer.
+   */
+  void clear() {
+    len = 0;
+    buf[0] = '\0';
+  }
+
+  /**
+   * Appends a string.
+   *
+   * \param input
+   *        null terminated string to append
+   */
+  TextBuffer& text(const char* input) {
+    while (*input && len < N - 1) buf[len++] = *input++;
+    buf[len] = '\0';
+    return *this;
+  }
+
+  /**
+   * Appends a number with a fixed amount of decimals.
+   *
+   * \param input
+   *        your input value
+   * \param places
+   *        the amount of decimals you want to display, defaults to 2
+   */
+  TextBuffer& fixed(double input, int places = 2) {
+    int n = format_fixed(buf + len, N - len, input, places);
+    len = len + n < N - 1 ? len + n : N - 1;
+    return *this;
+  }
+
+  /**
+   * Returns the null terminated text.
+   */
+  const char* c_str() const { return buf; }
+
+  /**
+   * Returns the length of the text.
+   */
+  std::size_t size() const { return len; }
+
+ private:
+  char buf[N];
+  std::size_t len = 0;
+};
+
+}  // namespace pls
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+
+#include "api.h"
+
+namespace pls {
+namespace input {
+/**
+ * Controller snapshots the recording holds, 2.5 minutes of opcontrol ticks.
+ * Ticks after it fills aren't recorded.
+ */
+constexpr int MAX_SAMPLES = 15000;
+
+/**
+ * Buttons in a snapshot, L1 to A in pros::controller_digital_e_t order.
+ */
+constexpr int BUTTONS = 12;
+
+/**
+ * What the driver was doing on one opcontrol tick.
+ */
+struct Sample {
+  std::uint32_t time_ms;    // Since start()
+  std::int8_t analog[4];    // pros::controller_analog_e_t order, -127 to 127
+  std::uint16_t buttons;    // Bit i is pros::E_CONTROLLER_DIGITAL_L1 + i
+};
+
+/**
+ * Clears the recording and starts recording.
+ *
+ * \param name
+ *        name of the run, copied into the recording
+ */
+void start(const char* name);
+
+/**
+ * Stops recording.
+ */
+void stop();
+
+/**
+ * Returns true while recording.
+ */
+bool recording();
+
+/**
+ * Returns the number of samples recorded.
+ */
+int size();
+
+/**
+ * Returns a recorded sample.
+ *
+ * \param index
+ *        0 to size() - 1
+ */
+const Sample& sample_get(int index);
+
+/**
+ * Reads the controller and adds a sample.  Call once per opcontrol tick,
+ * before anything reads the controller.
+ *
+ * \param controller
+ *        controller the driver is using
+ */
+void record(pros::Controller& controller);
+
+/**
+ * Writes the recording as text lines that host/tools/replay feeds back into
+ * opcontrol() on the simulated robot.
+ *
+ * \param file_path
+ *        file to write, like "/usd/input.txt", or nullptr to print to the terminal
+ */
+void dump(const char* file_path = nullptr);
+}  // namespace input
+}  // namespace pls
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "api.h"
+
+namespace pls {
+namespace log_detail {
+// Copies arguments into a record and formats them back out on the writer task
+template <class... Args>
+struct Pack {
+  static constexpr std::size_t SIZE = (sizeof(Args) + ... + 0);
+
+  static void store(unsigned char* out, Args... args) {
+    std::size_t offset = 0;
+    ((std::memcpy(out + offset, &args, sizeof(Args)), offset += sizeof(Args)), ...);
+  }
+
+  template <std::size_t I>
+  static constexpr std::size_t offset() {
+    constexpr std::size_t sizes[] = {sizeof(Args)..., 0};
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < I; i++) total += sizes[i];
+    return total;
+  }
+
+  template <class T>
+  static T load(const unsigned char* in, std::size_t offset) {
+    T value;
+    std::memcpy(&value, in + offset, sizeof(T));
+    return value;
+  }
+
+  template <std::size_t... I>
+  static int format_impl(char* buf, std::size_t size, const char* fmt, const unsigned char* in, std::index_sequence<I...>) {
+    if constexpr (sizeof...(Args) == 0)
+      return snprintf(buf, size, "%s", fmt);
+    else
+      return snprintf(buf, size, fmt, load<Args>(in, offset<I>())...);
+  }
+
+  static int format(char* buf, std::size_t size, const char* fmt, const unsigned char* in) {
+    return format_impl(buf, size, fmt, in, std::index_sequence_for<Args...>{});
+  }
+};
+}  // namespace log_detail
+
+/**
+ * Asynchronous logger for code that can't wait on serial or SD card writes.
+ *
+ * log() only copies the format string pointer and the raw arguments into a
+ * lock-free single producer, single consumer ring.  A low priority task turns
+ * records into text and writes them to the terminal or a file on the SD card.
+ * When the ring is full the record is dropped and counted, log() never blocks.
+ *
+ * Any task may log.  Pushes take turns by claiming the ring for the pushing
+ * task, and a task that finds another in the middle of a push drops its
+ * record and counts it in contended() instead of waiting or corrupting the
+ * ring.  A task deleted mid-push, like autonomous when the period ends, never
+ * gives the ring back, so the next push that finds it deleted takes over.
+ * Format strings and any const char* arguments must outlive the record,
+ * string literals are fine.
+ */
+class Logger {
+ public:
+  /**
+   * Records the ring holds, must be a power of two.
+   */
+  static constexpr std::uint32_t CAPACITY = 256;
+
+  /**
+   * Bytes of arguments one record holds.
+   */
+  static constexpr std::size_t PAYLOAD = 24;
+
+  /**
+   * Creates the logger and starts its writer task.
+   *
+   * \param file_path
+   *        file to append to, like "/usd/log.txt", or nullptr to print to the terminal
+   * \param name
+   *        short prefix printed on every line
+   */
+  Logger(const char* file_path = nullptr, const char* name = "log");
+
+  /**
+   * Queues a printf style message.
+   *
+   * Returns false if the ring was full and the message was dropped.
+   *
+   * \param fmt
+   *        printf format string, must outlive the message
+   * \param args
+   *        arithmetic, enum or pointer arguments
+   */
+  template <class... Args>
+  bool log(const char* fmt, Args... args) {
+    return push(&log_detail::Pack<Args...>::format, fmt, args...);
+  }
+
+  /**
+   * Returns the number of messages dropped because the ring was full.
+   */
+  std::uint32_t dropped();
+
+  /**
+   * Returns how many of the dropped messages were logged while another task was logging.
+   */
+  std::uint32_t contended();
+
+  /**
+   * Returns the number of messages written out.
+   */
+  std::uint32_t written();
+
+  /**
+   * Returns the number of messages waiting to be written.
+   */
+  std::uint32_t pending();
+
+  /**
+   * Measures how long log() takes on the calling task, in nanoseconds.
+   *
+   * Timing records go through the ring but are never written out.  Call this
+   * before logging starts, like in initialize(), so it can't crowd out real messages.
+   *
+   * \param samples
+   *        number of messages to time, defaults to 1024
+   */
+  double push_cost_ns(int samples = 1024);
+
+  /**
+   * Queues a line with the written, dropped and contended counts.
+   */
+  void stats_print();
+
+ private:
+  using format_fn = int (*)(char*, std::size_t, const char*, const unsigned char*);
+
+  struct Record {
+    std::uint32_t time;
+    const char* fmt;
+    format_fn format;
+    alignas(8) unsigned char payload[PAYLOAD];
+  };
+
+  // A null format function marks a record the writer skips, used when timing pushes
+  template <class... Args>
+  bool push(format_fn format, const char* fmt, Args... args) {
+    using P = log_detail::Pack<Args...>;
+    static_assert(P::SIZE <= PAYLOAD, "Too many bytes of arguments for one log record");
+    static_assert(((std::is_arithmetic_v<Args> || std::is_enum_v<Args> || std::is_pointer_v<Args>) && ...),
+                  "Log arguments must be numbers, enums or pointers");
+
+    // The ring has one producer at a time, whichever task claimed it
+    if (!claim()) {
+      contended_count.fetch_add(1, std::memory_order_relaxed);
+      dropped_count.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    std::uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= CAPACITY) {
+      pusher.store(nullptr, std::memory_order_release);
+      dropped_count.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    Record& r = ring[h & (CAPACITY - 1)];
+    r.time = pros::millis();
+    r.fmt = fmt;
+    r.format = format;
+    P::store(r.payload, args...);
+    head.store(h + 1, std::memory_order_release);
+    pusher.store(nullptr, std::memory_order_release);
+    return true;
+  }
+
+  bool claim();
+  void task();
+
+  Record ring[CAPACITY];
+  std::atomic<std::uint32_t> head{0};
+  std::atomic<std::uint32_t> tail{0};
+  std::atomic<pros::task_t> pusher{nullptr};  // Task in the middle of a push
+  std::atomic<std::uint32_t> dropped_count{0};
+  std::atomic<std::uint32_t> contended_count{0};
+  std::atomic<std::uint32_t> written_count{0};
+  const char* file_path;
+  const char* name;
+  pros::Task writer_task;
+};
+}  // namespace pls
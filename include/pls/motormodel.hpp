@@ -0,0 +1,98 @@
+#pragma once
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "okapi/squiggles/squiggles.hpp"
+
+namespace pls {
+/**
+ * A tank drive for MotorModel, in squiggles' units of meters, kilograms and seconds.
+ * The defaults are this robot's, matching host/sim/robot.hpp.
+ */
+struct DrivetrainDescription {
+  double track_width = 0.292;      // m, wheel center to wheel center
+  double wheel_diameter = 0.0826;  // m, 3.25" wheels
+  double cartridge_rpm = 600.0;
+  double wheel_rpm = 450.0;        // Geared down from the cartridge
+  int motors_per_side = 3;
+  double mass = 6.8;               // kg
+
+  // 11W motors, at the cartridge's output shaft
+  double voltage = 12.0;          // V the plan may use, less than 12 leaves room for feedback
+  double stall_current = 3.67;    // A at 12V without the limit
+  double current_limit = 2.5;     // A, pros::Motor::set_current_limit
+  double stall_torque = 0.35;     // Nm at 2.5A on a 600rpm cartridge, 2.1Nm on a 100rpm one
+  double motor_friction = 0.01;   // Nm per motor
+
+  double tire_friction = 1.0;     // Most the tires push, as a fraction of the robot's weight
+};
+
+/**
+ * squiggles::PhysicalModel for a tank drive limited by its motors and tires
+ * instead of by fixed speeds and accelerations.
+ *
+ * TankModel only knows a top speed and a top acceleration.  The V5 motor's
+ * torque falls off with speed as back EMF eats the voltage and is capped by the
+ * current limit near stall, so a fixed acceleration is either too slow off the
+ * line or more than the motors have at speed.  This works out, at each point's
+ * speed and curvature:
+ *
+ *   top speed     where each side's motors only have enough voltage left to
+ *                 beat their own friction, and where the tires can still
+ *                 hold the turn
+ *   acceleration  what each side's motors push at that speed, inside the
+ *                 friction circle: forward and sideways acceleration together
+ *                 are at most tire_friction g
+ *
+ * Each side pushes half the mass along its own arc, which leaves out the
+ * robot's turning inertia.  Every call is a handful of arithmetic, so
+ * SplineGenerator's forward and backward passes stay linear in path length.
+ * The linear constraints given still cap everything, including jerk and
+ * curvature.
+ */
+class MotorModel : public squiggles::PhysicalModel {
+ public:
+  MotorModel(DrivetrainDescription idrive, squiggles::Constraints ilinear_constraints);
+
+  squiggles::Constraints constraints(const squiggles::Pose pose, double curvature, double vel) override;
+
+  /**
+   * Left then right wheel speed in m/s, positive curvature turns left, like TankModel.
+   */
+  std::vector<double> linear_to_wheel_vels(double lin_vel, double curvature) override;
+
+  std::string to_string() const override;
+
+  /**
+   * Force one side's motors push at a wheel speed in m/s, most forward and most
+   * backward, in N.
+   */
+  std::tuple<double, double> side_force(double wheel_vel) const;
+
+  /**
+   * Fastest a side's wheels turn at the voltage, in m/s.
+   */
+  double side_top_speed() const;
+
+  /**
+   * Volts one side's motors need to push a force in N at a wheel speed in m/s,
+   * side_force() run backwards without the current limit.
+   */
+  double side_voltage(double wheel_vel, double force) const;
+
+  /**
+   * Wheel speed in m/s for a cartridge speed in rpm, like drive_velocity_left().
+   */
+  double wheel_speed(double rpm) const { return rpm / rpm_per_mps; }
+
+ private:
+  DrivetrainDescription drive;
+  squiggles::Constraints linear_constraints;
+  double rpm_per_mps;   // Cartridge rpm per m/s at the wheel
+  double newtons_per_nm;  // Force at the tread per Nm at the cartridge
+  double nm_per_amp;
+  double ohms;
+};
+}  // namespace pls
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "EZ-Template/api.hpp"
+
+namespace pls {
+/**
+ * An odom path with EZ's point injection and smoothing done ahead of time.
+ *
+ * pid_odom_set() with a list of points converts units, injects points every
+ * spacing and smooths them on every call, starting from wherever the robot is.
+ * A path that runs the same way every match can do that once in initialize()
+ * from where the robot will be when it starts, then pls::Drive::pid_odom_set()
+ * hands the finished points to EZ's pure pursuit.  Nothing on our side
+ * allocates per call, EZ still copies the points since it takes them by value.
+ *
+ * If the robot isn't within START_TOLERANCE of the start when the motion
+ * begins, pls::Drive injects and smooths the waypoints from where it is
+ * instead, like pid_odom_set() with a list of points.
+ *
+ * EZ's inject_points() and smooth_path() are private to the V5 library, so
+ * these are written from EZ 3.2's headers and docs, the same as host/ez, and
+ * haven't been checked against EZ's own source.  bench -a driving both ways
+ * only shows this agrees with host/ez.  Until it also agrees in a build with
+ * EZ_SRC pointing at EZ-Template 3.2, robot code passes points to
+ * pid_odom_set() instead.
+ */
+class PreparedPath {
+ public:
+  /**
+   * How far the robot can be from start() and still use the prepared points, in inches.
+   */
+  static constexpr double START_TOLERANCE = 0.5;
+
+  PreparedPath() = default;
+
+  /**
+   * Prepares a path.
+   *
+   * \param start
+   *        where the robot will be when the path starts, in the same frame as the waypoints
+   * \param waypoints
+   *        points like pid_odom_set() takes
+   * \param spacing
+   *        inches between injected points, odom_path_spacing_get().  Not more
+   *        than 0 prints an error and leaves the path empty
+   * \param weight_smooth, weight_data, tolerance
+   *        smoothing, odom_path_smooth_constants_get()
+   */
+  explicit PreparedPath(ez::pose start, const std::vector<ez::odom>& waypoints, double spacing, double weight_smooth, double weight_data, double tolerance);
+  explicit PreparedPath(ez::united_pose start, const std::vector<ez::united_odom>& waypoints, double spacing, double weight_smooth, double weight_data,
+               double tolerance);
+
+  /**
+   * Points to drive after the start pose, which the robot's pose takes the place of.
+   */
+  const std::vector<ez::odom>& points() const { return path; }
+
+  /**
+   * Where the path was prepared to start, in inches.
+   */
+  ez::pose start() const { return origin; }
+
+  /**
+   * The waypoints the path was prepared from, in inches.
+   */
+  const std::vector<ez::odom>& waypoints() const { return given; }
+
+  /**
+   * Index in points() of a waypoint.
+   */
+  int index(int waypoint) const { return waypoint_index[waypoint]; }
+
+  bool empty() const { return given.empty(); }
+
+  /**
+   * Number of points to drive.
+   */
+  int size() const { return path.size(); }
+
+  /**
+   * Time preparing took on the brain, in microseconds.
+   */
+  std::uint32_t prepare_us() const { return took_us; }
+
+  /**
+   * Memory the path holds onto, in bytes.
+   */
+  std::size_t bytes() const;
+
+  /**
+   * Prints the waypoints, points, preparation time and memory to the terminal.
+   */
+  void print(const char* name) const;
+
+ private:
+  ez::pose origin = {0.0, 0.0, ez::ANGLE_NOT_SET};
+  std::vector<ez::odom> given;
+  std::vector<ez::odom> path;
+  std::vector<int> waypoint_index;
+  std::uint32_t took_us = 0;
+};
+}  // namespace pls
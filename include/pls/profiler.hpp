@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "api.h"
+
+/**
+ * Set to 1 to compile in loop timing, make PROFILE=1 does.  When 0, every
+ * PLS_PROFILE_SCOPE and the profiler page compile to nothing.
+ */
+#ifndef PLS_PROFILE
+#define PLS_PROFILE 0
+#endif
+
+namespace pls {
+namespace prof {
+/**
+ * Number of histogram buckets.  Bucket 0 holds times under 1us, bucket n holds
+ * times from 2^(n-1) to 2^n us, and the last bucket holds everything longer.
+ */
+constexpr int BUCKETS = 16;
+
+/**
+ * Latency histogram for one named section of code.
+ *
+ * Declare these as static objects, they add themselves to a global list the
+ * first time they're constructed.  Recording only does relaxed atomic adds, so
+ * the screen task can read while a control task writes.
+ */
+class Section {
+ public:
+  /**
+   * Creates a section and adds it to the profiler.
+   *
+   * \param name
+   *        name shown on the profiler page, must outlive the section
+   * \param listed
+   *        false keeps the section off the profiler page, defaults to true
+   */
+  explicit Section(const char* name, bool listed = true);
+
+  /**
+   * Adds one timing.
+   *
+   * \param us
+   *        time taken in microseconds
+   */
+  void record(std::uint32_t us) {
+    int bucket = us == 0 ? 0 : 32 - __builtin_clz(us);
+    if (bucket >= BUCKETS) bucket = BUCKETS - 1;
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total_us.fetch_add(us, std::memory_order_relaxed);
+    std::uint32_t old_max = max_us.load(std::memory_order_relaxed);
+    while (us > old_max && !max_us.compare_exchange_weak(old_max, us, std::memory_order_relaxed)) {
+    }
+  }
+
+  /**
+   * Returns the upper edge of the bucket holding the given percentile, in us.
+   *
+   * \param percentile
+   *        0 to 100
+   */
+  std::uint32_t percentile_get(double percentile) const;
+
+  /**
+   * Returns the average time in us.
+   */
+  double average_get() const;
+
+  /**
+   * Clears all timings.
+   */
+  void reset();
+
+  const char* name;
+  std::atomic<std::uint32_t> buckets[BUCKETS] = {};
+  std::atomic<std::uint32_t> count{0};
+  std::atomic<std::uint32_t> total_us{0};
+  std::atomic<std::uint32_t> max_us{0};
+  Section* next = nullptr;
+};
+
+/**
+ * Times a scope with pros::micros() and records it into a section.
+ */
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Section& section) : section(section), start(pros::micros()) {}
+  ~ScopedTimer() { stop(); }
+
+  /**
+   * Records the time so far and stops timing, the destructor then does nothing.
+   */
+  void stop() {
+    if (running) section.record((std::uint32_t)(pros::micros() - start));
+    running = false;
+  }
+
+ private:
+  Section& section;
+  std::uint64_t start;
+  bool running = true;
+};
+
+/**
+ * Returns the first section in the profiler, follow next for the rest.
+ */
+Section* sections_get();
+
+/**
+ * Prints every section's count, average, p50, p99 and max to the terminal,
+ * under what timing a section costs.
+ */
+void print();
+
+/**
+ * Prints sections to the brain screen, one per line, with what timing a
+ * section costs on the header line.
+ *
+ * \param line
+ *        starting line to print on
+ */
+void screen_print(int line);
+
+/**
+ * Clears every section.
+ */
+void reset();
+
+/**
+ * Measures the cost of one PLS_PROFILE_SCOPE, in nanoseconds.
+ *
+ * \param samples
+ *        number of scopes to time, defaults to 10000
+ */
+double overhead_ns(int samples = 10000);
+}  // namespace prof
+}  // namespace pls
+
+#define PLS_PROFILE_CONCAT_(a, b) a##b
+#define PLS_PROFILE_CONCAT(a, b) PLS_PROFILE_CONCAT_(a, b)
+
+#if PLS_PROFILE
+/**
+ * Times the rest of the enclosing scope under the given section name.
+ */
+#define PLS_PROFILE_SCOPE(name)                                                         \
+  static pls::prof::Section PLS_PROFILE_CONCAT(pls_profile_section_, __LINE__)(name); \
+  pls::prof::ScopedTimer PLS_PROFILE_CONCAT(pls_profile_timer_, __LINE__)(PLS_PROFILE_CONCAT(pls_profile_section_, __LINE__))
+
+/**
+ * Starts timing under the given section name until PLS_PROFILE_END(id) or the end of the scope.
+ * Use this for loop bodies that end in a delay that shouldn't be counted.
+ */
+#define PLS_PROFILE_BEGIN(id, name)                        \
+  static pls::prof::Section pls_profile_section_##id(name); \
+  pls::prof::ScopedTimer pls_profile_timer_##id(pls_profile_section_##id)
+
+/**
+ * Stops timing a section started with PLS_PROFILE_BEGIN(id, name).
+ */
+#define PLS_PROFILE_END(id) pls_profile_timer_##id.stop()
+#else
+#define PLS_PROFILE_SCOPE(name) \
+  do {                          \
+  } while (0)
+#define PLS_PROFILE_BEGIN(id, name) \
+  do {                              \
+  } while (0)
+#define PLS_PROFILE_END(id) \
+  do {                      \
+  } while (0)
+#endif
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "okapi/squiggles/squiggles.hpp"
+
+namespace pls {
+/**
+ * Points along a spline from Spline::evaluate(), one array per quantity.
+ * Derivatives are per unit of the spline's parameter.
+ */
+template <typename T>
+struct SplineSamples {
+  std::vector<T> x, y;
+  std::vector<T> dx, dy;
+  std::vector<T> ddx, ddy;
+  std::vector<T> dddx, dddy;
+  std::vector<T> speed;
+  std::vector<T> curvature;  // 1/m, positive turning left, 0 where the spline stops
+
+  void resize(std::size_t n) {
+    for (std::vector<T>* v : {&x, &y, &dx, &dy, &ddx, &ddy, &dddx, &dddy, &speed, &curvature}) v->resize(n);
+  }
+  std::size_t size() const { return x.size(); }
+};
+
+/**
+ * One squiggles spline segment with a table of distances along it.
+ *
+ * squiggles' quintics are parameterized by time on a made up schedule, not by
+ * distance, so finding where a path is some distance in means marching
+ * calc_point() from the start and adding up chords.  This integrates the
+ * speed once at construction with 5 point Gauss-Legendre on each of INTERVALS
+ * even steps of the parameter and keeps the distance at each knot.
+ *
+ *   distance_at(t)         O(1), the knot's distance plus one Gauss-Legendre from it
+ *   parameter_at(distance) O(log INTERVALS), binary search over the knots, then
+ *                          Newton from a line between them
+ *
+ * Where the spline nearly stops its speed turns sharply, and one Gauss-Legendre
+ * isn't enough.  Those intervals are found at construction and halved until
+ * the halves agree, on every lookup that lands in them.  The knots are floats,
+ * so both lookups are good to MAX_ERROR of the length.
+ */
+class Spline {
+ public:
+  static constexpr int INTERVALS = 32;  // One bit each in sharp
+
+  /**
+   * Worst error of distance_at() and of the distance at parameter_at(),
+   * relative to the length.  Checked by ./bin/host/bench -a.
+   */
+  static constexpr double MAX_ERROR = 2e-7;
+
+  Spline() = default;
+
+  /**
+   * The spline squiggles::SplineGenerator::gen_single_raw_path() makes between
+   * two poses.
+   *
+   * \param start, end
+   *        ends of the segment, the accelerations count but the velocities are replaced
+   * \param duration
+   *        parameter at the end, the made up seconds squiggles picked
+   * \param start_vel, end_vel
+   *        made up speeds at the ends, squiggles uses K_DEFAULT_VEL when they'd be 0
+   * \param table
+   *        false skips integrating the distance table, for a shape that's only evaluated
+   */
+  explicit Spline(squiggles::ControlVector start, squiggles::ControlVector end, double duration, double start_vel, double end_vel, bool table = true);
+
+  /**
+   * A Spline for each segment between the waypoints, rebuilt from the points
+   * gen_raw_path() gives for it, each with its table.
+   *
+   * squiggles doesn't hand out the made up seconds and speeds it settles on,
+   * so this guesses them from the points: the duration is the point count
+   * times dt rounded to whole seconds, and the speed is the middle point
+   * projected onto how a unit of speed moves it, since a segment is linear in
+   * it.  Both are read off host/squiggles, which is written from squiggles'
+   * headers, and bench -a only checks the shapes against host/squiggles'
+   * points.  Until a build with SQUIGGLES_SRC agrees, treat these as close to
+   * the path generate() follows, not the same.  Running gen_raw_path() is
+   * most of the time, about 12ms for the s-curve on the host.
+   *
+   * \param generator
+   *        the generator the path is or will be generated with
+   * \param waypoints
+   *        what generate() is given
+   * \param dt
+   *        seconds between points, the generator's dt
+   * \param fast
+   *        generate()'s fast
+   */
+  static std::vector<Spline> segments(squiggles::SplineGenerator& generator, std::vector<squiggles::ControlVector> waypoints, double dt, bool fast = false);
+
+  double duration() const { return span; }
+  double length() const { return distance[INTERVALS]; }
+
+  /**
+   * Distance along the spline at a parameter, 0 to duration().
+   */
+  double distance_at(double t) const;
+
+  /**
+   * Parameter a distance along the spline, 0 to length().
+   */
+  double parameter_at(double s) const;
+
+  squiggles::Pose pose_at(double t) const;
+  squiggles::Pose pose_at_distance(double s) const { return pose_at(parameter_at(s)); }
+
+  /**
+   * Curvature at a parameter in 1/m, positive turning left.
+   */
+  double curvature_at(double t) const;
+
+  /**
+   * Speed along the spline per unit of parameter.
+   */
+  double speed_at(double t) const;
+
+  /**
+   * Position, derivatives, speed and curvature at n parameters, written to the
+   * first n of each array in out, which has to have room.
+   *
+   * squiggles::QuinticPolynomial evaluates x and y and each derivative with a
+   * call apiece.  This runs every Horner chain for a parameter together with
+   * no branches, so the double version vectorizes where the compiler can and
+   * the float one takes 4 parameters at a time with NEON on the brain when
+   * FAST_MATH is on.
+   *
+   * Floats lose bits to the powers of the parameter, so both evaluate from the
+   * middle of the duration, where the powers are 32 times smaller.  The float
+   * version's worst errors against the double one, for splines that fit on a
+   * field, are FLOAT_MAX_ERROR in meters and meters per unit of parameter, and
+   * FLOAT_CURVATURE_MAX_ERROR of the curvature or 1/m, whichever is more,
+   * where the spline moves faster than 0.05.  Checked by ./bin/host/bench -a.
+   */
+  void evaluate(const double* t, int n, SplineSamples<double>& out) const;
+  void evaluate(const float* t, int n, SplineSamples<float>& out) const;
+
+  static constexpr double FLOAT_MAX_ERROR = 2e-5;
+  static constexpr double FLOAT_CURVATURE_MAX_ERROR = 3e-4;
+
+  /**
+   * Bytes the spline holds, coefficients and table.
+   */
+  std::size_t bytes() const { return sizeof(Spline); }
+
+ private:
+  std::array<double, 6> x = {}, y = {};  // Coefficients, lowest power first
+  double span = 0.0;
+  double step = 1.0;  // Parameter between knots
+  std::array<float, INTERVALS + 1> distance = {};  // At each knot
+  std::uint32_t sharp = 0;                         // Intervals the speed turns too sharply in for one Gauss-Legendre
+
+  double gauss_legendre(double from, double to) const;
+  double integral(double from, double to, double whole, int depth) const;
+  double integral(int knot, double to) const;  // From a knot
+};
+
+/**
+ * A path from squiggles::SplineGenerator::generate() with lookups by time and
+ * distance.
+ *
+ * SplineGenerator::get_point_at_time() takes the path by value and binary
+ * searches it, so every lookup copies every point.  generate() spaces points
+ * dt apart within each segment, so point_at_time() guesses the index from the
+ * time and steps past the few points segment ends shift it by.  point_at_distance()
+ * binary searches a table of distances along the path built once here.
+ * Between points both interpolate like get_point_at_time().
+ */
+class Profile {
+ public:
+  Profile() = default;
+
+  /**
+   * \param points
+   *        what generate() returned
+   * \param dt
+   *        seconds between points, the generator's dt
+   */
+  explicit Profile(std::vector<squiggles::ProfilePoint> points, double dt);
+
+  squiggles::ProfilePoint point_at_time(double t) const;
+  squiggles::ProfilePoint point_at_distance(double s) const;
+
+  /**
+   * A fraction of the way from one point to another, like SplineGenerator::lerp_point().
+   */
+  static squiggles::ProfilePoint lerp(const squiggles::ProfilePoint& start, const squiggles::ProfilePoint& end, double fraction);
+
+  const std::vector<squiggles::ProfilePoint>& points() const { return path; }
+  bool empty() const { return path.empty(); }
+  double duration() const { return path.empty() ? 0.0 : path.back().time - path.front().time; }
+  double length() const { return distance.empty() ? 0.0 : distance.back(); }
+
+ private:
+  std::vector<squiggles::ProfilePoint> path;
+  std::vector<double> distance;  // Along the path at each point
+  double dt = 0.01;
+};
+}  // namespace pls
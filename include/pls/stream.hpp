@@ -0,0 +1,210 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "api.h"
+#include "okapi/squiggles/squiggles.hpp"
+#include "pls/trajectory.hpp"
+
+namespace pls {
+/**
+ * Where a TrajectoryStream's points come from.  Only the stream's producer
+ * task calls it.
+ */
+class TrajectorySource {
+ public:
+  virtual ~TrajectorySource() = default;
+
+  /**
+   * Writes the next points to out, which has room for max of them, and
+   * returns how many.  0 means there are no more.
+   */
+  virtual int read(squiggles::ProfilePoint* out, int max) = 0;
+
+  /**
+   * Memory the source holds right now, in bytes.
+   */
+  virtual std::size_t bytes() const = 0;
+};
+
+/**
+ * Points baked into the program or already in memory, which have to outlive the source.
+ */
+class TableSource : public TrajectorySource {
+ public:
+  TableSource(const squiggles::ProfilePoint* points, std::size_t size) : points(points), size(size) {}
+  explicit TableSource(const std::vector<squiggles::ProfilePoint>& points) : TableSource(points.data(), points.size()) {}
+
+  int read(squiggles::ProfilePoint* out, int max) override;
+  std::size_t bytes() const override { return sizeof(*this); }
+
+ private:
+  const squiggles::ProfilePoint* points;
+  std::size_t size;
+  std::size_t next = 0;
+};
+
+/**
+ * A pls::trajectory file, a chunk at a time.
+ */
+class FileSource : public TrajectorySource {
+ public:
+  /**
+   * \param file_path
+   *        file like "/usd/skills.traj", opened right away, check status()
+   */
+  explicit FileSource(const char* file_path);
+
+  /**
+   * The bytes of a file in memory, which have to outlive the source.
+   */
+  FileSource(const std::uint8_t* data, std::size_t size);
+
+  int read(squiggles::ProfilePoint* out, int max) override;
+  std::size_t bytes() const override;
+  trajectory::status_e status() const { return reader.status(); }
+
+ private:
+  trajectory::Reader reader;
+  std::vector<squiggles::ProfilePoint> chunk;  // What's left of the last chunk read
+  int used = 0;
+};
+
+/**
+ * Waypoints generated one segment at a time, the same points generate() returns
+ * for all of them at once.
+ *
+ * squiggles fits and parameterizes every pair of waypoints on its own, from
+ * each waypoint's velocity to the next's, so the first segment can be driven
+ * while the next is generated.
+ */
+class GeneratorSource : public TrajectorySource {
+ public:
+  GeneratorSource(squiggles::SplineGenerator generator, std::vector<squiggles::ControlVector> waypoints);
+  GeneratorSource(squiggles::SplineGenerator generator, const std::vector<squiggles::Pose>& waypoints);
+
+  int read(squiggles::ProfilePoint* out, int max) override;
+  std::size_t bytes() const override;
+
+ private:
+  squiggles::SplineGenerator generator;
+  std::vector<squiggles::ControlVector> waypoints;
+  std::size_t next_waypoint = 0;
+  std::vector<squiggles::ProfilePoint> segment;  // What's left of the last segment generated
+  std::size_t used = 0;
+  double end_time = 0.0;
+};
+
+/**
+ * A profile driven while it's still being read or generated, through a ring of
+ * CAPACITY points.
+ *
+ * okapi's AsyncMotionProfileController holds every point of a path for the
+ * whole path, and the path has to be generated before it moves.  Here a low
+ * priority producer task fills the ring from a source and waits when it's
+ * full, and the follower frees points as it drives past them.  Memory is the
+ * ring and whatever the source holds, however long the path is.
+ *
+ * Start driving once ready(), after the first CHUNK points.  point_at_time()
+ * interpolates like pls::Profile.  If the follower catches up to the producer
+ * it gets the last point there is and the underrun is counted.
+ */
+class TrajectoryStream {
+ public:
+  static constexpr std::uint32_t CAPACITY = 256;  // Points, a power of two, 2.56s at 10ms
+  static constexpr std::uint32_t CHUNK = trajectory::CHUNK_POINTS;
+
+  /**
+   * Starts the producer.
+   *
+   * \param source
+   *        where the points come from, has to outlive the stream
+   * \param prio
+   *        producer task priority, below the follower's
+   */
+  explicit TrajectoryStream(TrajectorySource& source, std::uint32_t prio = TASK_PRIORITY_MIN + 1);
+
+  /**
+   * Stops the producer and waits for it.
+   */
+  ~TrajectoryStream();
+
+  TrajectoryStream(const TrajectoryStream&) = delete;
+  TrajectoryStream& operator=(const TrajectoryStream&) = delete;
+
+  /**
+   * True once the first CHUNK points are in, or the whole path if it's shorter.
+   */
+  bool ready() const;
+
+  /**
+   * Blocks until ready() or the timeout.  Returns ready().
+   */
+  bool wait_ready(std::uint32_t timeout_ms);
+
+  /**
+   * The point at a time on the profile's clock.  Times have to go forward,
+   * points before t are handed back to the producer.  Before the first point
+   * there's nothing to give but a stop at the origin, so don't drive with it
+   * until ready() and not if empty().
+   */
+  squiggles::ProfilePoint point_at_time(double t);
+
+  /**
+   * True once the source has run out and point_at_time() has reached its last point.
+   */
+  bool finished() const;
+
+  /**
+   * True once the source has run out without giving a point, like a missing file.
+   */
+  bool empty() const;
+
+  /**
+   * Time of the latest point point_at_time() has had from the producer, 0 before the first.
+   */
+  double time() const { return latest_time; }
+
+  /**
+   * Times point_at_time() asked past what the producer had.
+   */
+  int underruns() const { return underrun_count; }
+
+  /**
+   * Most points the ring has held at once.
+   */
+  std::uint32_t peak_points() const { return peak.load(std::memory_order_relaxed); }
+
+  /**
+   * Most memory the stream and its source have held at once, in bytes.
+   */
+  std::size_t peak_bytes() const;
+
+  /**
+   * Microseconds from the stream starting to ready().
+   */
+  std::uint32_t ready_us() const { return first_ready_us.load(std::memory_order_relaxed); }
+
+ private:
+  TrajectorySource& source;
+  squiggles::ProfilePoint ring[CAPACITY];
+  std::atomic<std::uint32_t> head{0};  // Next slot the producer fills
+  std::atomic<std::uint32_t> tail{0};  // Oldest slot the follower still needs
+  std::atomic<bool> exhausted{false};
+  std::atomic<bool> stopping{false};
+  std::atomic<std::uint32_t> peak{0};
+  std::atomic<std::size_t> ring_heap{0};  // Wheel velocities of the slots filled so far
+  std::atomic<std::size_t> peak_source_bytes{0};
+  std::uint32_t start_us;
+  std::atomic<std::uint32_t> first_ready_us{0};
+  int underrun_count = 0;
+  bool reached_end = false;
+  double latest_time = 0.0;
+  pros::Task producer_task;
+
+  void produce();
+};
+}  // namespace pls
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+
+#include "EZ-Template/api.hpp"
+
+namespace pls {
+namespace trace {
+/**
+ * Events the trace buffer holds.  Recording stops when it fills.
+ */
+constexpr int MAX_EVENTS = 2048;
+
+/**
+ * Rows the events are drawn on in the trace viewer.
+ */
+enum track_e { MOTION = 1,
+               WAIT = 2,
+               MECHANISM = 3 };
+
+/**
+ * One begin, end or instant event.  Names must be string literals.
+ */
+struct Event {
+  std::uint32_t time_us;
+  const char* name;
+  float value;
+  char phase;
+  std::uint8_t track;
+};
+
+/**
+ * Clears the buffer and starts recording.
+ *
+ * \param name
+ *        name of the run, like the auton name, copied into the trace
+ */
+void start(const char* name);
+
+/**
+ * Stops recording, closing any motion that is still open.
+ */
+void stop();
+
+/**
+ * Returns true while recording.
+ */
+bool recording();
+
+/**
+ * Returns the number of events recorded.
+ */
+int size();
+
+/**
+ * Returns the number of events that didn't fit in the buffer.
+ */
+int dropped();
+
+/**
+ * Returns a recorded event.
+ *
+ * \param index
+ *        0 to size() - 1
+ */
+const Event& event_get(int index);
+
+/**
+ * Starts a motion, ending the one before it if it never got a pid_wait.
+ *
+ * \param name
+ *        motion name, like "pid_drive_set"
+ * \param target
+ *        motion target, in inches or degrees
+ */
+void motion_begin(const char* name, double target);
+
+/**
+ * Ends the current motion.
+ *
+ * \param reason
+ *        why the motion exited
+ */
+void motion_end(ez::exit_output reason);
+
+/**
+ * Starts a span on the wait track, like a pid_wait.
+ *
+ * \param name
+ *        span name
+ * \param value
+ *        value shown with the span, defaults to 0
+ */
+void span_begin(const char* name, double value = 0.0);
+
+/**
+ * Ends the open span on the wait track.
+ */
+void span_end();
+
+/**
+ * Marks a mechanism action, like a piston firing or an intake speed change.
+ *
+ * \param name
+ *        mechanism name
+ * \param value
+ *        new state or speed
+ */
+void action(const char* name, double value);
+
+/**
+ * pros::delay that shows up in the trace.
+ *
+ * \param milliseconds
+ *        time to wait
+ */
+void delay(std::uint32_t milliseconds);
+
+/**
+ * Writes the trace as text lines that host/tools/trace2json turns into Chrome trace JSON.
+ *
+ * \param file_path
+ *        file to write, like "/usd/trace.txt", or nullptr to print to the terminal
+ */
+void dump(const char* file_path = nullptr);
+}  // namespace trace
+}  // namespace pls
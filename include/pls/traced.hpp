@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+#include "pls/trace.hpp"
+
+namespace pls {
+/**
+ * ez::Piston that marks every change in pls::trace.
+ */
+class Piston : public ez::Piston {
+ public:
+  /**
+   * Piston constructor.
+   *
+   * \param trace_name
+   *        name shown in the trace, must be a string literal
+   * \param input_port
+   *        the ports of your pistons
+   * \param default_state
+   *        starting state of your piston
+   */
+  Piston(const char* trace_name, int input_port, bool default_state = false)
+      : ez::Piston(input_port, default_state), name(trace_name) {}
+
+  /**
+   * Sets the piston to the input.
+   *
+   * \param input
+   *        true sets to the opposite of the starting position
+   */
+  void set(bool input) {
+    if (input != get()) trace::action(name, input);
+    ez::Piston::set(input);
+  }
+
+ private:
+  const char* name;
+};
+
+/**
+ * pros::MotorGroup that marks every speed change in pls::trace.
+ */
+class MotorGroup : public pros::MotorGroup {
+ public:
+  /**
+   * MotorGroup constructor.
+   *
+   * \param trace_name
+   *        name shown in the trace, must be a string literal
+   * \param ports
+   *        motor ports, negative to reverse
+   */
+  MotorGroup(const char* trace_name, std::initializer_list<std::int8_t> ports)
+      : pros::MotorGroup(ports), name(trace_name) {}
+
+  /**
+   * Sets the voltage of the motors from -127 to 127.  Only changes are traced,
+   * so this is fine to call every loop.
+   */
+  std::int32_t move(std::int32_t voltage) const override {
+    if (voltage != last) {
+      trace::action(name, voltage);
+      last = voltage;
+    }
+    return pros::MotorGroup::move(voltage);
+  }
+
+ private:
+  const char* name;
+  mutable std::int32_t last = 0;
+};
+}  // namespace pls
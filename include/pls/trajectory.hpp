@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "okapi/squiggles/squiggles.hpp"
+
+namespace pls {
+namespace trajectory {
+/**
+ * Binary files of squiggles profiles, for paths generated ahead of time and
+ * loaded from the SD card.
+ *
+ * okapi's AsyncMotionProfileController::storePath() writes each point as a
+ * line of text and loadPath() parses it back one number at a time, about 120
+ * bytes a point.  These files hold a header and then chunks of CHUNK_POINTS
+ * points each.  Every chunk is the same size, decodes on its own and has its
+ * own CRC, so a reader holds one chunk at a time and the first points can be
+ * driven before the rest of the file is read.
+ *
+ * In a chunk each column, x, y, yaw, vel, accel, jerk, curvature, time and
+ * each wheel's velocity, is a float base and step and a uint16 per point.  A
+ * value comes back within 1/131070 of the range its column covers in its
+ * chunk, micrometers for a path that moves under a meter in 0.64s.  Files are
+ * little endian like the brain, about 21 bytes a point with two wheels.
+ */
+constexpr std::uint32_t MAGIC = 0x54534c50;  // "PLST"
+constexpr std::uint16_t VERSION = 1;
+constexpr int CHUNK_POINTS = 64;
+constexpr int MAX_WHEELS = 4;
+constexpr int FIXED_COLUMNS = 8;  // Before the wheels
+constexpr int MAX_COLUMNS = FIXED_COLUMNS + MAX_WHEELS;
+
+/**
+ * Bytes in the header and in each chunk.
+ */
+constexpr std::size_t HEADER_BYTES = 32;
+constexpr std::size_t chunk_bytes(int wheels) { return 8 + (FIXED_COLUMNS + wheels) * (8 + CHUNK_POINTS * 2) + 4; }
+constexpr std::size_t MAX_CHUNK_BYTES = chunk_bytes(MAX_WHEELS);
+
+enum status_e { OK = 0,
+                OPEN_FAILED = 1,
+                WRITE_FAILED = 2,
+                BAD_HEADER = 3,  // Not a trajectory file, or its header CRC is wrong
+                BAD_VERSION = 4,
+                BAD_CHUNK = 5,   // A chunk's CRC is wrong
+                TRUNCATED = 6,
+                BAD_WHEELS = 7 };  // Points with different numbers of wheels, or more than MAX_WHEELS
+
+const char* status_to_string(status_e status);
+
+/**
+ * What the header says about the file.
+ */
+struct Header {
+  std::uint32_t points = 0;
+  std::uint32_t chunks = 0;
+  int wheels = 0;
+  double dt = 0.0;  // Seconds between points, the generator's dt
+};
+
+/**
+ * Encodes a profile into the bytes of a file.
+ *
+ * \param points
+ *        what squiggles::SplineGenerator::generate() returned
+ * \param dt
+ *        the generator's dt
+ * \param out
+ *        replaced with the file's bytes
+ */
+status_e encode(const std::vector<squiggles::ProfilePoint>& points, double dt, std::vector<std::uint8_t>& out);
+
+/**
+ * Writes a profile to a file, like "/usd/skills.traj".
+ */
+status_e store(const char* file_path, const std::vector<squiggles::ProfilePoint>& points, double dt);
+
+/**
+ * Reads a whole file into points.
+ *
+ * \param dt
+ *        set to the file's dt when not nullptr
+ */
+status_e load(const char* file_path, std::vector<squiggles::ProfilePoint>& points, double* dt = nullptr);
+
+/**
+ * Decodes a whole file already in memory.
+ */
+status_e decode(const std::uint8_t* data, std::size_t size, std::vector<squiggles::ProfilePoint>& points, double* dt = nullptr);
+
+/**
+ * Reads a file one chunk at a time, from the SD card or from memory.
+ *
+ * Holds one chunk's bytes and nothing else, so memory doesn't grow with the
+ * path.  The first read() after open() has the first CHUNK_POINTS points ready
+ * to drive.
+ */
+class Reader {
+ public:
+  Reader() = default;
+  ~Reader();
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+
+  /**
+   * Opens a file and reads its header.
+   */
+  status_e open(const char* file_path);
+
+  /**
+   * Reads from bytes in memory, which have to outlive the reader.
+   */
+  status_e open(const std::uint8_t* data, std::size_t size);
+
+  void close();
+
+  /**
+   * Decodes the next chunk.  Returns the number of points written to out,
+   * which has room for CHUNK_POINTS, or 0 at the end of the file or on an
+   * error, which status() tells apart.
+   */
+  int read(squiggles::ProfilePoint* out);
+
+  const Header& header() const { return head; }
+  status_e status() const { return result; }
+  bool done() const { return next_chunk >= head.chunks || result != OK; }
+
+  /**
+   * Chunks decoded so far.
+   */
+  std::uint32_t chunks_read() const { return next_chunk; }
+
+ private:
+  FILE* file = nullptr;
+  const std::uint8_t* memory = nullptr;
+  std::size_t memory_size = 0;
+  std::size_t memory_offset = 0;
+
+  Header head;
+  std::size_t chunk_size = 0;
+  std::uint32_t next_chunk = 0;
+  status_e result = OK;
+  std::uint8_t buffer[MAX_CHUNK_BYTES];
+
+  bool fill(std::size_t bytes);
+  status_e header_read();
+  status_e fail(status_e status);
+};
+}  // namespace trajectory
+}  // namespace pls
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "EZ-Template/api.hpp"
+#include "okapi/squiggles/squiggles.hpp"
+#include "pls/spline.hpp"
+#include "pls/stream.hpp"
+
+namespace pls {
+/**
+ * A mirror, rotation and translation of the field, applied to points as
+ * they're read instead of to a copy of the path.
+ *
+ * Coordinates are odom's, inches and degrees clockwise from +y.  A point is
+ * mirrored first, then rotated clockwise about the origin, then translated.
+ * mirror() swaps left and right from the same start, so an auton written for
+ * the right side runs on the left from odom_xyt_set(0, 0, 0) with one stored
+ * path.  Unlike odom_x_flip() and odom_theta_flip(), nothing about the chassis
+ * changes, only the motion the transform is handed to.
+ *
+ * Mirroring flips headings, curvature and the turn_behavior of ez::odom, and
+ * swaps the left and right wheel velocities of squiggles points.  Speeds,
+ * times and drive directions never change.
+ */
+class Transform {
+ public:
+  /**
+   * Leaves points where they are.
+   */
+  Transform() = default;
+
+  /**
+   * x to -x, left and right swapped.
+   */
+  static Transform mirror();
+
+  /**
+   * Across a line through the origin at a heading, in degrees clockwise from +y.
+   * reflect(0) is mirror(), reflect(90) swaps forward and back.
+   */
+  static Transform reflect(double line_deg);
+
+  /**
+   * Clockwise about the origin, in degrees.
+   */
+  static Transform rotate(double deg);
+
+  /**
+   * By inches right and forward.
+   */
+  static Transform translate(double x, double y);
+
+  /**
+   * This transform, then next.
+   */
+  Transform then(const Transform& next) const;
+
+  bool mirrored() const { return flip; }
+  bool identity() const { return !flip && turn == 0.0 && dx == 0.0 && dy == 0.0; }
+
+  /**
+   * An odom pose or waypoint.  A theta of ANGLE_NOT_SET stays unset.
+   */
+  ez::pose apply(ez::pose pose) const;
+  ez::odom apply(ez::odom point) const;
+
+  /**
+   * A pose or profile point in squiggles' frame, through pls::pose_from_odom().
+   */
+  squiggles::Pose apply(squiggles::Pose pose) const;
+  squiggles::ProfilePoint apply(squiggles::ProfilePoint point) const;
+
+ private:
+  bool flip = false;
+  double turn = 0.0;  // Degrees clockwise
+  double cos_turn = 1.0, sin_turn = 0.0;
+  double dx = 0.0, dy = 0.0;  // Inches
+
+  Transform(bool flip, double turn, double dx, double dy);
+};
+
+/**
+ * A Profile seen through a Transform, with the same lookups.
+ *
+ * Holds a reference, so left and right variants of a path share one
+ * generated profile and each lookup transforms the one point it returns.
+ * The profile has to outlive the view.
+ */
+class ProfileView {
+ public:
+  ProfileView(const Profile& profile, Transform transform = {}) : source(&profile), how(transform) {}
+
+  squiggles::ProfilePoint point_at_time(double t) const { return how.apply(source->point_at_time(t)); }
+  squiggles::ProfilePoint point_at_distance(double s) const { return how.apply(source->point_at_distance(s)); }
+
+  /**
+   * A point of the profile, like points()[i].
+   */
+  squiggles::ProfilePoint point(std::size_t i) const { return how.apply(source->points()[i]); }
+
+  std::size_t size() const { return source->points().size(); }
+  bool empty() const { return source->empty(); }
+  double duration() const { return source->duration(); }
+  double length() const { return source->length(); }
+
+  const Profile& profile() const { return *source; }
+  const Transform& transform() const { return how; }
+
+ private:
+  const Profile* source;
+  Transform how;
+};
+
+/**
+ * Another source's points through a Transform, for a TrajectoryStream of a
+ * mirrored file or generator.  Points are transformed in the stream's ring as
+ * they're read.
+ */
+class TransformSource : public TrajectorySource {
+ public:
+  /**
+   * \param source
+   *        where the points come from, has to outlive this
+   */
+  TransformSource(TrajectorySource& source, Transform transform) : source(source), how(transform) {}
+
+  int read(squiggles::ProfilePoint* out, int max) override;
+  std::size_t bytes() const override { return sizeof(*this) + source.bytes(); }
+
+ private:
+  TrajectorySource& source;
+  Transform how;
+};
+
+/**
+ * Waypoints through a Transform, for lists handed to EZ by value anyway.
+ */
+std::vector<ez::odom> transformed(std::vector<ez::odom> points, const Transform& transform);
+}  // namespace pls
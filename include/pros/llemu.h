@@ -42,6 +42,8 @@ namespace c {
  * errno values as specified above.
  */
 bool __attribute__((weak)) lcd_print(int16_t line, const char* fmt, ...)  {
+    (void)line;
+    (void)fmt;
     return false;
 }
 
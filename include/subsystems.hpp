@@ -2,14 +2,23 @@
 
 #include "EZ-Template/api.hpp"
 #include "api.h"
+#include "pls/controller_queue.hpp"
+#include "pls/drive.hpp"
+#include "pls/log.hpp"
+#include "pls/traced.hpp"
 
-extern ez::Drive chassis;
+extern pls::Drive chassis;
 
 // Top ten pistons
-inline ez::Piston scraper('A');
-inline ez::Piston descore('H');
-inline ez::Piston switcher('C');
+inline pls::Piston scraper("scraper", 'A');
+inline pls::Piston descore("descore", 'H');
+inline pls::Piston switcher("switcher", 'C');
 
 // elite motors
-inline pros::MotorGroup intake({9, -10});
- 
\ No newline at end of file
+inline pls::MotorGroup intake("intake", {9, -10});
+
+// Controller screen and rumble, sent at the rate the controller accepts
+inline pls::ControllerQueue master_out(master);
+
+// Terminal logging that never blocks the task calling it, any task can log to it
+inline pls::Logger telemetry;
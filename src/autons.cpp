@@ -213,7 +213,7 @@ void combining_movements() {
 void tug(int attempts) {
   for (int i = 0; i < attempts - 1; i++) {
     // Attempt to drive backward
-    printf("i - %i", i);
+    telemetry.log("i - %i", i);
     chassis.pid_drive_set(-12_in, 127);
     chassis.pid_wait();
 
@@ -221,7 +221,7 @@ void tug(int attempts) {
     if (chassis.interfered) {
       chassis.drive_sensor_reset();
       chassis.pid_drive_set(-2_in, 20);
-      pros::delay(1000);
+      pls::trace::delay(1000);
     }
     // If the robot successfully drove back, return
     else {
@@ -351,10 +351,10 @@ void measure_offsets() {
     // Turn to target at half power
     chassis.pid_turn_set(target, 63, ez::raw);
     chassis.pid_wait();
-    pros::delay(250);
+    pls::trace::delay(250);
 
     // Calculate delta in angle
-    double t_delta = util::to_rad(fabs(util::wrap_angle(chassis.odom_theta_get() - imu_start)));
+    double t_delta = pls::angle::to_rad(fabs(pls::angle::wrap(chassis.odom_theta_get() - imu_start)));
 
     // Calculate delta in sensor values that exist
     double l_delta = chassis.odom_tracker_left != nullptr ? chassis.odom_tracker_left->get() : 0.0;
@@ -403,11 +403,11 @@ void L() {
 
 
   chassis.pid_drive_set(32_in, 60);
-  pros::delay(500);
+  pls::trace::delay(500);
   scraper.set(true);
   chassis.pid_wait();
 
-  pros::delay(500);
+  pls::trace::delay(500);
 
 
   chassis.pid_drive_set(-6.4_in, 127);
@@ -424,7 +424,7 @@ void L() {
 
   switcher.set(true);
 
-  pros::delay(725);
+  pls::trace::delay(725);
 
   switcher.set(false);
   descore.set(true);
@@ -440,7 +440,7 @@ void L() {
   chassis.pid_drive_set(15_in, 127);
   chassis.pid_wait();
 
-  pros::delay(2000);
+  pls::trace::delay(2000);
 
 
   chassis.pid_drive_set(-37_in, 127);
@@ -449,7 +449,7 @@ void L() {
 
   descore.set(false);
 
-  pros::delay(1800);
+  pls::trace::delay(1800);
 
 
   chassis.pid_drive_set(8_in, 127);
@@ -497,11 +497,11 @@ void L7() {
 
 
   chassis.pid_drive_set(32_in, 60);
-  pros::delay(500);
+  pls::trace::delay(500);
   scraper.set(true);
   chassis.pid_wait();
 
-  pros::delay(500);
+  pls::trace::delay(500);
 
 
   chassis.pid_drive_set(-6.4_in, 127);
@@ -524,7 +524,7 @@ void L7() {
   chassis.pid_drive_set(16_in, 127);
   chassis.pid_wait();
 
-  pros::delay(400);
+  pls::trace::delay(400);
 
 
 
@@ -534,7 +534,7 @@ void L7() {
 
   descore.set(false);
 
-  pros::delay(2500);
+  pls::trace::delay(2500);
 
 
   chassis.pid_drive_set(8_in, 127);
@@ -602,7 +602,7 @@ void RA7() {
   chassis.odom_turn_bias_set(0.4);
                         //4 in right, 25 in forward, 15 deg right
   chassis.pid_odom_set({{4_in, 25_in, 15_deg}, fwd, DRIVE_SPEED});
-  pros::delay(560);
+  pls::trace::delay(560);
   scraper.set(true);
   chassis.pid_wait();
 
@@ -617,7 +617,7 @@ void RA7() {
 
   chassis.pid_drive_set(10.3_in, 127);
   chassis.pid_wait();
-  pros::delay(120);
+  pls::trace::delay(120);
 
   chassis.pid_turn_set(180_deg, 85);
   chassis.pid_wait();
@@ -631,7 +631,7 @@ void RA7() {
 
   descore.set(false);
 
-  pros::delay(2500);
+  pls::trace::delay(2500);
   intake.move(0);
 
   chassis.pid_drive_set(11_in, DRIVE_SPEED);
@@ -672,7 +672,7 @@ void RA34() {
   chassis.odom_turn_bias_set(0.4);
 
   chassis.pid_odom_set({{4_in, 25_in, 15_deg}, fwd, DRIVE_SPEED});
-  pros::delay(560);
+  pls::trace::delay(560);
   scraper.set(true);
   chassis.pid_wait();
   
@@ -701,7 +701,7 @@ void RA34() {
 
   chassis.pid_drive_set(10.3_in, 127);
   chassis.pid_wait();
-  pros::delay(120);
+  pls::trace::delay(120);
 
   chassis.pid_turn_set(180_deg, 85);
   chassis.pid_wait();
@@ -715,7 +715,7 @@ void RA34() {
 
   descore.set(false);
 
-  pros::delay(2500);
+  pls::trace::delay(2500);
   intake.move(0);
 
   chassis.pid_drive_set(11_in, DRIVE_SPEED);
@@ -760,7 +760,7 @@ void LA7() {
   chassis.odom_turn_bias_set(0.4);
 
   chassis.pid_odom_set({{-5_in, 25_in, -15_deg}, fwd, DRIVE_SPEED});
-  pros::delay(560);
+  pls::trace::delay(560);
   scraper.set(true);
   chassis.pid_wait();
 
@@ -777,7 +777,7 @@ void LA7() {
   chassis.pid_drive_set(10_in, 127);
   chassis.pid_wait();
   // scraper time
-  pros::delay(90);
+  pls::trace::delay(90);
 
   chassis.pid_turn_set(180_deg, 85);
   chassis.pid_wait();
@@ -790,10 +790,10 @@ void LA7() {
 
 
   intake.move(-100);
-  pros::delay(100);
+  pls::trace::delay(100);
   intake.move(127);
 
-  pros::delay(2500);
+  pls::trace::delay(2500);
 
   //decore
 
@@ -836,7 +836,7 @@ void LA34() {
   chassis.odom_turn_bias_set(0.4);
 
   chassis.pid_odom_set({{-5_in, 25_in, -17_deg}, fwd, 127});
-  pros::delay(560);
+  pls::trace::delay(560);
   scraper.set(true);
   chassis.pid_wait();
 
@@ -848,7 +848,7 @@ void LA34() {
 
   intake.move(85);
   switcher.set(true);
-  pros::delay(600);
+  pls::trace::delay(600);
   switcher.set(false);
   intake.move(127);
 
@@ -862,7 +862,7 @@ void LA34() {
 
   chassis.pid_drive_set(12.5_in, 127);
   chassis.pid_wait();
-  pros::delay(130);
+  pls::trace::delay(130);
   chassis.pid_turn_set(180_deg, 85);
   chassis.pid_wait();
 
@@ -873,10 +873,10 @@ void LA34() {
   descore.set(false);
 
   intake.move(-100);
-  pros::delay(60);
+  pls::trace::delay(60);
   intake.move(127);
 
-  pros::delay(2250);
+  pls::trace::delay(2250);
 
 
    // descore
@@ -936,7 +936,7 @@ void skills() {
 
   // scraper time
 
-  pros::delay(665);
+  pls::trace::delay(665);
 
   chassis.pid_drive_set(-8_in, DRIVE_SPEED);
   chassis.pid_wait();
@@ -983,10 +983,10 @@ void skills() {
 
 
   intake.move(-50);
-  pros::delay(100);
+  pls::trace::delay(100);
   intake.move(127);
   descore.set(false);
-  pros::delay(2500);
+  pls::trace::delay(2500);
 
   
   descore.set(true);
@@ -1003,17 +1003,17 @@ void skills() {
   chassis.pid_turn_set(0_deg, 85);
   chassis.pid_wait();
 
-  pros::delay(570);
+  pls::trace::delay(570);
 
   chassis.pid_drive_set(-31_in, 120);
   chassis.pid_wait();
   descore.set(false);
 
   intake.move(-50);
-  pros::delay(100);
+  pls::trace::delay(100);
   intake.move(127);
   descore.set(false);
-  pros::delay(2500);
+  pls::trace::delay(2500);
 
   chassis.pid_drive_set(-2.5_in, DRIVE_SPEED);
   chassis.pid_wait();
@@ -1053,14 +1053,14 @@ void WinForPoint(){
 
   // scraper time
 
-  pros::delay(24);
+  pls::trace::delay(24);
   scraper.set(false);
 
   chassis.pid_drive_set(-28.6_in, 127);
   chassis.pid_wait();
 
   descore.set(false);
-  pros::delay(900);
+  pls::trace::delay(900);
   descore.set(true);
 
   chassis.pid_swing_set(ez::LEFT_SWING, 332_deg, 94);
@@ -6,7 +6,7 @@
 /////
 
 // Chassis constructor
-ez::Drive chassis(
+pls::Drive chassis(
     // These are your drive motors, the first motor is used for sensing!
     {-11, -12, -13},  // Left Chassis Ports
     {14, 15, 16},     // Right Chassis Ports
@@ -31,6 +31,9 @@ void initialize() {
 
   pros::delay(500);  // Stop the user from doing anything while legacy ports configure
 
+  // What a log() costs, timed once here before anything else logs so it can't crowd out real messages
+  telemetry.log("telemetry log() takes %.0f ns", telemetry.push_cost_ns());
+
   chassis.odom_tracker_back_set(&horiz_tracker);
   chassis.odom_tracker_left_set(&vert_tracker);
 
@@ -62,7 +65,7 @@ void initialize() {
   chassis.initialize();
   
   ez::as::initialize();
-  master.rumble(chassis.drive_imu_calibrated() ? "." : "---");
+  master_out.rumble(chassis.drive_imu_calibrated() ? "." : "---");
 }
 
 /**
@@ -71,7 +74,20 @@ void initialize() {
  * the robot is enabled, this task will exit.
  */
 void disabled() {
-  // . . .
+  // Messages the last mode logged and any it dropped
+  telemetry.stats_print();
+
+  // An auton killed by field control never got to stop and dump its own trace
+  if (pls::trace::recording()) {
+    pls::trace::stop();
+    pls::trace::dump(ez::util::SD_CARD_ACTIVE ? "/usd/trace.txt" : nullptr);
+  }
+
+  // Save what the driver did for host/tools/replay
+  if (pls::input::recording()) {
+    pls::input::stop();
+    pls::input::dump(ez::util::SD_CARD_ACTIVE ? "/usd/input.txt" : nullptr);
+  }
 }
 
 /**
@@ -118,20 +134,27 @@ void autonomous() {
   to be consistent
   */
 
+  pls::trace::start(ez::as::auton_selector.Autons.empty() ? "none" : ez::as::auton_selector.Autons[ez::as::auton_selector.auton_page_current].Name.c_str());
   ez::as::auton_selector.selected_auton_call();  // Calls selected auton from autonomous selector
+  pls::trace::stop();
+  pls::trace::dump(ez::util::SD_CARD_ACTIVE ? "/usd/trace.txt" : nullptr);  // Convert with host/tools/trace2json
+
+#if PLS_PROFILE
+  pls::prof::print();  // Print loop timing from the run to the terminal
+#endif
 }
 
 /**
  * Simplifies printing tracker values to the brain screen
  */
-void screen_print_tracker(ez::tracking_wheel *tracker, std::string name, int line) {
-  std::string tracker_value = "", tracker_width = "";
+void screen_print_tracker(ez::tracking_wheel *tracker, const char *name, int line) {
+  pls::TextBuffer<64> text;
   // Check if the tracker exists
   if (tracker != nullptr) {
-    tracker_value = name + " tracker: " + util::to_string_with_precision(tracker->get());             // Make text for the tracker value
-    tracker_width = "  width: " + util::to_string_with_precision(tracker->distance_to_center_get());  // Make text for the distance to center
+    text.text(name).text(" tracker: ").fixed(tracker->get());         // Make text for the tracker value
+    text.text("  width: ").fixed(tracker->distance_to_center_get());  // Make text for the distance to center
   }
-  ez::screen_print(tracker_value + tracker_width, line);  // Print final tracker text
+  ez::screen_print(text.c_str(), line);  // Print final tracker text
 }
 
 /**
@@ -141,6 +164,8 @@ void screen_print_tracker(ez::tracking_wheel *tracker, std::string name, int lin
  */
 void ez_screen_task() {
   while (true) {
+    PLS_PROFILE_BEGIN(screen, "screen task");
+
     // Only run this when not connected to a competition switch
     if (!pros::competition::is_connected()) {
       // Blank page for odom debugging
@@ -148,10 +173,11 @@ void ez_screen_task() {
         // If we're on the first blank page...
         if (ez::as::page_blank_is_on(0)) {
           // Display X, Y, and Theta
-          ez::screen_print("x: " + util::to_string_with_precision(chassis.odom_x_get()) +
-                               "\ny: " + util::to_string_with_precision(chassis.odom_y_get()) +
-                               "\na: " + util::to_string_with_precision(chassis.odom_theta_get()),
-                           1);  // Don't override the top Page line
+          pls::TextBuffer<64> text;
+          text.text("x: ").fixed(chassis.odom_x_get());
+          text.text("\ny: ").fixed(chassis.odom_y_get());
+          text.text("\na: ").fixed(chassis.odom_theta_get());
+          ez::screen_print(text.c_str(), 1);  // Don't override the top Page line
 
           // Display all trackers that are being used
           screen_print_tracker(chassis.odom_tracker_left, "l", 4);
@@ -160,6 +186,13 @@ void ez_screen_task() {
           screen_print_tracker(chassis.odom_tracker_front, "f", 7);
         }
       }
+
+#if PLS_PROFILE
+      // Blank page for loop timing
+      if (!chassis.pid_tuner_enabled() && ez::as::page_blank_is_on(1)) {
+        pls::prof::screen_print(1);  // Don't override the top Page line
+      }
+#endif
     }
 
     // Remove all blank pages when connected to a comp switch
@@ -168,6 +201,7 @@ void ez_screen_task() {
         ez::as::page_blank_remove_all();
     }
 
+    PLS_PROFILE_END(screen);
     pros::delay(ez::util::DELAY_TIME);
   }
 }
@@ -228,7 +262,13 @@ void opcontrol() {
   // This is preference to what you like to drive on
   chassis.drive_brake_set(MOTOR_BRAKE_COAST);
 
+  pls::input::start("opcontrol");  // Record the controller so the match can be replayed on a computer
+
   while (true) {
+    PLS_PROFILE_BEGIN(opcontrol, "opcontrol");
+
+    pls::input::record(master);
+
     // Gives you some extras to make EZ-Template ezier
     ez_template_extras();
 
@@ -260,6 +300,7 @@ void opcontrol() {
       RA34();
     }
 
+    PLS_PROFILE_END(opcontrol);
     pros::delay(ez::util::DELAY_TIME);  // This is used for timer calculations!  Keep this ez::util::DELAY_TIME
   }
 }
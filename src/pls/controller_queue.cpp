@@ -0,0 +1,111 @@
+#include "pls/controller_queue.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace pls {
+
+ControllerQueue::ControllerQueue(pros::Controller& controller)
+    : controller(controller),
+      output_task([this]() { task(); }, TASK_PRIORITY_DEFAULT - 1, TASK_STACK_DEPTH_DEFAULT, "controller output") {}
+
+// Pads with spaces so a shorter line fully covers what was there before
+void ControllerQueue::line_store(int line, const char* text) {
+  if (line < 0 || line >= LINES) return;
+
+  char padded[LINE_LENGTH + 1];
+  std::size_t n = strnlen(text, LINE_LENGTH);
+  std::memcpy(padded, text, n);
+  std::memset(padded + n, ' ', LINE_LENGTH - n);
+  padded[LINE_LENGTH] = '\0';
+
+  mutex.take();
+  Line& l = lines[line];
+  if (l.dirty)
+    coalesced_count++;
+  std::memcpy(l.text, padded, sizeof(padded));
+  l.dirty = std::strcmp(l.text, l.shown) != 0;
+  mutex.give();
+}
+
+void ControllerQueue::set_text(int line, const char* text) { line_store(line, text); }
+
+void ControllerQueue::print(int line, const char* fmt, ...) {
+  char text[LINE_LENGTH + 1];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(text, sizeof(text), fmt, args);
+  va_end(args);
+  line_store(line, text);
+}
+
+void ControllerQueue::clear_line(int line) { line_store(line, ""); }
+
+void ControllerQueue::clear() {
+  for (int i = 0; i < LINES; i++) line_store(i, "");
+}
+
+void ControllerQueue::rumble(const char* pattern) {
+  mutex.take();
+  if (rumble_dirty)
+    coalesced_count++;
+  std::strncpy(rumble_pattern, pattern, RUMBLE_LENGTH);
+  rumble_pattern[RUMBLE_LENGTH] = '\0';
+  rumble_dirty = true;
+  mutex.give();
+}
+
+int ControllerQueue::pending() {
+  mutex.take();
+  int count = rumble_dirty;
+  for (int i = 0; i < LINES; i++) count += lines[i].dirty;
+  mutex.give();
+  return count;
+}
+
+int ControllerQueue::coalesced() {
+  mutex.take();
+  int count = coalesced_count;
+  mutex.give();
+  return count;
+}
+
+void ControllerQueue::task() {
+  std::uint32_t now = pros::millis();
+  while (true) {
+    // Pick one update while holding the lock, then send it without the lock
+    char out[LINE_LENGTH + 1];
+    int line = -1;
+    bool send_rumble = false;
+
+    mutex.take();
+    if (rumble_dirty) {
+      std::memcpy(out, rumble_pattern, sizeof(rumble_pattern));
+      rumble_dirty = false;
+      send_rumble = true;
+    } else {
+      for (int i = 0; i < LINES; i++) {
+        int check = (next_line + i) % LINES;
+        if (lines[check].dirty) {
+          line = check;
+          std::memcpy(out, lines[line].text, sizeof(out));
+          std::memcpy(lines[line].shown, out, sizeof(out));
+          lines[line].dirty = false;
+          next_line = (line + 1) % LINES;
+          break;
+        }
+      }
+    }
+    mutex.give();
+
+    if (send_rumble)
+      controller.rumble(out);
+    else if (line != -1)
+      controller.set_text(line, 0, out);
+
+    pros::Task::delay_until(&now, UPDATE_TIME);
+  }
+}
+
+}  // namespace pls
@@ -0,0 +1,355 @@
+#include "pls/drive.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "pls/profiler.hpp"
+
+namespace pls {
+
+void Drive::motion_begin(const char* name, double target) {
+  prepared = nullptr;
+  trace::motion_begin(name, target);
+}
+
+void Drive::pid_odom_set(double target, int speed) {
+  motion_begin("pid_odom_set", target);
+  ez::Drive::pid_odom_set(target, speed);
+}
+
+void Drive::pid_odom_set(double target, int speed, bool slew_on) {
+  motion_begin("pid_odom_set", target);
+  ez::Drive::pid_odom_set(target, speed, slew_on);
+}
+
+void Drive::pid_odom_set(okapi::QLength p_target, int speed) {
+  motion_begin("pid_odom_set", p_target.convert(okapi::inch));
+  ez::Drive::pid_odom_set(p_target, speed);
+}
+
+void Drive::pid_odom_set(okapi::QLength p_target, int speed, bool slew_on) {
+  motion_begin("pid_odom_set", p_target.convert(okapi::inch));
+  ez::Drive::pid_odom_set(p_target, speed, slew_on);
+}
+
+// Point motions show how far away the point is
+double Drive::distance_to(ez::pose target) { return ez::util::distance_to_point(target, odom_pose_get()); }
+
+void Drive::pid_odom_set(ez::odom imovement) {
+  motion_begin("pid_odom_set point", distance_to(imovement.target));
+  ez::Drive::pid_odom_set(imovement);
+}
+
+void Drive::pid_odom_set(ez::odom imovement, bool slew_on) {
+  motion_begin("pid_odom_set point", distance_to(imovement.target));
+  ez::Drive::pid_odom_set(imovement, slew_on);
+}
+
+void Drive::pid_odom_set(ez::united_odom p_imovement) {
+  motion_begin("pid_odom_set point", distance_to(ez::util::united_pose_to_pose(p_imovement.target)));
+  ez::Drive::pid_odom_set(p_imovement);
+}
+
+void Drive::pid_odom_set(ez::united_odom p_imovement, bool slew_on) {
+  motion_begin("pid_odom_set point", distance_to(ez::util::united_pose_to_pose(p_imovement.target)));
+  ez::Drive::pid_odom_set(p_imovement, slew_on);
+}
+
+// Path motions show how many points they were given
+void Drive::pid_odom_set(std::vector<ez::odom> imovements) {
+  motion_begin("pid_odom_set path", imovements.size());
+  ez::Drive::pid_odom_set(imovements);
+}
+
+void Drive::pid_odom_set(std::vector<ez::odom> imovements, bool slew_on) {
+  motion_begin("pid_odom_set path", imovements.size());
+  ez::Drive::pid_odom_set(imovements, slew_on);
+}
+
+void Drive::pid_odom_set(std::vector<ez::united_odom> p_imovements) {
+  motion_begin("pid_odom_set path", p_imovements.size());
+  ez::Drive::pid_odom_set(p_imovements);
+}
+
+void Drive::pid_odom_set(std::vector<ez::united_odom> p_imovements, bool slew_on) {
+  motion_begin("pid_odom_set path", p_imovements.size());
+  ez::Drive::pid_odom_set(p_imovements, slew_on);
+}
+
+// A prepared path only fits from where it was prepared, anywhere else EZ injects from the robot
+bool Drive::at_start(const PreparedPath& path, const Transform& transform) {
+  return ez::util::distance_to_point(transform.apply(path.start()), odom_pose_get()) <= PreparedPath::START_TOLERANCE;
+}
+
+void Drive::pid_odom_set(const PreparedPath& path) {
+  motion_begin("pid_odom_set prepared", path.waypoints().size());
+  if (path.empty()) return;
+  if (path.waypoints().size() == 1) {
+    ez::Drive::pid_odom_set(path.waypoints().front());
+    return;
+  }
+  if (!at_start(path, {})) {
+    ez::Drive::pid_odom_set(path.waypoints());
+    return;
+  }
+  prepared = &path;
+  ez::Drive::pid_odom_pp_set(path.points());
+}
+
+void Drive::pid_odom_set(const PreparedPath& path, bool slew_on) {
+  motion_begin("pid_odom_set prepared", path.waypoints().size());
+  if (path.empty()) return;
+  if (path.waypoints().size() == 1) {
+    ez::Drive::pid_odom_set(path.waypoints().front(), slew_on);
+    return;
+  }
+  if (!at_start(path, {})) {
+    ez::Drive::pid_odom_set(path.waypoints(), slew_on);
+    return;
+  }
+  prepared = &path;
+  ez::Drive::pid_odom_pp_set(path.points(), slew_on);
+}
+
+void Drive::pid_odom_set(ez::odom imovement, const Transform& transform) {
+  motion_begin("pid_odom_set point", distance_to(transform.apply(imovement.target)));
+  ez::Drive::pid_odom_set(transform.apply(imovement));
+}
+
+void Drive::pid_odom_set(ez::odom imovement, const Transform& transform, bool slew_on) {
+  motion_begin("pid_odom_set point", distance_to(transform.apply(imovement.target)));
+  ez::Drive::pid_odom_set(transform.apply(imovement), slew_on);
+}
+
+void Drive::pid_odom_set(std::vector<ez::odom> imovements, const Transform& transform) {
+  motion_begin("pid_odom_set path", imovements.size());
+  ez::Drive::pid_odom_set(transformed(std::move(imovements), transform));
+}
+
+void Drive::pid_odom_set(std::vector<ez::odom> imovements, const Transform& transform, bool slew_on) {
+  motion_begin("pid_odom_set path", imovements.size());
+  ez::Drive::pid_odom_set(transformed(std::move(imovements), transform), slew_on);
+}
+
+void Drive::pid_odom_set(ez::united_odom p_imovement, const Transform& transform) {
+  pid_odom_set(ez::util::united_odom_to_odom(p_imovement), transform);
+}
+
+void Drive::pid_odom_set(ez::united_odom p_imovement, const Transform& transform, bool slew_on) {
+  pid_odom_set(ez::util::united_odom_to_odom(p_imovement), transform, slew_on);
+}
+
+void Drive::pid_odom_set(std::vector<ez::united_odom> p_imovements, const Transform& transform) {
+  pid_odom_set(ez::util::united_odoms_to_odoms(p_imovements), transform);
+}
+
+void Drive::pid_odom_set(std::vector<ez::united_odom> p_imovements, const Transform& transform, bool slew_on) {
+  pid_odom_set(ez::util::united_odoms_to_odoms(p_imovements), transform, slew_on);
+}
+
+void Drive::pid_odom_set(const PreparedPath& path, const Transform& transform) {
+  motion_begin("pid_odom_set prepared", path.waypoints().size());
+  if (path.empty()) return;
+  if (path.waypoints().size() == 1) {
+    ez::Drive::pid_odom_set(transform.apply(path.waypoints().front()));
+    return;
+  }
+  if (!at_start(path, transform)) {
+    ez::Drive::pid_odom_set(transformed(path.waypoints(), transform));
+    return;
+  }
+  prepared = &path;
+  ez::Drive::pid_odom_pp_set(transformed(path.points(), transform));
+}
+
+void Drive::pid_odom_set(const PreparedPath& path, const Transform& transform, bool slew_on) {
+  motion_begin("pid_odom_set prepared", path.waypoints().size());
+  if (path.empty()) return;
+  if (path.waypoints().size() == 1) {
+    ez::Drive::pid_odom_set(transform.apply(path.waypoints().front()), slew_on);
+    return;
+  }
+  if (!at_start(path, transform)) {
+    ez::Drive::pid_odom_set(transformed(path.waypoints(), transform), slew_on);
+    return;
+  }
+  prepared = &path;
+  ez::Drive::pid_odom_pp_set(transformed(path.points(), transform), slew_on);
+}
+
+PreparedPath Drive::path_prepare(ez::pose start, const std::vector<ez::odom>& waypoints) {
+  std::vector<double> smooth = odom_path_smooth_constants_get();
+  return PreparedPath(start, waypoints, odom_path_spacing_get(), smooth[0], smooth[1], smooth[2]);
+}
+
+PreparedPath Drive::path_prepare(ez::united_pose start, const std::vector<ez::united_odom>& waypoints) {
+  std::vector<double> smooth = odom_path_smooth_constants_get();
+  return PreparedPath(start, waypoints, odom_path_spacing_get(), smooth[0], smooth[1], smooth[2]);
+}
+
+namespace {
+// Follows point_at(t, pose) until done(t) says the profile is over, then holds its last point.  Gives up
+// FOLLOW_TIMEOUT_MS past end(), the profile's end as far as it's known
+template <typename PointAt, typename Done, typename End>
+FollowResult follow(Drive& drive, const LtvFollower& follower, PointAt point_at, Done done, End end) {
+  FollowResult result;
+  drive.drive_mode_set(ez::DISABLE);
+  std::uint32_t start = pros::millis(), now = start, settle_until = 0;
+  double total_error = 0.0, total_us = 0.0;
+  squiggles::ProfilePoint target;
+  squiggles::Pose pose(0.0, 0.0, 0.0);
+  while (true) {
+    double t = (now - start) / 1000.0;
+    if (settle_until == 0 && done(t)) settle_until = now + Drive::FOLLOW_SETTLE_MS;
+    if (settle_until != 0 && now >= settle_until) break;
+    if (t > end() + Drive::FOLLOW_TIMEOUT_MS / 1000.0) {
+      result.timed_out = true;
+      break;
+    }
+    PLS_PROFILE_BEGIN(follow, "profile_follow tick");
+
+    std::uint32_t tick_start = pros::micros();
+    pose = pose_from_odom(drive.odom_pose_get());
+    target = point_at(t, pose);
+    LtvOutput out = follower.calculate(pose, target, drive.drive_velocity_left(), drive.drive_velocity_right());
+    drive.drive_set((int)std::lround(std::clamp(out.left_volts, -12.0, 12.0) * 127.0 / 12.0), (int)std::lround(std::clamp(out.right_volts, -12.0, 12.0) * 127.0 / 12.0));
+    std::uint32_t tick_us = pros::micros() - tick_start;
+
+    double error = pose.dist(target.vector.pose);
+    result.ticks++;
+    result.worst_error = std::max(result.worst_error, error);
+    result.worst_tick_us = std::max(result.worst_tick_us, tick_us);
+    total_error += error;
+    total_us += tick_us;
+    PLS_PROFILE_END(follow);
+    pros::Task::delay_until(&now, ez::util::DELAY_TIME);
+  }
+  drive.drive_set(0, 0);
+  result.end_error = pose_from_odom(drive.odom_pose_get()).dist(target.vector.pose);
+  result.mean_error = result.ticks > 0 ? total_error / result.ticks : 0.0;
+  result.mean_tick_us = result.ticks > 0 ? total_us / result.ticks : 0.0;
+  return result;
+}
+
+// EZ has no exit for running out of time besides its velocity timeout
+ez::exit_output follow_exit(const FollowResult& result) {
+  if (result.timed_out) return ez::VELOCITY_EXIT;
+  return result.end_error < 0.0254 ? ez::SMALL_EXIT : ez::BIG_EXIT;
+}
+}  // namespace
+
+FollowResult Drive::profile_follow(const Profile& profile, const LtvFollower& follower, Replanner* replanner) {
+  if (replanner == nullptr || !replanner->profile_set(profile.points())) return profile_follow(ProfileView(profile), follower);
+  motion_begin("profile_follow replanned", profile.duration());
+  if (profile.empty()) {
+    trace::motion_end(ez::SMALL_EXIT);
+    return {};
+  }
+  int before = replanner->replans();
+  FollowResult result = follow(
+      *this, follower,
+      [&](double t, const squiggles::Pose& pose) {
+        replanner->update(pose, follower.speed(drive_velocity_left(), drive_velocity_right()), t);
+        return replanner->profile().point_at_time(t);
+      },
+      [&](double t) { return t >= replanner->profile().points().back().time; }, [&] { return replanner->profile().points().back().time; });
+  result.replans = replanner->replans() - before;
+  trace::motion_end(follow_exit(result));
+  return result;
+}
+
+FollowResult Drive::profile_follow(const ProfileView& profile, const LtvFollower& follower) {
+  motion_begin("profile_follow", profile.duration());
+  if (profile.empty()) {
+    trace::motion_end(ez::SMALL_EXIT);
+    return {};
+  }
+  double end = profile.profile().points().back().time;
+  FollowResult result = follow(
+      *this, follower, [&](double t, const squiggles::Pose&) { return profile.point_at_time(t); }, [&](double t) { return t >= end; }, [&] { return end; });
+  trace::motion_end(follow_exit(result));
+  return result;
+}
+
+FollowResult Drive::profile_follow(TrajectoryStream& stream, const LtvFollower& follower) {
+  motion_begin("profile_follow stream", 0);
+  trace::span_begin("stream ready");
+  bool ready = stream.wait_ready(FOLLOW_TIMEOUT_MS);
+  trace::span_end();
+  if (!ready) {
+    FollowResult result;
+    result.timed_out = true;
+    trace::motion_end(follow_exit(result));
+    return result;
+  }
+  if (stream.empty()) {
+    trace::motion_end(ez::SMALL_EXIT);
+    return {};
+  }
+  FollowResult result = follow(
+      *this, follower, [&](double t, const squiggles::Pose&) { return stream.point_at_time(t); }, [&](double) { return stream.finished(); },
+      [&] { return stream.time(); });
+  trace::motion_end(follow_exit(result));
+  return result;
+}
+
+void Drive::wait_traced(const char* name, void (ez::Drive::*wait)()) {
+  // EZ's odom waits disable the drive before they return, so the mode has to be read first
+  ez::e_mode mode = drive_mode_get();
+  trace::span_begin(name);
+  (this->*wait)();
+  trace::span_end();
+  trace::motion_end(exit_reason_get(mode));
+}
+
+void Drive::pid_wait() { wait_traced("pid_wait", &ez::Drive::pid_wait); }
+
+void Drive::pid_wait_quick() { wait_traced("pid_wait_quick", &ez::Drive::pid_wait_quick); }
+
+void Drive::pid_wait_quick_chain() { wait_traced("pid_wait_quick_chain", &ez::Drive::pid_wait_quick_chain); }
+
+void Drive::pid_wait_until_index(int index) {
+  trace::span_begin("pid_wait_until_index", index);
+  bool waypoint = prepared != nullptr && index >= 0 && index < (int)prepared->waypoints().size();
+  ez::Drive::pid_wait_until_index(waypoint ? prepared->index(index) : index);
+  trace::span_end();
+}
+
+ez::exit_output Drive::exit_reason_get() { return exit_reason_get(drive_mode_get()); }
+
+ez::exit_output Drive::exit_reason_get(ez::e_mode mode) {
+  // Error left over in the PID that decides the exit for this mode
+  double error = 0.0;
+  const ez::PID::exit_condition_* exit = nullptr;
+  switch (mode) {
+    case ez::DRIVE:
+      error = std::fmax(std::fabs(leftPID.error), std::fabs(rightPID.error));
+      exit = &leftPID.exit;
+      break;
+    case ez::TURN:
+    case ez::TURN_TO_POINT:
+      error = std::fabs(turnPID.error);
+      exit = &turnPID.exit;
+      break;
+    case ez::SWING:
+      error = std::fabs(swingPID.error);
+      exit = &swingPID.exit;
+      break;
+    case ez::POINT_TO_POINT:
+    case ez::PURE_PURSUIT:
+      error = std::fabs(xyPID.error);
+      exit = &xyPID.exit;
+      break;
+    default:
+      return ez::RUNNING;
+  }
+
+  if (exit->small_error == 0 && exit->big_error == 0) return ez::ERROR_NO_CONSTANTS;
+  if (error <= exit->small_error) return ez::SMALL_EXIT;
+  if (error <= exit->big_error) return ez::BIG_EXIT;
+  if (interfered || drive_current_left_over() || drive_current_right_over()) return ez::mA_EXIT;
+  return ez::VELOCITY_EXIT;
+}
+
+}  // namespace pls
@@ -0,0 +1,88 @@
+#include "pls/fastmath.hpp"
+
+namespace pls {
+namespace fast {
+
+#if PLS_FAST_NEON
+namespace {
+using namespace fast_detail;
+
+inline float32x4_t poly(float32x4_t z, float c0, float c1, float c2) { return vmlaq_f32(vdupq_n_f32(c0), z, vmlaq_f32(vdupq_n_f32(c1), z, vdupq_n_f32(c2))); }
+
+void sincos4(float32x4_t x, float32x4_t* s, float32x4_t* c) {
+  uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x80000000u));
+  float32x4_t half = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(vdupq_n_f32(0.5f)), sign));
+  int32x4_t k = vcvtq_s32_f32(vmlaq_n_f32(half, x, TWO_OVER_PI));
+  float32x4_t kf = vcvtq_f32_s32(k);
+  float32x4_t r = vmlsq_n_f32(vmlsq_n_f32(vmlsq_n_f32(x, kf, PI_OVER_2_A), kf, PI_OVER_2_B), kf, PI_OVER_2_C);
+  float32x4_t z = vmulq_f32(r, r);
+
+  float32x4_t sr = vmlaq_f32(r, vmulq_f32(r, z), poly(z, -1.6666654611e-1f, 8.3321608736e-3f, -1.9515295891e-4f));
+  float32x4_t cr = vmlaq_f32(vmlsq_n_f32(vdupq_n_f32(1.0f), z, 0.5f), vmulq_f32(z, z), poly(z, 4.166664568e-2f, -1.388731625e-3f, 2.443315711e-5f));
+
+  uint32x4_t q = vreinterpretq_u32_s32(k);
+  uint32x4_t swap = vtstq_u32(q, vdupq_n_u32(1));
+  float32x4_t sv = vbslq_f32(swap, cr, sr);
+  float32x4_t cv = vbslq_f32(swap, sr, cr);
+  uint32x4_t s_sign = vshlq_n_u32(vandq_u32(q, vdupq_n_u32(2)), 30);
+  uint32x4_t c_sign = vshlq_n_u32(vandq_u32(vaddq_u32(q, vdupq_n_u32(1)), vdupq_n_u32(2)), 30);
+  *s = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(sv), s_sign));
+  *c = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(cv), c_sign));
+}
+
+float32x4_t atan2_4(float32x4_t y, float32x4_t x) {
+  float32x4_t ax = vabsq_f32(x), ay = vabsq_f32(y);
+  float32x4_t big = vmaxq_f32(ax, ay), small = vminq_f32(ax, ay);
+  uint32x4_t nonzero = vcgtq_f32(big, vdupq_n_f32(0.0f));
+  float32x4_t t = vbslq_f32(nonzero, vmulq_f32(small, reciprocal(big)), vdupq_n_f32(0.0f));
+
+  uint32x4_t high = vcgtq_f32(t, vdupq_n_f32(TAN_PI_OVER_8));
+  float32x4_t folded = vmulq_f32(vsubq_f32(t, vdupq_n_f32(1.0f)), reciprocal(vaddq_f32(t, vdupq_n_f32(1.0f))));
+  t = vbslq_f32(high, folded, t);
+  float32x4_t base = vbslq_f32(high, vdupq_n_f32(PI_OVER_4), vdupq_n_f32(0.0f));
+  float32x4_t z = vmulq_f32(t, t);
+  float32x4_t p = vmlaq_f32(vdupq_n_f32(-3.33329491539e-1f), z, poly(z, 1.99777106478e-1f, -1.38776856032e-1f, 8.05374449538e-2f));
+  float32x4_t a = vaddq_f32(base, vmlaq_f32(t, vmulq_f32(t, z), p));
+
+  a = vbslq_f32(vcgtq_f32(ay, ax), vsubq_f32(vdupq_n_f32(PI_OVER_2), a), a);
+  a = vbslq_f32(vcltq_f32(x, vdupq_n_f32(0.0f)), vsubq_f32(vdupq_n_f32(PI), a), a);
+  uint32x4_t y_sign = vandq_u32(vreinterpretq_u32_f32(y), vdupq_n_u32(0x80000000u));
+  return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), y_sign));
+}
+}  // namespace
+#endif
+
+void sincos(const float* x, float* s, float* c, int n) {
+  int i = 0;
+#if PLS_FAST_NEON
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t sv, cv;
+    sincos4(vld1q_f32(x + i), &sv, &cv);
+    vst1q_f32(s + i, sv);
+    vst1q_f32(c + i, cv);
+  }
+#endif
+  for (; i < n; i++) sincos(x[i], s + i, c + i);
+}
+
+void atan2(const float* y, const float* x, float* out, int n) {
+  int i = 0;
+#if PLS_FAST_NEON
+  for (; i + 4 <= n; i += 4) vst1q_f32(out + i, atan2_4(vld1q_f32(y + i), vld1q_f32(x + i)));
+#endif
+  for (; i < n; i++) out[i] = atan2(y[i], x[i]);
+}
+
+void hypot(const float* x, const float* y, float* out, int n) {
+  int i = 0;
+#if PLS_FAST_NEON
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t xv = vld1q_f32(x + i), yv = vld1q_f32(y + i);
+    vst1q_f32(out + i, square_root(vmlaq_f32(vmulq_f32(xv, xv), yv, yv)));
+  }
+#endif
+  for (; i < n; i++) out[i] = hypot(x[i], y[i]);
+}
+
+}  // namespace fast
+}  // namespace pls
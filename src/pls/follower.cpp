@@ -0,0 +1,151 @@
+#include "pls/follower.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "pls/fastmath.hpp"
+
+namespace pls {
+
+namespace {
+constexpr double METERS_PER_INCH = 0.0254;
+
+// Least speed the Riccati equation is solved at, sideways error can't be steered out at a stop
+constexpr double MIN_VEL = 1e-4;
+constexpr int DOUBLINGS = 64;
+
+using Mat3 = std::array<std::array<double, 3>, 3>;
+
+Mat3 multiply(const Mat3& a, const Mat3& b) {
+  Mat3 out = {};
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      for (int k = 0; k < 3; k++) out[i][j] += a[i][k] * b[k][j];
+  return out;
+}
+
+Mat3 transpose(const Mat3& a) {
+  Mat3 out;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) out[i][j] = a[j][i];
+  return out;
+}
+
+Mat3 inverse(const Mat3& a) {
+  Mat3 out;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) {
+      int r0 = (j + 1) % 3, r1 = (j + 2) % 3, c0 = (i + 1) % 3, c1 = (i + 2) % 3;
+      out[i][j] = a[r0][c0] * a[r1][c1] - a[r0][c1] * a[r1][c0];
+    }
+  double det = a[0][0] * out[0][0] + a[0][1] * out[1][0] + a[0][2] * out[2][0];
+  for (auto& row : out)
+    for (double& v : row) v /= det;
+  return out;
+}
+
+Mat3 plus_identity(Mat3 a) {
+  for (int i = 0; i < 3; i++) a[i][i] += 1.0;
+  return a;
+}
+
+// Gains for the unicycle linearized at a speed, discretized exactly since A squares to 0:
+//   A = [0 0 0; 0 0 v; 0 0 0]  B = [1 0; 0 0; 0 1]
+//   Ad = I + A dt              Bd = B dt + A B dt^2 / 2
+std::array<double, 6> solve_gains(double vel, double dt, const LtvSettings& s) {
+  Mat3 ad = {{{1.0, 0.0, 0.0}, {0.0, 1.0, vel * dt}, {0.0, 0.0, 1.0}}};
+  double bd[3][2] = {{dt, 0.0}, {0.0, vel * dt * dt / 2.0}, {0.0, dt}};
+  double q[3] = {1.0 / (s.x_tolerance * s.x_tolerance), 1.0 / (s.y_tolerance * s.y_tolerance), 1.0 / (s.heading_tolerance * s.heading_tolerance)};
+  double r[2] = {1.0 / (s.vel_tolerance * s.vel_tolerance), 1.0 / (s.turn_tolerance * s.turn_tolerance)};
+
+  // Structure preserving doubling: a -> a (I + g h)^-1 a, g -> g + a (I + g h)^-1 g a', h -> h + a' h (I + g h)^-1 a, h ends at P
+  Mat3 a = ad, g = {}, h = {};
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) g[i][j] = bd[i][0] * bd[j][0] / r[0] + bd[i][1] * bd[j][1] / r[1];
+  for (int i = 0; i < 3; i++) h[i][i] = q[i];
+  for (int step = 0; step < DOUBLINGS; step++) {
+    Mat3 w = inverse(plus_identity(multiply(g, h)));
+    Mat3 wa = multiply(w, a);
+    Mat3 grown_g = multiply(a, multiply(multiply(w, g), transpose(a))), grown_h = multiply(multiply(transpose(a), h), wa);
+    Mat3 next_h = h;
+    double change = 0.0;
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++) {
+        g[i][j] += grown_g[i][j];
+        next_h[i][j] += grown_h[i][j];
+        change = std::max(change, std::fabs(next_h[i][j] - h[i][j]) / std::max(1.0, std::fabs(next_h[i][j])));
+      }
+    h = next_h;
+    a = multiply(a, wa);
+    if (change < 1e-12) break;
+  }
+
+  // K = (R + Bd' P Bd)^-1 Bd' P Ad
+  double pb[3][2] = {}, bpb[2][2] = {}, bpa[2][3] = {};
+  for (int i = 0; i < 3; i++)
+    for (int k = 0; k < 2; k++)
+      for (int j = 0; j < 3; j++) pb[i][k] += h[i][j] * bd[j][k];
+  for (int k = 0; k < 2; k++) {
+    for (int l = 0; l < 2; l++)
+      for (int i = 0; i < 3; i++) bpb[k][l] += bd[i][k] * pb[i][l];
+    for (int j = 0; j < 3; j++)
+      for (int i = 0; i < 3; i++) bpa[k][j] += pb[i][k] * ad[i][j];
+  }
+  bpb[0][0] += r[0];
+  bpb[1][1] += r[1];
+  double det = bpb[0][0] * bpb[1][1] - bpb[0][1] * bpb[1][0];
+  std::array<double, 6> k;
+  for (int j = 0; j < 3; j++) {
+    k[j] = (bpb[1][1] * bpa[0][j] - bpb[0][1] * bpa[1][j]) / det;
+    k[3 + j] = (bpb[0][0] * bpa[1][j] - bpb[1][0] * bpa[0][j]) / det;
+  }
+  return k;
+}
+}  // namespace
+
+squiggles::Pose pose_from_odom(ez::pose pose) {
+  return squiggles::Pose(pose.x * METERS_PER_INCH, pose.y * METERS_PER_INCH, (90.0 - pose.theta) * M_PI / 180.0);
+}
+
+LtvFollower::LtvFollower(DrivetrainDescription idrive, double dt, LtvSettings isettings)
+    : drive(idrive), motors(idrive, squiggles::Constraints(isettings.max_vel)), settings(isettings) {
+  for (int bin = 0; bin < BINS; bin++) table[bin] = solve_gains(std::max(bin_vel(bin), MIN_VEL), dt, settings);
+}
+
+LtvOutput LtvFollower::calculate(squiggles::Pose pose, const squiggles::ProfilePoint& target, double left_rpm, double right_rpm) const {
+  // Error in the robot's frame
+  double s, c;
+  math::sincos(pose.yaw, &s, &c);
+  double dx = target.vector.pose.x - pose.x, dy = target.vector.pose.y - pose.y;
+  double along = c * dx + s * dy, across = c * dy - s * dx;
+  double heading = std::remainder(target.vector.pose.yaw - pose.yaw, 2.0 * M_PI);
+
+  // Gains between the two bins around the speed, sideways ones flipped going backwards
+  double vel = target.vector.vel;
+  double at = std::min(std::fabs(vel) / settings.max_vel * (BINS - 1), BINS - 1.0);
+  int bin = std::min((int)at, BINS - 2);
+  double f = at - bin;
+  const std::array<double, 6>& lo = table[bin];
+  const std::array<double, 6>& hi = table[bin + 1];
+  double k[6];
+  for (int i = 0; i < 6; i++) k[i] = lo[i] + f * (hi[i] - lo[i]);
+  if (vel < 0.0) {
+    k[1] = -k[1];
+    k[4] = -k[4];
+  }
+
+  LtvOutput out;
+  out.vel = vel + k[0] * along + k[1] * across + k[2] * heading;
+  out.turn = vel * target.curvature + k[3] * along + k[4] * across + k[5] * heading;
+  double half_track = drive.track_width / 2.0;
+  out.left = out.vel - out.turn * half_track;
+  out.right = out.vel + out.turn * half_track;
+
+  // Each side pushes half the mass along its own arc
+  double half_mass = drive.mass / 2.0, accel = target.vector.accel, bend = target.curvature * half_track;
+  out.left_volts = motors.side_voltage(out.left, half_mass * accel * (1.0 - bend)) + settings.wheel_kp * (out.left - motors.wheel_speed(left_rpm));
+  out.right_volts = motors.side_voltage(out.right, half_mass * accel * (1.0 + bend)) + settings.wheel_kp * (out.right - motors.wheel_speed(right_rpm));
+  return out;
+}
+
+}  // namespace pls
@@ -0,0 +1,73 @@
+#include "pls/input.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+namespace pls {
+namespace input {
+
+static Sample samples[MAX_SAMPLES];
+static std::atomic<int> sample_count{0};
+static std::atomic<bool> is_recording{false};
+static std::uint32_t start_ms = 0;
+static bool competition = false;
+static char run_name[48] = "";
+
+void start(const char* name) {
+  std::strncpy(run_name, name, sizeof(run_name) - 1);
+  run_name[sizeof(run_name) - 1] = '\0';
+  sample_count.store(0);
+  start_ms = pros::millis();
+  competition = pros::competition::is_connected();
+  is_recording.store(true);
+}
+
+void stop() { is_recording.store(false); }
+
+bool recording() { return is_recording.load(); }
+
+int size() { return sample_count.load(); }
+
+const Sample& sample_get(int index) { return samples[index]; }
+
+void record(pros::Controller& controller) {
+  if (!is_recording.load(std::memory_order_relaxed)) return;
+
+  int index = sample_count.load(std::memory_order_relaxed);
+  if (index >= MAX_SAMPLES) return;
+  Sample& s = samples[index];
+  s.time_ms = pros::millis() - start_ms;
+  for (int i = 0; i < 4; i++)
+    s.analog[i] = (std::int8_t)controller.get_analog((pros::controller_analog_e_t)i);
+  s.buttons = 0;
+  for (int i = 0; i < BUTTONS; i++)
+    if (controller.get_digital((pros::controller_digital_e_t)(pros::E_CONTROLLER_DIGITAL_L1 + i))) s.buttons |= 1 << i;
+  sample_count.store(index + 1, std::memory_order_relaxed);
+}
+
+void dump(const char* file_path) {
+  FILE* out = stdout;
+  if (file_path != nullptr) {
+    out = fopen(file_path, "w");
+    if (out == nullptr) {
+      printf("input: could not open %s, printing to terminal\n", file_path);
+      out = stdout;
+    }
+  }
+
+  // One tick per line: INPUT <time ms> <left x> <left y> <right x> <right y> <buttons hex>
+  fprintf(out, "INPUT START %d %s\n", competition ? 1 : 0, run_name);
+  int n = size();
+  for (int i = 0; i < n; i++) {
+    const Sample& s = samples[i];
+    fprintf(out, "INPUT %lu %d %d %d %d %x\n", (unsigned long)s.time_ms, s.analog[0], s.analog[1], s.analog[2], s.analog[3], s.buttons);
+  }
+  fprintf(out, "INPUT DONE %d\n", n);
+
+  if (out != stdout)
+    fclose(out);
+}
+
+}  // namespace input
+}  // namespace pls
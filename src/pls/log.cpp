@@ -0,0 +1,91 @@
+#include "pls/log.hpp"
+
+#include <algorithm>
+
+namespace pls {
+
+Logger::Logger(const char* file_path, const char* name)
+    : file_path(file_path),
+      name(name),
+      writer_task([this]() { task(); }, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "logger") {}
+
+std::uint32_t Logger::dropped() { return dropped_count.load(std::memory_order_relaxed); }
+
+std::uint32_t Logger::contended() { return contended_count.load(std::memory_order_relaxed); }
+
+std::uint32_t Logger::written() { return written_count.load(std::memory_order_relaxed); }
+
+std::uint32_t Logger::pending() { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+
+bool Logger::claim() {
+  pros::task_t self = pros::c::task_get_current();
+  pros::task_t owner = nullptr;
+  if (pusher.compare_exchange_strong(owner, self, std::memory_order_acquire)) return true;
+
+  // A task deleted mid-push never published its record, so the slot is free to take over
+  pros::task_state_e_t state = pros::c::task_get_state(owner);
+  if (state != pros::E_TASK_STATE_DELETED && state != pros::E_TASK_STATE_INVALID) return false;
+  return pusher.compare_exchange_strong(owner, self, std::memory_order_acquire);
+}
+
+double Logger::push_cost_ns(int samples) {
+  // Time small batches so the ring never fills and every push takes the normal path
+  const int batch = 32;
+  std::uint64_t total_us = 0;
+  int timed = 0;
+  while (timed < samples) {
+    while (CAPACITY - pending() < (std::uint32_t)batch) pros::delay(1);
+    std::uint64_t start = pros::micros();
+    for (int i = 0; i < batch; i++) push(nullptr, "", i, 1.0);
+    total_us += pros::micros() - start;
+    timed += batch;
+  }
+  while (pending() > 0) pros::delay(1);
+  return total_us * 1000.0 / timed;
+}
+
+void Logger::stats_print() {
+  log("logger stats: written %lu, dropped %lu, %lu of them while another task logged", (unsigned long)written(), (unsigned long)dropped(),
+      (unsigned long)contended());
+}
+
+void Logger::task() {
+  FILE* out = stdout;
+  if (file_path != nullptr) {
+    out = fopen(file_path, "a");
+    if (out == nullptr) {
+      printf("%s: could not open %s, logging to terminal\n", name, file_path);
+      out = stdout;
+    }
+  }
+
+  char line[160];
+  while (true) {
+    std::uint32_t t = tail.load(std::memory_order_relaxed);
+    std::uint32_t h = head.load(std::memory_order_acquire);
+    if (t == h) {
+      pros::delay(10);
+      continue;
+    }
+
+    // Format everything that's ready, freeing each slot as soon as it's copied out
+    while (t != h) {
+      const Record& r = ring[t & (CAPACITY - 1)];
+      if (r.format == nullptr) {
+        tail.store(++t, std::memory_order_release);
+        continue;
+      }
+      // Both snprintfs return the length they wanted, which can be past the end of line
+      const int most = sizeof(line) - 2;
+      int n = std::min(snprintf(line, sizeof(line), "[%s %lu.%03lu] ", name, (unsigned long)(r.time / 1000), (unsigned long)(r.time % 1000)), most);
+      n = std::min(n + r.format(line + n, sizeof(line) - n - 1, r.fmt, r.payload), most);
+      line[n++] = '\n';
+      tail.store(++t, std::memory_order_release);
+      fwrite(line, 1, n, out);
+      written_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    fflush(out);
+  }
+}
+
+}  // namespace pls
@@ -0,0 +1,90 @@
+#include "pls/motormodel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace pls {
+
+namespace {
+constexpr double G = 9.81;
+}  // namespace
+
+MotorModel::MotorModel(DrivetrainDescription idrive, squiggles::Constraints ilinear_constraints) : drive(idrive), linear_constraints(ilinear_constraints) {
+  double gear = drive.cartridge_rpm / drive.wheel_rpm;
+  rpm_per_mps = 60.0 / (M_PI * drive.wheel_diameter) * gear;
+  newtons_per_nm = drive.motors_per_side * gear / (drive.wheel_diameter / 2.0);
+  nm_per_amp = drive.stall_torque / std::min(drive.current_limit, drive.stall_current);
+  ohms = 12.0 / drive.stall_current;
+}
+
+std::tuple<double, double> MotorModel::side_force(double wheel_vel) const {
+  // The motor sees voltage minus back EMF across its windings, and the current limit caps the rest
+  double rpm = wheel_vel * rpm_per_mps;
+  double back_emf = 12.0 * rpm / drive.cartridge_rpm;
+  double most = std::min((drive.voltage - back_emf) / ohms, drive.current_limit);
+  double least = std::max((-drive.voltage - back_emf) / ohms, -drive.current_limit);
+
+  // Friction drags against the way the wheels turn
+  double drag = wheel_vel > 0.0 ? drive.motor_friction : wheel_vel < 0.0 ? -drive.motor_friction : 0.0;
+  return {(most * nm_per_amp - drag) * newtons_per_nm, (least * nm_per_amp - drag) * newtons_per_nm};
+}
+
+double MotorModel::side_top_speed() const {
+  // Where the torque left after back EMF only covers friction
+  double amps = drive.motor_friction / nm_per_amp;
+  double rpm = (drive.voltage - amps * ohms) / 12.0 * drive.cartridge_rpm;
+  return std::max(rpm, 0.0) / rpm_per_mps;
+}
+
+double MotorModel::side_voltage(double wheel_vel, double force) const {
+  double drag = wheel_vel > 0.0 ? drive.motor_friction : wheel_vel < 0.0 ? -drive.motor_friction : 0.0;
+  double amps = (force / newtons_per_nm + drag) / nm_per_amp;
+  return amps * ohms + 12.0 * wheel_vel * rpm_per_mps / drive.cartridge_rpm;
+}
+
+squiggles::Constraints MotorModel::constraints([[maybe_unused]] const squiggles::Pose pose, double curvature, double vel) {
+  double half_track = drive.track_width / 2.0;
+  double sides[2] = {1.0 - curvature * half_track, 1.0 + curvature * half_track};
+
+  // The outside wheel runs out of voltage first, and the tires have to hold the turn
+  double max_vel = std::min(linear_constraints.max_vel, side_top_speed() / std::max(std::fabs(sides[0]), std::fabs(sides[1])));
+  double grip = drive.tire_friction * G;
+  if (std::fabs(curvature) > 1e-9) max_vel = std::min(max_vel, std::sqrt(grip / std::fabs(curvature)));
+
+  // Each side's acceleration is the center's scaled by how far out its arc is
+  double max_accel = linear_constraints.max_accel;
+  double min_accel = linear_constraints.min_accel;
+  double half_mass = drive.mass / 2.0;
+  for (double scale : sides) {
+    if (std::fabs(scale) < 1e-9) continue;
+    auto [push, pull] = side_force(vel * scale);
+    double a_push = push / (half_mass * scale), a_pull = pull / (half_mass * scale);
+    max_accel = std::min(max_accel, std::max(a_push, a_pull));
+    min_accel = std::max(min_accel, std::min(a_push, a_pull));
+  }
+
+  // Whatever grip the turn leaves over
+  double lateral = vel * vel * curvature;
+  double traction = std::sqrt(std::max(0.0, grip * grip - lateral * lateral));
+  max_accel = std::min(max_accel, traction);
+  min_accel = std::max(min_accel, -traction);
+
+  // Hold a speed when nothing's left, instead of handing squiggles an impossible range
+  max_accel = std::max(max_accel, 0.0);
+  min_accel = std::min(min_accel, 0.0);
+  return squiggles::Constraints(max_vel, max_accel, linear_constraints.max_jerk, linear_constraints.max_curvature, min_accel);
+}
+
+std::vector<double> MotorModel::linear_to_wheel_vels(double lin_vel, double curvature) {
+  double half_track = drive.track_width / 2.0;
+  return {lin_vel * (1.0 - curvature * half_track), lin_vel * (1.0 + curvature * half_track)};
+}
+
+std::string MotorModel::to_string() const {
+  return "MotorModel {track_width: " + std::to_string(drive.track_width) + ", side_top_speed: " + std::to_string(side_top_speed()) +
+         ", voltage: " + std::to_string(drive.voltage) + ", current_limit: " + std::to_string(drive.current_limit) +
+         ", tire_friction: " + std::to_string(drive.tire_friction) + ", linear_constraints: " + linear_constraints.to_string() + "}";
+}
+
+}  // namespace pls
@@ -0,0 +1,83 @@
+#include "pls/path.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+namespace pls {
+
+PreparedPath::PreparedPath(ez::pose start, const std::vector<ez::odom>& waypoints, double spacing, double weight_smooth, double weight_data,
+                           double tolerance)
+    : origin(start), given(waypoints) {
+  std::uint64_t start_us = pros::micros();
+  if (!(spacing > 0.0)) {
+    printf("Prepared path spacing has to be more than 0, got %.2f\n", spacing);
+    given.clear();
+  }
+  if (given.empty()) return;
+  given.shrink_to_fit();
+
+  // Count first so the points are allocated once
+  ez::pose previous = start;
+  std::size_t count = 1;
+  for (const ez::odom& waypoint : given) {
+    int between = (int)std::floor(ez::util::distance_to_point(waypoint.target, previous) / spacing);
+    count += std::max(between - 1, 0) + 1;
+    previous = waypoint.target;
+  }
+  path.reserve(count);
+  waypoint_index.reserve(given.size());
+
+  // Injection, like EZ's inject_points() on the path from the start
+  ez::odom first = given.front();
+  first.target = {start.x, start.y, ez::ANGLE_NOT_SET};
+  path.push_back(first);
+  previous = first.target;
+  for (const ez::odom& waypoint : given) {
+    double length = ez::util::distance_to_point(waypoint.target, previous);
+    int between = (int)std::floor(length / spacing);
+    for (int j = 1; j < between; j++) {
+      double t = (j * spacing) / length;
+      ez::odom point = waypoint;
+      point.target = {previous.x + (waypoint.target.x - previous.x) * t, previous.y + (waypoint.target.y - previous.y) * t, ez::ANGLE_NOT_SET};
+      path.push_back(point);
+    }
+    path.push_back(waypoint);
+    waypoint_index.push_back(path.size() - 1);
+    previous = waypoint.target;
+  }
+
+  // Smoothing, like EZ's smooth_path(), pulling each point toward its neighbors and its injected spot
+  if (path.size() >= 3) {
+    std::vector<ez::odom> injected = path;
+    double change = tolerance;
+    int iterations = 0;
+    while (change >= tolerance && iterations++ < 1000) {
+      change = 0.0;
+      for (std::size_t i = 1; i < path.size() - 1; i++) {
+        ez::pose& p = path[i].target;
+        double old_x = p.x, old_y = p.y;
+        p.x += weight_data * (injected[i].target.x - p.x) + weight_smooth * (path[i - 1].target.x + path[i + 1].target.x - 2.0 * p.x);
+        p.y += weight_data * (injected[i].target.y - p.y) + weight_smooth * (path[i - 1].target.y + path[i + 1].target.y - 2.0 * p.y);
+        change += std::fabs(old_x - p.x) + std::fabs(old_y - p.y);
+      }
+    }
+  }
+  // EZ puts the robot's pose in front of the points it's given
+  path.erase(path.begin());
+  for (int& i : waypoint_index) i--;
+  took_us = pros::micros() - start_us;
+}
+
+PreparedPath::PreparedPath(ez::united_pose start, const std::vector<ez::united_odom>& waypoints, double spacing, double weight_smooth,
+                           double weight_data, double tolerance)
+    : PreparedPath(ez::util::united_pose_to_pose(start), ez::util::united_odoms_to_odoms(waypoints), spacing, weight_smooth, weight_data, tolerance) {}
+
+std::size_t PreparedPath::bytes() const {
+  return sizeof(*this) + (given.capacity() + path.capacity()) * sizeof(ez::odom) + waypoint_index.capacity() * sizeof(int);
+}
+
+void PreparedPath::print(const char* name) const {
+  printf("Prepared path %s: %d waypoints, %d points, %.2f ms, %zu bytes\n", name, (int)given.size(), (int)path.size(), took_us / 1000.0, bytes());
+}
+
+}  // namespace pls
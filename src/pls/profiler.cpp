@@ -0,0 +1,91 @@
+#include "pls/profiler.hpp"
+
+#include <cstdio>
+
+#include "EZ-Template/api.hpp"
+
+namespace pls {
+namespace prof {
+
+// Sections push themselves on the front of this list as they're constructed
+static std::atomic<Section*> first_section{nullptr};
+
+Section::Section(const char* name, bool listed) : name(name) {
+  if (!listed) return;
+  Section* head = first_section.load(std::memory_order_relaxed);
+  do {
+    next = head;
+  } while (!first_section.compare_exchange_weak(head, this, std::memory_order_release, std::memory_order_relaxed));
+}
+
+std::uint32_t Section::percentile_get(double percentile) const {
+  std::uint32_t total = count.load(std::memory_order_relaxed);
+  if (total == 0) return 0;
+
+  // The bucket edge can be past the slowest time seen, so cap it at max
+  std::uint32_t max = max_us.load(std::memory_order_relaxed);
+  std::uint32_t wanted = (std::uint32_t)(total * percentile / 100.0);
+  std::uint32_t seen = 0;
+  for (int i = 0; i < BUCKETS - 1; i++) {
+    seen += buckets[i].load(std::memory_order_relaxed);
+    if (seen > wanted) return (1u << i) < max ? (1u << i) : max;
+  }
+  return max;
+}
+
+double Section::average_get() const {
+  std::uint32_t n = count.load(std::memory_order_relaxed);
+  return n == 0 ? 0.0 : (double)total_us.load(std::memory_order_relaxed) / n;
+}
+
+void Section::reset() {
+  for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+  count.store(0, std::memory_order_relaxed);
+  total_us.store(0, std::memory_order_relaxed);
+  max_us.store(0, std::memory_order_relaxed);
+}
+
+Section* sections_get() { return first_section.load(std::memory_order_acquire); }
+
+// Timed the first time a page or print needs it, not at startup
+static double overhead_cached() {
+  static double ns = overhead_ns();
+  return ns;
+}
+
+void print() {
+  printf("\nloop timing, each section's own timing costs %.0f ns\n", overhead_cached());
+  printf("%-16s %8s %9s %7s %7s %7s\n", "section", "count", "avg us", "p50", "p99", "max");
+  for (Section* s = sections_get(); s != nullptr; s = s->next) {
+    printf("%-16s %8lu %9.1f %7lu %7lu %7lu\n", s->name, (unsigned long)s->count.load(), s->average_get(),
+           (unsigned long)s->percentile_get(50), (unsigned long)s->percentile_get(99), (unsigned long)s->max_us.load());
+  }
+}
+
+void screen_print(int line) {
+  char text[64];
+  snprintf(text, sizeof(text), "%-10s %5s %5s %6s +%.0fns", "us", "p50", "p99", "max", overhead_cached());
+  ez::screen_print(text, line++);
+  for (Section* s = sections_get(); s != nullptr && line < 8; s = s->next, line++) {
+    snprintf(text, sizeof(text), "%-10.10s %5lu %5lu %6lu", s->name,
+             (unsigned long)s->percentile_get(50), (unsigned long)s->percentile_get(99), (unsigned long)s->max_us.load());
+    ez::screen_print(text, line);
+  }
+}
+
+void reset() {
+  for (Section* s = sections_get(); s != nullptr; s = s->next) s->reset();
+}
+
+double overhead_ns(int samples) {
+  // Times scopes into a section that isn't on the profiler page
+  static Section scratch("overhead", false);
+  std::uint64_t start = pros::micros();
+  for (int i = 0; i < samples; i++) {
+    ScopedTimer timer(scratch);
+  }
+  return (pros::micros() - start) * 1000.0 / samples;
+}
+
+}  // namespace prof
+}  // namespace pls
@@ -0,0 +1,227 @@
+#include "pls/replan.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+#include "pls/profiler.hpp"
+#include "pros/rtos.hpp"
+
+namespace pls {
+
+namespace {
+// Same search squiggles' gradient_descent() does
+constexpr int T_MIN = 2;
+constexpr int T_MAX = 15;
+constexpr double K_EPSILON = squiggles::SplineGenerator::K_EPSILON;
+
+// Points the splice's shape is judged at, and spacing of the points it's parameterized over
+constexpr int COST_SAMPLES = 32;
+constexpr double STATE_SPACING = 0.01;  // m
+constexpr int MAX_STATES = 512;
+
+// Seconds of profile around the current time to look for the closest point in
+constexpr double SEARCH_BEHIND = 0.5;
+constexpr double SEARCH_AHEAD = 2.0;
+
+double ai(double vf, double vi, double s) { return s < K_EPSILON ? 0.0 : (vf * vf - vi * vi) / (2.0 * s); }
+double vf(double vi, double a, double s) { return std::sqrt(std::max(0.0, vi * vi + 2.0 * a * s)); }
+}  // namespace
+
+Replanner::Replanner(squiggles::Constraints iconstraints, std::shared_ptr<squiggles::PhysicalModel> imodel, double idt, ReplanSettings isettings)
+    : constraints(iconstraints), model(imodel), dt(idt), settings(isettings) {}
+
+bool Replanner::profile_set(std::vector<squiggles::ProfilePoint> points) {
+  duration = 0;
+  for (const squiggles::ProfilePoint& point : points) {
+    if (point.vector.vel < 0.0) {
+      printf("Replanner only splices profiles driven forward\n");
+      current = Profile();
+      return false;
+    }
+  }
+  current = Profile(std::move(points), dt);
+  return true;
+}
+
+double Replanner::tracking_error(squiggles::Pose pose, double t) const {
+  if (current.empty()) return 0.0;
+  return pose.dist(current.point_at_time(t).vector.pose);
+}
+
+bool Replanner::update(squiggles::Pose pose, double vel, double t) {
+  PLS_PROFILE_SCOPE("Replanner::update");
+  if (current.empty() || t >= current.points().back().time || tracking_error(pose, t) <= settings.threshold) return false;
+  replan(pose, vel, t);
+  return true;
+}
+
+// Mean squared acceleration, jerk and curvature, like SplineGenerator's, and whether the shape keeps to the constraints
+double Replanner::cost(const Spline& spline, bool* valid) const {
+  double t[COST_SAMPLES];
+  for (int i = 0; i < COST_SAMPLES; i++) t[i] = spline.duration() * i / (COST_SAMPLES - 1);
+  SplineSamples<double>& s = scratch;
+  s.resize(COST_SAMPLES);
+  spline.evaluate(t, COST_SAMPLES, s);
+
+  double total = 0.0;
+  *valid = true;
+  for (int i = 0; i < COST_SAMPLES; i++) {
+    double accel2 = s.ddx[i] * s.ddx[i] + s.ddy[i] * s.ddy[i];
+    double jerk2 = s.dddx[i] * s.dddx[i] + s.dddy[i] * s.dddy[i];
+    if (accel2 > constraints.max_accel * constraints.max_accel || jerk2 > constraints.max_jerk * constraints.max_jerk ||
+        std::fabs(s.curvature[i]) > constraints.max_curvature)
+      *valid = false;
+    total += accel2 + jerk2 + s.curvature[i] * s.curvature[i];
+  }
+  return total / COST_SAMPLES;
+}
+
+// SplineGenerator::parameterize() and integrate_constrained_states(), then one walk to resample every dt
+std::vector<squiggles::ProfilePoint> Replanner::parameterize(const Spline& spline, double start_vel, double end_vel, double start_time) const {
+  int n = std::clamp((int)std::ceil(spline.length() / STATE_SPACING) + 1, 2, MAX_STATES);
+  std::vector<double> t(n);
+  for (int i = 0; i < n; i++) t[i] = spline.duration() * i / (n - 1);
+  SplineSamples<double> s;
+  s.resize(n);
+  spline.evaluate(t.data(), n, s);
+
+  std::vector<squiggles::Pose> poses(n);
+  std::vector<double> distance(n), max_vel(n), min_accel(n), max_accel(n);
+  auto enforce = [&](int i) {
+    squiggles::Constraints limits = model->constraints(poses[i], s.curvature[i], max_vel[i]);
+    max_vel[i] = std::min(max_vel[i], limits.max_vel);
+    min_accel[i] = std::max(constraints.min_accel, limits.min_accel);
+    max_accel[i] = std::min(constraints.max_accel, limits.max_accel);
+  };
+  for (int i = 0; i < n; i++) {
+    poses[i] = squiggles::Pose(s.x[i], s.y[i], std::atan2(s.dy[i], s.dx[i]));
+    distance[i] = i == 0 ? 0.0 : distance[i - 1] + poses[i].dist(poses[i - 1]);
+    max_vel[i] = constraints.max_vel;
+    if (std::fabs(s.curvature[i]) > K_EPSILON) max_vel[i] = std::min(max_vel[i], constraints.max_curvature / std::fabs(s.curvature[i]));
+    enforce(i);
+  }
+
+  max_vel[0] = std::min(max_vel[0], std::max(start_vel, 0.0));
+  for (int i = 1; i < n; i++) {
+    max_vel[i] = std::min(max_vel[i], vf(max_vel[i - 1], max_accel[i - 1], distance[i] - distance[i - 1]));
+    enforce(i);
+  }
+  max_vel[n - 1] = std::min(max_vel[n - 1], end_vel);
+  for (int i = n - 1; i > 0; i--) {
+    max_vel[i - 1] = std::min(max_vel[i - 1], vf(max_vel[i], -min_accel[i], distance[i] - distance[i - 1]));
+    enforce(i - 1);
+  }
+
+  std::vector<squiggles::ProfilePoint> states;
+  states.reserve(n);
+  double time = start_time;
+  for (int i = 0; i < n; i++) {
+    if (i > 0) {
+      double average = (max_vel[i] + max_vel[i - 1]) / 2.0;
+      if (average > K_EPSILON) time += (distance[i] - distance[i - 1]) / average;
+    }
+    double accel = i + 1 < n ? ai(max_vel[i + 1], max_vel[i], distance[i + 1] - distance[i]) : 0.0;
+    states.emplace_back(squiggles::ControlVector(poses[i], max_vel[i], accel, 0.0), model->linear_to_wheel_vels(max_vel[i], s.curvature[i]),
+                        s.curvature[i], time);
+  }
+
+  std::vector<squiggles::ProfilePoint> out;
+  out.reserve((time - start_time) / dt + 2);
+  int i = 0;
+  for (double at = start_time; at < time - K_EPSILON; at += dt) {
+    while (i + 2 < n && states[i + 1].time <= at) i++;
+    double span = states[i + 1].time - states[i].time;
+    out.push_back(Profile::lerp(states[i], states[i + 1], span > 0.0 ? std::clamp((at - states[i].time) / span, 0.0, 1.0) : 0.0));
+  }
+  out.push_back(states.back());
+  return out;
+}
+
+void Replanner::replan(squiggles::Pose pose, double vel, double t) {
+  if (current.empty()) return;
+  PLS_PROFILE_SCOPE("Replanner::replan");
+  std::uint64_t start_us = pros::micros();
+  const std::vector<squiggles::ProfilePoint>& points = current.points();
+  int last = points.size() - 1;
+
+  // Closest point near where the profile has the robot now
+  double first_time = points.front().time;
+  int begin = std::clamp((int)((t - SEARCH_BEHIND - first_time) / dt), 0, last);
+  int end = std::clamp((int)((t + SEARCH_AHEAD - first_time) / dt), begin, last);
+  int closest = begin;
+  for (int i = begin + 1; i <= end; i++)
+    if (pose.dist(points[i].vector.pose) < pose.dist(points[closest].vector.pose)) closest = i;
+
+  // Rejoin far enough ahead to turn back onto the path
+  double ahead = std::max(settings.rejoin_min, std::fabs(vel) * settings.rejoin_time), along = 0.0;
+  int rejoin = closest;
+  while (rejoin < last && along < ahead) {
+    along += points[rejoin + 1].vector.pose.dist(points[rejoin].vector.pose);
+    rejoin++;
+  }
+  const squiggles::ProfilePoint& target = points[rejoin];
+
+  // Gradient descent on the log of the made up speed, from the last splice's when there was one.  The profile
+  // only drives forward, so a robot rolling back still faces along it and the splice starts from a stop
+  vel = std::max(vel, 0.0);
+  squiggles::ControlVector from(pose), to(target.vector.pose);
+  from.accel = to.accel = 0.0;
+  double distance = pose.dist(target.vector.pose);
+  bool warm = duration != 0;
+  int low = warm ? std::max(T_MIN, duration - 1) : T_MIN, high = warm ? std::min(T_MAX, duration + 1) : T_MIN + 2;
+  double best_cost = std::numeric_limits<double>::infinity();
+  bool best_valid = false;
+  int best_duration = low;
+  double best_log_vel = 0.0;
+  for (int d = low; d <= high; d++) {
+    double lv = warm ? log_vel : std::log(std::max(distance / d, K_EPSILON));
+    double step = warm ? 0.125 : 0.5;
+    auto cost_at = [&](double at, bool* valid) { return cost(Spline(from, to, d, std::exp(at), std::exp(at), false), valid); };
+    bool valid;
+    double c = cost_at(lv, &valid);
+    for (int i = 0; i < settings.iterations; i++) {
+      bool up_valid, down_valid;
+      double up = cost_at(lv + step, &up_valid);
+      double down = cost_at(lv - step, &down_valid);
+      if (up < c && up <= down) {
+        lv += step;
+        c = up;
+        valid = up_valid;
+      } else if (down < c) {
+        lv -= step;
+        c = down;
+        valid = down_valid;
+      } else {
+        step /= 2.0;
+      }
+    }
+
+    // Valid shapes beat smooth ones
+    if ((valid && !best_valid) || (valid == best_valid && c < best_cost)) {
+      best_cost = c;
+      best_valid = valid;
+      best_duration = d;
+      best_log_vel = lv;
+    }
+  }
+  duration = best_duration;
+  log_vel = best_log_vel;
+
+  // The splice, then the rest of the profile from where it ends
+  Spline splice(from, to, duration, std::exp(log_vel), std::exp(log_vel));
+  std::vector<squiggles::ProfilePoint> next = parameterize(splice, vel, target.vector.vel, t);
+  double shift = next.back().time - target.time;
+  next.reserve(next.size() + last - rejoin);
+  for (int i = rejoin + 1; i <= last; i++) {
+    next.push_back(points[i]);
+    next.back().time += shift;
+  }
+  current = Profile(std::move(next), dt);
+
+  count++;
+  last_us = pros::micros() - start_us;
+}
+
+}  // namespace pls
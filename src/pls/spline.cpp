@@ -0,0 +1,295 @@
+#include "pls/spline.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "pls/fastmath.hpp"
+
+namespace pls {
+
+namespace {
+// 5 point Gauss-Legendre on [-1, 1]
+constexpr double GL_NODES[5] = {-0.906179845938664, -0.538469310105683, 0.0, 0.538469310105683, 0.906179845938664};
+constexpr double GL_WEIGHTS[5] = {0.236926885056189, 0.478628670499366, 0.568888888888889, 0.478628670499366, 0.236926885056189};
+
+// Meters a piece of the integral may be off by before it's halved, and how many times it can be
+constexpr double INTEGRAL_TOLERANCE = 1e-10;
+constexpr int MAX_HALVINGS = 12;
+
+// Most it takes to pin down a parameter, halving through a stop in the spline included
+constexpr int NEWTON_STEPS = 8;
+
+// squiggles keeps the coefficients to itself
+struct Coefficients : squiggles::QuinticPolynomial {
+  explicit Coefficients(const squiggles::QuinticPolynomial& polynomial) : squiggles::QuinticPolynomial(polynomial) {}
+  std::array<double, 6> get() const { return {a0, a1, a2, a3, a4, a5}; }
+};
+
+double value(const std::array<double, 6>& a, double t) { return a[0] + t * (a[1] + t * (a[2] + t * (a[3] + t * (a[4] + t * a[5])))); }
+double first(const std::array<double, 6>& a, double t) { return a[1] + t * (2.0 * a[2] + t * (3.0 * a[3] + t * (4.0 * a[4] + t * 5.0 * a[5]))); }
+double second(const std::array<double, 6>& a, double t) { return 2.0 * a[2] + t * (6.0 * a[3] + t * (12.0 * a[4] + t * 20.0 * a[5])); }
+
+// Coefficients of a spline and its derivatives around the middle of its parameter, lowest power first.
+// Powers of half the duration lose 32 times fewer bits in float than powers of all of it
+template <typename T>
+struct Chains {
+  T middle;
+  T p[6], d1[5], d2[4], d3[3];
+
+  Chains(const std::array<double, 6>& a, double duration) : middle(duration / 2.0) {
+    // Taylor shift to t = middle + u, in double
+    double m = middle, shifted[6];
+    std::copy(a.begin(), a.end(), shifted);
+    for (int j = 0; j < 5; j++)
+      for (int k = 4; k >= j; k--) shifted[k] += m * shifted[k + 1];
+    for (int k = 0; k < 6; k++) p[k] = shifted[k];
+    for (int k = 0; k < 5; k++) d1[k] = (k + 1) * shifted[k + 1];
+    for (int k = 0; k < 4; k++) d2[k] = (k + 2) * (k + 1) * shifted[k + 2];
+    for (int k = 0; k < 3; k++) d3[k] = (k + 3) * (k + 2) * (k + 1) * shifted[k + 3];
+  }
+};
+
+// Parameters from begin to end, with nothing for the compiler to think the arrays overlap through
+template <typename T>
+void evaluate_range(const Chains<T>& cx, const Chains<T>& cy, const T* __restrict t, int begin, int end, SplineSamples<T>& out) {
+  T* __restrict ox = out.x.data();
+  T* __restrict oy = out.y.data();
+  T* __restrict odx = out.dx.data();
+  T* __restrict ody = out.dy.data();
+  T* __restrict oddx = out.ddx.data();
+  T* __restrict oddy = out.ddy.data();
+  T* __restrict odddx = out.dddx.data();
+  T* __restrict odddy = out.dddy.data();
+  T* __restrict ospeed = out.speed.data();
+  T* __restrict ocurvature = out.curvature.data();
+  for (int i = begin; i < end; i++) {
+    T u = t[i] - cx.middle;
+    T x = cx.p[0] + u * (cx.p[1] + u * (cx.p[2] + u * (cx.p[3] + u * (cx.p[4] + u * cx.p[5]))));
+    T y = cy.p[0] + u * (cy.p[1] + u * (cy.p[2] + u * (cy.p[3] + u * (cy.p[4] + u * cy.p[5]))));
+    T dx = cx.d1[0] + u * (cx.d1[1] + u * (cx.d1[2] + u * (cx.d1[3] + u * cx.d1[4])));
+    T dy = cy.d1[0] + u * (cy.d1[1] + u * (cy.d1[2] + u * (cy.d1[3] + u * cy.d1[4])));
+    T ddx = cx.d2[0] + u * (cx.d2[1] + u * (cx.d2[2] + u * cx.d2[3]));
+    T ddy = cy.d2[0] + u * (cy.d2[1] + u * (cy.d2[2] + u * cy.d2[3]));
+    T dddx = cx.d3[0] + u * (cx.d3[1] + u * cx.d3[2]);
+    T dddy = cy.d3[0] + u * (cy.d3[1] + u * cy.d3[2]);
+    T v2 = dx * dx + dy * dy;
+    T v = std::sqrt(v2);
+    T cross = dx * ddy - dy * ddx;
+    ox[i] = x;
+    oy[i] = y;
+    odx[i] = dx;
+    ody[i] = dy;
+    oddx[i] = ddx;
+    oddy[i] = ddy;
+    odddx[i] = dddx;
+    odddy[i] = dddy;
+    ospeed[i] = v;
+    ocurvature[i] = v < (T)squiggles::SplineGenerator::K_EPSILON ? (T)0 : cross / (v2 * v);
+  }
+}
+
+#if PLS_FAST_NEON
+inline float32x4_t horner(const float* c, int degree, float32x4_t t) {
+  float32x4_t r = vdupq_n_f32(c[degree]);
+  for (int k = degree - 1; k >= 0; k--) r = vmlaq_f32(vdupq_n_f32(c[k]), r, t);
+  return r;
+}
+
+void evaluate4(const Chains<float>& cx, const Chains<float>& cy, const float* t, int i, SplineSamples<float>& out) {
+  float32x4_t tv = vsubq_f32(vld1q_f32(t + i), vdupq_n_f32(cx.middle));
+  float32x4_t dx = horner(cx.d1, 4, tv), dy = horner(cy.d1, 4, tv), ddx = horner(cx.d2, 3, tv), ddy = horner(cy.d2, 3, tv);
+  vst1q_f32(&out.x[i], horner(cx.p, 5, tv));
+  vst1q_f32(&out.y[i], horner(cy.p, 5, tv));
+  vst1q_f32(&out.dx[i], dx);
+  vst1q_f32(&out.dy[i], dy);
+  vst1q_f32(&out.ddx[i], ddx);
+  vst1q_f32(&out.ddy[i], ddy);
+  vst1q_f32(&out.dddx[i], horner(cx.d3, 2, tv));
+  vst1q_f32(&out.dddy[i], horner(cy.d3, 2, tv));
+
+  float32x4_t v2 = vmlaq_f32(vmulq_f32(dx, dx), dy, dy);
+  float32x4_t v = fast::fast_detail::square_root(v2);
+  float32x4_t cross = vmlsq_f32(vmulq_f32(dx, ddy), dy, ddx);
+  uint32x4_t moving = vcgeq_f32(v, vdupq_n_f32(squiggles::SplineGenerator::K_EPSILON));
+  float32x4_t curvature = vmulq_f32(cross, fast::fast_detail::reciprocal(vmulq_f32(v2, v)));
+  vst1q_f32(&out.speed[i], v);
+  vst1q_f32(&out.curvature[i], vbslq_f32(moving, curvature, vdupq_n_f32(0.0f)));
+}
+#endif
+}  // namespace
+
+Spline::Spline(squiggles::ControlVector start, squiggles::ControlVector end, double duration, double start_vel, double end_vel, bool table)
+    : span(duration), step(duration / INTERVALS) {
+  // Same polynomials as SplineGenerator::get_x_spline() and get_y_spline()
+  double c0 = std::cos(start.pose.yaw), s0 = std::sin(start.pose.yaw), c1 = std::cos(end.pose.yaw), s1 = std::sin(end.pose.yaw);
+  x = Coefficients(squiggles::QuinticPolynomial(start.pose.x, start_vel * c0, start.accel * c0, end.pose.x, end_vel * c1, end.accel * c1, duration)).get();
+  y = Coefficients(squiggles::QuinticPolynomial(start.pose.y, start_vel * s0, start.accel * s0, end.pose.y, end_vel * s1, end.accel * s1, duration)).get();
+
+  if (!table) return;
+  double total = 0.0;
+  for (int i = 0; i < INTERVALS; i++) {
+    double from = i * step, to = (i + 1) * step;
+    double once = gauss_legendre(from, to), halved = integral(from, to, once, MAX_HALVINGS);
+    if (std::fabs(halved - once) >= INTEGRAL_TOLERANCE) sharp |= 1u << i;
+    total += halved;
+    distance[i + 1] = total;
+  }
+}
+
+std::vector<Spline> Spline::segments(squiggles::SplineGenerator& generator, std::vector<squiggles::ControlVector> waypoints, double dt, bool fast) {
+  std::vector<Spline> out;
+  if (waypoints.size() < 2) return out;
+  out.reserve(waypoints.size() - 1);
+  for (std::size_t i = 0; i + 1 < waypoints.size(); i++) {
+    squiggles::ControlVector& start = waypoints[i];
+    squiggles::ControlVector& end = waypoints[i + 1];
+    std::vector<squiggles::SplineGenerator::GeneratedPoint> raw = generator.gen_raw_path(start, end, fast);
+    int steps = std::max<int>(raw.size(), 2) - 1;
+    double duration = std::round(steps * dt);
+
+    // Given speeds stand in for 0 with K_DEFAULT_VEL, gradient descent picks one for both ends
+    if (!std::isnan(start.vel) && !std::isnan(end.vel)) {
+      double start_vel = start.vel > squiggles::SplineGenerator::K_EPSILON ? start.vel : generator.K_DEFAULT_VEL;
+      double end_vel = end.vel > squiggles::SplineGenerator::K_EPSILON ? end.vel : generator.K_DEFAULT_VEL;
+      out.emplace_back(start, end, duration, start_vel, end_vel);
+      continue;
+    }
+    int middle = steps / 2;
+    double t = duration * middle / steps;
+    squiggles::Pose still = Spline(start, end, duration, 0.0, 0.0, false).pose_at(t);
+    squiggles::Pose unit = Spline(start, end, duration, 1.0, 1.0, false).pose_at(t);
+    double bx = unit.x - still.x, by = unit.y - still.y;
+    const squiggles::Pose& at = raw[middle].pose;
+    double scale = bx * bx + by * by;
+    double vel = scale > 0.0 ? (bx * (at.x - still.x) + by * (at.y - still.y)) / scale : generator.K_DEFAULT_VEL;
+    out.emplace_back(start, end, duration, vel, vel);
+  }
+  return out;
+}
+
+double Spline::speed_at(double t) const {
+  double dx = first(x, t), dy = first(y, t);
+  return std::sqrt(dx * dx + dy * dy);
+}
+
+double Spline::gauss_legendre(double from, double to) const {
+  double middle = (from + to) / 2.0, half = (to - from) / 2.0;
+  double sum = 0.0;
+  for (int j = 0; j < 5; j++) sum += GL_WEIGHTS[j] * speed_at(middle + GL_NODES[j] * half);
+  return sum * half;
+}
+
+// Halves where the halves disagree, which only happens where the spline nearly stops and the speed turns sharply
+double Spline::integral(double from, double to, double whole, int depth) const {
+  double middle = (from + to) / 2.0;
+  double left = gauss_legendre(from, middle), right = gauss_legendre(middle, to);
+  if (depth == 0 || std::fabs(left + right - whole) < INTEGRAL_TOLERANCE) return left + right;
+  return integral(from, middle, left, depth - 1) + integral(middle, to, right, depth - 1);
+}
+
+double Spline::integral(int knot, double to) const {
+  double from = knot * step;
+  double once = gauss_legendre(from, to);
+  return sharp & (1u << knot) ? integral(from, to, once, MAX_HALVINGS) : once;
+}
+
+double Spline::distance_at(double t) const {
+  t = std::clamp(t, 0.0, span);
+  int i = std::min((int)(t / step), INTERVALS - 1);
+  return distance[i] + integral(i, t);
+}
+
+double Spline::parameter_at(double s) const {
+  s = std::clamp(s, 0.0, length());
+  int i = std::upper_bound(distance.begin() + 1, distance.end() - 1, (float)s) - distance.begin() - 1;
+  double ds = distance[i + 1] - distance[i];
+  double low = i * step, high = (i + 1) * step;
+  if (ds <= 0.0) return low;
+
+  // Newton from a line between the knots, kept inside them by halving when a stop in the
+  // spline sends it out
+  double t = low + step * (s - distance[i]) / ds;
+  for (int n = 0; n < NEWTON_STEPS; n++) {
+    double error = distance[i] + integral(i, t) - s;
+    if (std::fabs(error) < ds * 1e-9) break;
+    if (error > 0.0)
+      high = t;
+    else
+      low = t;
+    double v = speed_at(t);
+    double next = v > 0.0 ? t - error / v : low - 1.0;
+    t = next >= low && next <= high ? next : (low + high) / 2.0;
+  }
+  return t;
+}
+
+void Spline::evaluate(const double* t, int n, SplineSamples<double>& out) const {
+  Chains<double> cx(x, span), cy(y, span);
+  evaluate_range(cx, cy, t, 0, n, out);
+}
+
+void Spline::evaluate(const float* t, int n, SplineSamples<float>& out) const {
+  Chains<float> cx(x, span), cy(y, span);
+  int i = 0;
+#if PLS_FAST_NEON
+  for (; i + 4 <= n; i += 4) evaluate4(cx, cy, t, i, out);
+#endif
+  evaluate_range(cx, cy, t, i, n, out);
+}
+
+squiggles::Pose Spline::pose_at(double t) const {
+  double dx = first(x, t), dy = first(y, t);
+  return squiggles::Pose(value(x, t), value(y, t), std::atan2(dy, dx));
+}
+
+double Spline::curvature_at(double t) const {
+  double dx = first(x, t), dy = first(y, t);
+  double v = std::hypot(dx, dy);
+  if (v < squiggles::SplineGenerator::K_EPSILON) return 0.0;
+  return (dx * second(y, t) - dy * second(x, t)) / (v * v * v);
+}
+
+Profile::Profile(std::vector<squiggles::ProfilePoint> points, double idt) : path(std::move(points)), dt(idt) {
+  distance.reserve(path.size());
+  double total = 0.0;
+  for (std::size_t i = 0; i < path.size(); i++) {
+    if (i > 0) total += path[i].vector.pose.dist(path[i - 1].vector.pose);
+    distance.push_back(total);
+  }
+}
+
+squiggles::ProfilePoint Profile::lerp(const squiggles::ProfilePoint& start, const squiggles::ProfilePoint& end, double fraction) {
+  auto mix = [fraction](double a, double b) { return a + (b - a) * fraction; };
+  double yaw_change = std::remainder(end.vector.pose.yaw - start.vector.pose.yaw, 2.0 * M_PI);
+  squiggles::Pose pose(mix(start.vector.pose.x, end.vector.pose.x), mix(start.vector.pose.y, end.vector.pose.y),
+                       start.vector.pose.yaw + yaw_change * fraction);
+  std::vector<double> wheels(start.wheel_velocities.size());
+  for (std::size_t w = 0; w < wheels.size() && w < end.wheel_velocities.size(); w++) wheels[w] = mix(start.wheel_velocities[w], end.wheel_velocities[w]);
+  return squiggles::ProfilePoint(squiggles::ControlVector(pose, mix(start.vector.vel, end.vector.vel), mix(start.vector.accel, end.vector.accel), 0.0),
+                                 wheels, mix(start.curvature, end.curvature), mix(start.time, end.time));
+}
+
+squiggles::ProfilePoint Profile::point_at_time(double t) const {
+  if (path.empty()) return squiggles::ProfilePoint();
+  if (t <= path.front().time) return path.front();
+  if (t >= path.back().time) return path.back();
+
+  // Each segment's last point comes early, so the point before t is at the guess or a point per segment past it
+  int last = path.size() - 1;
+  int i = std::clamp((int)((t - path.front().time) / dt), 0, last - 1);
+  while (i > 0 && path[i].time > t) i--;
+  while (i < last - 1 && path[i + 1].time <= t) i++;
+  if (squiggles::nearly_equal(path[i + 1].time, t)) return path[i + 1];
+  return lerp(path[i], path[i + 1], (t - path[i].time) / (path[i + 1].time - path[i].time));
+}
+
+squiggles::ProfilePoint Profile::point_at_distance(double s) const {
+  if (path.empty()) return squiggles::ProfilePoint();
+  if (s <= 0.0) return path.front();
+  if (s >= distance.back()) return path.back();
+  int i = std::upper_bound(distance.begin(), distance.end(), s) - distance.begin() - 1;
+  double ds = distance[i + 1] - distance[i];
+  return ds > 0.0 ? lerp(path[i], path[i + 1], (s - distance[i]) / ds) : path[i];
+}
+
+}  // namespace pls
@@ -0,0 +1,166 @@
+#include "pls/stream.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "pls/profiler.hpp"
+#include "pls/spline.hpp"
+
+namespace pls {
+
+//
+// Sources
+//
+
+int TableSource::read(squiggles::ProfilePoint* out, int max) {
+  int n = std::min<std::size_t>(max, size - next);
+  std::copy(points + next, points + next + n, out);
+  next += n;
+  return n;
+}
+
+FileSource::FileSource(const char* file_path) { reader.open(file_path); }
+
+FileSource::FileSource(const std::uint8_t* data, std::size_t size) { reader.open(data, size); }
+
+int FileSource::read(squiggles::ProfilePoint* out, int max) {
+  if (used == (int)chunk.size()) {
+    chunk.resize(trajectory::CHUNK_POINTS);
+    chunk.resize(reader.read(chunk.data()));
+    used = 0;
+  }
+  int n = std::min<int>(max, chunk.size() - used);
+  std::copy(chunk.begin() + used, chunk.begin() + used + n, out);
+  used += n;
+  return n;
+}
+
+std::size_t FileSource::bytes() const {
+  std::size_t wheels = chunk.empty() ? 0 : chunk.front().wheel_velocities.capacity();
+  return sizeof(*this) + chunk.capacity() * (sizeof(squiggles::ProfilePoint) + wheels * sizeof(double));
+}
+
+GeneratorSource::GeneratorSource(squiggles::SplineGenerator generator, std::vector<squiggles::ControlVector> waypoints)
+    : generator(std::move(generator)), waypoints(std::move(waypoints)) {}
+
+GeneratorSource::GeneratorSource(squiggles::SplineGenerator generator, const std::vector<squiggles::Pose>& poses)
+    : GeneratorSource(std::move(generator), std::vector<squiggles::ControlVector>(poses.begin(), poses.end())) {}
+
+// One pair of waypoints at a time, like SplineGenerator::_generate()
+int GeneratorSource::read(squiggles::ProfilePoint* out, int max) {
+  if (used == segment.size()) {
+    if (next_waypoint + 1 >= waypoints.size()) return 0;
+    squiggles::ControlVector from = waypoints[next_waypoint], to = waypoints[next_waypoint + 1];
+    std::vector<squiggles::SplineGenerator::GeneratedPoint> raw = generator.gen_raw_path(from, to, false);
+    segment = generator.parameterize(from, to, raw, from.vel, to.vel, end_time);
+    used = next_waypoint > 0 && !segment.empty() ? 1 : 0;  // Segments share their end points
+    if (!segment.empty()) end_time = segment.back().time;
+    next_waypoint++;
+    if (used == segment.size()) return read(out, max);
+  }
+  int n = std::min<std::size_t>(max, segment.size() - used);
+  std::copy(segment.begin() + used, segment.begin() + used + n, out);
+  used += n;
+  return n;
+}
+
+std::size_t GeneratorSource::bytes() const {
+  std::size_t wheels = segment.empty() ? 0 : segment.front().wheel_velocities.capacity();
+  return sizeof(*this) + waypoints.capacity() * sizeof(squiggles::ControlVector) +
+         segment.capacity() * (sizeof(squiggles::ProfilePoint) + wheels * sizeof(double));
+}
+
+//
+// TrajectoryStream
+//
+
+TrajectoryStream::TrajectoryStream(TrajectorySource& source, std::uint32_t prio)
+    : source(source),
+      start_us(pros::micros()),
+      producer_task([this]() { produce(); }, prio, TASK_STACK_DEPTH_DEFAULT, "trajectory stream") {}
+
+TrajectoryStream::~TrajectoryStream() {
+  stopping.store(true, std::memory_order_relaxed);
+  producer_task.join();
+}
+
+bool TrajectoryStream::ready() const { return head.load(std::memory_order_acquire) >= CHUNK || exhausted.load(std::memory_order_acquire); }
+
+bool TrajectoryStream::wait_ready(std::uint32_t timeout_ms) {
+  std::uint32_t start = pros::millis();
+  while (!ready() && pros::millis() - start < timeout_ms) pros::delay(1);
+  return ready();
+}
+
+std::size_t TrajectoryStream::peak_bytes() const {
+  return sizeof(*this) + ring_heap.load(std::memory_order_relaxed) + peak_source_bytes.load(std::memory_order_relaxed);
+}
+
+void TrajectoryStream::produce() {
+  while (!stopping.load(std::memory_order_relaxed)) {
+    std::uint32_t h = head.load(std::memory_order_relaxed);
+    std::uint32_t room = CAPACITY - (h - tail.load(std::memory_order_acquire));
+    if (room == 0) {
+      pros::delay(5);
+      continue;
+    }
+    PLS_PROFILE_SCOPE("stream producer");
+
+    // Up to the end of the ring, the rest on the next pass
+    int got = source.read(&ring[h & (CAPACITY - 1)], std::min(room, CAPACITY - (h & (CAPACITY - 1))));
+    peak_source_bytes.store(std::max(peak_source_bytes.load(std::memory_order_relaxed), source.bytes()), std::memory_order_relaxed);
+    if (got <= 0) break;
+
+    // Slots keep their wheel velocities' memory once they've been filled
+    if (h < CAPACITY) {
+      std::size_t heap = ring_heap.load(std::memory_order_relaxed);
+      for (std::uint32_t i = h; i < h + got && i < CAPACITY; i++) heap += ring[i].wheel_velocities.capacity() * sizeof(double);
+      ring_heap.store(heap, std::memory_order_relaxed);
+    }
+    head.store(h + got, std::memory_order_release);
+    peak.store(std::max(peak.load(std::memory_order_relaxed), h + got - tail.load(std::memory_order_acquire)), std::memory_order_relaxed);
+    if (h < CHUNK && h + got >= CHUNK) first_ready_us.store(pros::micros() - start_us, std::memory_order_relaxed);
+  }
+  if (head.load(std::memory_order_relaxed) < CHUNK) first_ready_us.store(pros::micros() - start_us, std::memory_order_relaxed);
+  exhausted.store(true, std::memory_order_release);
+}
+
+squiggles::ProfilePoint TrajectoryStream::point_at_time(double t) {
+  // Whether the source has run out has to be read before head, so the last points are in when it has
+  bool last = exhausted.load(std::memory_order_acquire);
+  std::uint32_t h = head.load(std::memory_order_acquire);
+  std::uint32_t i = tail.load(std::memory_order_relaxed);
+  if (i == h) {
+    // Nothing came, and nothing will once the source has run out
+    if (last)
+      reached_end = true;
+    else
+      underrun_count++;
+    return squiggles::ProfilePoint(squiggles::ControlVector(squiggles::Pose(0.0, 0.0, 0.0), 0.0, 0.0, 0.0), {}, 0.0, 0.0);
+  }
+
+  while (i + 1 < h && ring[(i + 1) & (CAPACITY - 1)].time <= t) i++;
+  tail.store(i, std::memory_order_release);
+  const squiggles::ProfilePoint& at = ring[i & (CAPACITY - 1)];
+  latest_time = at.time;
+  if (i + 1 == h) {
+    if (t > at.time) {
+      if (last)
+        reached_end = true;
+      else
+        underrun_count++;
+    }
+    return at;
+  }
+
+  const squiggles::ProfilePoint& next = ring[(i + 1) & (CAPACITY - 1)];
+  if (squiggles::nearly_equal(next.time, t)) return next;
+  double span = next.time - at.time;
+  return Profile::lerp(at, next, span > 0.0 ? std::clamp((t - at.time) / span, 0.0, 1.0) : 0.0);
+}
+
+bool TrajectoryStream::finished() const { return reached_end; }
+
+bool TrajectoryStream::empty() const { return exhausted.load(std::memory_order_acquire) && head.load(std::memory_order_acquire) == 0; }
+
+}  // namespace pls
@@ -0,0 +1,109 @@
+#include "pls/trace.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+namespace pls {
+namespace trace {
+
+static Event events[MAX_EVENTS];
+static std::atomic<int> event_count{0};
+static std::atomic<int> dropped_count{0};
+static std::atomic<bool> is_recording{false};
+static bool motion_open = false;
+static std::uint64_t start_us = 0;
+static char run_name[48] = "";
+
+static void record(char phase, track_e track, const char* name, double value) {
+  if (!is_recording.load(std::memory_order_relaxed)) return;
+
+  int index = event_count.fetch_add(1, std::memory_order_relaxed);
+  if (index >= MAX_EVENTS) {
+    event_count.store(MAX_EVENTS, std::memory_order_relaxed);
+    dropped_count.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  Event& e = events[index];
+  e.time_us = (std::uint32_t)(pros::micros() - start_us);
+  e.name = name;
+  e.value = (float)value;
+  e.phase = phase;
+  e.track = track;
+}
+
+void start(const char* name) {
+  std::strncpy(run_name, name, sizeof(run_name) - 1);
+  run_name[sizeof(run_name) - 1] = '\0';
+  event_count.store(0);
+  dropped_count.store(0);
+  motion_open = false;
+  start_us = pros::micros();
+  is_recording.store(true);
+}
+
+void stop() {
+  if (motion_open) motion_end(ez::RUNNING);
+  is_recording.store(false);
+}
+
+bool recording() { return is_recording.load(); }
+
+int size() { return event_count.load(); }
+
+int dropped() { return dropped_count.load(); }
+
+const Event& event_get(int index) { return events[index]; }
+
+void motion_begin(const char* name, double target) {
+  if (motion_open) motion_end(ez::RUNNING);
+  record('B', MOTION, name, target);
+  motion_open = true;
+}
+
+void motion_end(ez::exit_output reason) {
+  if (!motion_open) return;
+  record('E', MOTION, "", reason);
+  motion_open = false;
+}
+
+void span_begin(const char* name, double value) { record('B', WAIT, name, value); }
+
+void span_end() { record('E', WAIT, "", 0); }
+
+void action(const char* name, double value) { record('i', MECHANISM, name, value); }
+
+void delay(std::uint32_t milliseconds) {
+  span_begin("delay", milliseconds);
+  pros::delay(milliseconds);
+  span_end();
+}
+
+void dump(const char* file_path) {
+  FILE* out = stdout;
+  if (file_path != nullptr) {
+    out = fopen(file_path, "w");
+    if (out == nullptr) {
+      printf("trace: could not open %s, printing to terminal\n", file_path);
+      out = stdout;
+    }
+  }
+
+  // One event per line: TRACE <phase> <time us> <track> <value> <name>
+  fprintf(out, "TRACE START %s\n", run_name);
+  int n = size();
+  for (int i = 0; i < n; i++) {
+    const Event& e = events[i];
+    if (e.phase == 'E' && e.track == MOTION)
+      fprintf(out, "TRACE E %lu %d %g %s\n", (unsigned long)e.time_us, e.track, e.value, ez::exit_to_string((ez::exit_output)e.value).c_str());
+    else
+      fprintf(out, "TRACE %c %lu %d %g %s\n", e.phase, (unsigned long)e.time_us, e.track, e.value, e.name);
+  }
+  fprintf(out, "TRACE DONE %d %d\n", n, dropped());
+
+  if (out != stdout)
+    fclose(out);
+}
+
+}  // namespace trace
+}  // namespace pls
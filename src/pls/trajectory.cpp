@@ -0,0 +1,281 @@
+#include "pls/trajectory.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace pls {
+namespace trajectory {
+
+namespace {
+// CRC-32 as zlib and the SD card's own tools compute it
+constexpr std::array<std::uint32_t, 256> CRC_TABLE = [] {
+  std::array<std::uint32_t, 256> table = {};
+  for (std::uint32_t i = 0; i < 256; i++) {
+    std::uint32_t c = i;
+    for (int k = 0; k < 8; k++) c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+    table[i] = c;
+  }
+  return table;
+}();
+
+std::uint32_t crc32(const std::uint8_t* data, std::size_t size) {
+  std::uint32_t c = 0xffffffffu;
+  for (std::size_t i = 0; i < size; i++) c = CRC_TABLE[(c ^ data[i]) & 0xff] ^ (c >> 8);
+  return c ^ 0xffffffffu;
+}
+
+template <typename T>
+void put(std::uint8_t* out, std::size_t offset, T value) { std::memcpy(out + offset, &value, sizeof(T)); }
+
+template <typename T>
+T get(const std::uint8_t* in, std::size_t offset) {
+  T value;
+  std::memcpy(&value, in + offset, sizeof(T));
+  return value;
+}
+
+// Header fields, by offset
+constexpr std::size_t H_MAGIC = 0, H_VERSION = 4, H_HEADER_BYTES = 6, H_POINTS = 8, H_CHUNKS = 12, H_CHUNK_POINTS = 16, H_WHEELS = 18,
+                      H_COLUMNS = 19, H_CHUNK_BYTES = 20, H_DT = 24, H_CRC = 28;
+
+// Chunk fields, the ranges and values are one after another per column
+constexpr std::size_t C_INDEX = 0, C_COUNT = 4, C_RANGES = 8;
+constexpr double LEVELS = 65535.0;
+
+double column(const squiggles::ProfilePoint& p, int c) {
+  switch (c) {
+    case 0: return p.vector.pose.x;
+    case 1: return p.vector.pose.y;
+    case 2: return p.vector.pose.yaw;
+    case 3: return p.vector.vel;
+    case 4: return p.vector.accel;
+    case 5: return p.vector.jerk;
+    case 6: return p.curvature;
+    case 7: return p.time;
+    default: return p.wheel_velocities[c - FIXED_COLUMNS];
+  }
+}
+
+void column_set(squiggles::ProfilePoint& p, int c, double value) {
+  switch (c) {
+    case 0: p.vector.pose.x = value; break;
+    case 1: p.vector.pose.y = value; break;
+    case 2: p.vector.pose.yaw = value; break;
+    case 3: p.vector.vel = value; break;
+    case 4: p.vector.accel = value; break;
+    case 5: p.vector.jerk = value; break;
+    case 6: p.curvature = value; break;
+    case 7: p.time = value; break;
+    default: p.wheel_velocities[c - FIXED_COLUMNS] = value;
+  }
+}
+
+// Base at or under the lowest value and a step that reaches the highest, both as floats
+void range(double low, double high, float* base, float* step) {
+  *base = low;
+  if (*base > low) *base = std::nextafter(*base, -INFINITY);
+  *step = (high - *base) / LEVELS;
+  if (*base + LEVELS * (double)*step < high) *step = std::nextafter(*step, INFINITY);
+}
+
+void encode_chunk(const squiggles::ProfilePoint* points, int count, std::uint32_t index, int columns, std::uint8_t* out) {
+  std::size_t size = chunk_bytes(columns - FIXED_COLUMNS);
+  std::memset(out, 0, size);
+  put<std::uint32_t>(out, C_INDEX, index);
+  put<std::uint16_t>(out, C_COUNT, count);
+  std::size_t values = C_RANGES + columns * 8;
+  for (int c = 0; c < columns; c++) {
+    double low = INFINITY, high = -INFINITY;
+    for (int i = 0; i < count; i++) {
+      low = std::min(low, column(points[i], c));
+      high = std::max(high, column(points[i], c));
+    }
+    float base, step;
+    range(low, high, &base, &step);
+    put<float>(out, C_RANGES + c * 8, base);
+    put<float>(out, C_RANGES + c * 8 + 4, step);
+    for (int i = 0; i < count; i++) {
+      double level = step > 0.0f ? std::round((column(points[i], c) - base) / step) : 0.0;
+      put<std::uint16_t>(out, values + (c * CHUNK_POINTS + i) * 2, std::clamp(level, 0.0, LEVELS));
+    }
+  }
+  put<std::uint32_t>(out, size - 4, crc32(out, size - 4));
+}
+}  // namespace
+
+const char* status_to_string(status_e status) {
+  switch (status) {
+    case OK: return "ok";
+    case OPEN_FAILED: return "could not open the file";
+    case WRITE_FAILED: return "could not write the file";
+    case BAD_HEADER: return "not a trajectory file";
+    case BAD_VERSION: return "trajectory file from a newer version";
+    case BAD_CHUNK: return "chunk CRC mismatch";
+    case TRUNCATED: return "file ends early";
+    case BAD_WHEELS: return "wheel velocities a file can't hold";
+  }
+  return "unknown";
+}
+
+status_e encode(const std::vector<squiggles::ProfilePoint>& points, double dt, std::vector<std::uint8_t>& out) {
+  int wheels = points.empty() ? 0 : points.front().wheel_velocities.size();
+  for (const squiggles::ProfilePoint& p : points)
+    if ((int)p.wheel_velocities.size() != wheels) return BAD_WHEELS;
+  if (wheels > MAX_WHEELS) return BAD_WHEELS;
+
+  std::uint32_t chunks = (points.size() + CHUNK_POINTS - 1) / CHUNK_POINTS;
+  std::size_t size = chunk_bytes(wheels);
+  out.assign(HEADER_BYTES + chunks * size, 0);
+  std::uint8_t* head = out.data();
+  put<std::uint32_t>(head, H_MAGIC, MAGIC);
+  put<std::uint16_t>(head, H_VERSION, VERSION);
+  put<std::uint16_t>(head, H_HEADER_BYTES, HEADER_BYTES);
+  put<std::uint32_t>(head, H_POINTS, points.size());
+  put<std::uint32_t>(head, H_CHUNKS, chunks);
+  put<std::uint16_t>(head, H_CHUNK_POINTS, CHUNK_POINTS);
+  put<std::uint8_t>(head, H_WHEELS, wheels);
+  put<std::uint8_t>(head, H_COLUMNS, FIXED_COLUMNS + wheels);
+  put<std::uint32_t>(head, H_CHUNK_BYTES, size);
+  put<float>(head, H_DT, dt);
+  put<std::uint32_t>(head, H_CRC, crc32(head, H_CRC));
+
+  for (std::uint32_t k = 0; k < chunks; k++) {
+    int count = std::min<std::size_t>(CHUNK_POINTS, points.size() - k * CHUNK_POINTS);
+    encode_chunk(points.data() + k * CHUNK_POINTS, count, k, FIXED_COLUMNS + wheels, out.data() + HEADER_BYTES + k * size);
+  }
+  return OK;
+}
+
+status_e store(const char* file_path, const std::vector<squiggles::ProfilePoint>& points, double dt) {
+  std::vector<std::uint8_t> bytes;
+  status_e status = encode(points, dt, bytes);
+  if (status != OK) return status;
+  FILE* out = fopen(file_path, "wb");
+  if (out == nullptr) return OPEN_FAILED;
+  bool written = fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size();
+  return fclose(out) == 0 && written ? OK : WRITE_FAILED;
+}
+
+namespace {
+status_e read_all(Reader& reader, std::vector<squiggles::ProfilePoint>& points, double* dt) {
+  points.resize(reader.header().points);
+  std::size_t at = 0;
+  while (!reader.done()) {
+    if (at + CHUNK_POINTS > points.size()) points.resize(at + CHUNK_POINTS);  // Room for a chunk that claims more than the header
+    at += reader.read(points.data() + at);
+  }
+  points.resize(at);
+  if (reader.status() == OK && at != reader.header().points) return TRUNCATED;
+  if (dt != nullptr) *dt = reader.header().dt;
+  return reader.status();
+}
+}  // namespace
+
+status_e load(const char* file_path, std::vector<squiggles::ProfilePoint>& points, double* dt) {
+  Reader reader;
+  status_e status = reader.open(file_path);
+  return status == OK ? read_all(reader, points, dt) : status;
+}
+
+status_e decode(const std::uint8_t* data, std::size_t size, std::vector<squiggles::ProfilePoint>& points, double* dt) {
+  Reader reader;
+  status_e status = reader.open(data, size);
+  return status == OK ? read_all(reader, points, dt) : status;
+}
+
+//
+// Reader
+//
+
+Reader::~Reader() { close(); }
+
+void Reader::close() {
+  if (file != nullptr) fclose(file);
+  file = nullptr;
+  memory = nullptr;
+  head = Header();
+  next_chunk = 0;
+}
+
+status_e Reader::fail(status_e status) {
+  result = status;
+  return status;
+}
+
+// Next bytes of the file into the buffer
+bool Reader::fill(std::size_t bytes) {
+  if (file != nullptr) return fread(buffer, 1, bytes, file) == bytes;
+  if (memory_offset + bytes > memory_size) return false;
+  std::memcpy(buffer, memory + memory_offset, bytes);
+  memory_offset += bytes;
+  return true;
+}
+
+status_e Reader::open(const char* file_path) {
+  close();
+  result = OK;
+  file = fopen(file_path, "rb");
+  if (file == nullptr) return fail(OPEN_FAILED);
+  return header_read();
+}
+
+status_e Reader::open(const std::uint8_t* data, std::size_t size) {
+  close();
+  result = OK;
+  memory = data;
+  memory_size = size;
+  memory_offset = 0;
+  return header_read();
+}
+
+status_e Reader::header_read() {
+  if (!fill(HEADER_BYTES)) return fail(TRUNCATED);
+  if (get<std::uint32_t>(buffer, H_MAGIC) != MAGIC || get<std::uint32_t>(buffer, H_CRC) != crc32(buffer, H_CRC)) return fail(BAD_HEADER);
+  if (get<std::uint16_t>(buffer, H_VERSION) != VERSION || get<std::uint16_t>(buffer, H_HEADER_BYTES) != HEADER_BYTES ||
+      get<std::uint16_t>(buffer, H_CHUNK_POINTS) != CHUNK_POINTS)
+    return fail(BAD_VERSION);
+  int wheels = get<std::uint8_t>(buffer, H_WHEELS);
+  if (wheels > MAX_WHEELS || get<std::uint8_t>(buffer, H_COLUMNS) != FIXED_COLUMNS + wheels ||
+      get<std::uint32_t>(buffer, H_CHUNK_BYTES) != chunk_bytes(wheels))
+    return fail(BAD_HEADER);
+
+  head.points = get<std::uint32_t>(buffer, H_POINTS);
+  head.chunks = get<std::uint32_t>(buffer, H_CHUNKS);
+  head.wheels = wheels;
+  head.dt = get<float>(buffer, H_DT);
+  chunk_size = chunk_bytes(wheels);
+  if (head.chunks != (head.points + CHUNK_POINTS - 1) / CHUNK_POINTS) return fail(BAD_HEADER);
+  return OK;
+}
+
+int Reader::read(squiggles::ProfilePoint* out) {
+  if (done()) return 0;
+  if (!fill(chunk_size)) {
+    fail(TRUNCATED);
+    return 0;
+  }
+  if (get<std::uint32_t>(buffer, chunk_size - 4) != crc32(buffer, chunk_size - 4) || get<std::uint32_t>(buffer, C_INDEX) != next_chunk) {
+    fail(BAD_CHUNK);
+    return 0;
+  }
+  int count = get<std::uint16_t>(buffer, C_COUNT);
+  if (count > CHUNK_POINTS) {
+    fail(BAD_CHUNK);
+    return 0;
+  }
+
+  int columns = FIXED_COLUMNS + head.wheels;
+  std::size_t values = C_RANGES + columns * 8;
+  for (int i = 0; i < count; i++) out[i].wheel_velocities.resize(head.wheels);
+  for (int c = 0; c < columns; c++) {
+    double base = get<float>(buffer, C_RANGES + c * 8), step = get<float>(buffer, C_RANGES + c * 8 + 4);
+    for (int i = 0; i < count; i++) column_set(out[i], c, base + step * get<std::uint16_t>(buffer, values + (c * CHUNK_POINTS + i) * 2));
+  }
+  next_chunk++;
+  return count;
+}
+
+}  // namespace trajectory
+}  // namespace pls
@@ -0,0 +1,86 @@
+#include "pls/transform.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace pls {
+
+namespace {
+constexpr double METERS_PER_INCH = 0.0254;
+}  // namespace
+
+Transform::Transform(bool flip, double turn, double dx, double dy) : flip(flip), turn(turn), dx(dx), dy(dy) {
+  // Quarter turns exactly, so a path turned and turned back lands where it was
+  double quarters = turn / 90.0;
+  if (quarters == std::round(quarters)) {
+    static const double SIN[] = {0.0, 1.0, 0.0, -1.0};
+    int q = ((int)std::fmod(quarters, 4.0) + 4) % 4;
+    sin_turn = SIN[q];
+    cos_turn = SIN[(q + 1) % 4];
+  } else {
+    sin_turn = std::sin(turn * M_PI / 180.0);
+    cos_turn = std::cos(turn * M_PI / 180.0);
+  }
+}
+
+Transform Transform::mirror() { return Transform(true, 0.0, 0.0, 0.0); }
+
+Transform Transform::reflect(double line_deg) { return Transform(true, 2.0 * line_deg, 0.0, 0.0); }
+
+Transform Transform::rotate(double deg) { return Transform(false, deg, 0.0, 0.0); }
+
+Transform Transform::translate(double x, double y) { return Transform(false, 0.0, x, y); }
+
+Transform Transform::then(const Transform& next) const {
+  // A mirror turns rotations before it the other way
+  ez::pose offset = next.apply(ez::pose{dx, dy, ez::ANGLE_NOT_SET});
+  return Transform(flip != next.flip, next.turn + (next.flip ? -turn : turn), offset.x, offset.y);
+}
+
+ez::pose Transform::apply(ez::pose pose) const {
+  double x = flip ? -pose.x : pose.x;
+  ez::pose out;
+  out.x = x * cos_turn + pose.y * sin_turn + dx;
+  out.y = pose.y * cos_turn - x * sin_turn + dy;
+  out.theta = pose.theta == ez::ANGLE_NOT_SET ? ez::ANGLE_NOT_SET : (flip ? -pose.theta : pose.theta) + turn;
+  return out;
+}
+
+ez::odom Transform::apply(ez::odom point) const {
+  point.target = apply(point.target);
+  if (flip && point.turn_behavior == ez::left_turn)
+    point.turn_behavior = ez::right_turn;
+  else if (flip && point.turn_behavior == ez::right_turn)
+    point.turn_behavior = ez::left_turn;
+  return point;
+}
+
+squiggles::Pose Transform::apply(squiggles::Pose pose) const {
+  // Yaw is counterclockwise from +x, so a clockwise turn takes away from it
+  double x = flip ? -pose.x : pose.x;
+  double yaw = (flip ? M_PI - pose.yaw : pose.yaw) - turn * M_PI / 180.0;
+  return squiggles::Pose(x * cos_turn + pose.y * sin_turn + dx * METERS_PER_INCH, pose.y * cos_turn - x * sin_turn + dy * METERS_PER_INCH, yaw);
+}
+
+squiggles::ProfilePoint Transform::apply(squiggles::ProfilePoint point) const {
+  point.vector.pose = apply(point.vector.pose);
+  if (flip) {
+    point.curvature = -point.curvature;
+    std::reverse(point.wheel_velocities.begin(), point.wheel_velocities.end());
+  }
+  return point;
+}
+
+int TransformSource::read(squiggles::ProfilePoint* out, int max) {
+  int n = source.read(out, max);
+  for (int i = 0; i < n; i++) out[i] = how.apply(std::move(out[i]));
+  return n;
+}
+
+std::vector<ez::odom> transformed(std::vector<ez::odom> points, const Transform& transform) {
+  for (ez::odom& point : points) point = transform.apply(point);
+  return points;
+}
+
+}  // namespace pls